@@ -0,0 +1,20 @@
+// Compare heatshrink compression ratio and speed for different window/lookahead
+// sizes on a real var image. Run `save()` on the device first so there is a
+// var image in Storage to test with.
+var hs = require("heatshrink");
+var v = require("Storage").readArrayBuffer(".varimg");
+if (!v) throw new Error("No .varimg - run save() first");
+var img = hs.decompress(new Uint8Array(v,4)); // skip the build hash
+print("Var image", img.byteLength, "bytes");
+[[8,4],[8,6],[9,6],[9,7],[10,6],[10,7],[11,6],[11,8]].forEach(function(p) {
+  var t = getTime();
+  try {
+    var c = hs.compress(img, {window:p[0], lookahead:p[1]});
+  } catch (e) {
+    return print(p, "not supported");
+  }
+  t = getTime()-t;
+  var ok = E.toString(hs.decompress(c))==E.toString(img);
+  print(p, c.byteLength+" bytes", (100*c.byteLength/img.byteLength).toFixed(1)+"%",
+        (img.byteLength/(t*1024)).toFixed(0)+" kB/s", ok?"":"MISMATCH");
+});
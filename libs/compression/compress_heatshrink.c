@@ -8,7 +8,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  *
  * ----------------------------------------------------------------------------
- *  Wrapper for LZ4 encode/decode
+ *  Wrapper for heatshrink encode/decode
  * ----------------------------------------------------------------------------
  */
 
@@ -47,16 +47,35 @@ int heatshrink_var_input_cb(uint32_t *cbdata) {
   return d;
 }
 
-/** gets data from callback, writes to callback if nonzero. Returns total length. */
-uint32_t heatshrink_encode_cb(int (*in_callback)(uint32_t *cbdata), uint32_t *in_cbdata, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata) {
+/** gets data from callback, writes to callback if nonzero. Returns total length.
+ * windowBits/lookaheadBits can be 0 to use the default values. */
+uint32_t heatshrink_encode_cb(int (*in_callback)(uint32_t *cbdata), uint32_t *in_cbdata, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata, int windowBits, int lookaheadBits) {
   heatshrink_encoder hse;
   uint8_t inBuf[BUFFERSIZE];
   uint8_t outBuf[BUFFERSIZE];
-  heatshrink_encoder_reset(&hse);
+  if (!windowBits) windowBits = HEATSHRINK_DEFAULT_WINDOW_BITS;
+  if (!lookaheadBits) lookaheadBits = HEATSHRINK_DEFAULT_LOOKAHEAD_BITS;
+  struct hs_index *index = NULL;
+#if HEATSHRINK_USE_INDEX
+  // The index makes compression much faster, but uses 4 bytes per byte of window - so only use it if there's room
+  size_t indexSize = HEATSHRINK_ENCODER_INDEX_SIZE(windowBits);
+  if (windowBits<=HEATSHRINK_STATIC_WINDOW_BITS && indexSize+512 < jsuGetFreeStack())
+    index = (struct hs_index *)alloca(indexSize);
+#endif
+  if (!heatshrink_encoder_init(&hse, (uint8_t)windowBits, (uint8_t)lookaheadBits, index)) {
+    assert(0); // invalid window/lookahead sizes
+    return 0;
+  }
 
   size_t i;
   size_t count = 0;
   size_t polled = 0;
+  if (windowBits!=HEATSHRINK_DEFAULT_WINDOW_BITS || lookaheadBits!=HEATSHRINK_DEFAULT_LOOKAHEAD_BITS) {
+    // write a header byte so the decoder knows what sizes we used
+    if (out_callback)
+      out_callback((unsigned char)((windowBits<<3) | (lookaheadBits-3)), out_cbdata);
+    polled++;
+  }
   int lastByte = 0;
   size_t inBufCount = 0;
   size_t inBufOffset = 0;
@@ -101,14 +120,25 @@ uint32_t heatshrink_decode_cb(int (*in_callback)(uint32_t *cbdata), uint32_t *in
   heatshrink_decoder hsd;
   uint8_t inBuf[BUFFERSIZE];
   uint8_t outBuf[BUFFERSIZE];
-  heatshrink_decoder_reset(&hsd);
+  int windowBits = HEATSHRINK_DEFAULT_WINDOW_BITS;
+  int lookaheadBits = HEATSHRINK_DEFAULT_LOOKAHEAD_BITS;
+  size_t inBufCount = 0;
+  size_t inBufOffset = 0;
+  // Check for a header byte specifying non-default window/lookahead sizes
+  int lastByte = in_callback(in_cbdata);
+  if (HEATSHRINK_IS_HEADER(lastByte)) {
+    windowBits = lastByte>>3;
+    lookaheadBits = (lastByte&7)+3;
+  } else if (lastByte >= 0)
+    inBuf[inBufCount++] = (uint8_t)lastByte;
+  if (!heatshrink_decoder_init(&hsd, (uint8_t)windowBits, (uint8_t)lookaheadBits)) {
+    jsExceptionHere(JSET_ERROR, "Heatshrink window of %d bits not supported", windowBits);
+    return 0;
+  }
 
   size_t i;
   size_t count = 0;
   size_t polled = 0;
-  int lastByte = 0;
-  size_t inBufCount = 0;
-  size_t inBufOffset = 0;
   while (lastByte >= 0 || inBufCount>0) {
     // Read data from input
     if (inBufCount==0) {
@@ -147,12 +177,13 @@ uint32_t heatshrink_decode_cb(int (*in_callback)(uint32_t *cbdata), uint32_t *in
 
 
 
-/** gets data from array, writes to callback if nonzero. Returns total length. */
-uint32_t heatshrink_encode(unsigned char *in_data, size_t in_len, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata) {
+/** gets data from array, writes to callback if nonzero. Returns total length.
+ * windowBits/lookaheadBits can be 0 to use the default values. */
+uint32_t heatshrink_encode(unsigned char *in_data, size_t in_len, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata, int windowBits, int lookaheadBits) {
   HeatShrinkPtrInputCallbackInfo cbi;
   cbi.ptr = in_data;
   cbi.len = in_len;
-  return heatshrink_encode_cb(heatshrink_ptr_input_cb, (uint32_t*)&cbi, out_callback, out_cbdata);
+  return heatshrink_encode_cb(heatshrink_ptr_input_cb, (uint32_t*)&cbi, out_callback, out_cbdata, windowBits, lookaheadBits);
 }
 
 /** gets data from callback, writes it into array if nonzero. Returns total length */
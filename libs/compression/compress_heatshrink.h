@@ -14,6 +14,9 @@
 #ifndef COMPRESS_HEATSHRINK_H_
 #define COMPRESS_HEATSHRINK_H_
 
+#include "heatshrink_common.h"
+#include "heatshrink_config.h"
+
 typedef struct {
   unsigned char *ptr;
   size_t len;
@@ -24,14 +27,23 @@ int heatshrink_ptr_input_cb(uint32_t *cbdata); // takes *HeatShrinkPtrInputCallb
 void heatshrink_var_output_cb(unsigned char ch, uint32_t *cbdata); // takes *JsvStringIterator
 int heatshrink_var_input_cb(uint32_t *cbdata); // takes *JsvIterator
 
-/** gets data from callback, writes to callback if nonzero. Returns total length. */
-uint32_t heatshrink_encode_cb(int (*in_callback)(uint32_t *cbdata), uint32_t *in_cbdata, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata);
+/** If the window/lookahead sizes used for compression aren't the defaults (8 and 6
+ * bits), a one byte header of the form 0b0WWWWLLL (W=window bits, L=lookahead bits-3)
+ * is written. Data compressed with the default settings always starts with either 0
+ * (a backreference into the initially zeroed window) or a byte with the top bit set
+ * (a literal), so this is unambiguous and old compressed data still decompresses. */
+#define HEATSHRINK_IS_HEADER(ch) ((ch)>=0x20 && (ch)<0x80)
+
+/** gets data from callback, writes to callback if nonzero. Returns total length.
+ * windowBits/lookaheadBits can be 0 to use the default values. */
+uint32_t heatshrink_encode_cb(int (*in_callback)(uint32_t *cbdata), uint32_t *in_cbdata, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata, int windowBits, int lookaheadBits);
 
 /** gets data from callback, writes it into callback if nonzero. Returns total length */
 uint32_t heatshrink_decode_cb(int (*in_callback)(uint32_t *cbdata), uint32_t *in_cbdata, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata);
 
-/** gets data from array, writes to callback if nonzero. Returns total length. */
-uint32_t heatshrink_encode(unsigned char *in_data, size_t in_len, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata);
+/** gets data from array, writes to callback if nonzero. Returns total length.
+ * windowBits/lookaheadBits can be 0 to use the default values. */
+uint32_t heatshrink_encode(unsigned char *in_data, size_t in_len, void (*out_callback)(unsigned char ch, uint32_t *cbdata), uint32_t *out_cbdata, int windowBits, int lookaheadBits);
 
 /** gets data from callback, writes it into array if nonzero. Returns total length */
 uint32_t heatshrink_decode(int (*in_callback)(uint32_t *cbdata), uint32_t *in_cbdata, unsigned char *out_data);
@@ -6,13 +6,34 @@
 
 /* Required parameters for static configuration */
 #define HEATSHRINK_STATIC_INPUT_BUFFER_SIZE 32
+/* Espruino: with static configuration the window and lookahead sizes are
+ * set at runtime with heatshrink_encoder_init/heatshrink_decoder_init.
+ * HEATSHRINK_STATIC_WINDOW_BITS is the largest window that can be used
+ * (it sets the size of the buffers), and the DEFAULT sizes are what has
+ * always been used by Espruino (so are used when nothing else is specified) */
+#ifndef HEATSHRINK_STATIC_WINDOW_BITS
+#ifdef LINUX
+#define HEATSHRINK_STATIC_WINDOW_BITS 11
+#else
 #define HEATSHRINK_STATIC_WINDOW_BITS 8
-#define HEATSHRINK_STATIC_LOOKAHEAD_BITS 6
+#endif
+#endif
+#define HEATSHRINK_DEFAULT_WINDOW_BITS 8
+#define HEATSHRINK_DEFAULT_LOOKAHEAD_BITS 6
 
 /* Turn on logging for debugging. */
 #define HEATSHRINK_DEBUGGING_LOGS 0
 
-/* Use indexing for faster compression. (This requires additional space.) */
+/* Use indexing for faster compression. (This requires additional space.)
+ * Espruino: with static configuration the index is supplied to
+ * heatshrink_encoder_init and is optional, so this only adds code - which
+ * we don't want on boards that are short of flash */
+#ifndef HEATSHRINK_USE_INDEX
+#ifndef SAVE_ON_FLASH
+#define HEATSHRINK_USE_INDEX 1
+#else
 #define HEATSHRINK_USE_INDEX 0
+#endif
+#endif
 
 #endif
@@ -38,10 +38,10 @@ typedef enum {
 #else
 #define HEATSHRINK_DECODER_INPUT_BUFFER_SIZE(_) \
     HEATSHRINK_STATIC_INPUT_BUFFER_SIZE
-#define HEATSHRINK_DECODER_WINDOW_BITS(_) \
-    (HEATSHRINK_STATIC_WINDOW_BITS)
+#define HEATSHRINK_DECODER_WINDOW_BITS(BUF) \
+    ((BUF)->window_sz2)
 #define HEATSHRINK_DECODER_LOOKAHEAD_BITS(BUF) \
-    (HEATSHRINK_STATIC_LOOKAHEAD_BITS)
+    ((BUF)->lookahead_sz2)
 #endif
 
 typedef struct {
@@ -63,8 +63,10 @@ typedef struct {
     /* Input buffer, then expansion window buffer */
     uint8_t buffers[];
 #else
+    uint8_t window_sz2;         /* window buffer bits */
+    uint8_t lookahead_sz2;      /* lookahead bits */
     /* Input buffer, then expansion window buffer */
-    uint8_t buffers[(1 << HEATSHRINK_DECODER_WINDOW_BITS(_))
+    uint8_t buffers[(1 << HEATSHRINK_STATIC_WINDOW_BITS)
         + HEATSHRINK_DECODER_INPUT_BUFFER_SIZE(_)];
 #endif
 } heatshrink_decoder;
@@ -82,6 +84,15 @@ heatshrink_decoder *heatshrink_decoder_alloc(uint16_t input_buffer_size,
 void heatshrink_decoder_free(heatshrink_decoder *hsd);
 #endif
 
+#if !HEATSHRINK_DYNAMIC_ALLOC
+/* Set the window and lookahead sizes of a statically allocated decoder
+ * (window_sz2 can't be bigger than HEATSHRINK_STATIC_WINDOW_BITS) and reset it.
+ * These must match the settings used when the data was compressed.
+ * Returns 0 if the sizes are invalid. */
+int heatshrink_decoder_init(heatshrink_decoder *hsd, uint8_t window_sz2,
+    uint8_t lookahead_sz2);
+#endif
+
 /* Reset a decoder. */
 void heatshrink_decoder_reset(heatshrink_decoder *hsd);
 
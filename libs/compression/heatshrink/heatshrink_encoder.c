@@ -117,6 +117,29 @@ void heatshrink_encoder_free(heatshrink_encoder *hse) {
 }
 #endif
 
+#if !HEATSHRINK_DYNAMIC_ALLOC
+int heatshrink_encoder_init(heatshrink_encoder *hse, uint8_t window_sz2,
+        uint8_t lookahead_sz2, struct hs_index *search_index) {
+    if ((window_sz2 < HEATSHRINK_MIN_WINDOW_BITS) ||
+        (window_sz2 > HEATSHRINK_STATIC_WINDOW_BITS) ||
+        (lookahead_sz2 < HEATSHRINK_MIN_LOOKAHEAD_BITS) ||
+        (lookahead_sz2 >= window_sz2)) {
+        return 0;
+    }
+    hse->window_sz2 = window_sz2;
+    hse->lookahead_sz2 = lookahead_sz2;
+#if HEATSHRINK_USE_INDEX
+    hse->search_index = search_index;
+    if (search_index)
+        search_index->size = (uint16_t)((2 << window_sz2)*sizeof(int16_t));
+#else
+    (void)search_index;
+#endif
+    heatshrink_encoder_reset(hse);
+    return 1;
+}
+#endif
+
 void heatshrink_encoder_reset(heatshrink_encoder *hse) {
     size_t buf_sz = (2 << HEATSHRINK_ENCODER_WINDOW_BITS(hse));
     memset(hse->buffer, 0, buf_sz);
@@ -421,6 +444,7 @@ static void do_indexing(heatshrink_encoder *hse) {
      *    dynamically improve the index.
      * */
     struct hs_index *hsi = HEATSHRINK_ENCODER_INDEX(hse);
+    if (hsi == NULL) { return; } /* no index - brute force search instead */
     int16_t last[256];
     memset(last, 0xFF, sizeof(last));
 
@@ -435,7 +459,7 @@ static void do_indexing(heatshrink_encoder *hse) {
         uint8_t v = data[i];
         int16_t lv = last[v];
         index[i] = lv;
-        last[v] = i;
+        last[v] = (int16_t)i;
     }
 #else
     (void)hse;
@@ -463,36 +487,38 @@ static uint16_t find_longest_match(heatshrink_encoder *hse, uint16_t start,
 
     uint16_t len = 0;
     uint8_t * const needlepoint = &buf[end];
+    int16_t pos;
 #if HEATSHRINK_USE_INDEX
     struct hs_index *hsi = HEATSHRINK_ENCODER_INDEX(hse);
-    int16_t pos = hsi->index[end];
+    if (hsi) {
+        pos = hsi->index[end];
+
+        while (pos - (int16_t)start >= 0) {
+            uint8_t * const pospoint = &buf[pos];
+            len = 0;
+
+            /* Only check matches that will potentially beat the current maxlen.
+             * This is redundant with the index if match_maxlen is 0, but the
+             * added branch overhead to check if it == 0 seems to be worse. */
+            if (pospoint[match_maxlen] != needlepoint[match_maxlen]) {
+                pos = hsi->index[pos];
+                continue;
+            }
 
-    while (pos - (int16_t)start >= 0) {
-        uint8_t * const pospoint = &buf[pos];
-        len = 0;
+            for (len = 1; len < maxlen; len++) {
+                if (pospoint[len] != needlepoint[len]) break;
+            }
 
-        /* Only check matches that will potentially beat the current maxlen.
-         * This is redundant with the index if match_maxlen is 0, but the
-         * added branch overhead to check if it == 0 seems to be worse. */
-        if (pospoint[match_maxlen] != needlepoint[match_maxlen]) {
+            if (len > match_maxlen) {
+                match_maxlen = len;
+                match_index = (uint16_t)pos;
+                if (len == maxlen) { break; } /* won't find better */
+            }
             pos = hsi->index[pos];
-            continue;
-        }
-
-        for (len = 1; len < maxlen; len++) {
-            if (pospoint[len] != needlepoint[len]) break;
-        }
-
-        if (len > match_maxlen) {
-            match_maxlen = len;
-            match_index = pos;
-            if (len == maxlen) { break; } /* won't find better */
         }
-        pos = hsi->index[pos];
-    }
-#else    
-    int16_t pos;
-    for (pos=end - 1; pos - (int16_t)start >= 0; pos--) {
+    } else
+#endif
+    for (pos=(int16_t)(end - 1); pos - (int16_t)start >= 0; pos = (int16_t)(pos - 1)) {
         uint8_t * const pospoint = &buf[pos];
         if ((pospoint[match_maxlen] == needlepoint[match_maxlen])
             && (*pospoint == *needlepoint)) {
@@ -505,15 +531,14 @@ static uint16_t find_longest_match(heatshrink_encoder *hse, uint16_t start,
             }
             if (len > match_maxlen) {
                 match_maxlen = len;
-                match_index = pos;
+                match_index = (uint16_t)pos;
                 if (len == maxlen) { break; } /* don't keep searching */
             }
         }
     }
-#endif
     
     const size_t break_even_point =
-      (1 + HEATSHRINK_ENCODER_WINDOW_BITS(hse) +
+      (size_t)(1 + HEATSHRINK_ENCODER_WINDOW_BITS(hse) +
           HEATSHRINK_ENCODER_LOOKAHEAD_BITS(hse));
 
     /* Instead of comparing break_even_point against 8*match_maxlen,
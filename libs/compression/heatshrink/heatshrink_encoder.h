@@ -40,16 +40,19 @@ struct hs_index {
     int16_t index[];
 };
 #else
-#define HEATSHRINK_ENCODER_WINDOW_BITS(_) \
-    (HEATSHRINK_STATIC_WINDOW_BITS)
-#define HEATSHRINK_ENCODER_LOOKAHEAD_BITS(_) \
-    (HEATSHRINK_STATIC_LOOKAHEAD_BITS)
+#define HEATSHRINK_ENCODER_WINDOW_BITS(HSE) \
+    ((HSE)->window_sz2)
+#define HEATSHRINK_ENCODER_LOOKAHEAD_BITS(HSE) \
+    ((HSE)->lookahead_sz2)
 #define HEATSHRINK_ENCODER_INDEX(HSE) \
-    (&(HSE)->search_index)
+    ((HSE)->search_index)
 struct hs_index {
     uint16_t size;
-    int16_t index[2 << HEATSHRINK_STATIC_WINDOW_BITS];
+    int16_t index[];
 };
+/* Size in bytes of the (optional) search index for a given window size */
+#define HEATSHRINK_ENCODER_INDEX_SIZE(WINDOW_SZ2) \
+    (sizeof(struct hs_index) + (2 << (WINDOW_SZ2))*sizeof(int16_t))
 #endif
 
 typedef struct {
@@ -72,11 +75,13 @@ typedef struct {
     /* input buffer and / sliding window for expansion */
     uint8_t buffer[];
 #else
+    uint8_t window_sz2;         /* 2^n size of window */
+    uint8_t lookahead_sz2;      /* 2^n size of lookahead */
     #if HEATSHRINK_USE_INDEX
-        struct hs_index search_index;
+        struct hs_index *search_index; /* may be NULL, in which case we search without it */
     #endif
     /* input buffer and / sliding window for expansion */
-    uint8_t buffer[2 << HEATSHRINK_ENCODER_WINDOW_BITS(_)];
+    uint8_t buffer[2 << HEATSHRINK_STATIC_WINDOW_BITS];
 #endif
 } heatshrink_encoder;
 
@@ -90,6 +95,16 @@ heatshrink_encoder *heatshrink_encoder_alloc(uint8_t window_sz2,
 void heatshrink_encoder_free(heatshrink_encoder *hse);
 #endif
 
+#if !HEATSHRINK_DYNAMIC_ALLOC
+/* Set the window and lookahead sizes of a statically allocated encoder
+ * (window_sz2 can't be bigger than HEATSHRINK_STATIC_WINDOW_BITS) and reset it.
+ * SEARCH_INDEX is either NULL or points to HEATSHRINK_ENCODER_INDEX_SIZE(window_sz2)
+ * bytes of memory that is used to speed up compression.
+ * Returns 0 if the sizes are invalid. */
+int heatshrink_encoder_init(heatshrink_encoder *hse, uint8_t window_sz2,
+    uint8_t lookahead_sz2, struct hs_index *search_index);
+#endif
+
 /* Reset an encoder. */
 void heatshrink_encoder_reset(heatshrink_encoder *hse);
 
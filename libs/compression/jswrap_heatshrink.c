@@ -57,7 +57,8 @@ If you'd like a way to perform compression/decompression on desktop, check out h
   "name" : "compress",
   "generate" : "jswrap_heatshrink_compress",
   "params" : [
-    ["data","JsVar","The data to compress"]
+    ["data","JsVar","The data to compress"],
+    ["options","JsVar","[optional] An object `{ window : int=8, lookahead : int=6 }` - see below"]
   ],
   "return" : ["JsVar","Returns the result as an `ArrayBuffer`"],
   "return_object" : "ArrayBuffer",
@@ -69,18 +70,45 @@ No type information is stored, and the `data` argument is treated as an array of
 (whether it is a `String`/`Uint8Array` or even `Uint16Array`), so the result of
 decompressing any compressed data will always be an `ArrayBuffer`.
 
+`options.window` is the size of the window in bits (4..15, default 8) and
+`options.lookahead` the maximum length of a match in bits (3..10, default 6 -
+or `window-1` for windows smaller than 7 bits).
+Bigger windows compress better but need more RAM to compress and decompress
+(the largest window supported depends on the device - 8 bits on most devices).
+If non-default values are used, a one byte header is added to the compressed
+data so that `decompress` knows which values to use (and other heatshrink
+decoders won't be able to decompress it).
+
 If you'd like a way to perform compression/decompression on desktop, check out https://github.com/espruino/EspruinoWebTools#heatshrinkjs
 */
-JsVar *jswrap_heatshrink_compress(JsVar *data) {
+JsVar *jswrap_heatshrink_compress(JsVar *data, JsVar *options) {
   if (!jsvIsIterable(data)) {
     jsExceptionHere(JSET_TYPEERROR,"Expecting something iterable, got %t",data);
     return 0;
   }
+  JsVarInt windowBits = HEATSHRINK_DEFAULT_WINDOW_BITS;
+  JsVarInt lookaheadBits = 0; // 0 = not given, so choose one to suit the window
+  jsvConfigObject configs[] = {
+      {"window", JSV_INTEGER, &windowBits},
+      {"lookahead", JSV_INTEGER, &lookaheadBits}
+  };
+  if (!jsvReadConfigObject(options, configs, sizeof(configs) / sizeof(jsvConfigObject)))
+    return 0;
+  if (windowBits<HEATSHRINK_MIN_WINDOW_BITS || windowBits>HEATSHRINK_STATIC_WINDOW_BITS) {
+    jsExceptionHere(JSET_ERROR, "Window must be between %d and %d bits", HEATSHRINK_MIN_WINDOW_BITS, HEATSHRINK_STATIC_WINDOW_BITS);
+    return 0;
+  }
+  if (!lookaheadBits) // lookahead must be smaller than the window
+    lookaheadBits = (windowBits>HEATSHRINK_DEFAULT_LOOKAHEAD_BITS) ? HEATSHRINK_DEFAULT_LOOKAHEAD_BITS : windowBits-1;
+  if (lookaheadBits<HEATSHRINK_MIN_LOOKAHEAD_BITS || lookaheadBits>=windowBits || lookaheadBits>10) {
+    jsExceptionHere(JSET_ERROR, "Lookahead must be between %d and %d bits", HEATSHRINK_MIN_LOOKAHEAD_BITS, (windowBits>11)?10:(int)windowBits-1);
+    return 0;
+  }
   JsvIterator in_it;
   JsvStringIterator out_it;
 
   jsvIteratorNew(&in_it, data, JSIF_EVERY_ARRAY_ELEMENT);
-  uint32_t compressedSize = heatshrink_encode_cb(heatshrink_var_input_cb, (uint32_t*)&in_it, NULL, NULL);
+  uint32_t compressedSize = heatshrink_encode_cb(heatshrink_var_input_cb, (uint32_t*)&in_it, NULL, NULL, (int)windowBits, (int)lookaheadBits);
   jsvIteratorFree(&in_it);
 
   JsVar *outVar = jsvNewStringOfLength((unsigned int)compressedSize, NULL);
@@ -91,7 +119,7 @@ JsVar *jswrap_heatshrink_compress(JsVar *data) {
 
   jsvIteratorNew(&in_it, data, JSIF_EVERY_ARRAY_ELEMENT);
   jsvStringIteratorNew(&out_it,outVar,0);
-  heatshrink_encode_cb(heatshrink_var_input_cb, (uint32_t*)&in_it, heatshrink_var_output_cb, (uint32_t*)&out_it);
+  heatshrink_encode_cb(heatshrink_var_input_cb, (uint32_t*)&in_it, heatshrink_var_output_cb, (uint32_t*)&out_it, (int)windowBits, (int)lookaheadBits);
   jsvStringIteratorFree(&out_it);
   jsvIteratorFree(&in_it);
 
@@ -130,6 +158,7 @@ JsVar *jswrap_heatshrink_decompress(JsVar *data) {
   jsvIteratorNew(&in_it, data, JSIF_EVERY_ARRAY_ELEMENT);
   uint32_t decompressedSize = heatshrink_decode(heatshrink_var_input_cb, (uint32_t*)&in_it, NULL);
   jsvIteratorFree(&in_it);
+  if (jspHasError()) return 0; // unsupported window size
 
   JsVar *outVar = jsvNewStringOfLength((unsigned int)decompressedSize, NULL);
   if (!outVar) {
@@ -13,5 +13,5 @@
  */
 #include "jsvar.h"
 
-JsVar *jswrap_heatshrink_compress(JsVar *data);
+JsVar *jswrap_heatshrink_compress(JsVar *data, JsVar *options);
 JsVar *jswrap_heatshrink_decompress(JsVar *data);
@@ -151,12 +151,7 @@ void graphicsStructInit(JsGraphics *gfx, int width, int height, int bpp) {
   gfx->data.height = (unsigned short)height;
   gfx->data.bpp = (unsigned char)bpp;
   graphicsStructResetState(gfx);
-#ifndef NO_MODIFIED_AREA
-  gfx->data.modMaxX = -32768;
-  gfx->data.modMaxY = -32768;
-  gfx->data.modMinX = 32767;
-  gfx->data.modMinY = 32767;
-#endif
+  graphicsClearModified(gfx);
 }
 
 /// Set up the callbacks for this graphics instance (usually done by graphicsGetFromVar)
@@ -307,6 +302,73 @@ unsigned short graphicsGetHeight(const JsGraphics *gfx) {
 }
 
 // Set the area modified by a draw command and also clip to the screen/clipping bounds. Returns true if clipped. If coordsRotatedAlready we assume the coordinates have gone through deviceToGraphicsCoordinates already
+#ifdef GRAPHICS_MODIFIED_RECTS
+static bool graphicsModifiedRectsTouch(const JsGraphicsClipRect *a, const JsGraphicsClipRect *b) {
+  return a->x1 <= b->x2+1 && b->x1 <= a->x2+1 &&
+         a->y1 <= b->y2+1 && b->y1 <= a->y2+1;
+}
+
+static void graphicsModifiedRectsMerge(JsGraphicsClipRect *a, const JsGraphicsClipRect *b) {
+  if (b->x1 < a->x1) a->x1 = b->x1;
+  if (b->y1 < a->y1) a->y1 = b->y1;
+  if (b->x2 > a->x2) a->x2 = b->x2;
+  if (b->y2 > a->y2) a->y2 = b->y2;
+}
+
+static unsigned int graphicsModifiedRectsArea(const JsGraphicsClipRect *a) {
+  return (unsigned int)(1+a->x2-a->x1) * (unsigned int)(1+a->y2-a->y1);
+}
+
+/* Add an area to the list of modified rectangles. Anything touching an
+existing rectangle is merged into it, and if we run out of rectangles we merge
+with whichever one grows the least. */
+static void graphicsAddModifiedRect(JsGraphics *gfx, int x1, int y1, int x2, int y2) {
+  if (x2<x1 || y2<y1) return; // nothing modified
+  JsGraphicsClipRect *rects = gfx->data.modRects;
+  int n = gfx->data.modRectCount;
+  JsGraphicsClipRect r;
+  r.x1 = (unsigned short)x1;
+  r.y1 = (unsigned short)y1;
+  r.x2 = (unsigned short)x2;
+  r.y2 = (unsigned short)y2;
+  int i;
+  for (i=0;i<n;i++) {
+    if (r.x1>=rects[i].x1 && r.y1>=rects[i].y1 && r.x2<=rects[i].x2 && r.y2<=rects[i].y2)
+      return; // already covered - the common case when drawing pixel by pixel
+  }
+  for (i=0;i<n;i++)
+    if (graphicsModifiedRectsTouch(&rects[i], &r)) break;
+  if (i<n) { // grow an existing rect
+    graphicsModifiedRectsMerge(&rects[i], &r);
+  } else if (n<GRAPHICS_MODIFIED_RECTS) { // add a new one
+    rects[n] = r;
+    i = n++;
+  } else { // merge with whatever adds the least area
+    unsigned int best = 0xFFFFFFFF;
+    for (int j=0;j<n;j++) {
+      JsGraphicsClipRect m = rects[j];
+      graphicsModifiedRectsMerge(&m, &r);
+      unsigned int growth = graphicsModifiedRectsArea(&m) - graphicsModifiedRectsArea(&rects[j]);
+      if (growth < best) {
+        best = growth;
+        i = j;
+      }
+    }
+    graphicsModifiedRectsMerge(&rects[i], &r);
+  }
+  // rects[i] grew, so it may now touch others - merge those in
+  for (int j=0;j<n;j++) {
+    if (j!=i && graphicsModifiedRectsTouch(&rects[i], &rects[j])) {
+      graphicsModifiedRectsMerge(&rects[i], &rects[j]);
+      rects[j] = rects[--n];
+      if (i==n) i=j;
+      j = -1; // start again
+    }
+  }
+  gfx->data.modRectCount = (unsigned char)n;
+}
+#endif
+
 bool graphicsSetModifiedAndClip(JsGraphics *gfx, int *x1, int *y1, int *x2, int *y2, bool coordsRotatedAlready) {
   bool modified = false;
 #ifndef NO_MODIFIED_AREA
@@ -335,6 +397,9 @@ bool graphicsSetModifiedAndClip(JsGraphics *gfx, int *x1, int *y1, int *x2, int
   if (*x2 > gfx->data.modMaxX) { gfx->data.modMaxX=(short)*x2; modified = true; }
   if (*y1 < gfx->data.modMinY) { gfx->data.modMinY=(short)*y1; modified = true; }
   if (*y2 > gfx->data.modMaxY) { gfx->data.modMaxY=(short)*y2; modified = true; }
+#endif
+#ifdef GRAPHICS_MODIFIED_RECTS
+  graphicsAddModifiedRect(gfx, *x1, *y1, *x2, *y2);
 #endif
   return modified;
 }
@@ -347,6 +412,80 @@ void graphicsSetModified(JsGraphics *gfx, int x1, int y1, int x2, int y2) {
   if (y1 < gfx->data.modMinY) { gfx->data.modMinY=(short)y1; }
   if (y2 > gfx->data.modMaxY) { gfx->data.modMaxY=(short)y2; }
 #endif
+#ifdef GRAPHICS_MODIFIED_RECTS
+  graphicsAddModifiedRect(gfx, x1, y1, x2, y2);
+#endif
+}
+
+/// Mark the whole Graphics as unmodified
+void graphicsClearModified(JsGraphics *gfx) {
+#ifndef NO_MODIFIED_AREA
+  gfx->data.modMaxX = -32768;
+  gfx->data.modMaxY = -32768;
+  gfx->data.modMinX = 32767;
+  gfx->data.modMinY = 32767;
+#endif
+#ifdef GRAPHICS_MODIFIED_RECTS
+  gfx->data.modRectCount = 0;
+#endif
+}
+
+/** Get the modified area as a list of up to GRAPHICS_MODIFIED_RECTS_MAX non-overlapping rectangles, in device coordinates.
+If fullRows, each covers the full width and they are sorted top to bottom. Returns how many were written to 'areas' */
+int graphicsGetModifiedAreas(JsGraphics *gfx, JsGraphicsClipRect *areas, bool fullRows) {
+#ifndef NO_MODIFIED_AREA
+  if (gfx->data.modMinX > gfx->data.modMaxX || gfx->data.modMinY > gfx->data.modMaxY)
+    return 0;
+#ifdef GRAPHICS_MODIFIED_RECTS
+  int n = gfx->data.modRectCount;
+  /* If something modified the bounding box directly (eg. to force
+  a full flip) the rects won't cover it, so just use that */
+  bool valid = n>0;
+  if (valid) {
+    JsGraphicsClipRect bounds = gfx->data.modRects[0];
+    for (int i=1;i<n;i++)
+      graphicsModifiedRectsMerge(&bounds, &gfx->data.modRects[i]);
+    valid = bounds.x1==gfx->data.modMinX && bounds.y1==gfx->data.modMinY &&
+            bounds.x2==gfx->data.modMaxX && bounds.y2==gfx->data.modMaxY;
+  }
+  if (valid) {
+    memcpy(areas, gfx->data.modRects, sizeof(JsGraphicsClipRect)*(size_t)n);
+    if (fullRows) {
+      // sort by y (insertion sort - there are very few)
+      for (int i=1;i<n;i++) {
+        JsGraphicsClipRect t = areas[i];
+        int j = i;
+        while (j>0 && areas[j-1].y1 > t.y1) {
+          areas[j] = areas[j-1];
+          j--;
+        }
+        areas[j] = t;
+      }
+      // merge overlapping/adjacent row ranges
+      int m = 0;
+      for (int i=0;i<n;i++) {
+        if (m && areas[i].y1 <= areas[m-1].y2+1) {
+          if (areas[i].y2 > areas[m-1].y2) areas[m-1].y2 = areas[i].y2;
+        } else
+          areas[m++] = areas[i];
+      }
+      n = m;
+      for (int i=0;i<n;i++) {
+        areas[i].x1 = 0;
+        areas[i].x2 = (unsigned short)(gfx->data.width-1);
+      }
+    }
+    return n;
+  }
+#endif
+  areas[0].x1 = (unsigned short)(fullRows ? 0 : gfx->data.modMinX);
+  areas[0].y1 = (unsigned short)gfx->data.modMinY;
+  areas[0].x2 = (unsigned short)(fullRows ? gfx->data.width-1 : gfx->data.modMaxX);
+  areas[0].y2 = (unsigned short)gfx->data.modMaxY;
+  return 1;
+#else
+  return 0;
+#endif
 }
 
 /// Get a setPixel function (assuming coordinates already clipped with graphicsSetModifiedAndClip) - if all is ok it can choose a faster draw function
@@ -366,6 +505,18 @@ JsGraphicsSetPixelFn graphicsGetSetPixelUnclippedFn(JsGraphics *gfx, int x1, int
     return gfx->setPixel; // fast
 }
 
+/// If the device's pixels are in memory as a packed MSB-first bitstream (like Images) return a pointer to them and set rowBits
+unsigned char *graphicsGetPixelData(JsGraphics *gfx, size_t *rowBits) {
+  if (gfx->data.flags & JSGRAPHICSFLAGS_MAPPEDXY) return 0;
+  if (gfx->data.type == JSGRAPHICSTYPE_ARRAYBUFFER)
+    return lcdGetPixelData_ArrayBuffer(gfx, rowBits);
+#ifdef USE_LCD_SPI
+  if (gfx->data.type == JSGRAPHICSTYPE_SPILCD)
+    return lcdGetPixelData_SPILCD(gfx, rowBits);
+#endif
+  return 0;
+}
+
 /// Merge one color into another based RGB565(amt is 0..256)
 uint16_t graphicsBlendColorRGB565(uint16_t f, uint16_t b, int amt) {
   unsigned int br = (b>>11)&0x1F;
@@ -435,10 +586,7 @@ static void graphicsSetPixelDevice(JsGraphics *gfx, int x, int y, unsigned int c
       y<gfx->data.clipRect.y1 ||
       x>gfx->data.clipRect.x2 ||
       y>gfx->data.clipRect.y2) return;
-  if (x < gfx->data.modMinX) gfx->data.modMinX=(short)x;
-  if (x > gfx->data.modMaxX) gfx->data.modMaxX=(short)x;
-  if (y < gfx->data.modMinY) gfx->data.modMinY=(short)y;
-  if (y > gfx->data.modMaxY) gfx->data.modMaxY=(short)y;
+  graphicsSetModified(gfx, x, y, x, y);
 #else
   if (x<0 || y<0 || x>=gfx->data.width || y>=gfx->data.height) return;
 #endif
@@ -480,12 +628,7 @@ void graphicsFillRectDevice(JsGraphics *gfx, int x1, int y1, int x2, int y2, uns
   if (y2>gfx->data.clipRect.y2) y2 = gfx->data.clipRect.y2;
 #endif
   if (x2<x1 || y2<y1) return; // nope
-#ifndef NO_MODIFIED_AREA
-  if (x1 < gfx->data.modMinX) gfx->data.modMinX=(short)x1;
-  if (x2 > gfx->data.modMaxX) gfx->data.modMaxX=(short)x2;
-  if (y1 < gfx->data.modMinY) gfx->data.modMinY=(short)y1;
-  if (y2 > gfx->data.modMaxY) gfx->data.modMaxY=(short)y2;
-#endif
+  graphicsSetModified(gfx, x1, y1, x2, y2);
   if (x1==x2 && y1==y2) {
     gfx->setPixel(gfx,(int)x1,(int)y1,col);
     return;
@@ -791,87 +934,249 @@ void graphicsDrawCircleAA(JsGraphics *gfx, int x0, int y0, int r){
 #endif
 
 // Fill poly - each member of vertices is 1/16th pixel
-void graphicsFillPoly(JsGraphics *gfx, int points, short *vertices) {
-  typedef struct {
-    short x,y;
-  } VertXY;
-  VertXY *v = (VertXY*)vertices;
-
-  int i,j,y;
-  int miny = (int)(gfx->data.height-1);
-  int maxy = 0;
-  for (i=0;i<points;i++) {
+/// One edge of a polygon in graphicsPolyScan's edge table
+typedef struct {
+  short yTop, yBottom; ///< edge crosses scanlines where yTop <= y < yBottom (1/16th px)
+  short xi, yi; ///< the vertex x is measured from
+  short x; ///< x at the current scanline (1/16th px)
+  short idx; ///< index in the polygon, used to keep sorting stable
+  bool slope; ///< winding direction
+  bool yiIsTop; ///< is (xi,yi) the top of the edge?
+  bool neg; ///< does x decrease as we go further from yi?
+  unsigned int d, dx; ///< abs(y delta), abs(x delta)
+  unsigned int q, r; ///< abs(x-xi) is q + r/d
+  unsigned int stepQ, stepR; ///< how much q,r change for each scanline
+} GfxPolyEdge;
+
+typedef void (*GfxPolySpanFn)(JsGraphics *gfx, int y, int x1, int x2, void *data);
+
+/* Scan-convert a polygon (device coordinates, 1/16th px) using an active edge
+table. Scanlines are sampled from y1 to y2 (1/16th px) every 'step', and
+spanFn is called for each filled span (x1..x2 in 1/16th px). x for each edge
+is stepped incrementally, but rounds exactly as
+xi + ((y-yi)*(xj-xi))/(yj-yi) would. Returns false if there wasn't enough
+stack for the edge table. */
+static bool graphicsPolyScan(JsGraphics *gfx, int points, short *vertices, int y1, int y2, int step, GfxPolySpanFn spanFn, void *data) {
+  if (points<2) return true;
+  size_t tableSize = (size_t)points*(sizeof(GfxPolyEdge)+sizeof(GfxPolyEdge*));
+  if (tableSize+256 > jsuGetFreeStack()) return false;
+  GfxPolyEdge *edges = (GfxPolyEdge*)alloca(tableSize);
+  GfxPolyEdge **active = (GfxPolyEdge**)&edges[points];
+  int edgeCount = 0, activeCount = 0;
+  // Build the edge table
+  int j = points-1;
+  for (int i=0;i<points;i++) {
+    int xi = vertices[i*2], yi = vertices[i*2+1];
+    int xj = vertices[j*2], yj = vertices[j*2+1];
+    int l = yj - yi;
+    if (l) { // don't do horiz lines - rely on the ends of the lines that join onto them
+      GfxPolyEdge *e = &edges[edgeCount++];
+      e->yiIsTop = l>0;
+      e->yTop = (short)(e->yiIsTop ? yi : yj);
+      e->yBottom = (short)(e->yiIsTop ? yj : yi);
+      e->xi = (short)xi;
+      e->yi = (short)yi;
+      e->idx = (short)i;
+      e->slope = l>1;
+      e->neg = xj<xi;
+      e->d = (unsigned int)(e->yiIsTop ? l : -l);
+      e->dx = (unsigned int)(e->neg ? xi-xj : xj-xi);
+      e->stepQ = ((unsigned int)step*e->dx) / e->d;
+      e->stepR = ((unsigned int)step*e->dx) % e->d;
+      // insertion sort by yTop
+      int k = edgeCount-1;
+      short yTop = e->yTop;
+      while (k>0 && edges[k-1].yTop > yTop) {
+        GfxPolyEdge t = edges[k];
+        edges[k] = edges[k-1];
+        edges[k-1] = t;
+        k--;
+      }
+    }
+    j = i;
+  }
+  int nextEdge = 0;
+  for (int y=y1;y<=y2;y+=step) {
+    // remove edges we've gone past
+    int n = 0;
+    for (int i=0;i<activeCount;i++)
+      if (active[i]->yBottom > y) active[n++] = active[i];
+    activeCount = n;
+    // add edges we've reached
+    while (nextEdge<edgeCount && edges[nextEdge].yTop <= y) {
+      GfxPolyEdge *e = &edges[nextEdge++];
+      if (e->yBottom <= y) continue; // entirely above us
+      unsigned int m = (unsigned int)(e->yiIsTop ? y-e->yi : e->yi-y) * e->dx;
+      e->q = m / e->d;
+      e->r = m % e->d;
+      active[activeCount++] = e;
+    }
+    if (!activeCount) {
+      if (nextEdge>=edgeCount) break;
+      continue;
+    }
+    // work out x, and sort by it (stable, so ties stay in polygon order)
+    for (int i=0;i<activeCount;i++) {
+      GfxPolyEdge *e = active[i];
+      e->x = (short)(e->neg ? e->xi - (int)e->q : e->xi + (int)e->q);
+      int k = i;
+      while (k>0 && (active[k-1]->x > e->x || (active[k-1]->x == e->x && active[k-1]->idx > e->idx))) {
+        active[k] = active[k-1];
+        k--;
+      }
+      active[k] = e;
+    }
+    // Fill the pixels between node pairs.
+    int x = 0, s = 0;
+    for (int i=0;i<activeCount;i++) {
+      if (s==0) x = active[i]->x;
+      if (active[i]->slope) s++; else s--;
+      if (!s || i==activeCount-1)
+        spanFn(gfx, y, x, active[i]->x, data);
+    }
+    // step x along for the next scanline
+    for (int i=0;i<activeCount;i++) {
+      GfxPolyEdge *e = active[i];
+      if (e->yiIsTop) { // getting further from yi
+        e->q += e->stepQ;
+        e->r += e->stepR;
+        if (e->r >= e->d) { e->r -= e->d; e->q++; }
+      } else { // getting closer to yi
+        e->q -= e->stepQ;
+        if (e->r < e->stepR) { e->r += e->d; e->q--; }
+        e->r -= e->stepR;
+      }
+    }
+    if (jspIsInterrupted()) break;
+  }
+  return true;
+}
+
+static void graphicsFillPolySpan(JsGraphics *gfx, int y, int x1, int x2, void *data) {
+  NOT_USED(data);
+  x1 = (x1+15)>>4;
+  x2 = (x2+15)>>4;
+  if (x2>x1) graphicsFillRectDevice(gfx,x1,y>>4,x2-1,y>>4,gfx->data.fgColor);
+}
+
+/// Convert polygon vertices to device coordinates and work out which rows it covers
+static void graphicsFillPolyPrepare(JsGraphics *gfx, int points, short *vertices, int *miny, int *maxy) {
+  *miny = (int)(gfx->data.height-1);
+  *maxy = 0;
+  for (int i=0;i<points;i++) {
     // convert into device coordinates...
-    int vx = v[i].x;
-    int vy = v[i].y;
+    int vx = vertices[i*2];
+    int vy = vertices[i*2+1];
     graphicsToDeviceCoordinates16x(gfx, &vx, &vy);
-    v[i].x = (short)vx;
-    v[i].y = (short)vy;
+    vertices[i*2] = (short)vx;
+    vertices[i*2+1] = (short)vy;
     // work out min and max
-    short y = v[i].y>>4;
-    if (y<miny) miny=y;
-    if (y>maxy) maxy=y;
+    short y = (short)(vy>>4);
+    if (y<*miny) *miny=y;
+    if (y>*maxy) *maxy=y;
   }
 #ifndef SAVE_ON_FLASH
-  if (miny < gfx->data.clipRect.y1) miny=gfx->data.clipRect.y1;
-  if (maxy > gfx->data.clipRect.y2) maxy=gfx->data.clipRect.y2;
+  if (*miny < gfx->data.clipRect.y1) *miny=gfx->data.clipRect.y1;
+  if (*maxy > gfx->data.clipRect.y2) *maxy=gfx->data.clipRect.y2;
 #else
-  if (miny<0) miny=0;
-  if (maxy>=gfx->data.height) maxy=(int)(gfx->data.height-1);
-#endif
-
-  const int MAX_CROSSES = 64;
-
-  // for each scanline
-  for (y=miny<<4;y<=maxy<<4;y+=16) {
-    int yl = y>>4;
-    short cross[MAX_CROSSES];
-    bool slopes[MAX_CROSSES];
-    int crosscnt = 0;
-    // work out all the times lines cross the scanline
-    j = points-1;
-    for (i=0;i<points;i++) {
-      if ((v[i].y<=y && v[j].y>y) || (v[j].y<=y && v[i].y>y)) {
-        if (crosscnt < MAX_CROSSES) {
-          int l = v[j].y - v[i].y;
-          if (l) { // don't do horiz lines - rely on the ends of the lines that join onto them
-            cross[crosscnt] = (short)(v[i].x + ((y - v[i].y) * (v[j].x-v[i].x)) / l);
-            slopes[crosscnt] = (l>1)?1:0;
-            crosscnt++;
-          }
-        }
-      }
-      j = i;
-    }
+  if (*miny<0) *miny=0;
+  if (*maxy>=gfx->data.height) *maxy=(int)(gfx->data.height-1);
+#endif
+}
 
-    // bubble sort
-    for (i=0;i<crosscnt-1;) {
-      if (cross[i]>cross[i+1]) {
-        short t=cross[i];
-        cross[i]=cross[i+1];
-        cross[i+1]=t;
-        bool ts=slopes[i];
-        slopes[i]=slopes[i+1];
-        slopes[i+1]=ts;
-        if (i) i--;
-      } else i++;
-    }
+void graphicsFillPoly(JsGraphics *gfx, int points, short *vertices) {
+  int miny, maxy;
+  graphicsFillPolyPrepare(gfx, points, vertices, &miny, &maxy);
+  if (!graphicsPolyScan(gfx, points, vertices, miny<<4, maxy<<4, 16, graphicsFillPolySpan, 0))
+    jsExceptionHere(JSET_ERROR, "Not enough free stack to fill polygon");
+}
 
-    //  Fill the pixels between node pairs.
-    int x = 0,s = 0;
-    for (i=0;i<crosscnt;i++) {
-      if (s==0) x=cross[i];
-      if (slopes[i]) s++; else s--;
-      if (!s || i==crosscnt-1) {
-        int x1 = (x+15)>>4;
-        int x2 = (cross[i]+15)>>4;
-        if (x2>x1) graphicsFillRectDevice(gfx,x1,yl,x2-1,yl,gfx->data.fgColor);
-      }
-      if (jspIsInterrupted()) break;
+#ifdef GRAPHICS_ANTIALIAS
+#define GRAPHICS_FILLPOLYAA_SUBSAMPLES 4 ///< vertical samples per pixel for antialiased polygons
+#define GRAPHICS_FILLPOLYAA_FULL (GRAPHICS_FILLPOLYAA_SUBSAMPLES*16) ///< coverage value for a fully covered pixel
+
+typedef struct {
+  unsigned char *coverage; ///< coverage for each pixel in the row (0..GRAPHICS_FILLPOLYAA_FULL)
+  int x1, x2; ///< range of pixels in 'coverage'
+  int row; ///< the row we're currently accumulating
+} GfxFillPolyAAState;
+
+/// Draw the row of coverage we have accumulated, and clear it
+static void graphicsFillPolyAAFlushRow(JsGraphics *gfx, GfxFillPolyAAState *st) {
+  int x = st->x1;
+  while (x<=st->x2) {
+    int c = st->coverage[x-st->x1];
+    if (c==GRAPHICS_FILLPOLYAA_FULL) { // fully covered - fill solid
+      int xs = x;
+      while (x<st->x2 && st->coverage[x+1-st->x1]==GRAPHICS_FILLPOLYAA_FULL) x++;
+      graphicsFillRectDevice(gfx, xs, st->row, x, st->row, gfx->data.fgColor);
+    } else if (c) { // partially covered - blend
+      graphicsSetPixelDeviceBlended(gfx, x, st->row, (c*256)/GRAPHICS_FILLPOLYAA_FULL);
     }
+    x++;
   }
+  memset(st->coverage, 0, (size_t)(1+st->x2-st->x1));
 }
 
+static void graphicsFillPolyAASpan(JsGraphics *gfx, int y, int x1, int x2, void *data) {
+  GfxFillPolyAAState *st = (GfxFillPolyAAState*)data;
+  if ((y>>4) != st->row) {
+    graphicsFillPolyAAFlushRow(gfx, st);
+    st->row = y>>4;
+  }
+  // clip to the pixels we have
+  if (x1 < st->x1*16) x1 = st->x1*16;
+  if (x2 > (st->x2+1)*16) x2 = (st->x2+1)*16;
+  if (x2<=x1) return;
+  int px1 = x1>>4, px2 = (x2-1)>>4;
+  unsigned char *c = &st->coverage[px1-st->x1];
+  if (px1==px2) {
+    *c = (unsigned char)(*c + x2-x1);
+  } else {
+    *c = (unsigned char)(*c + 16-(x1&15));
+    for (int px=px1+1;px<px2;px++)
+      *(++c) += 16;
+    c++;
+    *c = (unsigned char)(*c + x2-(px2<<4));
+  }
+}
+
+/// Fill a polygon, with edges antialiased based on how much of each pixel is covered
+void graphicsFillPolyAA(JsGraphics *gfx, int points, short *vertices) {
+  int miny, maxy;
+  graphicsFillPolyPrepare(gfx, points, vertices, &miny, &maxy);
+  GfxFillPolyAAState st;
+  st.x1 = gfx->data.width-1;
+  st.x2 = 0;
+  for (int i=0;i<points;i++) {
+    int x = vertices[i*2]>>4;
+    if (x<st.x1) st.x1=x;
+    if (x>st.x2) st.x2=x;
+  }
+#ifndef SAVE_ON_FLASH
+  if (st.x1 < gfx->data.clipRect.x1) st.x1=gfx->data.clipRect.x1;
+  if (st.x2 > gfx->data.clipRect.x2) st.x2=gfx->data.clipRect.x2;
+#else
+  if (st.x1<0) st.x1=0;
+  if (st.x2>=gfx->data.width) st.x2=(int)(gfx->data.width-1);
+#endif
+  if (st.x2<st.x1 || maxy<miny) return; // offscreen
+  size_t rowSize = (size_t)(1+st.x2-st.x1);
+  if (rowSize+256 > jsuGetFreeStack()) {
+    jsExceptionHere(JSET_ERROR, "Not enough free stack to fill polygon");
+    return;
+  }
+  st.coverage = (unsigned char*)alloca(rowSize);
+  memset(st.coverage, 0, rowSize);
+  st.row = miny;
+  // sample in the middle of each subsample
+  const int step = 16/GRAPHICS_FILLPOLYAA_SUBSAMPLES;
+  if (!graphicsPolyScan(gfx, points, vertices, (miny<<4)+step/2, (maxy<<4)+15, step, graphicsFillPolyAASpan, &st))
+    jsExceptionHere(JSET_ERROR, "Not enough free stack to fill polygon");
+  graphicsFillPolyAAFlushRow(gfx, &st);
+}
+#endif
+
 /// Scroll the graphics device (in user coords). X>0 = to right, Y >0 = down
 void graphicsScroll(JsGraphics *gfx, int xdir, int ydir) {
   // Ensure we flip coordinate system if needed
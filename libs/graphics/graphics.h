@@ -34,6 +34,15 @@
 #define GRAPHICS_FAST_PATHS // execute more optimised code when no rotation/etc
 #endif
 
+#if !defined(NO_MODIFIED_AREA) && !defined(SAVE_ON_FLASH)
+#define GRAPHICS_MODIFIED_RECTS 4 // As well as a bounding box, keep track of up to this many separate modified areas
+#endif
+#ifdef GRAPHICS_MODIFIED_RECTS
+#define GRAPHICS_MODIFIED_RECTS_MAX GRAPHICS_MODIFIED_RECTS
+#else
+#define GRAPHICS_MODIFIED_RECTS_MAX 1
+#endif
+
 typedef enum {
   JSGRAPHICSTYPE_ARRAYBUFFER, ///< Write everything into an ArrayBuffer
   JSGRAPHICSTYPE_JS,          ///< Call JavaScript when we want to write something
@@ -123,6 +132,10 @@ typedef struct {
   JsGraphicsClipRect clipRect;
   short modMinX, modMinY, modMaxX, modMaxY; ///< area that has been modified
 #endif
+#ifdef GRAPHICS_MODIFIED_RECTS
+  unsigned char modRectCount; ///< how many of modRects are used
+  JsGraphicsClipRect modRects[GRAPHICS_MODIFIED_RECTS]; ///< separate modified areas (non-touching, all inside modMin/Max)
+#endif
 } PACKED_FLAGS JsGraphicsData;
 
 typedef struct JsGraphics {
@@ -197,10 +210,17 @@ unsigned short graphicsGetHeight(const JsGraphics *gfx);
 bool graphicsSetModifiedAndClip(JsGraphics *gfx, int *x1, int *y1, int *x2, int *y2, bool coordsRotatedAlready);
 // Set the area modified by a draw command
 void graphicsSetModified(JsGraphics *gfx, int x1, int y1, int x2, int y2);
+/// Mark the whole Graphics as unmodified
+void graphicsClearModified(JsGraphics *gfx);
+/** Get the modified area as a list of up to GRAPHICS_MODIFIED_RECTS_MAX non-overlapping rectangles, in device coordinates.
+If fullRows, each covers the full width and they are sorted top to bottom. Returns how many were written to 'areas' */
+int graphicsGetModifiedAreas(JsGraphics *gfx, JsGraphicsClipRect *areas, bool fullRows);
 /// Get a setPixel function (assuming coordinates already clipped with graphicsSetModifiedAndClip) - if all is ok it can choose a faster draw function
 JsGraphicsSetPixelFn graphicsGetSetPixelFn(JsGraphics *gfx);
 /// Get a setPixel function and set modified area (assuming no clipping) (inclusive of x2,y2) - if all is ok it can choose a faster draw function
 JsGraphicsSetPixelFn graphicsGetSetPixelUnclippedFn(JsGraphics *gfx, int x1, int y1, int x2, int y2, bool coordsRotatedAlready);
+/// If the device's pixels are in memory as a packed MSB-first bitstream (like Images) return a pointer to them and set rowBits (distance between rows in bits), or 0
+unsigned char *graphicsGetPixelData(JsGraphics *gfx, size_t *rowBits);
 /// Merge one color into another based RGB565(amt is 0..256)
 uint16_t graphicsBlendColorRGB565(uint16_t fg, uint16_t bg, int iamt);
 /// Merge one color into another based on current bit depth (amt is 0..256)
@@ -224,6 +244,9 @@ void graphicsDrawLine(JsGraphics *gfx, int x1, int y1, int x2, int y2);
 void graphicsDrawLineAA(JsGraphics *gfx, int ix1, int iy1, int ix2, int iy2); ///< antialiased drawline. each pixel is 1/16th
 void graphicsDrawCircleAA(JsGraphics *gfx, int x, int y, int r);
 void graphicsFillPoly(JsGraphics *gfx, int points, short *vertices); ///< each pixel is 1/16th a pixel may overwrite vertices...
+#ifdef GRAPHICS_ANTIALIAS
+void graphicsFillPolyAA(JsGraphics *gfx, int points, short *vertices); ///< antialiased fillPoly. each pixel is 1/16th a pixel may overwrite vertices...
+#endif
 /// Scroll the graphics device (in user coords). X>0 = to right, Y >0 = down
 void graphicsScroll(JsGraphics *gfx, int xdir, int ydir);
 
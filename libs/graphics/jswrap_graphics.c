@@ -405,6 +405,117 @@ NO_INLINE void _jswrap_drawImageLayerNextY(GfxDrawImageLayer *l) {
   }
 }
 
+#ifdef GRAPHICS_FAST_PATHS
+/// Copy 'bits' bits of MSB-first bitstream from src (starting at bit srcBit) to dst (starting at bit dstBit)
+static void _jswrap_drawImageCopyBits(unsigned char *dst, size_t dstBit, const unsigned char *src, size_t srcBit, size_t bits) {
+  dst += dstBit>>3; dstBit &= 7;
+  src += srcBit>>3; srcBit &= 7;
+  if (!dstBit && !srcBit) { // both byte aligned - just copy
+    memcpy(dst, src, bits>>3);
+    dst += bits>>3;
+    src += bits>>3;
+    bits &= 7;
+  }
+  while (bits) {
+    if (!dstBit && bits>=8) { // whole bytes, shifted
+      *(dst++) = (unsigned char)((src[0]<<srcBit) | (srcBit ? (src[1]>>(8-srcBit)) : 0));
+      src++;
+      bits -= 8;
+      continue;
+    }
+    // part of a byte at the start or end
+    unsigned int n = 8-(unsigned int)dstBit;
+    if (n>bits) n=(unsigned int)bits;
+    unsigned int v = (unsigned int)src[0]<<8;
+    if (srcBit+n>8) v |= src[1];
+    v = (v >> (16-srcBit-n)) & ((1U<<n)-1);
+    unsigned int shift = 8-(unsigned int)dstBit-n;
+    *dst = (unsigned char)((*dst & ~(((1U<<n)-1)<<shift)) | (v<<shift));
+    dstBit += n;
+    if (dstBit==8) { dst++; dstBit=0; }
+    srcBit += n;
+    if (srcBit>=8) { src++; srcBit-=8; }
+    bits -= n;
+  }
+}
+
+/// Write a 'bpp' bit pixel into an MSB-first bitstream at bit offset 'bit'
+static ALWAYS_INLINE void _jswrap_drawImageSetBits(unsigned char *dst, size_t bit, unsigned int bpp, unsigned int col) {
+  dst += bit>>3;
+  unsigned int b = (unsigned int)bit&7;
+  if (bpp==8 && !b) {
+    *dst = (unsigned char)col;
+  } else if (bpp==16 && !b) {
+    dst[0] = (unsigned char)(col>>8);
+    dst[1] = (unsigned char)col;
+  } else {
+    while (bpp) {
+      unsigned int n = 8-b;
+      if (n>bpp) n=bpp;
+      unsigned int shift = 8-b-n;
+      unsigned int mask = ((1U<<n)-1);
+      *dst = (unsigned char)((*dst & ~(mask<<shift)) | (((col>>(bpp-n))&mask)<<shift));
+      bpp -= n;
+      b = 0;
+      dst++;
+    }
+  }
+}
+
+/* Fast path for _jswrap_drawImageSimple when the image data is in memory. If
+the display's pixels are in memory in the same layout as Images and no palette
+mapping is needed we copy whole rows. Otherwise rows are read directly and go
+through the palette as a lookup table, either straight into the display's
+memory or via setPixel. x1..y2 are the already-clipped area. Returns false if
+the image can't be drawn this way. */
+static bool _jswrap_drawImageSimpleFast(JsGraphics *gfx, int xPos, int yPos, GfxDrawImageInfo *img, int x1, int y1, int x2, int y2) {
+  if ((gfx->data.flags & JSGRAPHICSFLAGS_MAPPEDXY) || img->bpp>24 || jsvIsUTF8String(img->buffer))
+    return false;
+  size_t srcLen = 0;
+  const unsigned char *src = (const unsigned char*)jsvGetDataPointer(img->buffer, &srcLen);
+  // bitmapLength is only 16 bits, so work out the size here
+  if (!src || (size_t)img->bitmapOffset+(((size_t)img->width*(size_t)img->height*(size_t)img->bpp+7)>>3) > srcLen)
+    return false;
+  src += img->bitmapOffset;
+  size_t dstRowBits = 0;
+  unsigned char *dst = graphicsGetPixelData(gfx, &dstRowBits);
+  unsigned int dstBpp = gfx->data.bpp;
+  size_t srcRowBits = (size_t)img->width*(size_t)img->bpp;
+  // Can we just copy bits? Only if the palette (if any) doesn't change anything
+  bool copyBits = dst && img->bpp==(int)dstBpp && !img->isTransparent;
+  if (copyBits && img->palettePtr) {
+    if (img->bpp>8) copyBits = false;
+    for (unsigned int i=0;i<=img->bitMask && copyBits;i++)
+      copyBits = img->palettePtr[i&img->paletteMask]==i;
+  }
+  for (int y=y1;y<=y2;y++) {
+    size_t srcBit = (size_t)(y-yPos)*srcRowBits + (size_t)(x1-xPos)*(size_t)img->bpp;
+    if (copyBits) {
+      _jswrap_drawImageCopyBits(dst, (size_t)y*dstRowBits + (size_t)x1*dstBpp, src, srcBit, (size_t)(x2+1-x1)*dstBpp);
+      continue;
+    }
+    // Expand the row through the palette
+    const unsigned char *p = &src[srcBit>>3];
+    int bits = 8-(int)(srcBit&7);
+    uint32_t colData = *(p++);
+    for (int x=x1;x<=x2;x++) {
+      while (bits < img->bpp) {
+        colData = (colData<<8) | *(p++);
+        bits += 8;
+      }
+      unsigned int col = (colData>>(bits-img->bpp))&img->bitMask;
+      bits -= img->bpp;
+      if (img->transparentCol!=col) {
+        if (img->palettePtr) col = img->palettePtr[col&img->paletteMask];
+        if (dst) _jswrap_drawImageSetBits(dst, (size_t)y*dstRowBits + (size_t)x*dstBpp, dstBpp, col);
+        else gfx->setPixel(gfx, x, y, col);
+      }
+    }
+  }
+  return true;
+}
+#endif
+
 /* Draw an image 1:1 at xPos,yPos. If parseFullImage=true we ensure
 we leave the StringIterator pointing right at the end of the image. If not
 we can optimise if the image is clipped/offscreen. */
@@ -429,6 +540,10 @@ NO_INLINE void _jswrap_drawImageSimple(JsGraphics *gfx, int xPos, int yPos, GfxD
     return;
   } else // onscreen. y1!=yPos if clipped - ensure we skip enough bytes
     bits = -(y1-yPos)*img->bpp*img->width;
+#endif
+#ifdef GRAPHICS_FAST_PATHS
+  if (!parseFullImage && _jswrap_drawImageSimpleFast(gfx, xPos, yPos, img, x1, y1, x2, y2))
+    return;
 #endif
   JsGraphicsSetPixelFn setPixel = graphicsGetSetPixelUnclippedFn(gfx, xPos, y1, xPos+img->width-1, y2, true);
   for (int y=y1;y<=y2;y++) {
@@ -3350,7 +3465,8 @@ but not including* the bottom right. When placed together polygons will align
 perfectly without overdraw - but this will not fill the same pixels as
 `drawPoly` (drawing a line around the edge of the polygon).
 
-**Note:** there is a limit of 64 points (128 XY elements) for polygons
+**Note:** Before 2v27 there was a limit of 64 points (128 XY elements) for
+polygons. Now the number of points is only limited by available stack.
 */
 /*JSON{
   "type" : "method",
@@ -3365,7 +3481,9 @@ perfectly without overdraw - but this will not fill the same pixels as
   "return_object" : "Graphics",
   "typescript" : "fillPolyAA(poly: number[]): Graphics;"
 }
-Draw a filled polygon in the current foreground color.
+Draw a filled, **antialiased** polygon in the current foreground color. Pixels
+on the edge of the polygon are blended with the background based on how much of
+each pixel is covered.
 
 ```
 g.fillPolyAA([
@@ -3382,13 +3500,19 @@ but not including* the bottom right. When placed together polygons will align
 perfectly without overdraw - but this will not fill the same pixels as
 `drawPoly` (drawing a line around the edge of the polygon).
 
-**Note:** there is a limit of 64 points (128 XY elements) for polygons
+**Note:** Before 2v27 there was a limit of 64 points (128 XY elements) for
+polygons. Now the number of points is only limited by available stack.
 */
 JsVar *jswrap_graphics_fillPoly_X(JsVar *parent, JsVar *poly, bool antiAlias) {
   JsGraphics gfx; if (!graphicsGetFromVar(&gfx, parent)) return 0;
   if (!jsvIsIterable(poly)) return 0;
-  const int maxVerts = 128;
-  short verts[maxVerts];
+  int maxVerts = (int)jsvGetLength(poly);
+  size_t vertSize = sizeof(short)*(size_t)maxVerts;
+  if (vertSize+512 > jsuGetFreeStack()) {
+    jsExceptionHere(JSET_ERROR, "Not enough free stack for %d points in fillPoly", maxVerts/2);
+    return 0;
+  }
+  short *verts = (short*)alloca(vertSize);
   int idx = 0;
   JsvIterator it;
   jsvIteratorNew(&it, poly, JSIF_EVERY_ARRAY_ELEMENT);
@@ -3399,25 +3523,13 @@ JsVar *jswrap_graphics_fillPoly_X(JsVar *parent, JsVar *poly, bool antiAlias) {
     verts[idx++] = (short)v;
     jsvIteratorNext(&it);
   }
-  if (jsvIteratorHasElement(&it))
-    jsExceptionHere(JSET_ERROR, "Maximum number of points (%d) exceeded for fillPoly", maxVerts/2);
   jsvIteratorFree(&it);
 #ifdef GRAPHICS_ANTIALIAS
-  // For antialiased fillPoly the easiest solution is just to draw AA lines
-  // around the edge first, then fill solidly
-  if (antiAlias) {
-    int lx = verts[idx-2];
-    int ly = verts[idx-1];
-    for (int i=0;i<idx;i+=2) {
-      int vx = verts[i];
-      int vy = verts[i+1];
-      graphicsDrawLineAA(&gfx, vx,vy, lx,ly);
-      lx = vx;
-      ly = vy;
-    }
-  }
+  if (antiAlias)
+    graphicsFillPolyAA(&gfx, idx/2, verts);
+  else
 #endif
-  graphicsFillPoly(&gfx, idx/2, verts);
+    graphicsFillPoly(&gfx, idx/2, verts);
 
   graphicsSetVar(&gfx); // gfx data changed because modified area
   return jsvLockAgain(parent);
@@ -4176,35 +4288,55 @@ JsVar *jswrap_graphics_asImage(JsVar *parent, JsVar *options) {
   "ifndef" : "SAVE_ON_FLASH",
   "generate" : "jswrap_graphics_getModified",
   "params" : [
-    ["reset","bool","Whether to reset the modified area or not"]
+    ["reset","bool","Whether to reset the modified area or not"],
+    ["list","bool","[optional] (2v27+) If true, return an array of separate modified areas"]
   ],
   "return" : ["JsVar","An object {x1,y1,x2,y2} containing the modified area, or undefined if not modified"],
-  "typescript" : "getModified(reset?: boolean): { x1: number, y1: number, x2: number, y2: number };"
+  "typescript" : [
+    "getModified(reset?: boolean, list?: false): { x1: number, y1: number, x2: number, y2: number };",
+    "getModified(reset: boolean, list: true): { x1: number, y1: number, x2: number, y2: number }[];"
+  ]
 }
 Return the area of the Graphics canvas that has been modified, and optionally
 clear the modified area to 0.
 
 For instance if `g.setPixel(10,20)` was called, this would return `{x1:10,
 y1:20, x2:10, y2:20}`
+
+If `list` is true, an array of (up to 4) non-overlapping `{x1,y1,x2,y2}`
+areas is returned instead (empty if nothing was modified). Two small changes in
+opposite corners are reported separately rather than as one large area, and
+this is what displays use to decide what to send on `flip()`.
+
+**Note:** Coordinates are device coordinates, so if `setRotation` has been used
+they may not match those used for drawing.
 */
-JsVar *jswrap_graphics_getModified(JsVar *parent, bool reset) {
+static JsVar *jswrap_graphics_newModifiedRect(int x1, int y1, int x2, int y2) {
+  JsVar *obj = jsvNewObject();
+  if (obj) {
+    jsvObjectSetChildAndUnLock(obj, "x1", jsvNewFromInteger(x1));
+    jsvObjectSetChildAndUnLock(obj, "y1", jsvNewFromInteger(y1));
+    jsvObjectSetChildAndUnLock(obj, "x2", jsvNewFromInteger(x2));
+    jsvObjectSetChildAndUnLock(obj, "y2", jsvNewFromInteger(y2));
+  }
+  return obj;
+}
+
+JsVar *jswrap_graphics_getModified(JsVar *parent, bool reset, bool list) {
 #ifndef NO_MODIFIED_AREA
   JsGraphics gfx; if (!graphicsGetFromVar(&gfx, parent)) return 0;
   JsVar *obj = 0;
-  if (gfx.data.modMinX <= gfx.data.modMaxX) { // do we have a rect?
-    obj = jsvNewObject();
-    if (obj) {
-      jsvObjectSetChildAndUnLock(obj, "x1", jsvNewFromInteger(gfx.data.modMinX));
-      jsvObjectSetChildAndUnLock(obj, "y1", jsvNewFromInteger(gfx.data.modMinY));
-      jsvObjectSetChildAndUnLock(obj, "x2", jsvNewFromInteger(gfx.data.modMaxX));
-      jsvObjectSetChildAndUnLock(obj, "y2", jsvNewFromInteger(gfx.data.modMaxY));
-    }
+  if (list) {
+    obj = jsvNewEmptyArray();
+    JsGraphicsClipRect areas[GRAPHICS_MODIFIED_RECTS_MAX];
+    int n = graphicsGetModifiedAreas(&gfx, areas, false);
+    for (int i=0;obj && i<n;i++)
+      jsvArrayPushAndUnLock(obj, jswrap_graphics_newModifiedRect(areas[i].x1, areas[i].y1, areas[i].x2, areas[i].y2));
+  } else if (gfx.data.modMinX <= gfx.data.modMaxX) { // do we have a rect?
+    obj = jswrap_graphics_newModifiedRect(gfx.data.modMinX, gfx.data.modMinY, gfx.data.modMaxX, gfx.data.modMaxY);
   }
   if (reset) {
-    gfx.data.modMaxX = -32768;
-    gfx.data.modMaxY = -32768;
-    gfx.data.modMinX = 32767;
-    gfx.data.modMinY = 32767;
+    graphicsClearModified(&gfx);
     graphicsSetVar(&gfx);
   }
   return obj;
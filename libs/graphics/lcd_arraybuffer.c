@@ -430,8 +430,35 @@ void lcdScroll_ArrayBuffer_flat8(JsGraphics *gfx, int xdir, int ydir, int x1, in
 }
 #endif
 
+
 #endif // GRAPHICS_ARRAYBUFFER_OPTIMISATIONS
 
+/* If pixels are stored in a flat buffer as a packed MSB-first bitstream (the
+same layout Images use) return a pointer to the data and set rowBits to
+the distance between rows in bits. Otherwise return 0. */
+unsigned char *lcdGetPixelData_ArrayBuffer(JsGraphics *gfx, size_t *rowBits) {
+#ifdef GRAPHICS_ARRAYBUFFER_OPTIMISATIONS
+  if (gfx->getPixel!=lcdGetPixel_ArrayBuffer_flat
+#ifdef GRAPHICS_FAST_PATHS
+      && gfx->getPixel!=lcdGetPixel_ArrayBuffer_flat1
+      && gfx->getPixel!=lcdGetPixel_ArrayBuffer_flat2
+      && gfx->getPixel!=lcdGetPixel_ArrayBuffer_flat4
+      && gfx->getPixel!=lcdGetPixel_ArrayBuffer_flat8
+#endif
+      ) return 0; // not a flat buffer
+  if (gfx->data.flags & JSGRAPHICSFLAGS_NONLINEAR) return 0;
+  // 8 bit is the same either way. Otherwise we need MSB, and pixels can't straddle bytes
+  if (gfx->data.bpp!=8 &&
+      (!(gfx->data.flags & JSGRAPHICSFLAGS_ARRAYBUFFER_MSB) ||
+       (gfx->data.bpp<8 ? (8%gfx->data.bpp) : (gfx->data.bpp&7))))
+    return 0;
+  *rowBits = (size_t)gfx->data.width * gfx->data.bpp;
+  return (unsigned char*)gfx->backendData;
+#else
+  return 0;
+#endif
+}
+
 
 
 void lcdInit_ArrayBuffer(JsGraphics *gfx, JsVar *optionalBuffer) {
@@ -285,9 +285,12 @@ void lcdMemLCD_flip(JsGraphics *gfx) {
 #endif
   lcdMemLCD_waitForSendComplete();
 
-  int y1 = gfx->data.modMinY;
-  int y2 = gfx->data.modMaxY;
-  int l = 1+y2-y1;
+  // Only rows that have changed need sending
+  JsGraphicsClipRect rows[GRAPHICS_MODIFIED_RECTS_MAX];
+  int rowRanges = graphicsGetModifiedAreas(gfx, rows, true);
+  if (!rowRanges) return;
+  int y1 = rows[0].y1;
+  int y2 = rows[rowRanges-1].y2;
 
   bool hasOverlay = false;
   GfxDrawImageInfo overlayImg;
@@ -328,7 +331,13 @@ void lcdMemLCD_flip(JsGraphics *gfx) {
     jsvStringIteratorNew(&l.it, l.img.buffer, (size_t)l.img.bitmapOffset);
     _jswrap_drawImageLayerInit(&l);
     _jswrap_drawImageLayerSetStart(&l, 0, y1);
+    int r = 0;
     for (int y=y1;y<=y2;y++) {
+      if (y > rows[r].y2) r++;
+      if (y < rows[r].y1) { // unmodified row - skip it
+        _jswrap_drawImageLayerNextY(&l);
+        continue;
+      }
       int bufferLine = LCD_HEIGHT + (y&1); // alternate lines so we still get dither AND we can send while calculating next line
       unsigned char *buf = &lcdBuffer[LCD_STRIDE*bufferLine]; // point to line right on the end of gfx
       // copy original line in
@@ -367,16 +376,18 @@ void lcdMemLCD_flip(JsGraphics *gfx) {
     memcpy(fakeLCDBuffer, lcdBuffer, LCD_HEIGHT*LCD_STRIDE);
 #else
     lcdIsBusy = true;
-    if (!jshSPISendMany(LCD_SPI, &lcdBuffer[LCD_STRIDE*y1], NULL, (l*LCD_STRIDE)+2, lcdMemLCD_flip_spi_callback))
+    /* Each row has its own address header, so separate ranges of rows can be sent in one
+    transfer. The 2 bytes after the last row finish the transfer. */
+    for (int r=0;r<rowRanges-1;r++)
+      jshSPISendMany(LCD_SPI, &lcdBuffer[LCD_STRIDE*rows[r].y1], NULL, (1+rows[r].y2-rows[r].y1)*LCD_STRIDE, lcdMemLCD_flip_spi_ovr_callback);
+    int l = 1+y2-rows[rowRanges-1].y1;
+    if (!jshSPISendMany(LCD_SPI, &lcdBuffer[LCD_STRIDE*rows[rowRanges-1].y1], NULL, (l*LCD_STRIDE)+2, lcdMemLCD_flip_spi_callback))
       lcdMemLCD_flip_spi_callback();
     // lcdMemLCD_flip_spi_callback will call jshPinSetValue(LCD_SPI_CS, 0); when done and set lcdIsBusy=false
 #endif
   }
   // Reset modified-ness
-  gfx->data.modMaxX = -32768;
-  gfx->data.modMaxY = -32768;
-  gfx->data.modMinX = 32767;
-  gfx->data.modMinY = 32767;
+  graphicsClearModified(gfx);
 }
 
 void lcdMemLCD_init(JsGraphics *gfx) {
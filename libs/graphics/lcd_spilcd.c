@@ -140,6 +140,12 @@ void lcdSetPixel_SPILCD(JsGraphics *gfx, int x, int y, unsigned int col) {
 #endif
 }
 
+// Pixels are stored as a packed MSB-first bitstream (16 bit is byteswapped to big endian)
+unsigned char *lcdGetPixelData_SPILCD(JsGraphics *gfx, size_t *rowBits) {
+  *rowBits = LCD_STRIDE*8;
+  return lcdBuffer;
+}
+
 #if LCD_BPP==16
 void lcdFillRect_SPILCD(struct JsGraphics *gfx, int x1, int y1, int x2, int y2, unsigned int col) {
   // or update just part of it.
@@ -181,6 +187,33 @@ void lcdFlip_SPILCD_callback() {
   // just an empty stub for SPIsend - we'll just push data as fast as we can
 }
 
+// Set the window on the LCD that following pixel data will be written to
+static void lcdFlip_SPILCD_setWindow(int x1, int y1, int x2, int y2) {
+  unsigned char buf[4];
+  jshPinSetValue(LCD_SPI_DC, 0); // command
+  buf[0] = SPILCD_CMD_WINDOW_X;
+  jshSPISendMany(LCD_SPI, buf, NULL, 1, NULL);
+  jshPinSetValue(LCD_SPI_DC, 1); // data
+  buf[0] = 0;
+  buf[1] = x1;
+  buf[2] = 0;
+  buf[3] = x2;
+  jshSPISendMany(LCD_SPI, buf, NULL, 4, NULL);
+  jshPinSetValue(LCD_SPI_DC, 0); // command
+  buf[0] = SPILCD_CMD_WINDOW_Y;
+  jshSPISendMany(LCD_SPI, buf, NULL, 1, NULL);
+  jshPinSetValue(LCD_SPI_DC, 1); // data
+  buf[0] = 0;
+  buf[1] = y1;
+  buf[2] = 0;
+  buf[3] = y2;
+  jshSPISendMany(LCD_SPI, buf, NULL, 4, NULL);
+  jshPinSetValue(LCD_SPI_DC, 0); // command
+  buf[0] = SPILCD_CMD_DATA;
+  jshSPISendMany(LCD_SPI, buf, NULL, 1, NULL);
+  jshPinSetValue(LCD_SPI_DC, 1); // data
+}
+
 void lcdFlip_SPILCD(JsGraphics *gfx) {
   if (gfx->data.modMinX > gfx->data.modMaxX) return; // nothing to do!
 
@@ -191,6 +224,8 @@ void lcdFlip_SPILCD(JsGraphics *gfx) {
   if (lcdOverlayImage)
     hasOverlay = _jswrap_graphics_parseImage(gfx, lcdOverlayImage, 0, &overlayImg);
 
+  JsGraphicsClipRect areas[GRAPHICS_MODIFIED_RECTS_MAX];
+  int areaCount;
   if (hasOverlay) {
     /* If lcdOverlayImage is defined, we want to overlay this image
      * on top of what we have in our LCD buffer. Do this line by
@@ -199,22 +234,21 @@ void lcdFlip_SPILCD(JsGraphics *gfx) {
      * We use this rarely so don't mess around, we're just going to send the
      * whole buffer rather than part of it.
      */
-    gfx->data.modMinX = 0;
-    gfx->data.modMaxX = LCD_WIDTH-1;
-  }
+    areas[0].x1 = 0;
+    areas[0].y1 = gfx->data.modMinY;
+    areas[0].x2 = LCD_WIDTH-1;
+    areas[0].y2 = gfx->data.modMaxY;
+    areaCount = 1;
+  } else {
 #if LCD_BPP==12 || LCD_BPP==16
-  // Just send full rows as this allows us to issue a single SPI
-  // transfer.
-  // TODO: could swap to a transfer per row if we're filling less than half a row
-  gfx->data.modMinX = 0;
-  gfx->data.modMaxX = LCD_WIDTH-1;
+    // Just send full rows as this allows us to issue a single SPI
+    // transfer for each modified area.
+    // TODO: could swap to a transfer per row if we're filling less than half a row
+    areaCount = graphicsGetModifiedAreas(gfx, areas, true);
 #else
-  // use nearest 2 pixels as we're sending 12 bits
-  gfx->data.modMinX = (gfx->data.modMinX)&~1;
-  gfx->data.modMaxX = (gfx->data.modMaxX+2)&~1;
-  int xlen = gfx->data.modMaxX - gfx->data.modMinX;
-  int xstart = gfx->data.modMinX;
+    areaCount = graphicsGetModifiedAreas(gfx, areas, false);
 #endif
+  }
 
 #ifdef ESPR_USE_SPI3
   // anomaly 195 workaround - enable SPI before use
@@ -222,141 +256,129 @@ void lcdFlip_SPILCD(JsGraphics *gfx) {
 #endif
 
   jshPinSetValue(LCD_SPI_CS, 0);
-  jshPinSetValue(LCD_SPI_DC, 0); // command
-  buffer1[0] = SPILCD_CMD_WINDOW_X;
-  jshSPISendMany(LCD_SPI, buffer1, NULL, 1, NULL);
-  jshPinSetValue(LCD_SPI_DC, 1); // data
-  buffer1[0] = 0;
-  buffer1[1] = gfx->data.modMinX;
-  buffer1[2] = 0;
-  buffer1[3] = gfx->data.modMaxX;
-  jshSPISendMany(LCD_SPI, buffer1, NULL, 4, NULL);
-  jshPinSetValue(LCD_SPI_DC, 0); // command
-  buffer1[0] = SPILCD_CMD_WINDOW_Y;
-  jshSPISendMany(LCD_SPI, buffer1, NULL, 1, NULL);
-  jshPinSetValue(LCD_SPI_DC, 1); // data
-  buffer1[0] = 0;
-  buffer1[1] = gfx->data.modMinY;
-  buffer1[2] = 0;
-  buffer1[3] = gfx->data.modMaxY;
-  jshSPISendMany(LCD_SPI, buffer1, NULL, 4, NULL);
-  jshPinSetValue(LCD_SPI_DC, 0); // command
-  buffer1[0] = SPILCD_CMD_DATA;
-  jshSPISendMany(LCD_SPI, buffer1, NULL, 1, NULL);
-  jshPinSetValue(LCD_SPI_DC, 1); // data
+  for (int area=0;area<areaCount;area++) {
+    int x1 = areas[area].x1, y1 = areas[area].y1;
+    int x2 = areas[area].x2, y2 = areas[area].y2;
+#if !(LCD_BPP==12 || LCD_BPP==16)
+    // use nearest 2 pixels as we're sending 12 bits
+    x1 = x1&~1;
+    x2 = (x2+2)&~1;
+    int xlen = x2 - x1;
+    int xstart = x1;
+#endif
+    lcdFlip_SPILCD_setWindow(x1, y1, x2, y2);
 
 #if LCD_BPP==12 || LCD_BPP==16
-  if (hasOverlay) { // we have an overlay, just send line by line
-    // initialise image layer
-    GfxDrawImageLayer l;
-    int ovY = lcdOverlayY;
-    l.x1 = 0;
-    l.y1 = ovY;
-    l.img = overlayImg;
-    l.rotate = 0;
-    l.scale = 1;
-    l.center = false;
-    l.repeat = false;
-    jsvStringIteratorNew(&l.it, l.img.buffer, (size_t)l.img.bitmapOffset);
-    _jswrap_drawImageLayerInit(&l);
-    _jswrap_drawImageLayerSetStart(&l, 0, gfx->data.modMinY);
-    unsigned char buffer2[LCD_STRIDE];
-    memcpy(buffer1, &lcdBuffer[LCD_STRIDE*0], LCD_STRIDE); // save first 2 lines
-    memcpy(buffer2, &lcdBuffer[LCD_STRIDE*1], LCD_STRIDE);
-
-    for (int y=gfx->data.modMinY;y<=gfx->data.modMaxY;y++) {
-      int bufferLine = y&1; // alternate lines so we can send while calculating next line
-      unsigned char *buf = &lcdBuffer[LCD_STRIDE * bufferLine];
-      // copy original line in
-      memcpy(buf, &lcdBuffer[LCD_STRIDE*y], LCD_STRIDE);
-      // overwrite areas with overlay image
-      if (y>=ovY && y<ovY+overlayImg.height) {
-        _jswrap_drawImageLayerStartX(&l);
-        for (int x=0;x<overlayImg.width;x++) {
-          unsigned int c;
-          int ox = x+lcdOverlayX;
-          if (_jswrap_drawImageLayerGetPixel(&l, &c) && (ox < LCD_WIDTH) && (ox >= 0))
-            lcdSetPixel_SPILCD(NULL, ox, y&1, c);
-          _jswrap_drawImageLayerNextX(&l);
+    if (hasOverlay) { // we have an overlay, just send line by line
+      // initialise image layer
+      GfxDrawImageLayer l;
+      int ovY = lcdOverlayY;
+      l.x1 = 0;
+      l.y1 = ovY;
+      l.img = overlayImg;
+      l.rotate = 0;
+      l.scale = 1;
+      l.center = false;
+      l.repeat = false;
+      jsvStringIteratorNew(&l.it, l.img.buffer, (size_t)l.img.bitmapOffset);
+      _jswrap_drawImageLayerInit(&l);
+      _jswrap_drawImageLayerSetStart(&l, 0, y1);
+      unsigned char buffer2[LCD_STRIDE];
+      memcpy(buffer1, &lcdBuffer[LCD_STRIDE*0], LCD_STRIDE); // save first 2 lines
+      memcpy(buffer2, &lcdBuffer[LCD_STRIDE*1], LCD_STRIDE);
+
+      for (int y=y1;y<=y2;y++) {
+        int bufferLine = y&1; // alternate lines so we can send while calculating next line
+        unsigned char *buf = &lcdBuffer[LCD_STRIDE * bufferLine];
+        // copy original line in
+        memcpy(buf, &lcdBuffer[LCD_STRIDE*y], LCD_STRIDE);
+        // overwrite areas with overlay image
+        if (y>=ovY && y<ovY+overlayImg.height) {
+          _jswrap_drawImageLayerStartX(&l);
+          for (int x=0;x<overlayImg.width;x++) {
+            unsigned int c;
+            int ox = x+lcdOverlayX;
+            if (_jswrap_drawImageLayerGetPixel(&l, &c) && (ox < LCD_WIDTH) && (ox >= 0))
+              lcdSetPixel_SPILCD(NULL, ox, y&1, c);
+            _jswrap_drawImageLayerNextX(&l);
+          }
         }
+        _jswrap_drawImageLayerNextY(&l);
+        // send the line
+        jshSPISendMany(LCD_SPI, buf, 0, LCD_STRIDE, lcdFlip_SPILCD_callback);
+      }
+      jsvStringIteratorFree(&l.it);
+
+      memcpy(&lcdBuffer[LCD_STRIDE*0], buffer1, LCD_STRIDE); // restore first 2 lines
+      memcpy(&lcdBuffer[LCD_STRIDE*1], buffer2, LCD_STRIDE);
+
+      jshSPIWait(LCD_SPI);
+    } else { // ============================================  standard, non-overlay transfer
+      // FIXME: hack because SPI send on NRF52 fails for >65k transfers
+      // we should fix this in jshardware.c
+      unsigned char *p = &lcdBuffer[LCD_STRIDE*y1];
+      int c = (y2+1-y1)*LCD_STRIDE;
+      while (c) {
+        int n = c;
+        if (n>65535) n=65535;
+        jshSPISendMany(
+            LCD_SPI,
+            p,
+            0,
+            n,
+            NULL);
+        if (jspIsInterrupted()) break;
+        p+=n;
+        c-=n;
       }
-      _jswrap_drawImageLayerNextY(&l);
-      // send the line
-      jshSPISendMany(LCD_SPI, buf, 0, LCD_STRIDE, lcdFlip_SPILCD_callback);
-    }
-    jsvStringIteratorFree(&l.it);
-    _jswrap_graphics_freeImageInfo(&overlayImg);
-
-    memcpy(&lcdBuffer[LCD_STRIDE*0], buffer1, LCD_STRIDE); // restore first 2 lines
-    memcpy(&lcdBuffer[LCD_STRIDE*1], buffer2, LCD_STRIDE);
-
-    jshSPIWait(LCD_SPI);
-  } else { // ============================================  standard, non-overlay transfer
-    // FIXME: hack because SPI send on NRF52 fails for >65k transfers
-    // we should fix this in jshardware.c
-    unsigned char *p = &lcdBuffer[LCD_STRIDE*gfx->data.modMinY];
-    int c = (gfx->data.modMaxY+1-gfx->data.modMinY)*LCD_STRIDE;
-    while (c) {
-      int n = c;
-      if (n>65535) n=65535;
-      jshSPISendMany(
-          LCD_SPI,
-          p,
-          0,
-          n,
-          NULL);
-      if (jspIsInterrupted()) break;
-      p+=n;
-      c-=n;
     }
-  }
 #else // Data stored paletted - must decode the palette before sending
-  unsigned char buffer2[LCD_STRIDE];
-  for (int y=gfx->data.modMinY;y<=gfx->data.modMaxY;y++) {
-    unsigned char *buffer = (y&1)?buffer1:buffer2;
-    // skip any lines that don't need updating
+    unsigned char buffer2[LCD_STRIDE];
+    for (int y=y1;y<=y2;y++) {
+      unsigned char *buffer = (y&1)?buffer1:buffer2;
+      // skip any lines that don't need updating
 #if LCD_BPP==4
-    unsigned char *px = &lcdBuffer[y*LCD_STRIDE + (xstart>>1)];
+      unsigned char *px = &lcdBuffer[y*LCD_STRIDE + (xstart>>1)];
 #endif
 #if LCD_BPP==8
-    unsigned char *px = &lcdBuffer[y*LCD_STRIDE + xstart];
+      unsigned char *px = &lcdBuffer[y*LCD_STRIDE + xstart];
 #endif
-    unsigned char *bufPtr = (unsigned char*)buffer;
-    for (int x=0;x<xlen;x+=2) {
+      unsigned char *bufPtr = (unsigned char*)buffer;
+      for (int x=0;x<xlen;x+=2) {
 #if LCD_BPP==4
-      unsigned char c = *(px++);
-      unsigned int a = lcdPalette[c >> 4];
-      unsigned int b = lcdPalette[c & 15];
+        unsigned char c = *(px++);
+        unsigned int a = lcdPalette[c >> 4];
+        unsigned int b = lcdPalette[c & 15];
 #endif
 #if LCD_BPP==8
-      unsigned int a = lcdPalette[*(px++)];
-      unsigned int b = lcdPalette[*(px++)];
+        unsigned int a = lcdPalette[*(px++)];
+        unsigned int b = lcdPalette[*(px++)];
 #endif
-      *(bufPtr++) = a>>4;
-      *(bufPtr++) = (a<<4) | (b>>8);
-      *(bufPtr++) = b;
+        *(bufPtr++) = a>>4;
+        *(bufPtr++) = (a<<4) | (b>>8);
+        *(bufPtr++) = b;
+      }
+      size_t len = ((unsigned char*)bufPtr)-buffer;
+      jshSPISendMany(LCD_SPI, buffer, 0, len, lcdFlip_SPILCD_callback);
+      if (jspIsInterrupted()) break;
     }
-    size_t len = ((unsigned char*)bufPtr)-buffer;
-    jshSPISendMany(LCD_SPI, buffer, 0, len, lcdFlip_SPILCD_callback);
+    jshSPIWait(LCD_SPI);
+#endif // End of paletted send
     if (jspIsInterrupted()) break;
   }
-  jshSPIWait(LCD_SPI);
-#endif // End of paletted send
   jshPinSetValue(LCD_SPI_CS,1);
 #ifdef ESPR_USE_SPI3
   // anomaly 195 workaround - disable SPI when done
   *(volatile uint32_t *)0x4002F500 = 0;
   *(volatile uint32_t *)0x4002F004 = 1;
 #endif
+  if (hasOverlay)
+    _jswrap_graphics_freeImageInfo(&overlayImg);
 
   // Reset modified-ness
-  gfx->data.modMaxX = -32768;
-  gfx->data.modMaxY = -32768;
-  gfx->data.modMinX = 32767;
-  gfx->data.modMinY = 32767;
+  graphicsClearModified(gfx);
 }
 
-
 void lcdInit_SPILCD(JsGraphics *gfx) {
   gfx->data.width = LCD_WIDTH;
   gfx->data.height = LCD_HEIGHT;
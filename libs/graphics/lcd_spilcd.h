@@ -22,6 +22,7 @@ void lcdSetCallbacks_SPILCD(JsGraphics *gfx);
 void lcdFlip_SPILCD(JsGraphics *gfx); // run this to flip the offscreen buffer to the screen
 void lcdCmd_SPILCD(int cmd, int dataLen, const unsigned char *data); // to send specific commands to the display
 void lcdSetPalette_SPILCD(const char *pal);
+unsigned char *lcdGetPixelData_SPILCD(JsGraphics *gfx, size_t *rowBits); // get a pointer to pixel data for fast image blits
 
 #if LCD_BPP==12 || LCD_BPP==16
 // Enable overlay mode (to overlay a graphics instance on top of the LCD contents)
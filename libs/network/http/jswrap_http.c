@@ -42,6 +42,31 @@ page for more information on how to use it.
 The HTTP server created by `require('http').createServer`
 */
 // there is a 'connect' event on httpSrv, but it's used by createServer and isn't node-compliant
+/*JSON{
+  "type" : "event",
+  "class" : "httpSrv",
+  "name" : "websocket",
+  "params" : [
+    ["ws","JsVar","A `httpWS` for the new WebSocket connection"],
+    ["request","JsVar","The `httpSRq` for the request that asked to upgrade to a WebSocket"]
+  ]
+}
+(2v27+) If there's a handler for this event, requests asking to upgrade to a
+WebSocket are accepted and this is called with the new WebSocket, rather than
+the request being passed to the `createServer` callback. This needs a build
+with the `crypto` library (for SHA1) - on others, requests are passed to the
+callback as normal so the `ws` module can handle them.
+
+```
+var server = require("http").createServer(function(req, res) {
+  res.end("Not a WebSocket");
+});
+server.on('websocket', function(ws, req) {
+  ws.on('message', function(msg) { ws.send("Echo: "+msg); });
+});
+server.listen(80);
+```
+*/
 
 /*JSON{
   "type" : "class",
@@ -359,7 +384,10 @@ var options = {
     path: '/',           // path sent to server
     method: 'GET',       // HTTP command sent to server (must be uppercase 'GET', 'POST', etc)
     protocol: 'http:',   // optional protocol - https: or http:
-    headers: { key : value, key : value } // (optional) HTTP headers
+    headers: { key : value, key : value }, // (optional) HTTP headers
+    keepAlive: false,       // (optional, 2v27+) keep the connection open to reuse for the next request to this host
+    keepAliveTimeout: 5000, // (optional, 2v27+) close a kept-alive connection if unused for this many ms
+    maxFreeSockets: 2       // (optional, 2v27+) max number of unused kept-alive connections to this host
   };
 var req = require("http").request(options, function(res) {
   res.on('data', function(data) {
@@ -382,6 +410,14 @@ here](/Internet#http-post)
 **Note:** if TLS/HTTPS is enabled, options can have `ca`, `key` and `cert`
 fields. See `tls.connect` for more information about these and how to use them.
 
+With `keepAlive:true`, Espruino asks the server to keep the connection open.
+When the response has finished (and the server didn't ask to close it) the
+connection is kept, and the next request with `keepAlive:true` to the same
+host and port uses it rather than connecting again. Requests over HTTPS
+also resume the previous TLS session with a server where they can, which
+avoids most of the work of the TLS handshake. HTTPS requests that specify
+their own `ca`, `key` or `cert` are never kept.
+
 */
 
 /*JSON{
@@ -561,6 +597,38 @@ void jswrap_httpSRs_setHeader(JsVar *parent, JsVar *name, JsVar *value) {
   serverResponseSetHeader(parent, name, value);
 }
 
+/*JSON{
+  "type" : "method",
+  "class" : "httpSRs",
+  "name" : "sendFile",
+  "generate" : "jswrap_httpSRs_sendFile",
+  "params" : [
+    ["fileName","JsVar","The name of a file in Storage"],
+    ["headers","JsVar","(optional) An object containing extra headers to send"]
+  ]
+}
+(2v27+) Send a file from Storage as the response, and end it. The file is sent
+straight from flash rather than being loaded into RAM first.
+
+* If there's also a file called `fileName+".gz"` and the client accepts gzip,
+that is sent instead with `Content-Encoding: gzip`. This works even if
+`fileName` itself doesn't exist, so files can be stored only gzipped.
+* An `ETag` header is sent, and if the request's `If-None-Match` matches it
+an empty `304` response is sent instead of the file.
+* `Content-Type` is set from the file's extension, and if the file doesn't
+exist a `404` is sent.
+
+```
+require("http").createServer(function (req, res) {
+  var file = req.url=="/" ? "index.html" : req.url.substr(1);
+  res.sendFile(file, {"Cache-Control":"max-age=3600"});
+}).listen(80);
+```
+*/
+void jswrap_httpSRs_sendFile(JsVar *parent, JsVar *fileName, JsVar *headers) {
+  serverResponseSendFile(parent, fileName, headers);
+}
+
 // ---------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------
@@ -598,3 +666,168 @@ See `Socket.write` for more information about the data argument
 // Re-use existing
 
 
+
+// ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------
+/*JSON{
+  "type" : "class",
+  "library" : "http",
+  "class" : "httpWS"
+}
+(2v27+) A WebSocket connection, returned by `http.connectWebSocket` or passed
+to the `websocket` event of an HTTP server.
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "httpWS",
+  "name" : "open"
+}
+Called when the WebSocket handshake has finished and messages can be sent
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "httpWS",
+  "name" : "message",
+  "params" : [
+    ["data","JsVar","A String for text messages, or an ArrayBuffer for binary messages"]
+  ]
+}
+Called when a whole message has been received. Messages sent in fragments are
+joined together first.
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "httpWS",
+  "name" : "ping",
+  "params" : [
+    ["data","JsVar","A String containing the data sent with the ping"]
+  ]
+}
+Called when a ping is received. A pong is sent back automatically.
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "httpWS",
+  "name" : "pong",
+  "params" : [
+    ["data","JsVar","A String containing the data sent with the pong"]
+  ]
+}
+Called when a pong is received (in reply to `httpWS.ping`)
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "httpWS",
+  "name" : "close"
+}
+Called when the connection closes.
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "httpWS",
+  "name" : "error",
+  "params" : [
+    ["details","JsVar","An error object with an error code (a negative integer) and a message (a string)"]
+  ]
+}
+An event that is fired if there is an error, for instance if the server didn't
+accept the upgrade to a WebSocket
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "httpWS",
+  "name" : "drain"
+}
+An event that is fired when the buffer is empty and it can accept more data to
+send.
+*/
+
+/*JSON{
+  "type" : "staticmethod",
+  "class" : "http",
+  "name" : "connectWebSocket",
+  "generate" : "jswrap_http_connectWebSocket",
+  "params" : [
+    ["options","JsVar","A URL like `ws://example.com/path`, or an object containing host,port,path,protocol,headers fields (and also ca,key,cert if TLS is enabled)"],
+    ["callback","JsVar","A function(ws) that will be called when the WebSocket is open"]
+  ],
+  "return" : ["JsVar","Returns a new httpWS object"],
+  "return_object" : "httpWS"
+}
+(2v27+) Connect to a WebSocket server. Use the `wss:` (or `https:`) protocol to
+connect over TLS.
+
+```
+var ws = require("http").connectWebSocket("ws://example.com:8080/", function(ws) {
+  ws.send("Hello");
+});
+ws.on('message', function(msg) {
+  console.log("WS> "+msg);
+});
+```
+
+Messages received are passed to the `message` event as Strings (or
+ArrayBuffers for binary messages), and pings are answered automatically.
+*/
+JsVar *jswrap_http_connectWebSocket(JsVar *options, JsVar *callback) {
+  bool unlockOptions = false;
+  if (jsvIsString(options)) {
+    options = jswrap_url_parse(options, false);
+    unlockOptions = true;
+  }
+  if (!jsvIsObject(options)) {
+    jsError("Expecting Options to be an Object but it was %t", options);
+    return 0;
+  }
+  if (!jsvIsUndefined(callback) && !jsvIsFunction(callback)) {
+    jsError("Expecting Callback Function but got %t", callback);
+    if (unlockOptions) jsvUnLock(options);
+    return 0;
+  }
+  JsVar *ws = 0;
+  JsNetwork net;
+  if (networkGetFromVarIfOnline(&net)) {
+    ws = websocketConnect(&net, options, callback);
+    networkFree(&net);
+  }
+  if (unlockOptions) jsvUnLock(options);
+  return ws;
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "httpWS",
+  "name" : "send",
+  "generate" : "websocketSend",
+  "params" : [
+    ["data","JsVar","A String or ArrayBuffer to send"],
+    ["binary","bool","If true, send a String as a binary message (ArrayBuffers are always sent as binary)"]
+  ]
+}
+Send a message
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "httpWS",
+  "name" : "ping",
+  "generate" : "websocketPing",
+  "params" : [
+    ["data","JsVar","(optional) A String to send with the ping"]
+  ]
+}
+Send a ping. The other end will reply with a pong, which fires the `pong`
+event.
+*/
+/*JSON{
+  "type" : "method",
+  "class" : "httpWS",
+  "name" : "close",
+  "generate" : "websocketClose",
+  "params" : [
+    ["code","int32","(optional) The status code to send, eg. 1000"]
+  ]
+}
+Close the WebSocket, once everything queued has been sent
+*/
@@ -14,6 +14,7 @@
  * ----------------------------------------------------------------------------
  */
 #include "jswrap_net.h"
+#include "jswrap_arraybuffer.h"
 #include "jsvariterator.h"
 #include "jsinteractive.h"
 #include "jsparse.h"
@@ -46,6 +47,9 @@ void jswrap_net_init() {
   "generate" : "jswrap_net_kill"
 }*/
 void jswrap_net_kill() {
+#ifdef USE_TLS
+  ssl_clearSessionCache();
+#endif
   JsNetwork net;
   if (networkWasCreated()) {
     if (!networkGetFromVar(&net)) return;
@@ -321,7 +325,7 @@ Return a string containing characters that have been received
   "generate" : "jswrap_pipe",
   "params" : [
     ["destination","JsVar","The destination file/stream that will receive content from the source."],
-    ["options","JsVar",["[optional] An object `{ chunkSize : int=32, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
+    ["options","JsVar",["[optional] An object `{ chunkSize : int, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time (chosen automatically if not specified)","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
   ],
   "typescript": "pipe(destination: any, options?: PipeOptions): void"
 }
@@ -456,13 +460,17 @@ page for more information on how to use it.
   "name" : "createSocket",
   "generate_full" : "jswrap_dgram_createSocket(type, callback)",
   "params" : [
-    ["type","JsVar","Socket type to create e.g. 'udp4'. Or options object { type: 'udp4', reuseAddr: true, recvBufferSize: 1024 }"],
+    ["type","JsVar","Socket type to create e.g. 'udp4'. Or options object { type: 'udp4', reuseAddr: true, recvBufferSize: 1024, batch: false }"],
     ["callback","JsVar","A `function(sckt)` that will be called  with the socket when a connection is made. You can then call `sckt.send(...)` to send data, and `sckt.on('message', function(data) { ... })` and `sckt.on('close', function() { ... })` to deal with the response."]
   ],
   "return" : ["JsVar","Returns a new dgram.Socket object"],
   "return_object" : "dgramSocket"
 }
 Create a UDP socket
+
+If the `batch: true` option is given, rather than a `message` event for each
+packet, all the packets received in one go are delivered together in a
+`messages` event.
 */
 JsVar *jswrap_dgram_createSocket(JsVar *type, JsVar *callback) {
   NOT_USED(type);
@@ -485,7 +493,7 @@ An actual socket connection - allowing transmit/receive of TCP data
   "name" : "send",
   "generate" : "jswrap_dgram_socket_send",
   "params" : [
-    ["buffer","JsVar","A string containing message to send"],
+    ["buffer","JsVar","A string or ArrayBuffer containing message to send"],
     ["offset","JsVar","Offset in the passed string where the message starts [optional]"],
     ["length","JsVar","Number of bytes in the message [optional]"],
     ["args","JsVarArray","Destination port number, Destination IP address string"]
@@ -496,7 +504,6 @@ An actual socket connection - allowing transmit/receive of TCP data
 //  ["address","JsVar","Destination hostname or IP address string"]
 void jswrap_dgram_socket_send(JsVar *parent, JsVar *buffer, JsVar *offset, JsVar *length, JsVar *args) {
   assert(jsvIsObject(parent));
-  assert(jsvIsString(buffer));
   JsNetwork net;
   if (!networkGetFromVarIfOnline(&net)) return;
 
@@ -504,14 +511,23 @@ void jswrap_dgram_socket_send(JsVar *parent, JsVar *buffer, JsVar *offset, JsVar
   JsVar *address;
   JsVar *port = jsvGetArrayItem(args, 0);
   if (jsvIsNumeric(port)) {
-    int from = jsvGetInteger(offset);
-    int count = jsvGetInteger(length);
-    msg = jsvNewFromEmptyString();
+    JsVarInt from = jsvGetInteger(offset);
+    JsVarInt count = jsvGetInteger(length);
+    if (jsvIsArrayBuffer(buffer)) { // just make a byte view of the part we want - no copy
+      bool isView = buffer->varData.arraybuffer.type != ARRAYBUFFERVIEW_ARRAYBUFFER;
+      JsVar *arrayBuffer = isView ? jsvLock(jsvGetFirstChild(buffer)) : jsvLockAgain(buffer);
+      if (isView) from += buffer->varData.arraybuffer.byteOffset;
+      msg = jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT8, arrayBuffer, from, count);
+      jsvUnLock(arrayBuffer);
+    } else {
+      msg = jsvNewFromEmptyString();
+      if (msg) jsvAppendStringVar(msg, buffer, (size_t)from, (size_t)count);
+    }
     if (!msg) {
+      jsvUnLock(port);
       networkFree(&net);
       return; // out of memory
     }
-    jsvAppendStringVar(msg, buffer, (size_t)from, (size_t)count);
     address = jsvGetArrayItem(args, 1);
   } else {
     jsvUnLock(port);
@@ -540,6 +556,29 @@ void jswrap_dgram_socket_send(JsVar *parent, JsVar *buffer, JsVar *offset, JsVar
 The 'message' event is called when a datagram message is received. If a handler
 is defined with `X.on('message', function(msg) { ... })` then it will be called
 */
+/*JSON{
+  "type" : "event",
+  "class" : "dgramSocket",
+  "name" : "messages",
+  "params" : [
+    ["data","JsVar","An ArrayBuffer containing the data from all the received messages, one after the other"],
+    ["info","JsVar","A Uint32Array with 4 elements for each message: offset in `data`, length, sender address (first byte of the IP in the lowest 8 bits) and sender port"]
+  ]
+}
+If the socket was created with the `batch:true` option, this is called instead
+of `message` with all the messages that were received at once. This uses far
+less memory and time than a `message` event per packet when lots of small
+packets are arriving.
+
+```
+sckt.on('messages', function(data, info) {
+  for (var i=0;i<info.length;i+=4) {
+    var msg = new Uint8Array(data, info[i], info[i+1]);
+    // ...
+  }
+});
+```
+*/
 
 /*JSON{
   "type" : "method",
@@ -586,7 +625,7 @@ void jswrap_dgram_close(JsVar *parent) {
   "generate" : "jswrap_dgram_addMembership",
   "params" : [
     ["group","JsVar","A string containing the group ip to join"],
-    ["ip","JsVar","A string containing the ip to join with"]
+    ["ip","JsVar","[optional] A string containing the ip of the interface to join with"]
   ]
 }
 */
@@ -595,6 +634,7 @@ void jswrap_dgram_addMembership(JsVar *parent, JsVar *group, JsVar *ip) {
   if (!networkGetFromVarIfOnline(&net)) return;
 
   serverAddMembership(&net, parent, group, ip);
+  networkFree(&net);
 }
 
 /*JSON{
@@ -11,8 +11,12 @@
  * Implementation of JsNetwork for Linux
  * ----------------------------------------------------------------------------
  */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // for recvmmsg/sendmmsg
+#endif
 #include "network.h"
 #include "network_linux.h"
+#include "jshardware_linux.h"
 
 #include <string.h> // for memset
 
@@ -31,6 +35,7 @@
   #include <resolv.h>
  #endif
  #include <sys/socket.h>
+ #include <sys/uio.h>
  #include <netdb.h>
  #include <unistd.h>
  #include <fcntl.h>
@@ -41,6 +46,14 @@
 #endif
 
 #define closesocket(SOCK) close(SOCK)
+#ifndef MSG_DONTWAIT
+#define MSG_DONTWAIT 0
+#endif
+
+#if defined(__linux__) && !defined(WIN32)
+#define NET_LINUX_MMSG // we can send/receive several UDP packets with one call
+#define NET_LINUX_MMSG_MAX 16 // most UDP packets to receive in one call
+#endif
 
 #if NET_DBG > 0
  #include "jsinteractive.h"
@@ -61,6 +74,8 @@ void net_linux_gethostbyname(JsNetwork *net, char * hostName, uint32_t* out_ip_a
 /// Called on idle. Do any checks required for this device
 void net_linux_idle(JsNetwork *net) {
   NOT_USED(net);
+  // find out which sockets are ready in one go, so recv/accept only touch those
+  jshLinuxWaitFds(0);
 }
 
 /// Call just before returning to idle loop. This checks for errors and tries to recover. Returns true if no errors.
@@ -70,6 +85,16 @@ bool net_linux_checkError(JsNetwork *net) {
   return hadErrors;
 }
 
+/// Join a multicast group on an existing UDP socket. ip is the interface to use (0 = any)
+void net_linux_addmembership(JsNetwork *net, int sckt, uint32_t group, uint32_t ip) {
+  NOT_USED(net);
+  struct ip_mreq mreq;
+  mreq.imr_multiaddr = *(struct in_addr *)&group;
+  mreq.imr_interface = *(struct in_addr *)&ip;
+  if (setsockopt(sckt, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char *)&mreq, sizeof(mreq)) < 0)
+    jsWarn("setsockopt(IP_ADD_MEMBERSHIP) failed\n");
+}
+
 /// if host=0, creates a server otherwise creates a client (and automatically connects). Returns >=0 on success
 int net_linux_createsocket(JsNetwork *net, SocketType socketType, uint32_t host, unsigned short port, JsVar *options) {
   int ippProto = socketType & ST_UDP ? IPPROTO_UDP : IPPROTO_TCP;
@@ -151,13 +176,12 @@ int net_linux_createsocket(JsNetwork *net, SocketType socketType, uint32_t host,
       return -1;
     }
 
-    // multicast support
-    // FIXME: perhaps extend the JsNetwork with addmembership/removemembership instead of using options
+    // multicast support (if addMembership was called before the socket was bound)
     JsVar *mgrpVar = jsvObjectGetChildIfExists(options, "multicastGroup");
     if (mgrpVar) {
         char ipStr[18];
 
-        uint32_t grpip;
+        uint32_t grpip = 0;
         jsvGetString(mgrpVar, ipStr, sizeof(ipStr));
         jsvUnLock(mgrpVar);
         net_linux_gethostbyname(net, ipStr, &grpip);
@@ -165,13 +189,10 @@ int net_linux_createsocket(JsNetwork *net, SocketType socketType, uint32_t host,
         JsVar *ipVar = jsvObjectGetChildIfExists(options, "multicastIp");
         jsvGetString(ipVar, ipStr, sizeof(ipStr));
         jsvUnLock(ipVar);
-        uint32_t ip;
+        uint32_t ip = 0;
         net_linux_gethostbyname(net, ipStr, &ip);
 
-        struct ip_mreq mreq;
-        mreq.imr_multiaddr = *(struct in_addr *)&grpip;
-        mreq.imr_interface = *(struct in_addr *)&ip;
-        setsockopt (sckt, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+        net_linux_addmembership(net, sckt, grpip, ip);
     }
 
     if (scktType == SOCK_STREAM) { // only for TCP
@@ -182,6 +203,10 @@ int net_linux_createsocket(JsNetwork *net, SocketType socketType, uint32_t host,
         closesocket(sckt);
         return -1;
       }
+#ifndef WIN32
+      // so accept won't block if the connection went away after we were told about it
+      fcntl(sckt, F_SETFL, fcntl(sckt, F_GETFL, 0) | O_NONBLOCK);
+#endif
     }
   }
 
@@ -199,12 +224,15 @@ int net_linux_createsocket(JsNetwork *net, SocketType socketType, uint32_t host,
     jsWarn("setsockopt(SO_NOSIGPIPE) failed\n");
 #endif
 
+  // wake up when there's data - and for TCP clients, when we're connected
+  jshLinuxWatchFd(sckt, JSH_LINUX_FD_READ | ((host && scktType==SOCK_STREAM) ? JSH_LINUX_FD_WRITE : 0));
   return sckt;
 }
 
 /// destroys the given socket
 void net_linux_closesocket(JsNetwork *net, int sckt) {
   NOT_USED(net);
+  jshLinuxWatchFd(sckt, 0);
   closesocket(sckt);
 }
 
@@ -212,44 +240,97 @@ void net_linux_closesocket(JsNetwork *net, int sckt) {
 int net_linux_accept(JsNetwork *net, int sckt) {
   NOT_USED(net);
   // TODO: look for unreffed servers?
-  fd_set s;
-  FD_ZERO(&s);
-  FD_SET(sckt,&s);
-  // check for waiting clients
-  struct timeval timeout;
-  timeout.tv_sec = 0;
-  timeout.tv_usec = 0;
-  int n = select(sckt+1,&s,NULL,NULL,&timeout);
+  int n = jshLinuxGetFdReady(sckt);
+  if (n<0) { // not watched, so check ourselves
+    fd_set s;
+    FD_ZERO(&s);
+    FD_SET(sckt,&s);
+    // check for waiting clients
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 0;
+    n = select(sckt+1,&s,NULL,NULL,&timeout);
+  }
   if (n>0) {
     // we have a client waiting to connect... try to connect and see what happens
     int theClient = accept(sckt,0,0);
+    if (theClient>=0)
+      jshLinuxWatchFd(theClient, JSH_LINUX_FD_READ);
     return theClient;
   }
   return -1;
 }
 
+#ifdef NET_LINUX_MMSG
+/** Receive as many UDP packets as we can with one call. Each is read into its own
+ * net->chunkSize slot of buf (like a single packet would be), then they're packed
+ * together, each with its JsNetUDPPacketHeader */
+static int net_linux_recvUDPBatch(JsNetwork *net, int sckt, char *buf, size_t len) {
+  size_t slot = (size_t)net->chunkSize;
+  unsigned int count = (unsigned int)(len / slot);
+  if (count > NET_LINUX_MMSG_MAX) count = NET_LINUX_MMSG_MAX;
+  struct mmsghdr msgs[NET_LINUX_MMSG_MAX];
+  struct iovec iov[NET_LINUX_MMSG_MAX];
+  struct sockaddr_in fromAddr[NET_LINUX_MMSG_MAX];
+  memset(msgs, 0, sizeof(msgs));
+  for (unsigned int i=0;i<count;i++) {
+    iov[i].iov_base = buf + i*slot + sizeof(JsNetUDPPacketHeader);
+    iov[i].iov_len = slot - sizeof(JsNetUDPPacketHeader);
+    msgs[i].msg_hdr.msg_iov = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_name = &fromAddr[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(fromAddr[i]);
+  }
+  int n = recvmmsg(sckt, msgs, count, MSG_DONTWAIT, NULL);
+  if (n<0) return (errno==EAGAIN || errno==EWOULDBLOCK) ? 0 : -1;
+  if (n==0) return -1; // select says data, but nothing there means the connection is closed
+  size_t pos = 0;
+  for (int i=0;i<n;i++) {
+    // pos is never after this slot, so moving the data down is safe
+    JsNetUDPPacketHeader header;
+    *(in_addr_t*)&header.host = fromAddr[i].sin_addr.s_addr;
+    header.port = ntohs(fromAddr[i].sin_port);
+    header.length = (uint16_t)msgs[i].msg_len;
+    memmove(buf + pos + sizeof(header), iov[i].iov_base, header.length);
+    memcpy(buf + pos, &header, sizeof(header));
+    pos += sizeof(header) + header.length;
+  }
+  DBG("Recv %d packets (%d bytes)", n, pos);
+  return (int)pos;
+}
+#endif
+
 /// Receive data if possible. returns nBytes on success, 0 on no data, or -1 on failure
 int net_linux_recv(JsNetwork *net, SocketType socketType, int sckt, void *buf, size_t len) {
-  NOT_USED(net);
   struct sockaddr_in fromAddr;
   int fromAddrLen = sizeof(fromAddr);
   int num = 0;
-  fd_set s;
-  FD_ZERO(&s);
-  FD_SET(sckt,&s);
-  // check for waiting clients
-  struct timeval timeout;
-  timeout.tv_sec = 0;
-  timeout.tv_usec = 0;
-  int n = select(sckt+1,&s,NULL,NULL,&timeout);
+  int n = jshLinuxGetFdReady(sckt);
+  if (n>=0) { // jshLinuxWaitFds has already told us if there's data
+    n &= JSH_LINUX_FD_READ;
+  } else { // not watched, so check ourselves
+    fd_set s;
+    FD_ZERO(&s);
+    FD_SET(sckt,&s);
+    // check for waiting clients
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 0;
+    n = select(sckt+1,&s,NULL,NULL,&timeout);
+  }
   if (n==SOCKET_ERROR) {
     // we probably disconnected
     return -1;
   } else if (n>0) {
     // receive data
     if (socketType & ST_UDP) {
+#ifdef NET_LINUX_MMSG
+      if (len >= 2*(size_t)net->chunkSize) // room for more than one packet
+        return net_linux_recvUDPBatch(net, sckt, buf, len);
+#endif
       JsNetUDPPacketHeader *header = (JsNetUDPPacketHeader*)buf;
-      num = (int)recvfrom(sckt,buf+sizeof(JsNetUDPPacketHeader),len-sizeof(JsNetUDPPacketHeader),0,(struct sockaddr *)&fromAddr,(socklen_t*)&fromAddrLen);
+      num = (int)recvfrom(sckt,buf+sizeof(JsNetUDPPacketHeader),len-sizeof(JsNetUDPPacketHeader),MSG_DONTWAIT,(struct sockaddr *)&fromAddr,(socklen_t*)&fromAddrLen);
+      if (num<0 && (errno==EAGAIN || errno==EWOULDBLOCK)) return 0; // nothing after all
       *(in_addr_t*)&header->host = fromAddr.sin_addr.s_addr;
       header->port = ntohs(fromAddr.sin_port);
       header->length = (uint16_t)num;
@@ -258,7 +339,8 @@ int net_linux_recv(JsNetwork *net, SocketType socketType, int sckt, void *buf, s
       if (num==0) return -1; // select says data, but recv says 0 means connection is closed
       num += sizeof(JsNetUDPPacketHeader);
     } else {
-      num = (int)recvfrom(sckt,buf,len,0,(struct sockaddr *)&fromAddr,(socklen_t*)&fromAddrLen);
+      num = (int)recvfrom(sckt,buf,len,MSG_DONTWAIT,(struct sockaddr *)&fromAddr,(socklen_t*)&fromAddrLen);
+      if (num<0 && (errno==EAGAIN || errno==EWOULDBLOCK)) return 0; // nothing after all
       if (num==0) return -1; // select says data, but recv says 0 means connection is closed
     }
   }
@@ -266,9 +348,8 @@ int net_linux_recv(JsNetwork *net, SocketType socketType, int sckt, void *buf, s
   return num;
 }
 
-/// Send data if possible. returns nBytes on success, 0 on no data, or -1 on failure
-int net_linux_send(JsNetwork *net, SocketType socketType, int sckt, const void *buf, size_t len) {
-  NOT_USED(net);
+/// Returns 1 if we can write to the socket, 0 if not (we'll be woken when we can), or -1 on error
+static int net_linux_canSend(int sckt) {
   fd_set writefds;
   FD_ZERO(&writefds);
   FD_SET(sckt, &writefds);
@@ -276,31 +357,98 @@ int net_linux_send(JsNetwork *net, SocketType socketType, int sckt, const void *
   time.tv_sec = 0;
   time.tv_usec = 0;
   int n = select(sckt+1, 0, &writefds, 0, &time);
-  if (n==SOCKET_ERROR ) {
-     // we probably disconnected so just get rid of this
-    return -1;
-  } else if (FD_ISSET(sckt, &writefds)) {
-    int flags = 0;
+  if (n==SOCKET_ERROR) return -1;
+  if (FD_ISSET(sckt, &writefds)) return 1;
+  jshLinuxWatchFdWrite(sckt); // wake us when we can send
+  return 0;
+}
+
+static int net_linux_sendFlags() {
+  int flags = 0;
 #if !defined(SO_NOSIGPIPE) && defined(MSG_NOSIGNAL)
-    flags |= MSG_NOSIGNAL;
+  flags |= MSG_NOSIGNAL;
 #endif
-    if (socketType & ST_UDP) {
-      JsNetUDPPacketHeader *header = (JsNetUDPPacketHeader*)buf;
-      sockaddr_in sin;
-      sin.sin_family = AF_INET;
-      sin.sin_addr.s_addr = *(in_addr_t*)&header->host;
-      sin.sin_port = htons(header->port);
+  return flags;
+}
 
-      DBG("Send %d %x:%d", len - sizeof(JsNetUDPPacketHeader), header->host, header->port);
-      n = (int)sendto(sckt, buf + sizeof(JsNetUDPPacketHeader), header->length, flags, (struct sockaddr *)&sin, sizeof(sockaddr_in));
-      n += sizeof(JsNetUDPPacketHeader);
-    } else {
-      n = (int)send(sckt, buf, len, flags);
+/// Send data if possible. returns nBytes on success, 0 on no data, or -1 on failure
+int net_linux_send(JsNetwork *net, SocketType socketType, int sckt, const void *buf, size_t len) {
+  NOT_USED(net);
+  int n = net_linux_canSend(sckt);
+  if (n<=0) return n; // we probably disconnected, or just not ready
+  int flags = net_linux_sendFlags();
+  if (socketType & ST_UDP) {
+    JsNetUDPPacketHeader *header = (JsNetUDPPacketHeader*)buf;
+    sockaddr_in sin;
+    sin.sin_family = AF_INET;
+    sin.sin_addr.s_addr = *(in_addr_t*)&header->host;
+    sin.sin_port = htons(header->port);
+
+    DBG("Send %d %x:%d", len - sizeof(JsNetUDPPacketHeader), header->host, header->port);
+    n = (int)sendto(sckt, buf + sizeof(JsNetUDPPacketHeader), header->length, flags, (struct sockaddr *)&sin, sizeof(sockaddr_in));
+    n += sizeof(JsNetUDPPacketHeader);
+  } else {
+    n = (int)send(sckt, buf, len, flags);
+    if (n>=0 && (size_t)n<len)
+      jshLinuxWatchFdWrite(sckt); // wake us when we can send the rest
+  }
+  return n;
+}
+
+#ifndef WIN32
+/** Send several buffers with one call. returns nBytes on success, 0 on no data, or -1 on failure.
+ * For UDP each buffer is a whole packet, and we return the total size of the packets that were sent */
+int net_linux_sendv(JsNetwork *net, SocketType socketType, int sckt, const JsNetSendBuf *bufs, int count) {
+  int n = net_linux_canSend(sckt);
+  if (n<=0) return n; // we probably disconnected, or just not ready
+  if (socketType & ST_UDP) {
+#ifdef NET_LINUX_MMSG
+    struct mmsghdr msgs[count];
+    struct iovec iov[count];
+    sockaddr_in sin[count];
+    memset(msgs, 0, sizeof(msgs));
+    for (int i=0;i<count;i++) {
+      const JsNetUDPPacketHeader *header = (const JsNetUDPPacketHeader*)bufs[i].buf;
+      sin[i].sin_family = AF_INET;
+      sin[i].sin_addr.s_addr = *(in_addr_t*)&header->host;
+      sin[i].sin_port = htons(header->port);
+      iov[i].iov_base = (void*)((const char*)bufs[i].buf + sizeof(JsNetUDPPacketHeader));
+      iov[i].iov_len = header->length;
+      msgs[i].msg_hdr.msg_iov = &iov[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = &sin[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(sin[i]);
     }
-    return n;
-  } else
-    return 0; // just not ready
+    n = sendmmsg(sckt, msgs, (unsigned int)count, net_linux_sendFlags());
+    if (n<0) return (errno==EAGAIN || errno==EWOULDBLOCK) ? 0 : -1;
+    DBG("Send %d of %d packets", n, count);
+    size_t sent = 0;
+    for (int i=0;i<n;i++) sent += bufs[i].len;
+    if (n<count)
+      jshLinuxWatchFdWrite(sckt); // wake us when we can send the rest
+    return (int)sent;
+#else
+    return net_linux_send(net, socketType, sckt, bufs[0].buf, bufs[0].len);
+#endif
+  }
+  NOT_USED(net);
+  struct iovec iov[count];
+  size_t len = 0;
+  for (int i=0;i<count;i++) {
+    iov[i].iov_base = (void*)bufs[i].buf;
+    iov[i].iov_len = bufs[i].len;
+    len += bufs[i].len;
+  }
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = (size_t)count;
+  n = (int)sendmsg(sckt, &msg, net_linux_sendFlags());
+  if (n>=0 && (size_t)n<len)
+    jshLinuxWatchFdWrite(sckt); // wake us when we can send the rest
+  return n;
 }
+#endif
 
 void netSetCallbacks_linux(JsNetwork *net) {
   net->idle = net_linux_idle;
@@ -311,5 +459,9 @@ void netSetCallbacks_linux(JsNetwork *net) {
   net->gethostbyname = net_linux_gethostbyname;
   net->recv = net_linux_recv;
   net->send = net_linux_send;
+#ifndef WIN32
+  net->sendv = net_linux_sendv;
+#endif
+  net->addmembership = net_linux_addmembership;
   net->chunkSize = 536;
 }
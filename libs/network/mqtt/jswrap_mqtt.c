@@ -0,0 +1,835 @@
+/*
+ * This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+ *
+ * Copyright (C) 2013 Gordon Williams <gw@pur3.co.uk>
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * ----------------------------------------------------------------------------
+ * This file is designed to be parsed during the build process
+ *
+ * Contains a native MQTT 3.1.1 client
+ * ----------------------------------------------------------------------------
+ */
+#include "jswrap_mqtt.h"
+#include "jswrap_net.h"
+#include "jswrap_interactive.h"
+#include "jsvariterator.h"
+#include "jsinteractive.h"
+#include "jsparse.h"
+#include "jswrapper.h"
+#include "jshardware.h"
+#include "jsflash.h"
+#include "socketserver.h"
+
+/* The client uses a normal 'net' Socket for its connection, with native
+ * functions (bound to the client) as the Socket's data/close/error
+ * listeners. PUBLISH packets that haven't been sent yet (because we're
+ * offline) or that are QoS 1 and haven't been acknowledged are kept, fully
+ * encoded, in MQTT_NAME_QUEUE - and optionally in a file in Storage, which is
+ * just those packets one after the other. */
+
+#define MQTT_NAME_OPTIONS "opt"
+#define MQTT_NAME_SERVER "svr"
+#define MQTT_NAME_SOCKET "sckt"
+#define MQTT_NAME_RECEIVE_DATA "dRcv"
+#define MQTT_NAME_QUEUE "q"           // PUBLISH packets waiting to be sent/acknowledged
+#define MQTT_NAME_PACKET_ID "pid"     // the last packet id we used
+#define MQTT_NAME_LAST_SENT "tSnd"    // time (ms) we last sent a packet
+#define MQTT_NAME_PING "tPng"         // time (ms) we sent a PINGREQ that hasn't been answered yet
+#define MQTT_NAME_TIMER "tmr"         // keepalive interval
+#define MQTT_NAME_DISCONNECTING "dis" // disconnect() was called, so don't reconnect
+#define MQTT_NAME_CONNECTED "connected"
+
+#define MQTT_DEFAULT_PORT 1883
+#define MQTT_DEFAULT_KEEPALIVE 60 // seconds
+
+typedef enum {
+  MQTT_CONNECT = 1,
+  MQTT_CONNACK = 2,
+  MQTT_PUBLISH = 3,
+  MQTT_PUBACK = 4,
+  MQTT_PUBREC = 5,
+  MQTT_PUBREL = 6,
+  MQTT_PUBCOMP = 7,
+  MQTT_SUBSCRIBE = 8,
+  MQTT_SUBACK = 9,
+  MQTT_UNSUBSCRIBE = 10,
+  MQTT_UNSUBACK = 11,
+  MQTT_PINGREQ = 12,
+  MQTT_PINGRESP = 13,
+  MQTT_DISCONNECT = 14,
+} MQTTPacketType;
+
+#define MQTT_FLAG_DUP 0x08 // in the first byte of a PUBLISH packet
+#define MQTT_HEADER_INVALID ((size_t)-1) // returned by mqttGetHeader if the 'remaining length' is more than 4 bytes
+
+/*JSON{
+  "type" : "library",
+  "class" : "MQTT",
+  "ifdef" : "USE_MQTT"
+}
+(2v27+) A native MQTT 3.1.1 client, compatible with the
+[MQTT module](https://www.espruino.com/MQTT).
+
+```
+var mqtt = require("MQTT").create("192.168.1.10", {
+  client_id : "espruino",
+  queue : "mqttq", // keep unsent messages in Storage
+  reconnect : 5000 // reconnect 5s after the connection drops
+});
+mqtt.on('connected', function() {
+  mqtt.subscribe("test");
+});
+mqtt.on('message', function(topic, message) {
+  console.log(topic, message);
+});
+mqtt.connect();
+mqtt.publish("test", "Hello", {qos:1});
+```
+
+Messages published with QoS 1 are kept until the server acknowledges them,
+and are sent again if the connection drops first. Messages published while
+there's no connection are sent once connected.
+*/
+/*JSON{
+  "type" : "class",
+  "library" : "MQTT",
+  "class" : "MQTTClient",
+  "ifdef" : "USE_MQTT"
+}
+An MQTT client, created with `require("MQTT").create`
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "MQTTClient",
+  "name" : "connected",
+  "ifdef" : "USE_MQTT"
+}
+Called when the connection to the server has been made and accepted
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "MQTTClient",
+  "name" : "disconnected",
+  "ifdef" : "USE_MQTT"
+}
+Called when the connection to the server closes
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "MQTTClient",
+  "name" : "publish",
+  "params" : [
+    ["msg","JsVar","An object containing `topic`, `message`, `dup`, `qos` and `retain`"]
+  ],
+  "ifdef" : "USE_MQTT"
+}
+Called when a message is received for a topic we subscribed to
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "MQTTClient",
+  "name" : "message",
+  "params" : [
+    ["topic","JsVar","The topic"],
+    ["message","JsVar","The message, as a String"]
+  ],
+  "ifdef" : "USE_MQTT"
+}
+Called when a message is received for a topic we subscribed to
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "MQTTClient",
+  "name" : "subscribed",
+  "ifdef" : "USE_MQTT"
+}
+Called when the server accepts a subscription (`subscribed_fail` is called if it doesn't)
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "MQTTClient",
+  "name" : "unsubscribed",
+  "ifdef" : "USE_MQTT"
+}
+Called when the server has removed a subscription
+*/
+/*JSON{
+  "type" : "event",
+  "class" : "MQTTClient",
+  "name" : "error",
+  "params" : [
+    ["details","JsVar","An error object, or a String describing why the server refused the connection"]
+  ],
+  "ifdef" : "USE_MQTT"
+}
+Called if there's a problem with the connection
+*/
+
+// -----------------------------
+
+static JsVarFloat mqttGetTime() {
+  return jshGetMillisecondsFromTime(jshGetSystemTime());
+}
+
+static JsVar *mqttNewCallback(JsVar *mqtt, void (*fn)(void), unsigned short argTypes) {
+  JsVar *f = jsvNewNativeFunction(fn, argTypes);
+  if (f) jsvObjectSetChild(f, JSPARSE_FUNCTION_THIS_NAME, mqtt); // bind 'this'
+  return f;
+}
+
+static void mqttAppendU16(JsVar *str, int value) {
+  char buf[2] = { (char)(value>>8), (char)value };
+  jsvAppendStringBuf(str, buf, 2);
+}
+
+/// Append a length-prefixed string
+static void mqttAppendString(JsVar *str, JsVar *value) {
+  JsVar *s = jsvAsString(value);
+  mqttAppendU16(str, (int)jsvGetStringLength(s));
+  jsvAppendStringVarComplete(str, s);
+  jsvUnLock(s);
+}
+
+/// Append data - binary data (eg. ArrayBuffers) is added as-is, anything else is converted to a String
+static void mqttAppendData(JsVar *str, JsVar *data) {
+  if (jsvIsIterable(data) && !jsvIsString(data)) {
+    JSV_GET_AS_CHAR_ARRAY(ptr, len, data);
+    if (ptr) jsvAppendStringBuf(str, ptr, len);
+  } else if (data) {
+    JsVar *s = jsvAsString(data);
+    jsvAppendStringVarComplete(str, s);
+    jsvUnLock(s);
+  }
+}
+
+/// Wrap body up in a packet with the given first byte (type and flags)
+static JsVar *mqttNewPacket(int typeAndFlags, JsVar *body) {
+  size_t len = body ? jsvGetStringLength(body) : 0;
+  char header[5];
+  size_t headerLen = 0;
+  header[headerLen++] = (char)typeAndFlags;
+  do { // 'remaining length' is 7 bits per byte, least significant first
+    header[headerLen] = (char)(len & 127);
+    len >>= 7;
+    if (len) header[headerLen] |= (char)128;
+    headerLen++;
+  } while (len && headerLen<sizeof(header));
+  JsVar *packet = jsvNewStringOfLength((unsigned int)headerLen, header);
+  if (packet && body) jsvAppendStringVarComplete(packet, body);
+  return packet;
+}
+
+/** Decode the fixed header of the packet starting at pos. Returns the header's
+ * length and sets *remaining, returns 0 if we don't have all of it yet, or
+ * MQTT_HEADER_INVALID if the 'remaining length' doesn't end after 4 bytes */
+static size_t mqttGetHeader(JsVar *data, size_t pos, size_t *remaining) {
+  unsigned char buf[5];
+  size_t len = jsvGetStringChars(data, pos, (char*)buf, sizeof(buf));
+  *remaining = 0;
+  for (size_t i=1;i<len;i++) {
+    *remaining |= (size_t)(buf[i]&127) << (7*(i-1));
+    if (!(buf[i]&128)) return i+1;
+  }
+  return (len==sizeof(buf)) ? MQTT_HEADER_INVALID : 0;
+}
+
+static int mqttGetU16(JsVar *data, size_t pos) {
+  unsigned char buf[2];
+  if (jsvGetStringChars(data, pos, (char*)buf, 2)<2) return 0;
+  return (buf[0]<<8) | buf[1];
+}
+
+/// Get the QoS of a PUBLISH packet
+static int mqttGetPublishQoS(JsVar *packet) {
+  return (jsvGetCharInString(packet, 0)>>1) & 3;
+}
+
+/// Get the packet id of a PUBLISH packet (or 0 for QoS 0)
+static int mqttGetPublishId(JsVar *packet) {
+  if (!mqttGetPublishQoS(packet)) return 0;
+  size_t remaining;
+  size_t pos = mqttGetHeader(packet, 0, &remaining);
+  pos += 2 + (size_t)mqttGetU16(packet, pos); // skip topic
+  return mqttGetU16(packet, pos);
+}
+
+/// Get the next packet id, skipping any still used by messages in the queue (waiting to be acknowledged)
+static int mqttNewPacketId(JsVar *mqtt) {
+  int id = (int)jsvObjectGetIntegerChild(mqtt, MQTT_NAME_PACKET_ID);
+  JsVar *queue = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_QUEUE);
+  bool used;
+  int tries = 0;
+  do {
+    id++;
+    if (id > 0xFFFF) id = 1;
+    used = false;
+    JsvObjectIterator it;
+    jsvObjectIteratorNew(&it, queue);
+    while (!used && jsvObjectIteratorHasValue(&it)) {
+      JsVar *packet = jsvObjectIteratorGetValue(&it);
+      used = mqttGetPublishId(packet)==id;
+      jsvUnLock(packet);
+      jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+  } while (used && ++tries<0xFFFF);
+  jsvUnLock(queue);
+  jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_PACKET_ID, jsvNewFromInteger(id));
+  return id;
+}
+
+// -----------------------------
+
+/// Write the queue to Storage (if the 'queue' option was given)
+static void mqttSaveQueue(JsVar *mqtt) {
+  JsVar *options = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_OPTIONS);
+  JsVar *fileName = jsvObjectGetChildIfExists(options, "queue");
+  jsvUnLock(options);
+  if (!jsvIsString(fileName)) {
+    jsvUnLock(fileName);
+    return;
+  }
+  JsfFileName name = jsfNameFromVarAndUnLock(fileName);
+  JsVar *queue = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_QUEUE);
+  JsVar *data = (!queue || jsvArrayIsEmpty(queue)) ? 0 : jsvArrayJoin(queue, 0, false);
+  if (data) jsfWriteFile(name, data, JSFF_NONE, 0, 0);
+  else jsfEraseFile(name);
+  jsvUnLock2(data, queue);
+}
+
+/// Load the queue from Storage (if the 'queue' option was given)
+static void mqttLoadQueue(JsVar *mqtt, JsVar *options) {
+  JsVar *fileName = jsvObjectGetChildIfExists(options, "queue");
+  JsVar *data = jsvIsString(fileName) ? jsfReadFile(jsfNameFromVar(fileName), 0, 0) : 0;
+  jsvUnLock(fileName);
+  if (!data) return;
+  JsVar *queue = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_QUEUE);
+  size_t len = jsvGetStringLength(data);
+  size_t pos = 0, remaining, headerLen;
+  int lastId = 0;
+  while (queue && (headerLen = mqttGetHeader(data, pos, &remaining)) && headerLen!=MQTT_HEADER_INVALID && pos+headerLen+remaining<=len) {
+    JsVar *packet = jsvNewFromStringVar(data, pos, headerLen+remaining);
+    if (!packet) break;
+    // QoS 1 messages may have been sent already, so mark them as duplicates
+    if (mqttGetPublishQoS(packet)) jsvSetCharInString(packet, 0, MQTT_FLAG_DUP, true);
+    int id = mqttGetPublishId(packet);
+    if (id > lastId) lastId = id;
+    jsvArrayPush(queue, packet);
+    jsvUnLock(packet);
+    pos += headerLen+remaining;
+  }
+  jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_PACKET_ID, jsvNewFromInteger(lastId));
+  jsvUnLock2(queue, data);
+}
+
+// -----------------------------
+
+static bool mqttIsConnected(JsVar *mqtt) {
+  return jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(mqtt, MQTT_NAME_CONNECTED));
+}
+
+static void mqttSend(JsVar *mqtt, JsVar *packet) {
+  JsVar *socket = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_SOCKET);
+  if (socket && packet) {
+    jswrap_net_socket_write(socket, packet);
+    jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_LAST_SENT, jsvNewFromFloat(mqttGetTime()));
+  }
+  jsvUnLock(socket);
+}
+
+/// Send a packet that's just a first byte and (optionally) a packet id
+static void mqttSendSimple(JsVar *mqtt, int typeAndFlags, int packetId) {
+  JsVar *body = 0;
+  if (packetId) {
+    body = jsvNewFromEmptyString();
+    if (body) mqttAppendU16(body, packetId);
+  }
+  JsVar *packet = mqttNewPacket(typeAndFlags, body);
+  mqttSend(mqtt, packet);
+  jsvUnLock2(packet, body);
+}
+
+/// Send everything in the queue. QoS 0 messages are removed, QoS 1 ones stay until they're acknowledged
+static void mqttSendQueue(JsVar *mqtt) {
+  JsVar *queue = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_QUEUE);
+  bool removed = false;
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, queue);
+  while (jsvObjectIteratorHasValue(&it)) {
+    JsVar *packet = jsvObjectIteratorGetValue(&it);
+    mqttSend(mqtt, packet);
+    if (!mqttGetPublishQoS(packet)) {
+      jsvObjectIteratorRemoveAndGotoNext(&it, queue);
+      removed = true;
+    } else
+      jsvObjectIteratorNext(&it);
+    jsvUnLock(packet);
+  }
+  jsvObjectIteratorFree(&it);
+  jsvUnLock(queue);
+  if (removed) mqttSaveQueue(mqtt);
+}
+
+/// Remove the QoS 1 message with this id from the queue, once it has been acknowledged
+static void mqttAcknowledged(JsVar *mqtt, int packetId) {
+  JsVar *queue = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_QUEUE);
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, queue);
+  while (jsvObjectIteratorHasValue(&it)) {
+    JsVar *packet = jsvObjectIteratorGetValue(&it);
+    bool found = mqttGetPublishId(packet)==packetId;
+    jsvUnLock(packet);
+    if (found) {
+      jsvObjectIteratorRemoveAndGotoNext(&it, queue);
+      break;
+    }
+    jsvObjectIteratorNext(&it);
+  }
+  jsvObjectIteratorFree(&it);
+  // once everything is acknowledged, there's nothing to keep in Storage
+  if (queue && jsvArrayIsEmpty(queue)) mqttSaveQueue(mqtt);
+  jsvUnLock(queue);
+}
+
+static void mqttReceivedPublish(JsVar *mqtt, JsVar *data, size_t pos, size_t headerLen, size_t remaining) {
+  int flags = jsvGetCharInString(data, pos);
+  int qos = (flags>>1) & 3;
+  size_t end = pos+headerLen+remaining;
+  pos += headerLen;
+  size_t topicLen = (size_t)mqttGetU16(data, pos);
+  JsVar *topic = jsvNewFromStringVar(data, pos+2, topicLen);
+  pos += 2 + topicLen;
+  int packetId = 0;
+  if (qos) {
+    packetId = mqttGetU16(data, pos);
+    pos += 2;
+  }
+  JsVar *message = (pos<end) ? jsvNewFromStringVar(data, pos, end-pos) : jsvNewFromEmptyString();
+  JsVar *msg = jsvNewObject();
+  if (msg && topic && message) {
+    jsvObjectSetChild(msg, "topic", topic);
+    jsvObjectSetChild(msg, "message", message);
+    jsvObjectSetChildAndUnLock(msg, "dup", jsvNewFromBool((flags & MQTT_FLAG_DUP)!=0));
+    jsvObjectSetChildAndUnLock(msg, "qos", jsvNewFromInteger(qos));
+    jsvObjectSetChildAndUnLock(msg, "retain", jsvNewFromBool(flags & 1));
+    jsiQueueObjectCallbacks(mqtt, JS_EVENT_PREFIX"publish", &msg, 1);
+    JsVar *args[2] = { topic, message };
+    jsiQueueObjectCallbacks(mqtt, JS_EVENT_PREFIX"message", args, 2);
+  }
+  jsvUnLock3(msg, topic, message);
+  if (qos==1) mqttSendSimple(mqtt, MQTT_PUBACK<<4, packetId);
+  if (qos==2) mqttSendSimple(mqtt, MQTT_PUBREC<<4, packetId);
+}
+
+static void mqttReceivedPacket(JsVar *mqtt, JsVar *data, size_t pos, size_t headerLen, size_t remaining) {
+  int type = (jsvGetCharInString(data, pos)>>4) & 15;
+  size_t body = pos+headerLen;
+  if (type==MQTT_CONNACK) {
+    int returnCode = (int)(unsigned char)jsvGetCharInString(data, body+1);
+    if (returnCode) {
+      const char *reasons[] = { "unacceptable protocol version", "identifier rejected", "server unavailable",
+                                "bad user name or password", "not authorized" };
+      JsVar *reason = jsvNewFromString((returnCode<=5) ? reasons[returnCode-1] : "unknown");
+      jsiQueueObjectCallbacks(mqtt, JS_EVENT_PREFIX"error", &reason, 1);
+      jsvUnLock(reason);
+      JsVar *socket = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_SOCKET);
+      if (socket) jswrap_net_socket_end(socket, 0);
+      jsvUnLock(socket);
+      return;
+    }
+    jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_CONNECTED, jsvNewFromBool(true));
+    JsVar *options = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_OPTIONS);
+    JsVar *v = jsvObjectGetChildIfExists(options, "keep_alive");
+    JsVarFloat keepAlive = jsvIsUndefined(v) ? MQTT_DEFAULT_KEEPALIVE : jsvGetFloat(v);
+    jsvUnLock2(v, options);
+    if (keepAlive > 0) {
+      JsVar *fn = mqttNewCallback(mqtt, (void (*)(void))jswrap_mqtt_keepAlive, JSWAT_VOID|JSWAT_THIS_ARG);
+      if (fn) jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_TIMER, jswrap_interface_setInterval(fn, keepAlive*500, 0));
+      jsvUnLock(fn);
+    }
+    jsiQueueObjectCallbacks(mqtt, JS_EVENT_PREFIX"connected", 0, 0);
+    mqttSendQueue(mqtt);
+  } else if (type==MQTT_PUBLISH) {
+    mqttReceivedPublish(mqtt, data, pos, headerLen, remaining);
+  } else if (type==MQTT_PUBACK) {
+    mqttAcknowledged(mqtt, mqttGetU16(data, body));
+  } else if (type==MQTT_PUBREL) {
+    mqttSendSimple(mqtt, MQTT_PUBCOMP<<4, mqttGetU16(data, body));
+  } else if (type==MQTT_SUBACK) {
+    bool failed = false;
+    for (size_t i=2;i<remaining;i++)
+      if (jsvGetCharInString(data, body+i) & 0x80) failed = true;
+    jsiQueueObjectCallbacks(mqtt, failed ? JS_EVENT_PREFIX"subscribed_fail" : JS_EVENT_PREFIX"subscribed", 0, 0);
+  } else if (type==MQTT_UNSUBACK) {
+    jsiQueueObjectCallbacks(mqtt, JS_EVENT_PREFIX"unsubscribed", 0, 0);
+  } else if (type==MQTT_PINGRESP) {
+    jsvObjectRemoveChild(mqtt, MQTT_NAME_PING);
+  }
+}
+
+/// Socket 'data' listener (this = the MQTT client)
+void jswrap_mqtt_onData(JsVar *mqtt, JsVar *newData) {
+  JsVar *data = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_RECEIVE_DATA);
+  if (!data) data = jsvNewFromEmptyString();
+  if (!data) return;
+  jsvAppendStringVarComplete(data, newData);
+  // handle all complete packets, then remove them in one go
+  size_t len = jsvGetStringLength(data);
+  size_t pos = 0, remaining, headerLen;
+  while ((headerLen = mqttGetHeader(data, pos, &remaining))) {
+    /* A bad header, or a packet that's bigger than we could ever store (each
+     * free JsVar holds at most JSVAR_DATA_STRING_MAX_LEN chars) would just
+     * make us wait forever, filling memory - so give up on the connection */
+    size_t maxLen = (size_t)(jsvGetMemoryTotal()-jsvGetMemoryUsage()) * JSVAR_DATA_STRING_MAX_LEN;
+    if (headerLen==MQTT_HEADER_INVALID || remaining > maxLen) {
+      JsVar *reason = jsvNewFromString((headerLen==MQTT_HEADER_INVALID) ? "invalid packet header" : "packet too large");
+      jsiQueueObjectCallbacks(mqtt, JS_EVENT_PREFIX"error", &reason, 1);
+      jsvUnLock2(reason, data);
+      jsvObjectRemoveChild(mqtt, MQTT_NAME_RECEIVE_DATA);
+      JsVar *socket = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_SOCKET);
+      if (socket) jswrap_net_socket_end(socket, 0);
+      jsvUnLock(socket);
+      return;
+    }
+    if (pos+headerLen+remaining > len) break; // wait for the rest of the packet
+    mqttReceivedPacket(mqtt, data, pos, headerLen, remaining);
+    pos += headerLen+remaining;
+  }
+  if (pos) {
+    JsVar *newReceiveData = (pos<len) ? jsvNewFromStringVar(data, pos, JSVAPPENDSTRINGVAR_MAXLENGTH) : 0;
+    jsvUnLock(data);
+    data = newReceiveData;
+  }
+  jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_RECEIVE_DATA, data);
+}
+
+/// Socket 'close' listener (this = the MQTT client)
+void jswrap_mqtt_onClose(JsVar *mqtt) {
+  bool wasConnected = mqttIsConnected(mqtt);
+  jsvObjectRemoveChild(mqtt, MQTT_NAME_SOCKET);
+  jsvObjectRemoveChild(mqtt, MQTT_NAME_RECEIVE_DATA);
+  jsvObjectRemoveChild(mqtt, MQTT_NAME_PING);
+  jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_CONNECTED, jsvNewFromBool(false));
+  JsVar *timer = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_TIMER);
+  if (timer) jsiClearTimeout(timer);
+  jsvUnLock(timer);
+  jsvObjectRemoveChild(mqtt, MQTT_NAME_TIMER);
+  if (wasConnected) {
+    // any QoS 1 messages left may have been sent - mark them as duplicates and keep them for next time
+    JsVar *queue = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_QUEUE);
+    JsvObjectIterator it;
+    jsvObjectIteratorNew(&it, queue);
+    while (jsvObjectIteratorHasValue(&it)) {
+      JsVar *packet = jsvObjectIteratorGetValue(&it);
+      if (mqttGetPublishQoS(packet)) jsvSetCharInString(packet, 0, MQTT_FLAG_DUP, true);
+      jsvUnLock(packet);
+      jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+    jsvUnLock(queue);
+    mqttSaveQueue(mqtt);
+  }
+  jsiQueueObjectCallbacks(mqtt, JS_EVENT_PREFIX"disconnected", 0, 0);
+  // reconnect if we were asked to, and it wasn't because of disconnect()
+  JsVar *options = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_OPTIONS);
+  JsVarFloat reconnect = jsvObjectGetFloatChild(options, "reconnect");
+  jsvUnLock(options);
+  if (reconnect>0 && !jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(mqtt, MQTT_NAME_DISCONNECTING))) {
+    JsVar *fn = mqttNewCallback(mqtt, (void (*)(void))jswrap_mqtt_connect, JSWAT_VOID|JSWAT_THIS_ARG);
+    if (fn) jsvUnLock(jswrap_interface_setTimeout(fn, reconnect, 0));
+    jsvUnLock(fn);
+  }
+  jsvObjectRemoveChild(mqtt, MQTT_NAME_DISCONNECTING);
+}
+
+/// Socket 'error' listener (this = the MQTT client)
+void jswrap_mqtt_onError(JsVar *mqtt, JsVar *error) {
+  jsiQueueObjectCallbacks(mqtt, JS_EVENT_PREFIX"error", &error, 1);
+}
+
+/// Called every keep_alive/2 seconds while connected
+void jswrap_mqtt_keepAlive(JsVar *mqtt) {
+  JsVar *options = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_OPTIONS);
+  JsVar *v = jsvObjectGetChildIfExists(options, "keep_alive");
+  JsVarFloat keepAlive = (jsvIsUndefined(v) ? MQTT_DEFAULT_KEEPALIVE : jsvGetFloat(v)) * 1000;
+  jsvUnLock2(v, options);
+  JsVarFloat now = mqttGetTime();
+  JsVar *ping = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_PING);
+  if (ping) {
+    if (now - jsvGetFloat(ping) >= keepAlive) {
+      // no reply to our ping - the connection has gone
+      JsVar *socket = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_SOCKET);
+      if (socket) jswrap_net_socket_end(socket, 0);
+      jsvUnLock(socket);
+    }
+  } else if (now - jsvObjectGetFloatChild(mqtt, MQTT_NAME_LAST_SENT) >= keepAlive/2) {
+    mqttSendSimple(mqtt, MQTT_PINGREQ<<4, 0);
+    jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_PING, jsvNewFromFloat(now));
+  }
+  jsvUnLock(ping);
+}
+
+// -----------------------------
+
+/*JSON{
+  "type" : "staticmethod",
+  "class" : "MQTT",
+  "name" : "create",
+  "generate" : "jswrap_mqtt_create",
+  "params" : [
+    ["server","JsVar","The host name or IP address of the server"],
+    ["options","JsVar","(optional) An object of options - see below"]
+  ],
+  "return" : ["JsVar","A new MQTTClient"],
+  "return_object" : "MQTTClient",
+  "ifdef" : "USE_MQTT"
+}
+Create an MQTT client. `options` can contain:
+
+```
+{
+  client_id : "",         // the client identifier
+  keep_alive : 60,        // keepalive interval in seconds (0 = none)
+  port : 1883,            // the server's port
+  clean_session : true,   // start a new session each time we connect
+  username : undefined,   // (optional) user name
+  password : undefined,   // (optional) password
+  protocol_name : "MQTT",
+  protocol_level : 4,     // MQTT 3.1.1
+  queue : undefined,      // (optional) file in Storage used to keep unsent messages across reboots
+  reconnect : 0,          // if nonzero, reconnect this many ms after the connection drops
+}
+```
+
+If `queue` is set, messages that are waiting to be sent are also written to
+that file in Storage, and are loaded from it when the client is created. The
+file is written when messages are published while offline, when the
+connection drops, and when everything sent has been acknowledged, so QoS 1
+messages sent while connected but not yet acknowledged may be lost if the
+device reboots.
+*/
+JsVar *jswrap_mqtt_create(JsVar *server, JsVar *options) {
+  if (!jsvIsString(server)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting server to be a String, got %t", server);
+    return 0;
+  }
+  if (!jsvIsUndefined(options) && !jsvIsObject(options)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting options to be an Object, got %t", options);
+    return 0;
+  }
+  JsVar *mqtt = jspNewObject(0, "MQTTClient");
+  JsVar *queue = jsvNewEmptyArray();
+  if (mqtt && queue) {
+    jsvObjectSetChild(mqtt, MQTT_NAME_SERVER, server);
+    if (options) jsvObjectSetChild(mqtt, MQTT_NAME_OPTIONS, options);
+    jsvObjectSetChild(mqtt, MQTT_NAME_QUEUE, queue);
+    jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_CONNECTED, jsvNewFromBool(false));
+    mqttLoadQueue(mqtt, options);
+  }
+  jsvUnLock(queue);
+  return mqtt;
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "MQTTClient",
+  "name" : "connect",
+  "generate" : "jswrap_mqtt_connect",
+  "ifdef" : "USE_MQTT"
+}
+Connect to the server. `connected` is emitted once the server accepts the connection.
+*/
+void jswrap_mqtt_connect(JsVar *mqtt) {
+  JsVar *socket = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_SOCKET);
+  jsvUnLock(socket);
+  if (socket) return; // already connected/connecting
+  JsVar *options = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_OPTIONS);
+  // the socket
+  JsVar *socketOptions = jsvNewObject();
+  if (!socketOptions) {
+    jsvUnLock(options);
+    return;
+  }
+  jsvObjectSetChildAndUnLock(socketOptions, "host", jsvObjectGetChildIfExists(mqtt, MQTT_NAME_SERVER));
+  JsVar *port = jsvObjectGetChildIfExists(options, "port");
+  jsvObjectSetChildAndUnLock(socketOptions, "port", port ? port : jsvNewFromInteger(MQTT_DEFAULT_PORT));
+  socket = jswrap_net_connect(socketOptions, 0, ST_NORMAL);
+  jsvUnLock(socketOptions);
+  if (!socket) {
+    jsvUnLock(options);
+    return;
+  }
+  jsvObjectSetChild(mqtt, MQTT_NAME_SOCKET, socket);
+  jsvObjectSetChildAndUnLock(socket, JS_EVENT_PREFIX"data",
+      mqttNewCallback(mqtt, (void (*)(void))jswrap_mqtt_onData, JSWAT_VOID|JSWAT_THIS_ARG|(JSWAT_JSVAR<<JSWAT_BITS)));
+  jsvObjectSetChildAndUnLock(socket, JS_EVENT_PREFIX"close",
+      mqttNewCallback(mqtt, (void (*)(void))jswrap_mqtt_onClose, JSWAT_VOID|JSWAT_THIS_ARG));
+  jsvObjectSetChildAndUnLock(socket, JS_EVENT_PREFIX"error",
+      mqttNewCallback(mqtt, (void (*)(void))jswrap_mqtt_onError, JSWAT_VOID|JSWAT_THIS_ARG|(JSWAT_JSVAR<<JSWAT_BITS)));
+  jsvUnLock(socket);
+  // the CONNECT packet
+  JsVar *body = jsvNewFromEmptyString();
+  if (body) {
+    JsVar *v = jsvObjectGetChildIfExists(options, "protocol_name");
+    if (v) mqttAppendString(body, v);
+    else jsvAppendStringBuf(body, "\0\4MQTT", 6);
+    jsvUnLock(v);
+    v = jsvObjectGetChildIfExists(options, "protocol_level");
+    char level = (char)(v ? jsvGetInteger(v) : 4);
+    jsvUnLock(v);
+    JsVar *clientId = jsvObjectGetChildIfExists(options, "client_id");
+    JsVar *username = jsvObjectGetChildIfExists(options, "username");
+    JsVar *password = jsvObjectGetChildIfExists(options, "password");
+    v = jsvObjectGetChildIfExists(options, "clean_session");
+    bool cleanSession = v ? jsvGetBool(v) : true;
+    jsvUnLock(v);
+    v = jsvObjectGetChildIfExists(options, "keep_alive");
+    int keepAlive = v ? (int)jsvGetInteger(v) : MQTT_DEFAULT_KEEPALIVE;
+    jsvUnLock(v);
+    char flags = (char)((username ? 0x80 : 0) | (password ? 0x40 : 0) | (cleanSession ? 0x02 : 0));
+    char buf[2] = { level, flags };
+    jsvAppendStringBuf(body, buf, 2);
+    mqttAppendU16(body, keepAlive);
+    if (clientId) mqttAppendString(body, clientId);
+    else mqttAppendU16(body, 0);
+    if (username) mqttAppendString(body, username);
+    if (password) mqttAppendString(body, password);
+    jsvUnLock3(clientId, username, password);
+    JsVar *packet = mqttNewPacket(MQTT_CONNECT<<4, body);
+    mqttSend(mqtt, packet);
+    jsvUnLock2(packet, body);
+  }
+  jsvUnLock(options);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "MQTTClient",
+  "name" : "disconnect",
+  "generate" : "jswrap_mqtt_disconnect",
+  "ifdef" : "USE_MQTT"
+}
+Disconnect from the server (without reconnecting)
+*/
+void jswrap_mqtt_disconnect(JsVar *mqtt) {
+  JsVar *socket = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_SOCKET);
+  if (socket) {
+    jsvObjectSetChildAndUnLock(mqtt, MQTT_NAME_DISCONNECTING, jsvNewFromBool(true));
+    if (mqttIsConnected(mqtt)) mqttSendSimple(mqtt, MQTT_DISCONNECT<<4, 0);
+    jswrap_net_socket_end(socket, 0);
+  }
+  jsvUnLock(socket);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "MQTTClient",
+  "name" : "publish",
+  "generate" : "jswrap_mqtt_publish",
+  "params" : [
+    ["topic","JsVar","The topic to publish to"],
+    ["message","JsVar","The message - a String, or binary data such as an ArrayBuffer"],
+    ["options","JsVar","(optional) An object containing `qos` (0 or 1) and `retain`"]
+  ],
+  "ifdef" : "USE_MQTT"
+}
+Publish a message. If we're not connected, the message is sent once we are.
+QoS 1 messages are sent again after a reconnect if the server hasn't
+acknowledged them.
+*/
+void jswrap_mqtt_publish(JsVar *mqtt, JsVar *topic, JsVar *message, JsVar *options) {
+  int qos = (int)jsvObjectGetIntegerChild(options, "qos");
+  if (qos > 1) qos = 1; // we don't do QoS 2 for messages we send
+  bool retain = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(options, "retain"));
+  JsVar *body = jsvNewFromEmptyString();
+  if (!body) return;
+  mqttAppendString(body, topic);
+  if (qos) mqttAppendU16(body, mqttNewPacketId(mqtt));
+  mqttAppendData(body, message);
+  JsVar *packet = mqttNewPacket((MQTT_PUBLISH<<4) | (qos<<1) | (retain?1:0), body);
+  jsvUnLock(body);
+  if (!packet) return;
+  bool connected = mqttIsConnected(mqtt);
+  if (connected) mqttSend(mqtt, packet);
+  if (!connected || qos) {
+    JsVar *queue = jsvObjectGetChildIfExists(mqtt, MQTT_NAME_QUEUE);
+    if (queue) jsvArrayPush(queue, packet);
+    jsvUnLock(queue);
+    if (!connected) mqttSaveQueue(mqtt);
+  }
+  jsvUnLock(packet);
+}
+
+/// Send a SUBSCRIBE or UNSUBSCRIBE packet. topics can be a String, an Array of them, or an object of {topic:qos}
+static void mqttSubscribe(JsVar *mqtt, MQTTPacketType type, JsVar *topics, int qos) {
+  if (!mqttIsConnected(mqtt)) {
+    jsExceptionHere(JSET_ERROR, "MQTT not connected");
+    return;
+  }
+  JsVar *body = jsvNewFromEmptyString();
+  if (!body) return;
+  mqttAppendU16(body, mqttNewPacketId(mqtt));
+  bool isObject = jsvIsObject(topics);
+  JsvObjectIterator it;
+  if (isObject || jsvIsArray(topics)) {
+    jsvObjectIteratorNew(&it, topics);
+    while (jsvObjectIteratorHasValue(&it)) {
+      JsVar *topic = isObject ? jsvObjectIteratorGetKey(&it) : jsvObjectIteratorGetValue(&it);
+      mqttAppendString(body, topic);
+      jsvUnLock(topic);
+      if (type==MQTT_SUBSCRIBE) {
+        char q = (char)(isObject ? jsvGetIntegerAndUnLock(jsvObjectIteratorGetValue(&it)) : qos);
+        jsvAppendStringBuf(body, &q, 1);
+      }
+      jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+  } else {
+    mqttAppendString(body, topics);
+    if (type==MQTT_SUBSCRIBE) {
+      char q = (char)qos;
+      jsvAppendStringBuf(body, &q, 1);
+    }
+  }
+  JsVar *packet = mqttNewPacket(((int)type<<4) | 2, body); // flags must be 2
+  mqttSend(mqtt, packet);
+  jsvUnLock2(packet, body);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "MQTTClient",
+  "name" : "subscribe",
+  "generate" : "jswrap_mqtt_subscribe",
+  "params" : [
+    ["topics","JsVar","A topic, an array of topics, or an object mapping topic to QoS"],
+    ["options","JsVar","(optional) An object containing `qos`"]
+  ],
+  "ifdef" : "USE_MQTT"
+}
+Subscribe to one or more topics. We must be connected - subscriptions are
+usually made from the `connected` event.
+*/
+void jswrap_mqtt_subscribe(JsVar *mqtt, JsVar *topics, JsVar *options) {
+  mqttSubscribe(mqtt, MQTT_SUBSCRIBE, topics, (int)jsvObjectGetIntegerChild(options, "qos"));
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "MQTTClient",
+  "name" : "unsubscribe",
+  "generate" : "jswrap_mqtt_unsubscribe",
+  "params" : [
+    ["topics","JsVar","A topic, or an array of topics"]
+  ],
+  "ifdef" : "USE_MQTT"
+}
+Unsubscribe from one or more topics
+*/
+void jswrap_mqtt_unsubscribe(JsVar *mqtt, JsVar *topics) {
+  mqttSubscribe(mqtt, MQTT_UNSUBSCRIBE, topics, 0);
+}
@@ -0,0 +1,27 @@
+/*
+ * This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+ *
+ * Copyright (C) 2013 Gordon Williams <gw@pur3.co.uk>
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * ----------------------------------------------------------------------------
+ * Contains a native MQTT 3.1.1 client
+ * ----------------------------------------------------------------------------
+ */
+#include "jsvar.h"
+
+JsVar *jswrap_mqtt_create(JsVar *server, JsVar *options);
+void jswrap_mqtt_connect(JsVar *mqtt);
+void jswrap_mqtt_disconnect(JsVar *mqtt);
+void jswrap_mqtt_publish(JsVar *mqtt, JsVar *topic, JsVar *message, JsVar *options);
+void jswrap_mqtt_subscribe(JsVar *mqtt, JsVar *topics, JsVar *options);
+void jswrap_mqtt_unsubscribe(JsVar *mqtt, JsVar *topics);
+
+// listeners/timers, bound to the client
+void jswrap_mqtt_onData(JsVar *mqtt, JsVar *newData);
+void jswrap_mqtt_onClose(JsVar *mqtt);
+void jswrap_mqtt_onError(JsVar *mqtt, JsVar *error);
+void jswrap_mqtt_keepAlive(JsVar *mqtt);
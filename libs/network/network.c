@@ -37,6 +37,7 @@
 #if defined(USE_TLS)
   #include "mbedtls/ssl.h"
   #include "mbedtls/ctr_drbg.h"
+  #include "mbedtls/platform.h"
   #include "jswrap_crypto.h"
 #endif
 #if defined(USE_NETWORK_JS)
@@ -231,6 +232,8 @@ bool networkGetFromVar(JsNetwork *net) {
   // Retrieve the data for the network var and save in the data property of the JsNetwork
   // structure.
   jsvGetStringChars(net->networkVar,0,(char *)&net->data, sizeof(JsNetworkData));
+  net->sendv = 0; // optional, so most network types won't set it
+  net->addmembership = 0; // optional
 
   // Now we know which kind of network we are working with, invoke the corresponding initialization
   // function to set the callbacks for this network tyoe.
@@ -299,6 +302,9 @@ JsNetwork *networkGetCurrent() {
 typedef struct {
   int sckt;
   bool connecting; // are we in the process of connecting?
+  uint32_t host; // address and port we're connecting to, for the session cache
+  unsigned short port;
+  bool canResume; // false if we're using our own ca/cert/key, so shouldn't share sessions
   mbedtls_ctr_drbg_context ctr_drbg;
   mbedtls_pk_context pkey;
   mbedtls_x509_crt owncert;
@@ -507,7 +513,69 @@ bool ssl_load_cacert(SSLSocketData *sd, JsVar *options) {
   return true;
 }
 
-bool ssl_newSocketData(int sckt, JsVar *options) {
+/* Sessions from completed handshakes, by server address and port, so the
+ * next connection to the same server can resume the session rather than do
+ * a full handshake. Session tickets aren't enabled, so once we drop the
+ * peer's certificate an mbedtls_ssl_session contains no pointers and can be
+ * stored as a plain string. Sessions contain the master secret, so the cache
+ * is removed on kill (before save() writes everything to flash), and
+ * connections with their own ca/cert/key never use it, as the key doesn't
+ * include them. */
+#define SSL_SESSION_CACHE "TLSs"
+#define SSL_SESSION_CACHE_SIZE 4 // how many sessions we remember
+
+static void ssl_getSessionKey(SSLSocketData *sd, char *key, size_t len) {
+  espruino_snprintf(key, len, "%x:%d", (int)sd->host, (int)sd->port);
+}
+
+/// If we have a session for the server we're connecting to, try and resume it
+static void ssl_loadSession(SSLSocketData *sd) {
+  if (!sd->canResume) return;
+  char key[16];
+  ssl_getSessionKey(sd, key, sizeof(key));
+  JsVar *cache = jsvObjectGetChildIfExists(execInfo.hiddenRoot, SSL_SESSION_CACHE);
+  JsVar *data = cache ? jsvObjectGetChildIfExists(cache, key) : 0;
+  jsvUnLock(cache);
+  mbedtls_ssl_session session;
+  if (jsvIsString(data) && jsvGetStringLength(data)==sizeof(session)) {
+    jsvGetStringChars(data, 0, (char*)&session, sizeof(session));
+    mbedtls_ssl_set_session(&sd->ssl, &session); // takes a copy
+  }
+  jsvUnLock(data);
+}
+
+/// Remember the session from a handshake that just completed
+static void ssl_saveSession(SSLSocketData *sd) {
+  if (!sd->canResume) return;
+  mbedtls_ssl_session session;
+  mbedtls_ssl_session_init(&session);
+  if (mbedtls_ssl_get_session(&sd->ssl, &session)==0 && session.id_len) {
+    // we don't need the certificate to resume, and it uses a lot of memory
+    if (session.peer_cert) {
+      mbedtls_x509_crt_free(session.peer_cert);
+      mbedtls_free(session.peer_cert);
+      session.peer_cert = NULL;
+    }
+    JsVar *cache = jsvObjectGetChild(execInfo.hiddenRoot, SSL_SESSION_CACHE, JSV_OBJECT);
+    if (cache) {
+      char key[16];
+      ssl_getSessionKey(sd, key, sizeof(key));
+      jsvObjectRemoveChild(cache, key);
+      // forget the oldest session if we have too many
+      if (jsvGetChildren(cache) >= SSL_SESSION_CACHE_SIZE)
+        jsvRemoveChildAndUnLock(cache, jsvLock(jsvGetFirstChild(cache)));
+      jsvObjectSetChildAndUnLock(cache, key, jsvNewStringOfLength(sizeof(session), (char*)&session));
+      jsvUnLock(cache);
+    }
+  }
+  mbedtls_ssl_session_free(&session);
+}
+
+void ssl_clearSessionCache() {
+  jsvObjectRemoveChild(execInfo.hiddenRoot, SSL_SESSION_CACHE);
+}
+
+bool ssl_newSocketData(int sckt, uint32_t host, unsigned short port, JsVar *options) {
   /* FIXME Warning:
    *
    * MBEDTLS_SSL_MAX_CONTENT_LEN = 16kB, so we need over double this = 32kB memory
@@ -540,6 +608,17 @@ bool ssl_newSocketData(int sckt, JsVar *options) {
   // Now initialise this
   sd->sckt = sckt;
   sd->connecting = true;
+  sd->host = host;
+  sd->port = port;
+  sd->canResume = true;
+  if (jsvIsObject(options)) {
+    const char *tlsOptions[] = {"ca", "key", "cert"};
+    for (unsigned int i=0;i<sizeof(tlsOptions)/sizeof(tlsOptions[0]);i++) {
+      JsVar *v = jsvObjectGetChildIfExists(options, tlsOptions[i]);
+      if (!jsvIsUndefined(v)) sd->canResume = false;
+      jsvUnLock(v);
+    }
+  }
 
   // jsiConsolePrintf( "Connecting with TLS...\n" );
 
@@ -615,6 +694,7 @@ bool ssl_newSocketData(int sckt, JsVar *options) {
   }
 
   mbedtls_ssl_set_bio( &sd->ssl, &sd->sckt, ssl_send, ssl_recv, NULL );
+  ssl_loadSession(sd);
 
   // jsiConsolePrintf("Performing the SSL/TLS handshake...\n" );
 
@@ -659,6 +739,8 @@ SSLSocketData *ssl_getSocketData(int sckt) {
         return 0;
       }
       sd->connecting = false;
+      ssl_saveSession(sd);
+      netActivity++; // we can now send/receive, so make sure we go around the idle loop again
     }
   }
 
@@ -669,6 +751,14 @@ SSLSocketData *ssl_getSocketData(int sckt) {
 #endif
 // ------------------------------------------------------------------------------
 
+unsigned int netActivity = 0;
+
+/// Count activity if a socket operation returned nonzero
+static int netCountActivity(int r) {
+  if (r) netActivity++;
+  return r;
+}
+
 bool netCheckError(JsNetwork *net) {
   return net->checkError(net);
 }
@@ -679,12 +769,13 @@ int netCreateSocket(JsNetwork *net, SocketType socketType, uint32_t host, unsign
 
 #ifdef USE_TLS
   if (socketType & ST_TLS) {
-    if (ssl_newSocketData(sckt, options)) {
+    if (ssl_newSocketData(sckt, host, port, options)) {
     } else {
       return -1; // fail!
     }
   }
 #endif
+  netActivity++;
   return sckt;
 }
 
@@ -695,10 +786,13 @@ void netCloseSocket(JsNetwork *net, SocketType socketType, int sckt) {
   }
 #endif
   net->closesocket(net, sckt);
+  netActivity++;
 }
 
 int netAccept(JsNetwork *net, int sckt) {
-  return net->accept(net, sckt);
+  int r = net->accept(net, sckt);
+  if (r>=0) netActivity++;
+  return r;
 }
 
 void netGetHostByName(JsNetwork *net, char * hostName, uint32_t* out_ip_addr) {
@@ -715,11 +809,11 @@ int netRecv(JsNetwork *net, SocketType socketType, int sckt, void *buf, size_t l
     int ret = mbedtls_ssl_read( &sd->ssl, buf, len );
     if( ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE )
       return 0;
-    return ret;
+    return netCountActivity(ret);
   } else
 #endif
   {
-    return net->recv(net, socketType, sckt, buf, len);
+    return netCountActivity(net->recv(net, socketType, sckt, buf, len));
   }
 }
 
@@ -733,10 +827,20 @@ int netSend(JsNetwork *net, SocketType socketType, int sckt, const void *buf, si
     int ret = mbedtls_ssl_write( &sd->ssl, buf, len );
     if( ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE )
       return 0;
-    return ret;
+    return netCountActivity(ret);
   } else
 #endif
   {
-    return net->send(net, socketType, sckt, buf, len);
+    return netCountActivity(net->send(net, socketType, sckt, buf, len));
   }
 }
+
+bool netCanSendv(JsNetwork *net, SocketType socketType) {
+  return net->sendv && !(socketType & ST_TLS);
+}
+
+int netSendv(JsNetwork *net, SocketType socketType, int sckt, const JsNetSendBuf *bufs, int count) {
+  if (count>1 && netCanSendv(net, socketType))
+    return netCountActivity(net->sendv(net, socketType, sckt, bufs, count));
+  return netSend(net, socketType, sckt, bufs[0].buf, bufs[0].len);
+}
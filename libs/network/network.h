@@ -59,6 +59,12 @@ typedef struct {
 } PACKED_FLAGS JsNetworkData;
 
 
+/// One of several areas of memory to be sent with JsNetwork.sendv
+typedef struct {
+  const void *buf;
+  size_t len;
+} JsNetSendBuf;
+
 // Here we assume that IP addresses are stored IN ORDER - eg. 192.168.1.1 = [192,168,1,1] - CC3000 does it backwards
 typedef struct JsNetwork {
   JsVar *networkVar; // this won't be locked again - we just know that it is already locked by something else
@@ -84,6 +90,11 @@ typedef struct JsNetwork {
   int (*recv)(struct JsNetwork *net, SocketType socketType, int sckt, void *buf, size_t len);
   /// Send data if possible. returns nBytes on success, 0 on no data, or -1 on failure
   int (*send)(struct JsNetwork *net, SocketType socketType, int sckt, const void *buf, size_t len);
+  /** Optional: send several buffers in one go. returns nBytes on success, 0 on no data, or -1 on failure.
+   * For UDP each buffer is a whole packet (starting with a JsNetUDPPacketHeader), and only whole packets are sent */
+  int (*sendv)(struct JsNetwork *net, SocketType socketType, int sckt, const JsNetSendBuf *bufs, int count);
+  /// Optional: join a multicast group on an existing UDP socket. ip is the interface to use (0 = any)
+  void (*addmembership)(struct JsNetwork *net, int sckt, uint32_t group, uint32_t ip);
 } PACKED_FLAGS JsNetwork;
 
 /// Header applied to all UDP packets when they are received
@@ -118,6 +129,10 @@ void networkPutAddressAsString(JsVar *object, const char *name,  unsigned char *
 /** Some devices (CC3000) store the IP address with the first element last, so we must flip it */
 unsigned long networkFlipIPAddress(unsigned long addr);
 
+/** Incremented whenever a socket operation does something (socket created,
+ * closed or accepted, or data sent/received) */
+extern unsigned int netActivity;
+
 /// Check for any errors and try and recover (CC3000 only really)
 bool netCheckError(JsNetwork *net);
 
@@ -135,5 +150,14 @@ void netGetHostByName(JsNetwork *net, char * hostName, uint32_t* out_ip_addr);
 
 int netRecv(JsNetwork *net, SocketType socketType, int sckt, void *buf, size_t len);
 int netSend(JsNetwork *net, SocketType socketType, int sckt, const void *buf, size_t len);
+/// Can netSendv send more than one buffer at once on this socket?
+bool netCanSendv(JsNetwork *net, SocketType socketType);
+/// Send several buffers - if !netCanSendv only the first one is sent
+int netSendv(JsNetwork *net, SocketType socketType, int sckt, const JsNetSendBuf *bufs, int count);
+
+#ifdef USE_TLS
+/// Forget the TLS sessions we keep for resuming (done on kill, so they're never saved to flash)
+void ssl_clearSessionCache();
+#endif
 
 #endif // _NETWORK_H
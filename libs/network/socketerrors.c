@@ -29,6 +29,8 @@ static char *socketErrors[] = {
   "SSL handshake failed",
   "invalid SSL data",
   "no response",
+  "WebSocket handshake failed",
+  "invalid WebSocket data",
 };
 
 char *socketErrorString(int error) {
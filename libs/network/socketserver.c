@@ -20,6 +20,11 @@
 #include "jswrap_stream.h"
 #include "jswrap_string.h"
 #include "jswrap_functions.h"
+#include "jsflash.h"
+#if defined(USE_CRYPTO) && !defined(USE_SHA1_JS)
+#include "mbedtls/sha1.h"
+#define WEBSOCKET_SERVER // we can accept WebSocket upgrades (needs SHA1)
+#endif
 
 #define HTTP_NAME_SOCKETTYPE "type" // normal socket or HTTP
 #define HTTP_NAME_PORT "port"
@@ -28,7 +33,12 @@
 #define HTTP_NAME_ENDED "endd"
 #define HTTP_NAME_RECEIVE_DATA "dRcv"
 #define HTTP_NAME_RECEIVE_COUNT "cRcv"
-#define HTTP_NAME_SEND_DATA "dSnd"
+#define HTTP_NAME_RECEIVE_PENDING "pRcv" // data that was received but couldn't be pushed to the stream
+#define HTTP_NAME_HEADER_POS "hPos"      // where the next HTTP header line starts in dRcv
+#define HTTP_NAME_CHUNK_LEFT "cLft"      // how much of the current HTTP chunk is still to be received
+#define HTTP_NAME_RECEIVE_BUDGET "bRcv"  // how much we'll read in one go, if more than net->chunkSize
+#define HTTP_NAME_SEND_DATA "dSnd"   // array of strings waiting to be sent
+#define HTTP_NAME_SEND_OFFSET "oSnd" // how much of the first string in dSnd has already been sent
 #define HTTP_NAME_RESPONSE_VAR "res"
 #define HTTP_NAME_OPTIONS_VAR "opt"
 #define HTTP_NAME_SERVER_VAR "svr"
@@ -37,17 +47,38 @@
 #define HTTP_NAME_CLOSENOW "clsNow"  // boolean: gotta close
 #define HTTP_NAME_CONNECTED "conn"     // boolean: we are connected
 #define HTTP_NAME_CLOSE "cls"        // close after sending
+#define HTTP_NAME_WEBSOCKET "ws"     // WebSocketState, if this is a WebSocket
+#define HTTP_NAME_WS_FRAGMENT "wsFr" // the start of a fragmented WebSocket message
+#define HTTP_NAME_WS_OPCODE "wsOp"   // the opcode of the fragmented WebSocket message
 #define HTTP_NAME_ON_CONNECT JS_EVENT_PREFIX"connect"
 #define HTTP_NAME_ON_CLOSE JS_EVENT_PREFIX"close"
 #define HTTP_NAME_ON_END JS_EVENT_PREFIX"end"
 #define HTTP_NAME_ON_DRAIN JS_EVENT_PREFIX"drain"
 #define HTTP_NAME_ON_ERROR JS_EVENT_PREFIX"error"
+#define HTTP_NAME_ON_WEBSOCKET JS_EVENT_PREFIX"websocket"
+#define HTTP_NAME_ON_OPEN JS_EVENT_PREFIX"open"
+#define HTTP_NAME_ON_MESSAGE JS_EVENT_PREFIX"message"
+#define HTTP_NAME_ON_PING JS_EVENT_PREFIX"ping"
+#define HTTP_NAME_ON_PONG JS_EVENT_PREFIX"pong"
 
 #define DGRAM_NAME_ON_MESSAGE JS_EVENT_PREFIX"message"
+#define DGRAM_NAME_ON_MESSAGES JS_EVENT_PREFIX"messages"
 
 #define HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS "HttpCC"
 #define HTTP_ARRAY_HTTP_SERVERS "HttpS"
 #define HTTP_ARRAY_HTTP_SERVER_CONNECTIONS "HttpSC"
+#define HTTP_ARRAY_HTTP_POOL "HttpP" // idle HTTP client connections that can be reused
+
+#define HTTP_NAME_POOL_KEY "key"     // host/port a pooled connection is for
+#define HTTP_NAME_POOL_EXPIRY "exp"  // time (ms) after which a pooled connection is closed
+#define HTTP_NAME_POOL_TIMER "tmr"   // timeout that closes the pooled connection when it expires
+#define HTTP_KEEPALIVE_TIMEOUT 5000  // default for keepAliveTimeout
+#define HTTP_KEEPALIVE_MAX_FREE 2    // default for maxFreeSockets
+
+#define SOCKET_SEND_MAX_BUFS 8 // most strings from the send queue to send in one go (if netCanSendv)
+#define SOCKET_SEND_GATHER_SIZE 4096 // how much non-flat data to copy out to send in one go (if netCanSendv)
+#define SOCKET_SEND_APPEND_SIZE 256 // writes smaller than this are appended to the last string in the send queue
+#define SOCKET_RECV_MAX_CHUNKS 16 // the most we'll read from one socket in one go, in units of net->chunkSize
 
 #ifdef ESP8266
 // esp8266 debugging, need to remove this eventually
@@ -90,79 +121,89 @@ static void httpAppendHeaders(JsVar *string, JsVar *headerObject) {
   // free headers
 }
 
+/* HTTP headers are parsed a line at a time as they arrive, so we never rescan
+ * what we've already seen. HTTP_NAME_HEADER_POS is where the first line we
+ * haven't parsed yet starts in receiveData, and the 'headers' object is
+ * created once the first (request/status) line has been parsed. */
+
+static void httpParseFirstLine(JsVar *receiveData, JsVar *objectForData, bool isServer, size_t lineStart, size_t lineEnd, size_t firstSpace, size_t secondSpace) {
+  if (isServer) {
+    jsvObjectSetChildAndUnLock(objectForData, "method", jsvNewFromStringVar(receiveData, lineStart, firstSpace-lineStart));
+    if (firstSpace<lineEnd)
+      jsvObjectSetChildAndUnLock(objectForData, "url", jsvNewFromStringVar(receiveData, firstSpace+1, secondSpace-(firstSpace+1)));
+  } else {
+    if (firstSpace>=lineStart+5)
+      jsvObjectSetChildAndUnLock(objectForData, "httpVersion", jsvNewFromStringVar(receiveData, lineStart+5, firstSpace-(lineStart+5)));
+    if (firstSpace<lineEnd)
+      jsvObjectSetChildAndUnLock(objectForData, "statusCode", jsvNewFromStringVar(receiveData, firstSpace+1, secondSpace-(firstSpace+1)));
+    if (secondSpace<lineEnd)
+      jsvObjectSetChildAndUnLock(objectForData, "statusMessage", jsvNewFromStringVar(receiveData, secondSpace+1, lineEnd-(secondSpace+1)));
+  }
+}
+
 // httpParseHeaders(&receiveData, reqVar, true) // server
 // httpParseHeaders(&receiveData, resVar, false) // client
+// Returns true once all headers have been parsed, and removes them from receiveData
 bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer) {
-  // find /r/n/r/n
-  int newlineIdx = 0;
-  int strIdx = 0;
-  int headerEnd = -1;
+  size_t lineStart = (size_t)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(objectForData, HTTP_NAME_HEADER_POS));
+  JsVar *vHeaders = jsvObjectGetChildIfExists(objectForData, HTTP_NAME_HEADERS);
+  bool hadHeaders = false;
+  size_t strIdx = lineStart;
+  size_t firstSpace = 0, secondSpace = 0; // in the first line
+  size_t colonPos = 0, valueStart = 0; // in header lines
+  char lastCh = 0;
   JsvStringIterator it;
-  jsvStringIteratorNew(&it, *receiveData, 0);
+  jsvStringIteratorNew(&it, *receiveData, lineStart);
   while (jsvStringIteratorHasChar(&it)) {
     char ch = jsvStringIteratorGetCharAndNext(&it);
-    if (ch == '\r') {
-      if (newlineIdx==0) newlineIdx=1;
-      else if (newlineIdx==2) newlineIdx=3;
-    } else if (ch == '\n') {
-      if (newlineIdx==1) newlineIdx=2;
-      else if (newlineIdx==3) {
-        headerEnd = strIdx+1;
+    if (ch == '\n') {
+      size_t lineEnd = (lastCh=='\r') ? strIdx-1 : strIdx;
+      if (!vHeaders) {
+        if (lineEnd > lineStart) { // skip any empty lines before the request/status line
+          vHeaders = jsvNewObject();
+          if (!vHeaders) break; // out of memory
+          jsvObjectSetChild(objectForData, HTTP_NAME_HEADERS, vHeaders);
+          if (!firstSpace) firstSpace = lineEnd;
+          if (!secondSpace) secondSpace = lineEnd;
+          httpParseFirstLine(*receiveData, objectForData, isServer, lineStart, lineEnd, firstSpace, secondSpace);
+        }
+      } else if (lineEnd == lineStart) { // empty line - end of headers
+        hadHeaders = true;
+        strIdx++;
         break;
-      }
-    } else newlineIdx=0;
-    strIdx++;
-  }
-  jsvStringIteratorFree(&it);
-  // skip if we have no header
-  if (headerEnd<0) return false;
-  // Now parse the header
-  JsVar *vHeaders = jsvNewObject();
-  if (!vHeaders) return true;
-  jsvUnLock(jsvAddNamedChild(objectForData, vHeaders, HTTP_NAME_HEADERS));
-  strIdx = 0;
-  int firstSpace = -1;
-  int secondSpace = -1;
-  int firstEOL = -1;
-  int lineNumber = 0;
-  int lastLineStart = 0;
-  int colonPos = 0;
-  int valueStart = 0;
-  //jsiConsolePrintStringVar(receiveData);
-  jsvStringIteratorNew(&it, *receiveData, 0);
-    while (jsvStringIteratorHasChar(&it)) {
-      char ch = jsvStringIteratorGetCharAndNext(&it);
-      if (ch==' ' || ch=='\r') {
-        if (firstSpace<0) firstSpace = strIdx;
-        else if (secondSpace<0) secondSpace = strIdx;
-      }
-      if (ch == ':' && colonPos<0) colonPos = strIdx;
-      else if (colonPos>0 && !valueStart && !isWhitespace(ch)) valueStart = strIdx; // ignore whitespace after :
-      if (ch == '\r') {
-        if (firstEOL<0) firstEOL=strIdx;
-        if (lineNumber>0 && colonPos>lastLineStart && valueStart>lastLineStart && lastLineStart<strIdx) {
-          JsVar *hVal = jsvNewFromEmptyString();
-          if (hVal)
-            jsvAppendStringVar(hVal, *receiveData, (size_t)valueStart, (size_t)(strIdx-valueStart));
-          JsVar *hKey = jsvNewFromEmptyString();
-          if (hKey) {
-            hKey = jsvMakeIntoVariableName(hKey, hVal);
-            jsvAppendStringVar(hKey, *receiveData, (size_t)lastLineStart, (size_t)(colonPos-lastLineStart));
-            jsvAddName(vHeaders, hKey);
-            jsvUnLock(hKey);
-          }
-          jsvUnLock(hVal);
+      } else if (colonPos>lineStart && valueStart) {
+        JsVar *hVal = jsvNewFromStringVar(*receiveData, valueStart, lineEnd-valueStart);
+        JsVar *hKey = jsvNewFromEmptyString();
+        if (hKey) {
+          hKey = jsvMakeIntoVariableName(hKey, hVal);
+          jsvAppendStringVar(hKey, *receiveData, lineStart, colonPos-lineStart);
+          jsvAddName(vHeaders, hKey);
+          jsvUnLock(hKey);
         }
-        lineNumber++;
-        colonPos=-1;
-        valueStart = 0;
+        jsvUnLock(hVal);
       }
-      if (ch == '\r' || ch == '\n') {
-        lastLineStart = strIdx+1;
+      lineStart = strIdx+1;
+      firstSpace = secondSpace = colonPos = valueStart = 0;
+    } else if (!vHeaders) {
+      if (ch==' ') {
+        if (!firstSpace) firstSpace = strIdx;
+        else if (!secondSpace) secondSpace = strIdx;
       }
-      strIdx++;
+    } else {
+      if (ch == ':' && !colonPos) colonPos = strIdx;
+      else if (colonPos && !valueStart && !isWhitespace(ch)) valueStart = strIdx; // ignore whitespace after :
     }
-    jsvStringIteratorFree(&it);
+    lastCh = ch;
+    strIdx++;
+  }
+  jsvStringIteratorFree(&it);
+  if (!hadHeaders) {
+    // remember where we got to, and carry on when there's more data
+    jsvObjectSetChildAndUnLock(objectForData, HTTP_NAME_HEADER_POS, jsvNewFromInteger((JsVarInt)lineStart));
+    jsvUnLock(vHeaders);
+    return false;
+  }
+  jsvObjectRemoveChild(objectForData, HTTP_NAME_HEADER_POS);
   // flag the req/response if Transfer-Encoding:chunked was set
   JsVarInt contentToReceive;
   if (compareTransferEncodingAndUnlock(jsvObjectGetChildI(vHeaders, "Transfer-Encoding"), "chunked")) {
@@ -173,35 +214,65 @@ bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer)
   }
   jsvObjectSetChildAndUnLock(objectForData, HTTP_NAME_RECEIVE_COUNT, jsvNewFromInteger(contentToReceive));
   jsvUnLock(vHeaders);
-  // try and pull out methods/etc
-  if (isServer) {
-    jsvObjectSetChildAndUnLock(objectForData, "method", jsvNewFromStringVar(*receiveData, 0, (size_t)firstSpace));
-    jsvObjectSetChildAndUnLock(objectForData, "url", jsvNewFromStringVar(*receiveData, (size_t)(firstSpace+1), (size_t)(secondSpace-(firstSpace+1))));
-  } else {
-    jsvObjectSetChildAndUnLock(objectForData, "httpVersion", jsvNewFromStringVar(*receiveData, 5, (size_t)firstSpace-5));
-    jsvObjectSetChildAndUnLock(objectForData, "statusCode", jsvNewFromStringVar(*receiveData, (size_t)(firstSpace+1), (size_t)(secondSpace-(firstSpace+1))));
-    jsvObjectSetChildAndUnLock(objectForData, "statusMessage", jsvNewFromStringVar(*receiveData, (size_t)(secondSpace+1), (size_t)(firstEOL-(secondSpace+1))));
-  }
   // strip out the header
-  JsVar *afterHeaders = jsvNewFromStringVar(*receiveData, (size_t)headerEnd, JSVAPPENDSTRINGVAR_MAXLENGTH);
+  JsVar *afterHeaders = jsvNewFromStringVar(*receiveData, strIdx, JSVAPPENDSTRINGVAR_MAXLENGTH);
   jsvUnLock(*receiveData);
   *receiveData = afterHeaders;
   return true;
 }
 
-size_t httpStringGet(JsVar *v, char *str, size_t len) {
-  size_t l = len;
+/* Decode as much 'chunked' transfer encoding from receiveData as we can, and
+ * return the data. HTTP_NAME_CHUNK_LEFT is how much of the current chunk is
+ * still to come (0 = next is a chunk size, -1 = skip to the end of the line).
+ * 'used' is set to how much of receiveData we're done with - the only thing
+ * we leave is a chunk size line we haven't got all of yet */
+static JsVar *httpDecodeChunked(JsVar *reader, JsVar *receiveData, size_t *used) {
+  JsVarInt left = jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(reader, HTTP_NAME_CHUNK_LEFT));
+  size_t len = jsvGetStringLength(receiveData);
+  JsVar *data = jsvNewFromEmptyString();
+  *used = 0;
+  if (!data) return 0; // out of memory
+  size_t strIdx = 0;
+  JsVarInt chunkLen = 0;
+  bool chunkLenDone = false;
   JsvStringIterator it;
-  jsvStringIteratorNew(&it, v, 0);
-  while (jsvStringIteratorHasChar(&it)) {
-    if (l--==0) {
-      jsvStringIteratorFree(&it);
-      return len;
+  jsvStringIteratorNew(&it, receiveData, 0);
+  while (strIdx < len) {
+    if (left > 0) { // chunk data
+      size_t n = len-strIdx;
+      if ((size_t)left < n) n = (size_t)left;
+      jsvAppendStringVar(data, receiveData, strIdx, n);
+      strIdx += n;
+      left -= (JsVarInt)n;
+      if (!left) left = -1; // skip the CRLF at the end
+      *used = strIdx;
+      jsvStringIteratorGoto(&it, receiveData, strIdx);
+      continue;
+    }
+    char ch = jsvStringIteratorGetCharAndNext(&it);
+    strIdx++;
+    if (left < 0) { // skip to the end of the line
+      if (ch == '\n') left = 0;
+      *used = strIdx;
+    } else if (ch == '\n') { // end of chunk size
+      *used = strIdx;
+      if (!chunkLen) { // last chunk - we're done (and ignore any trailers)
+        jsvObjectSetChildAndUnLock(reader, HTTP_NAME_RECEIVE_COUNT, jsvNewFromInteger(0));
+        *used = len;
+        break;
+      }
+      left = chunkLen;
+      chunkLen = 0;
+      chunkLenDone = false;
+    } else if (!chunkLenDone && isHexadecimal(ch)) {
+      chunkLen = chunkLen*16 + chtod(ch);
+    } else if (ch != '\r') { // ';' for extensions, or garbage
+      chunkLenDone = true;
     }
-    *(str++) = jsvStringIteratorGetCharAndNext(&it);
   }
   jsvStringIteratorFree(&it);
-  return len-l;
+  jsvObjectSetChildAndUnLock(reader, HTTP_NAME_CHUNK_LEFT, jsvNewFromInteger(left));
+  return data;
 }
 
 // -----------------------------
@@ -258,149 +329,840 @@ NO_INLINE static void _socketCloseAllConnections(JsNetwork *net) {
   _socketCloseAllConnectionsFor(net, HTTP_ARRAY_HTTP_SERVER_CONNECTIONS);
   _socketCloseAllConnectionsFor(net, HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS);
   _socketCloseAllConnectionsFor(net, HTTP_ARRAY_HTTP_SERVERS);
+  _socketCloseAllConnectionsFor(net, HTTP_ARRAY_HTTP_POOL);
 }
 
-// returns 0 on success and a (negative) error number on failure
-int socketSendData(JsNetwork *net, JsVar *connection, int sckt, JsVar **sendData) {
-  SocketType socketType = socketGetType(connection);
+// -----------------------------
 
-  assert(!jsvIsEmptyString(*sendData));
+/* HTTP client requests made with keepAlive:true leave the connection open
+ * when the response has finished, and put it in HTTP_ARRAY_HTTP_POOL. The
+ * next request to the same host/port takes it from there rather than
+ * connecting again. Pool entries store the socket and its type under the same
+ * names as a connection, so _socketConnectionKill can close them. */
+
+/// The key for pooling this request's connection: "host:port", plus "s" for TLS
+static JsVar *socketPoolGetKey(JsVar *options, SocketType socketType) {
+  JsVar *host = jsvObjectGetChildIfExists(options, "host");
+  int port = (int)jsvObjectGetIntegerChild(options, "port");
+  if (port==0) port = (socketType & ST_TLS) ? 443 : 80;
+  JsVar *key = jsvVarPrintf("%v:%d%s", host, port, (socketType & ST_TLS)?"s":"");
+  jsvUnLock(host);
+  return key;
+}
 
-  size_t sndBufLen;
-  if ((socketType&ST_TYPE_MASK)==ST_UDP) {
-      sndBufLen = (size_t)jsvGetStringLength(*sendData);
-      if (sndBufLen+1024 > jsuGetFreeStack()) {
-          jsExceptionHere(JSET_ERROR, "Not enough stack memory for data");
-          return -1;
+/** Can this request's connection be pooled? We don't try if it's using its own
+ * TLS CA/key/certificate, as the pool key doesn't include them */
+static bool socketPoolCanUse(JsVar *options, SocketType socketType) {
+  if (!jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(options, "keepAlive"))) return false;
+  if (socketType & ST_TLS) {
+    const char *tlsOptions[] = {"ca", "key", "cert"};
+    for (unsigned int i=0;i<sizeof(tlsOptions)/sizeof(tlsOptions[0]);i++) {
+      JsVar *v = jsvObjectGetChildIfExists(options, tlsOptions[i]);
+      bool isSet = !jsvIsUndefined(v);
+      jsvUnLock(v);
+      if (isSet) return false;
+    }
+  }
+  return true;
+}
+
+/** Remove an entry from the pool. If it hasn't expired its timeout is still
+ * pending, so we clear it (we don't otherwise, as the id may have been reused) */
+static void socketPoolRemoveEntry(JsNetwork *net, JsVar *entry, bool expired, bool close) {
+  if (!expired) {
+    JsVar *timeout = jsvObjectGetChildIfExists(entry, HTTP_NAME_POOL_TIMER);
+    if (timeout) jsiClearTimeout(timeout);
+    jsvUnLock(timeout);
+  }
+  if (close) _socketConnectionKill(net, entry);
+}
+
+/// Close pooled connections that have expired, or that have been closed (or sent data) by the server
+static void socketPoolIdle(JsNetwork *net) {
+  JsVar *pool = socketGetArray(HTTP_ARRAY_HTTP_POOL, false);
+  if (!pool) return;
+  JsVarFloat now = jshGetMillisecondsFromTime(jshGetSystemTime());
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, pool);
+  while (jsvObjectIteratorHasValue(&it)) {
+    JsVar *entry = jsvObjectIteratorGetValue(&it);
+    bool expired = now >= jsvObjectGetFloatChild(entry, HTTP_NAME_POOL_EXPIRY);
+    bool closed = expired;
+    if (!expired) {
+      // nothing should arrive on an idle connection, so if anything does we can't use it
+      char buf[16];
+      int sckt = (int)jsvObjectGetIntegerChild(entry, HTTP_NAME_SOCKET)-1;
+      closed = netRecv(net, socketGetType(entry), sckt, buf, sizeof(buf)) != 0;
+    }
+    if (closed) {
+      socketPoolRemoveEntry(net, entry, expired, true);
+      JsVar *entryName = jsvObjectIteratorGetKey(&it);
+      jsvObjectIteratorNext(&it);
+      jsvRemoveChildAndUnLock(pool, entryName);
+    } else {
+      jsvObjectIteratorNext(&it);
+    }
+    jsvUnLock(entry);
+  }
+  jsvObjectIteratorFree(&it);
+  jsvUnLock(pool);
+}
+
+static bool socketPoolKeyMatches(JsVar *entry, JsVar *key) {
+  JsVar *entryKey = jsvObjectGetChildIfExists(entry, HTTP_NAME_POOL_KEY);
+  bool matches = entryKey && jsvCompareString(entryKey, key, 0, 0, false)==0;
+  jsvUnLock(entryKey);
+  return matches;
+}
+
+/** Close pooled connections with the given key, oldest first, until there
+ * are fewer than maxCount left. If take is set, instead remove the first
+ * one from the pool and return its socket. Returns -1 if there wasn't one. */
+static int socketPoolRemove(JsNetwork *net, JsVar *pool, JsVar *key, int maxCount, bool take) {
+  int count = 0;
+  JsvObjectIterator it;
+  if (!take) {
+    jsvObjectIteratorNew(&it, pool);
+    while (jsvObjectIteratorHasValue(&it)) {
+      JsVar *entry = jsvObjectIteratorGetValue(&it);
+      if (socketPoolKeyMatches(entry, key))
+        count++;
+      jsvUnLock(entry);
+      jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+  }
+  int sckt = -1;
+  jsvObjectIteratorNew(&it, pool);
+  while (jsvObjectIteratorHasValue(&it) && (take ? sckt<0 : count>=maxCount)) {
+    JsVar *entry = jsvObjectIteratorGetValue(&it);
+    if (socketPoolKeyMatches(entry, key)) {
+      if (take) {
+        sckt = (int)jsvObjectGetIntegerChild(entry, HTTP_NAME_SOCKET)-1;
+      } else {
+        count--;
       }
+      socketPoolRemoveEntry(net, entry, false, !take);
+      JsVar *entryName = jsvObjectIteratorGetKey(&it);
+      jsvObjectIteratorNext(&it);
+      jsvRemoveChildAndUnLock(pool, entryName);
+    } else {
+      jsvObjectIteratorNext(&it);
+    }
+    jsvUnLock(entry);
+  }
+  jsvObjectIteratorFree(&it);
+  return sckt;
+}
+
+/// Called when a pooled connection's keepAliveTimeout has passed
+static void socketPoolTimeout() {
+  JsNetwork net;
+  if (!networkGetFromVar(&net)) return;
+  socketPoolIdle(&net);
+  networkFree(&net);
+}
+
+/// Get a pooled connection to the host/port this request is for, or return -1
+static int socketPoolTake(JsNetwork *net, JsVar *options, SocketType socketType) {
+  JsVar *pool = socketGetArray(HTTP_ARRAY_HTTP_POOL, false);
+  if (!pool) return -1;
+  socketPoolIdle(net); // don't return anything that's expired
+  JsVar *key = socketPoolGetKey(options, socketType);
+  int sckt = key ? socketPoolRemove(net, pool, key, 0, true) : -1;
+  jsvUnLock2(key, pool);
+  return sckt;
+}
+
+/// Move the socket of a finished request into the pool (the request no longer has a socket afterwards)
+static void socketPoolAdd(JsNetwork *net, JsVar *connection, JsVar *options) {
+  SocketType socketType = socketGetType(connection);
+  int sckt = (int)jsvObjectGetIntegerChild(connection, HTTP_NAME_SOCKET)-1;
+  JsVar *v = jsvObjectGetChildIfExists(options, "maxFreeSockets");
+  int maxFree = jsvIsUndefined(v) ? HTTP_KEEPALIVE_MAX_FREE : (int)jsvGetInteger(v);
+  jsvUnLock(v);
+  v = jsvObjectGetChildIfExists(options, "keepAliveTimeout");
+  JsVarFloat timeout = jsvIsUndefined(v) ? HTTP_KEEPALIVE_TIMEOUT : jsvGetFloat(v);
+  jsvUnLock(v);
+
+  JsVar *pool = socketGetArray(HTTP_ARRAY_HTTP_POOL, true);
+  JsVar *key = socketPoolGetKey(options, socketType);
+  JsVar *entry = jsvNewObject();
+  if (pool && key && entry && maxFree>0) {
+    // make space by closing the oldest idle connections to this host
+    socketPoolRemove(net, pool, key, maxFree, false);
+    socketSetType(entry, socketType);
+    jsvObjectSetChildAndUnLock(entry, HTTP_NAME_SOCKET, jsvNewFromInteger(sckt+1));
+    jsvObjectSetChild(entry, HTTP_NAME_POOL_KEY, key);
+    jsvObjectSetChildAndUnLock(entry, HTTP_NAME_POOL_EXPIRY, jsvNewFromFloat(jshGetMillisecondsFromTime(jshGetSystemTime()) + timeout));
+    jsvObjectSetChildAndUnLock(entry, HTTP_NAME_POOL_TIMER, jsiSetTimeout(socketPoolTimeout, timeout));
+    jsvArrayPush(pool, entry);
+    jsvObjectRemoveChild(connection, HTTP_NAME_SOCKET);
+  }
+  jsvUnLock3(entry, key, pool);
+}
+
+/// Has this HTTP client request finished in a way that means its connection can be reused?
+static bool socketPoolCanReuse(JsVar *connection, JsVar *socket) {
+  JsVar *options = jsvObjectGetChildIfExists(connection, HTTP_NAME_OPTIONS_VAR);
+  bool canUse = socketPoolCanUse(options, socketGetType(connection));
+  jsvUnLock(options);
+  // the response must have been completely received, so we know where it ended
+  if (!canUse || !jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(socket, HTTP_NAME_ENDED)))
+    return false;
+  JsVar *headers = jsvObjectGetChildIfExists(socket, HTTP_NAME_HEADERS);
+  bool hasLength = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(socket, HTTP_NAME_CHUNKED));
+  if (!hasLength) {
+    JsVar *length = jsvObjectGetChildI(headers, "Content-Length");
+    hasLength = length!=0;
+    jsvUnLock(length);
+  }
+  // HTTP/1.1 connections stay open unless the server says otherwise, HTTP/1.0 ones only if it asks
+  JsVar *httpVersion = jsvObjectGetChildIfExists(socket, "httpVersion");
+  bool keepAlive = jsvIsStringEqual(httpVersion, "1.1");
+  jsvUnLock(httpVersion);
+  JsVar *connHeader = jsvObjectGetChildI(headers, "Connection");
+  if (connHeader) {
+    if (jsvIsStringIEqualAndUnLock(jsvLockAgain(connHeader), "close")) keepAlive = false;
+    if (jsvIsStringIEqualAndUnLock(jsvLockAgain(connHeader), "keep-alive")) keepAlive = true;
+  }
+  jsvUnLock2(connHeader, headers);
+  return hasLength && keepAlive;
+}
+
+/* Data waiting to be sent is stored as an array of strings (plus an offset into
+ * the first one), so after a partial send we don't have to copy what's left.
+ * Flat and native strings (eg. files from Storage) are queued as-is and sent
+ * straight from memory, and flash strings are queued as-is and read out a
+ * chunk at a time as they're sent. Anything else is copied - into a flat string if it's
+ * big, or onto the end of a normal string we made if it's small, so lots of
+ * small writes still get sent together. */
+
+static JsVar *socketGetSendQueue(JsVar *connection, bool create) {
+  return jsvObjectGetChild(connection, HTTP_NAME_SEND_DATA, create?JSV_ARRAY:0);
+}
+
+static bool socketHasSendData(JsVar *connection) {
+  JsVar *queue = socketGetSendQueue(connection, false);
+  bool hasData = queue && !jsvArrayIsEmpty(queue);
+  jsvUnLock(queue);
+  return hasData;
+}
+
+/// Add data to the end of the send queue
+static void socketQueueSendData(JsVar *queue, JsVar *data) {
+  size_t len = jsvGetStringLength(data);
+  if (!len) return;
+  if (jsvIsFlatString(data) || jsvIsNativeString(data) || jsvIsFlashString(data)) {
+    jsvArrayPush(queue, data);
+    return;
+  }
+  JsVar *s = 0;
+  if (len < SOCKET_SEND_APPEND_SIZE) {
+    // Small writes are added onto the string at the end of the queue if we made it, so they get sent together
+    JsVar *last = jsvGetLastArrayItem(queue);
+    bool appended = jsvIsBasicString(last);
+    if (appended) jsvAppendStringVarComplete(last, data);
+    jsvUnLock(last);
+    if (appended) return;
   } else {
-      sndBufLen = (size_t)net->chunkSize;
+    // Big writes are copied into a flat string if we can, so they can be sent without copying again
+    s = jsvNewFlatStringOfLength((unsigned int)len);
+    if (s) jsvGetStringChars(data, 0, jsvGetFlatStringPointer(s), len);
   }
-  char *buf = alloca(sndBufLen); // allocate on stack
+  if (!s) s = jsvNewFromStringVar(data, 0, JSVAPPENDSTRINGVAR_MAXLENGTH);
+  if (s) jsvArrayPush(queue, s);
+  jsvUnLock(s);
+}
 
-  size_t bufLen = httpStringGet(*sendData, buf, sndBufLen);
-  int num = netSend(net, socketType, sckt, buf, bufLen);
-  DBG("socketSendData %x:%d (%d -> %d)\n", *(uint32_t*)buf, *(unsigned short*)(buf+sizeof(uint32_t)), bufLen, num);
-  if (num < 0) return num; // an error occurred
-  // Now cut what we managed to send off the beginning of sendData
-  if (num > 0) {
-    JsVar *newSendData = 0;
-    if (num < (int)jsvGetStringLength(*sendData)) {
-      // we didn't send all of it... cut out what we did send
-      newSendData = jsvNewFromStringVar(*sendData, (size_t)num, JSVAPPENDSTRINGVAR_MAXLENGTH);
+/// Add data to the end of the send queue, wrapped up for 'chunked' transfer encoding
+static void socketQueueSendChunk(JsVar *queue, JsVar *data) {
+  JsVar *s = jsvVarPrintf("%x\r\n", jsvGetStringLength(data));
+  socketQueueSendData(queue, s);
+  jsvUnLock(s);
+  socketQueueSendData(queue, data);
+  s = jsvNewFromString("\r\n");
+  socketQueueSendData(queue, s);
+  jsvUnLock(s);
+}
+
+// returns 0 on success and a (negative) error number on failure
+int socketSendData(JsNetwork *net, JsVar *connection, int sckt) {
+  SocketType socketType = socketGetType(connection);
+  bool isUDP = (socketType&ST_TYPE_MASK)==ST_UDP;
+  bool gather = netCanSendv(net, socketType);
+  JsVar *queue = socketGetSendQueue(connection, false);
+  assert(queue && !jsvArrayIsEmpty(queue));
+  size_t offset = (size_t)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_SEND_OFFSET));
+
+  JsVar *items[SOCKET_SEND_MAX_BUFS]; // kept locked until we've sent from them
+  size_t itemLen[SOCKET_SEND_MAX_BUFS]; // how much of each item is still to send
+  JsNetSendBuf bufs[SOCKET_SEND_MAX_BUFS];
+  int count = 0;
+  char *buf = 0; // for data that isn't in one area of memory
+  size_t bufSize = 0, bufLen = 0;
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, queue);
+  while (jsvObjectIteratorHasValue(&it) && count<SOCKET_SEND_MAX_BUFS) {
+    JsVar *item = jsvObjectIteratorGetValue(&it);
+    size_t start = count ? 0 : offset;
+    size_t len = jsvGetStringLength(item) - start;
+    size_t dataLen;
+    char *data = jsvGetDataPointer(item, &dataLen);
+    if (data) {
+      // send straight from memory. Drivers without sendv expect no more than chunkSize
+      bufs[count].buf = data + start;
+      bufs[count].len = (!gather && !isUDP && len>(size_t)net->chunkSize) ? (size_t)net->chunkSize : len;
     } else {
+      if (!buf) {
+        if (isUDP) { // each item is one packet, which must be sent all at once
+          bufSize = len;
+          if (gather && bufSize < SOCKET_SEND_GATHER_SIZE && SOCKET_SEND_GATHER_SIZE+1024 < jsuGetFreeStack())
+            bufSize = SOCKET_SEND_GATHER_SIZE;
+          if (bufSize+1024 > jsuGetFreeStack()) {
+            jsExceptionHere(JSET_ERROR, "Not enough stack memory for data");
+            jsvUnLock(item);
+            break;
+          }
+        } else {
+          // If we can send more than one buffer, the network can handle more than chunkSize at once
+          bufSize = (size_t)net->chunkSize;
+          if (gather && bufSize < SOCKET_SEND_GATHER_SIZE && SOCKET_SEND_GATHER_SIZE+1024 < jsuGetFreeStack())
+            bufSize = SOCKET_SEND_GATHER_SIZE;
+        }
+        buf = alloca(bufSize); // allocate on stack
+      }
+      if (bufLen == bufSize || (isUDP && len > bufSize-bufLen)) { // no space left (UDP packets can't be split)
+        jsvUnLock(item);
+        break;
+      }
+      size_t l = len < bufSize-bufLen ? len : bufSize-bufLen;
+      jsvGetStringChars(item, start, buf+bufLen, l);
+      bufs[count].buf = buf+bufLen;
+      bufs[count].len = l;
+      bufLen += l;
+    }
+    items[count] = item;
+    itemLen[count] = len;
+    count++;
+    if (!gather || bufs[count-1].len < len) break;
+    jsvObjectIteratorNext(&it);
+  }
+  jsvObjectIteratorFree(&it);
+
+  int num = count ? netSendv(net, socketType, sckt, bufs, count) : -1;
+  DBG("socketSendData %d bufs (%d -> %d)\n", count, count?bufs[0].len:0, num);
+  for (int i=0;i<count;i++) jsvUnLock(items[i]);
+  if (num < 0) {
+    jsvUnLock(queue);
+    return num; // an error occurred
+  }
+  // Now remove what we managed to send from the queue
+  if (num > 0) {
+    // UDP packets are only ever sent whole (and netSend may not count the header)
+    size_t sent = (isUDP && count==1) ? itemLen[0] : (size_t)num;
+    for (int i=0; i<count && sent>=itemLen[i]; i++) {
+      sent -= itemLen[i];
+      offset = 0;
+      jsvUnLock(jsvArrayPopFirst(queue));
+    }
+    offset += sent;
+    if (offset)
+      jsvObjectSetChildAndUnLock(connection, HTTP_NAME_SEND_OFFSET, jsvNewFromInteger((JsVarInt)offset));
+    else
+      jsvObjectRemoveChild(connection, HTTP_NAME_SEND_OFFSET);
+    if (jsvArrayIsEmpty(queue)) {
       // we sent all of it! Issue a drain event, unless we want to close, then we shouldn't
       // callback for more data
       bool wantClose = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_CLOSE));
       if (!wantClose) {
         jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_DRAIN, &connection, 1);
       }
-      newSendData = jsvNewFromEmptyString();
     }
-    jsvUnLock(*sendData);
-    *sendData = newSendData;
   }
-
+  jsvUnLock(queue);
   return 0;
 }
 
-void socketPushReceiveData(JsVar *reader, JsVar **receiveData, bool isHttp, bool force) {
+void socketPushReceiveData(JsVar *reader, JsVar **receiveData, bool isHttp, bool isServer, bool force) {
+  // If we couldn't push data last time, try that first
+  JsVar *pending = jsvObjectGetChildIfExists(reader, HTTP_NAME_RECEIVE_PENDING);
+  if (pending) {
+    bool ok = jswrap_stream_pushData(reader, pending, force);
+    jsvUnLock(pending);
+    if (!ok) return;
+    jsvObjectRemoveChild(reader, HTTP_NAME_RECEIVE_PENDING);
+  }
+
   if (!*receiveData || jsvIsEmptyString(*receiveData)) {
     // no data available (after headers)
     return;
   }
 
-  JsVar *nextChunk = 0;
-  JsVar *partialChunk = 0;
-
-  // Keep track of how much we received (so we can close once we have it)
-  if (isHttp) {
-    size_t len = (size_t)jsvGetStringLength(*receiveData);
-    if (jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(reader, HTTP_NAME_CHUNKED))) {
-      // check for incomplete chunk, at least "0\r\n\r\n"
-      if (len < 5) return; // incomplete, wait for more data
-
-      JsVar *crlf = jsvNewFromString("\r\n");
-      JsVar *zero = jsvNewFromInteger(0);
-      size_t startIdx = (size_t)jswrap_string_indexOf(*receiveData, crlf, zero, false);
-      jsvUnLock2(crlf, zero);
-
-      JsVar *sixteen = jsvNewFromInteger(16);
-      int chunkLen = jsvGetIntegerAndUnLock(jswrap_parseInt(*receiveData, sixteen));
-      jsvUnLock(sixteen);
-      DBG("D:%d\n", chunkLen);
-
-      // for 'chunked' set the counter to 1 to read on or 0 if at last chunk
-      jsvObjectSetChildAndUnLock(reader, HTTP_NAME_RECEIVE_COUNT, jsvNewFromInteger(chunkLen ? 1 : 0));
-      if (!chunkLen) { // no 'data' callback
-        // clear received data
-        jsvUnLock(*receiveData);
-        *receiveData = 0;
-        return;
+  size_t len = jsvGetStringLength(*receiveData);
+  size_t used = len; // how much of receiveData we have dealt with
+  JsVar *data = 0;
+  if (!isHttp) {
+    data = jsvLockAgain(*receiveData);
+  } else if (jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(reader, HTTP_NAME_CHUNKED))) {
+    data = httpDecodeChunked(reader, *receiveData, &used);
+  } else {
+    // Keep track of how much we received (so we can close once we have it)
+    JsVarInt contentToReceive = jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(reader, HTTP_NAME_RECEIVE_COUNT));
+    if (contentToReceive > 0) {
+      // anything after the content we were told about is the next message
+      if ((size_t)contentToReceive < len) used = (size_t)contentToReceive;
+    } else if (isServer) {
+      /* Without a Content-Length we just pass on everything until the connection
+       * closes - except for GET/HEAD requests, which have no body so anything
+       * else must be the next request */
+      JsVar *method = jsvObjectGetChildIfExists(reader, "method");
+      if (jsvIsStringEqual(method, "GET") || jsvIsStringEqual(method, "HEAD")) {
+        // ...unless it's asking to upgrade (eg. the 'ws' module), when everything is passed on
+        JsVar *headers = jsvObjectGetChildIfExists(reader, HTTP_NAME_HEADERS);
+        JsVar *upgrade = jsvObjectGetChildI(headers, "Upgrade");
+        if (!upgrade) used = 0;
+        jsvUnLock2(headers, upgrade);
       }
+      jsvUnLock(method);
+    }
+    if (used) {
+      jsvObjectSetChildAndUnLock(reader, HTTP_NAME_RECEIVE_COUNT, jsvNewFromInteger(contentToReceive - (JsVarInt)used));
+      data = (used==len) ? jsvLockAgain(*receiveData) : jsvNewFromStringVar(*receiveData, 0, used);
+    }
+  }
 
-      startIdx += 2; // skip the CRLF
-      size_t nextIdx = startIdx + (size_t)chunkLen + 2; // CRLF at the end
-      if (nextIdx < len) { // there is another chunk in the buffer
-        DBG("D:nextIdx %d %d\n", nextIdx, len);
-        nextChunk = jsvNewFromEmptyString();
-        if (!nextChunk) return; // out of memory
-        jsvAppendStringVar(nextChunk, *receiveData, nextIdx, len-nextIdx);
-      } else if (nextIdx > len) { // chunk not complete
-        DBG("D:partialIdx %d %d %d\n", len - startIdx, nextIdx - len - 2, len);
-        if (nextIdx - len < 3) return; // just CRLF missing, wait
-        // use the data available, write remaining length, wait
-        partialChunk = jsvNewFromEmptyString();
-        if (!partialChunk) return; // out of memory
-        jsvAppendPrintf(partialChunk, "%x\r\n", nextIdx - len - 2);
-      }
+  // remove what we've dealt with from receiveData (all of it if we're closing)
+  if (force) used = len;
+  if (used) {
+    JsVar *newReceiveData = (used<len) ? jsvNewFromStringVar(*receiveData, used, JSVAPPENDSTRINGVAR_MAXLENGTH) : 0;
+    jsvUnLock(*receiveData);
+    *receiveData = newReceiveData;
+  }
+
+  // execute 'data' callback or save data
+  if (data && !jsvIsEmptyString(data) && !jswrap_stream_pushData(reader, data, force))
+    jsvObjectSetChild(reader, HTTP_NAME_RECEIVE_PENDING, data);
+  jsvUnLock(data);
+}
+
+// -----------------------------
+
+/* WebSockets. Once connected (as a client, or when an HTTP server accepts an
+ * upgrade) a WebSocket is handled like a normal socket in
+ * HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS, but with HTTP_NAME_WEBSOCKET set so
+ * received data goes to websocketReceived rather than being passed on as-is.
+ * Frames are parsed straight out of the receive buffer, with the payload
+ * unmasked as it's copied out. */
+
+typedef enum {
+  WS_NONE,
+  WS_CLIENT_HANDSHAKE, ///< client waiting for the server's reply to the upgrade request
+  WS_CLIENT,           ///< client - frames we send must be masked
+  WS_SERVER,           ///< accepted by an HTTP server
+} WebSocketState;
+
+typedef enum {
+  WS_OP_CONTINUATION = 0,
+  WS_OP_TEXT = 1,
+  WS_OP_BINARY = 2,
+  WS_OP_CLOSE = 8,
+  WS_OP_PING = 9,
+  WS_OP_PONG = 10,
+} WebSocketOpcode;
+
+#define WEBSOCKET_FLAT_SIZE 64 // payloads at least this big are copied into flat strings
+
+static bool fireErrorEvent(int error, JsVar *obj1, JsVar *obj2);
+
+static WebSocketState websocketGetState(JsVar *ws) {
+  return (WebSocketState)jsvObjectGetIntegerChild(ws, HTTP_NAME_WEBSOCKET);
+}
 
-      JsVar *chunkData = jsvNewFromEmptyString();
-      if (!chunkData) return; // out of memory
-      jsvAppendStringVar(chunkData, *receiveData, startIdx, (size_t)chunkLen);
-      jsvUnLock(*receiveData);
-      *receiveData = chunkData;
+/// Copy len bytes from the iterator into a new string, XORing with mask (if set) as we go
+static JsVar *websocketCopyData(JsvStringIterator *it, size_t len, const unsigned char *mask) {
+  JsVar *data = (len >= WEBSOCKET_FLAT_SIZE) ? jsvNewFlatStringOfLength((unsigned int)len) : 0;
+  if (data) {
+    unsigned char *ptr = (unsigned char*)jsvGetFlatStringPointer(data);
+    for (size_t i=0;i<len;i++)
+      ptr[i] = (unsigned char)jsvStringIteratorGetCharAndNext(it) ^ (mask ? mask[i&3] : 0);
+    return data;
+  }
+  data = jsvNewFromEmptyString();
+  if (!data) return 0; // out of memory
+  JsvStringIterator dst;
+  jsvStringIteratorNew(&dst, data, 0);
+  for (size_t i=0;i<len;i++)
+    jsvStringIteratorAppend(&dst, (char)((unsigned char)jsvStringIteratorGetCharAndNext(it) ^ (mask ? mask[i&3] : 0)));
+  jsvStringIteratorFree(&dst);
+  return data;
+}
+
+/// Queue a frame to send. data can be a String, an ArrayBuffer/view, or 0
+static void websocketSendFrame(JsVar *ws, WebSocketOpcode opcode, JsVar *data) {
+  JsVar *queue = socketGetSendQueue(ws, true);
+  if (!queue) return;
+  JsVar *str = 0;
+  size_t offset = 0, len = 0;
+  bool isArrayBuffer = jsvIsArrayBuffer(data);
+  if (isArrayBuffer) {
+    uint32_t bufferOffset;
+    str = jsvGetArrayBufferBackingString(data, &bufferOffset);
+    offset = bufferOffset;
+    len = jsvGetArrayBufferLength(data) * JSV_ARRAYBUFFER_GET_SIZE(data->varData.arraybuffer.type);
+  } else if (data) {
+    str = jsvAsString(data);
+    len = jsvGetStringLength(str);
+  }
+  // header - clients have to mask what they send
+  bool masked = websocketGetState(ws) == WS_CLIENT;
+  unsigned char header[14], mask[4];
+  size_t headerLen = 0;
+  header[headerLen++] = (unsigned char)(0x80 | opcode); // FIN
+  if (len < 126) {
+    header[headerLen++] = (unsigned char)len;
+  } else if (len < 65536) {
+    header[headerLen++] = 126;
+    header[headerLen++] = (unsigned char)(len>>8);
+    header[headerLen++] = (unsigned char)len;
+  } else {
+    header[headerLen++] = 127;
+    for (int i=7;i>=0;i--)
+      header[headerLen++] = (unsigned char)((uint64_t)len >> (i*8));
+  }
+  if (masked) {
+    header[1] |= 0x80;
+    uint32_t r = (uint32_t)jshGetRandomNumber();
+    for (int i=0;i<4;i++)
+      header[headerLen++] = mask[i] = (unsigned char)(r >> (i*8));
+  }
+  JsVar *headerStr = jsvNewStringOfLength((unsigned int)headerLen, (char*)header);
+  if (headerStr) socketQueueSendData(queue, headerStr);
+  jsvUnLock(headerStr);
+  // payload
+  if (len) {
+    if (masked || isArrayBuffer) {
+      // copy (and mask) - ArrayBuffers could also change before they're sent
+      JsvStringIterator it;
+      jsvStringIteratorNew(&it, str, offset);
+      JsVar *copy = websocketCopyData(&it, len, masked ? mask : 0);
+      jsvStringIteratorFree(&it);
+      if (copy) socketQueueSendData(queue, copy);
+      jsvUnLock(copy);
     } else {
-      jsvObjectSetChildAndUnLock(reader, HTTP_NAME_RECEIVE_COUNT,
-        jsvNewFromInteger(
-          jsvGetIntegerAndUnLock(jsvObjectGetChild(reader, HTTP_NAME_RECEIVE_COUNT, JSV_INTEGER)) - (JsVarInt)len)
-        );
+      socketQueueSendData(queue, str);
     }
   }
+  jsvUnLock2(str, queue);
+}
 
-  // execute 'data' callback or save data
-  if (!jswrap_stream_pushData(reader, *receiveData, force)) {
-    jsvUnLock2(nextChunk, partialChunk);
+/// Send a close frame (with data as the payload) and close the connection once it's sent
+static void websocketSendClose(JsVar *ws, JsVar *data) {
+  if (!_socketConnectionOpen(ws)) return; // already closing
+  if (websocketGetState(ws) != WS_CLIENT_HANDSHAKE)
+    websocketSendFrame(ws, WS_OP_CLOSE, data);
+  jsvObjectSetChildAndUnLock(ws, HTTP_NAME_CLOSE, jsvNewFromBool(true));
+}
+
+static void websocketEmitMessage(JsVar *ws, int opcode, JsVar *data) {
+  JsVar *msg = (opcode == WS_OP_BINARY) ? jsvNewArrayBufferFromString(data, 0) : jsvLockAgain(data);
+  if (msg) jsiQueueObjectCallbacks(ws, HTTP_NAME_ON_MESSAGE, &msg, 1);
+  jsvUnLock(msg);
+}
+
+static void websocketHandleFrame(JsVar *ws, unsigned char b0, JsVar *data) {
+  bool fin = (b0 & 0x80) != 0;
+  int opcode = b0 & 15;
+  if (opcode == WS_OP_PING) {
+    websocketSendFrame(ws, WS_OP_PONG, data);
+    jsiQueueObjectCallbacks(ws, HTTP_NAME_ON_PING, &data, 1);
+  } else if (opcode == WS_OP_PONG) {
+    jsiQueueObjectCallbacks(ws, HTTP_NAME_ON_PONG, &data, 1);
+  } else if (opcode == WS_OP_CLOSE) {
+    // reply with the same status code
+    JsVar *code = jsvNewFromStringVar(data, 0, 2);
+    websocketSendClose(ws, code);
+    jsvUnLock(code);
+  } else if (opcode != WS_OP_CONTINUATION) {
+    if (fin) {
+      websocketEmitMessage(ws, opcode, data);
+    } else { // first part of a fragmented message
+      JsVar *fragment = jsvNewFromEmptyString();
+      if (fragment) jsvAppendStringVarComplete(fragment, data);
+      jsvObjectSetChildAndUnLock(ws, HTTP_NAME_WS_FRAGMENT, fragment);
+      jsvObjectSetChildAndUnLock(ws, HTTP_NAME_WS_OPCODE, jsvNewFromInteger(opcode));
+    }
+  } else {
+    JsVar *fragment = jsvObjectGetChildIfExists(ws, HTTP_NAME_WS_FRAGMENT);
+    if (fragment) {
+      jsvAppendStringVarComplete(fragment, data);
+      if (fin) {
+        websocketEmitMessage(ws, (int)jsvObjectGetIntegerChild(ws, HTTP_NAME_WS_OPCODE), fragment);
+        jsvObjectRemoveChild(ws, HTTP_NAME_WS_FRAGMENT);
+        jsvObjectRemoveChild(ws, HTTP_NAME_WS_OPCODE);
+      }
+      jsvUnLock(fragment);
+    }
+  }
+}
+
+/// Handle the server's reply to our upgrade request. Returns true if we're now connected
+static bool websocketClientHandshake(JsVar *ws, JsVar **receiveData) {
+  if (!httpParseHeaders(receiveData, ws, false)) return false;
+  jsvObjectRemoveChild(ws, HTTP_NAME_RECEIVE_COUNT);
+  jsvObjectRemoveChild(ws, HTTP_NAME_CHUNKED);
+  JsVar *statusCode = jsvObjectGetChildIfExists(ws, "statusCode");
+  bool upgraded = jsvIsStringEqual(statusCode, "101");
+  jsvUnLock(statusCode);
+  if (!upgraded) {
+    fireErrorEvent(SOCKET_ERR_WS_HAND, ws, NULL);
+    jsvObjectSetChildAndUnLock(ws, HTTP_NAME_CLOSENOW, jsvNewFromBool(true));
+    return false;
+  }
+  jsvObjectSetChildAndUnLock(ws, HTTP_NAME_WEBSOCKET, jsvNewFromInteger(WS_CLIENT));
+  jsiQueueObjectCallbacks(ws, HTTP_NAME_ON_OPEN, &ws, 1);
+  return true;
+}
+
+/// Handle all the complete frames in receiveData, and remove them from it
+static void websocketReceived(JsVar *ws, JsVar **receiveData) {
+  if (websocketGetState(ws) == WS_CLIENT_HANDSHAKE &&
+      !websocketClientHandshake(ws, receiveData))
     return;
+  if (!*receiveData) return;
+  size_t len = jsvGetStringLength(*receiveData);
+  size_t pos = 0; // start of the first frame we haven't handled
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, *receiveData, 0);
+  while (len-pos >= 2) {
+    unsigned char b0 = (unsigned char)jsvStringIteratorGetCharAndNext(&it);
+    unsigned char b1 = (unsigned char)jsvStringIteratorGetCharAndNext(&it);
+    uint64_t dataLen = b1 & 127;
+    size_t extendedLen = (dataLen==126) ? 2 : ((dataLen==127) ? 8 : 0);
+    size_t headerLen = 2 + extendedLen + ((b1&0x80) ? 4 : 0);
+    if (len-pos < headerLen) break; // wait for the rest of the header
+    if (extendedLen) {
+      dataLen = 0;
+      for (size_t i=0;i<extendedLen;i++)
+        dataLen = (dataLen<<8) | (unsigned char)jsvStringIteratorGetCharAndNext(&it);
+    }
+    unsigned char mask[4];
+    if (b1&0x80)
+      for (int i=0;i<4;i++)
+        mask[i] = (unsigned char)jsvStringIteratorGetCharAndNext(&it);
+    if (dataLen > JSVAPPENDSTRINGVAR_MAXLENGTH) {
+      // we could never hold this in memory
+      fireErrorEvent(SOCKET_ERR_WS_INVALID, ws, NULL);
+      jsvObjectSetChildAndUnLock(ws, HTTP_NAME_CLOSENOW, jsvNewFromBool(true));
+      pos = len;
+      break;
+    }
+    if (dataLen > len-pos-headerLen) break; // wait for the rest of the frame
+    JsVar *data = websocketCopyData(&it, (size_t)dataLen, (b1&0x80) ? mask : 0);
+    pos += headerLen + (size_t)dataLen;
+    if (data) websocketHandleFrame(ws, b0, data);
+    jsvUnLock(data);
+  }
+  jsvStringIteratorFree(&it);
+  if (pos) {
+    JsVar *newReceiveData = (pos<len) ? jsvNewFromStringVar(*receiveData, pos, JSVAPPENDSTRINGVAR_MAXLENGTH) : 0;
+    jsvUnLock(*receiveData);
+    *receiveData = newReceiveData;
   }
+}
 
-  // clear received data
+#ifdef WEBSOCKET_SERVER
+/** If this HTTP server request is a WebSocket upgrade and the server has a
+ * 'websocket' listener, move the connection over to a new WebSocket, reply,
+ * and return true */
+static bool websocketServerUpgrade(JsVar *req, JsVar *res, JsVar *server, JsVar **receiveData) {
+  JsVar *listener = jsvObjectGetChildIfExists(server, HTTP_NAME_ON_WEBSOCKET);
+  JsVar *headers = jsvObjectGetChildIfExists(req, HTTP_NAME_HEADERS);
+  JsVar *key = jsvObjectGetChildI(headers, "Sec-WebSocket-Key");
+  bool upgrade = listener && jsvIsString(key) &&
+                 jsvIsStringIEqualAndUnLock(jsvObjectGetChildI(headers, "Upgrade"), "websocket");
+  jsvUnLock2(listener, headers);
+  JsVar *ws = upgrade ? jspNewObject(0, "httpWS") : 0;
+  JsVar *arr = ws ? socketGetArray(HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS, true) : 0;
+  if (!arr) {
+    jsvUnLock2(key, ws);
+    return false;
+  }
+  // Sec-WebSocket-Accept is base64(sha1(key + magic string))
+  char keyStr[100];
+  size_t keyLen = jsvGetString(key, keyStr, 60);
+  strcpy(&keyStr[keyLen], "258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+  unsigned char hash[20];
+  mbedtls_sha1((unsigned char*)keyStr, strlen(keyStr), hash);
+  JsVar *hashStr = jsvNewStringOfLength(sizeof(hash), (char*)hash);
+  JsVar *accept = hashStr ? jswrap_btoa(hashStr) : 0;
+  JsVar *reply = jsvVarPrintf("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %v\r\n\r\n", accept);
+  jsvUnLock3(key, hashStr, accept);
+  // move the socket over to the WebSocket, and get rid of the request
+  socketSetType(ws, (SocketType)(socketGetType(req) & ST_TLS));
+  jsvObjectSetChildAndUnLock(ws, HTTP_NAME_WEBSOCKET, jsvNewFromInteger(WS_SERVER));
+  jsvObjectSetChildAndUnLock(ws, HTTP_NAME_CONNECTED, jsvNewFromBool(true));
+  jsvObjectSetChildAndUnLock(ws, HTTP_NAME_SOCKET, jsvObjectGetChildIfExists(req, HTTP_NAME_SOCKET));
+  jsvObjectRemoveChild(req, HTTP_NAME_SOCKET);
+  jsvObjectRemoveChild(res, HTTP_NAME_SOCKET);
+  jsvObjectSetChildAndUnLock(req, HTTP_NAME_CLOSENOW, jsvNewFromBool(true));
+  jsvObjectSetChild(ws, HTTP_NAME_RECEIVE_DATA, *receiveData); // anything sent after the request
   jsvUnLock(*receiveData);
-  *receiveData = nextChunk ? nextChunk : partialChunk;
+  *receiveData = 0;
+  JsVar *queue = socketGetSendQueue(ws, true);
+  if (queue && reply) socketQueueSendData(queue, reply);
+  jsvUnLock2(queue, reply);
+  jsvArrayPush(arr, ws);
+  jsvUnLock(arr);
+  JsVar *args[2] = { ws, req };
+  jsiQueueObjectCallbacks(server, HTTP_NAME_ON_WEBSOCKET, args, 2);
+  jsvUnLock(ws);
+  return true;
+}
+#endif
 
-  if (nextChunk) { // process following chunks if any
-    socketPushReceiveData(reader, receiveData, isHttp, force);
+JsVar *websocketConnect(JsNetwork *net, JsVar *options, JsVar *callback) {
+  SocketType socketType = ST_NORMAL;
+  JsVar *protocol = jsvObjectGetChildIfExists(options, "protocol");
+  if (jsvIsStringEqual(protocol, "wss:") || jsvIsStringEqual(protocol, "https:"))
+    socketType |= ST_TLS;
+  jsvUnLock(protocol);
+
+  JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS, true);
+  JsVar *ws = arr ? jspNewObject(0, "httpWS") : 0;
+  JsVar *queue = ws ? socketGetSendQueue(ws, true) : 0;
+  if (!queue) {
+    jsvUnLock2(arr, ws);
+    return 0; // out of memory
+  }
+  socketSetType(ws, socketType);
+  jsvObjectSetChild(ws, HTTP_NAME_OPTIONS_VAR, options);
+  jsvObjectSetChildAndUnLock(ws, HTTP_NAME_WEBSOCKET, jsvNewFromInteger(WS_CLIENT_HANDSHAKE));
+  if (jsvIsFunction(callback))
+    jsvUnLock(jsvAddNamedChild(ws, callback, HTTP_NAME_ON_OPEN));
+  // the upgrade request
+  char key[16];
+  for (size_t i=0;i<sizeof(key);i++) key[i] = (char)jshGetRandomNumber();
+  JsVar *keyStr = jsvNewStringOfLength(sizeof(key), key);
+  JsVar *keyBase64 = keyStr ? jswrap_btoa(keyStr) : 0;
+  JsVar *path = jsvObjectGetChildIfExists(options, "path");
+  JsVar *host = jsvObjectGetChildIfExists(options, "host");
+  JsVar *request = jsvVarPrintf("GET %v HTTP/1.1\r\nHost: %v\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                "Sec-WebSocket-Key: %v\r\nSec-WebSocket-Version: 13\r\n",
+                                jsvIsUndefined(path) ? 0 : path, host, keyBase64);
+  jsvUnLock4(keyStr, keyBase64, path, host);
+  if (request) {
+    JsVar *headers = jsvObjectGetChildIfExists(options, HTTP_NAME_HEADERS);
+    if (jsvIsObject(headers)) httpAppendHeaders(request, headers);
+    jsvUnLock(headers);
+    jsvAppendString(request, "\r\n");
+    jsvArrayPush(queue, request);
+    jsvUnLock(request);
   }
+  jsvUnLock(queue);
+  jsvArrayPush(arr, ws);
+  jsvUnLock(arr);
+  clientRequestConnect(net, ws);
+  return ws;
+}
+
+void websocketSend(JsVar *ws, JsVar *data, bool binary) {
+  if (!_socketConnectionOpen(ws)) {
+    jsExceptionHere(JSET_ERROR, "This socket is closed");
+    return;
+  }
+  if (websocketGetState(ws) == WS_CLIENT_HANDSHAKE) {
+    jsExceptionHere(JSET_ERROR, "WebSocket isn't open yet");
+    return;
+  }
+  websocketSendFrame(ws, (binary || jsvIsArrayBuffer(data)) ? WS_OP_BINARY : WS_OP_TEXT, data);
+}
+
+void websocketPing(JsVar *ws, JsVar *data) {
+  if (_socketConnectionOpen(ws) && websocketGetState(ws) != WS_CLIENT_HANDSHAKE)
+    websocketSendFrame(ws, WS_OP_PING, data);
+}
+
+void websocketClose(JsVar *ws, int code) {
+  JsVar *data = 0;
+  if (code > 0) {
+    char codeStr[2] = { (char)(code>>8), (char)code };
+    data = jsvNewStringOfLength(2, codeStr);
+  }
+  websocketSendClose(ws, data);
+  jsvUnLock(data);
+}
+
+/// Send all the UDP packets in receiveData as one 'messages' event (see the dgram 'batch' option)
+static void socketReceivedUDPBatch(JsVar *connection, JsVar *receiveData, size_t len) {
+  // find out how many complete packets we have, and how much data is in them
+  JsNetUDPPacketHeader header;
+  size_t count = 0, dataLen = 0, pos = 0;
+  while (pos+sizeof(header) <= len) {
+    jsvGetStringChars(receiveData, pos, (char*)&header, sizeof(header));
+    if (pos+sizeof(header)+header.length > len) break; // not all there
+    count++;
+    dataLen += header.length;
+    pos += sizeof(header)+header.length;
+  }
+  if (!count) return;
+  // packet data goes into one ArrayBuffer, with [offset,length,address,port] for each in a Uint32Array
+  JsVar *str = jsvNewFlatStringOfLength((unsigned int)dataLen);
+  char *ptr = str ? jsvGetFlatStringPointer(str) : 0;
+  if (!str) str = jsvNewFromEmptyString();
+  JsVar *info = jsvNewTypedArray(ARRAYBUFFERVIEW_UINT32, (JsVarInt)(count*4));
+  if (str && info) {
+    JsvArrayBufferIterator it;
+    jsvArrayBufferIteratorNew(&it, info, 0);
+    size_t offset = 0;
+    pos = 0;
+    for (size_t i=0;i<count;i++) {
+      jsvGetStringChars(receiveData, pos, (char*)&header, sizeof(header));
+      pos += sizeof(header);
+      if (ptr) jsvGetStringChars(receiveData, pos, &ptr[offset], header.length);
+      else jsvAppendStringVar(str, receiveData, pos, header.length);
+      JsVarInt values[4] = {
+        (JsVarInt)offset, header.length,
+        (JsVarInt)(header.host[0] | (header.host[1]<<8) | (header.host[2]<<16) | ((uint32_t)header.host[3]<<24)),
+        header.port };
+      for (int j=0;j<4;j++) {
+        jsvArrayBufferIteratorSetIntegerValue(&it, values[j]);
+        jsvArrayBufferIteratorNext(&it);
+      }
+      offset += header.length;
+      pos += header.length;
+    }
+    jsvArrayBufferIteratorFree(&it);
+    JsVar *args[2] = { jsvNewArrayBufferFromString(str, (unsigned int)dataLen), info };
+    jsiQueueObjectCallbacks(connection, DGRAM_NAME_ON_MESSAGES, args, 2);
+    jsvUnLock(args[0]);
+  }
+  jsvUnLock2(str, info);
 }
 
 void socketReceivedUDP(JsVar *connection, JsVar **receiveData) {
-  // Get the header
   size_t len = jsvGetStringLength(*receiveData);
-  if (len < sizeof(JsNetUDPPacketHeader)) return; // not enough data for header!
-  char buf[sizeof(JsNetUDPPacketHeader)];
-  jsvGetStringChars(*receiveData, 0, buf, sizeof(JsNetUDPPacketHeader));
-  JsNetUDPPacketHeader *header = (JsNetUDPPacketHeader*)buf;
-  if (sizeof(JsNetUDPPacketHeader)+header->length < len) return; // not enough data yet
-
-  JsVar *rinfo = jsvNewObject();
-  if (rinfo) {
+  size_t pos = 0; // how much of receiveData we've dealt with
+  JsVar *options = jsvObjectGetChildIfExists(connection, HTTP_NAME_OPTIONS_VAR);
+  bool batch = jsvObjectGetBoolChild(options, "batch");
+  jsvUnLock(options);
+  if (batch) {
+    socketReceivedUDPBatch(connection, *receiveData, len);
+    pos = len;
+  }
+  // otherwise, a 'message' event for each complete packet
+  while (pos+sizeof(JsNetUDPPacketHeader) <= len) {
+    // Get the header
+    char buf[sizeof(JsNetUDPPacketHeader)];
+    jsvGetStringChars(*receiveData, pos, buf, sizeof(JsNetUDPPacketHeader));
+    JsNetUDPPacketHeader *header = (JsNetUDPPacketHeader*)buf;
+    if (pos+sizeof(JsNetUDPPacketHeader)+header->length > len) break; // not enough data yet
+
+    JsVar *rinfo = jsvNewObject();
+    if (!rinfo) break; // out of memory
     // split the received data string to get the data we need
-    JsVar *data = jsvNewFromStringVar(*receiveData, sizeof(JsNetUDPPacketHeader), header->length);
-    JsVar *newReceiveData = 0;
-    if (len > sizeof(JsNetUDPPacketHeader)+header->length)
-      newReceiveData = jsvNewFromStringVar(*receiveData, sizeof(JsNetUDPPacketHeader)+header->length, JSVAPPENDSTRINGVAR_MAXLENGTH);
-    jsvUnLock(*receiveData);
-    *receiveData = newReceiveData;
+    JsVar *data = jsvNewFromStringVar(*receiveData, pos+sizeof(JsNetUDPPacketHeader), header->length);
+    pos += sizeof(JsNetUDPPacketHeader)+header->length;
     // fire the received data event
     jsvObjectSetChildAndUnLock(rinfo, "address", jsvVarPrintf("%d.%d.%d.%d", header->host[0], header->host[1], header->host[2], header->host[3]));
     jsvObjectSetChildAndUnLock(rinfo, "port", jsvNewFromInteger(header->port));
@@ -409,6 +1171,11 @@ void socketReceivedUDP(JsVar *connection, JsVar **receiveData) {
     jsiQueueObjectCallbacks(connection, DGRAM_NAME_ON_MESSAGE, args, 2);
     jsvUnLock2(data,rinfo);
   }
+  if (pos) {
+    JsVar *newReceiveData = (pos<len) ? jsvNewFromStringVar(*receiveData, pos, JSVAPPENDSTRINGVAR_MAXLENGTH) : 0;
+    jsvUnLock(*receiveData);
+    *receiveData = newReceiveData;
+  }
 }
 
 void socketReceived(JsVar *connection, JsVar *socket, SocketType socketType, JsVar **receiveData, bool isServer) {
@@ -416,6 +1183,10 @@ void socketReceived(JsVar *connection, JsVar *socket, SocketType socketType, JsV
     socketReceivedUDP(connection, receiveData);
     return;
   }
+  if (!isServer && websocketGetState(connection)) {
+    websocketReceived(connection, receiveData);
+    return;
+  }
   JsVar *reader = isServer ? connection : socket;
   bool isHttp = (socketType&ST_TYPE_MASK)==ST_HTTP;
   bool hadHeaders = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(reader,HTTP_NAME_HAD_HEADERS));
@@ -428,6 +1199,12 @@ void socketReceived(JsVar *connection, JsVar *socket, SocketType socketType, JsV
       // on connect only when just parsed the HTTP headers
       if (isServer) {
         JsVar *server = jsvObjectGetChildIfExists(connection,HTTP_NAME_SERVER_VAR);
+#ifdef WEBSOCKET_SERVER
+        if (websocketServerUpgrade(connection, socket, server, receiveData)) {
+          jsvUnLock(server);
+          return;
+        }
+#endif
         JsVar *args[2] = { connection, socket };
         jsiQueueObjectCallbacks(server, HTTP_NAME_ON_CONNECT, args, isHttp ? 2 : 1);
         jsvUnLock(server);
@@ -441,7 +1218,7 @@ void socketReceived(JsVar *connection, JsVar *socket, SocketType socketType, JsV
     // no headers yet, no 'data' callback
     return;
   }
-  socketPushReceiveData(reader, receiveData, isHttp, false);
+  socketPushReceiveData(reader, receiveData, isHttp, isServer, false);
 }
 
 
@@ -486,6 +1263,101 @@ static bool fireErrorEvent(int error, JsVar *obj1, JsVar *obj2) {
 
 // -----------------------------
 
+/* Each idle pass we read everything a socket has ready, up to a budget that
+ * starts at net->chunkSize. The budget doubles (up to SOCKET_RECV_MAX_CHUNKS
+ * chunks) each time a pass fills it, and halves when a pass reads less than a
+ * quarter of it, so bulk transfers get big reads while idle connections cost
+ * nothing. Anything bigger than a chunk is read straight into a flat string,
+ * which is used as-is if there was nothing waiting to be handled already. */
+static size_t socketRecvGetBudget(JsNetwork *net, JsVar *connection) {
+  JsVarInt budget = jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_RECEIVE_BUDGET));
+  return (budget > net->chunkSize) ? (size_t)budget : (size_t)net->chunkSize;
+}
+
+static void socketRecvSetBudget(JsNetwork *net, JsVar *connection, size_t budget) {
+  if (budget > (size_t)net->chunkSize)
+    jsvObjectSetChildAndUnLock(connection, HTTP_NAME_RECEIVE_BUDGET, jsvNewFromInteger((JsVarInt)budget));
+  else
+    jsvObjectRemoveChild(connection, HTTP_NAME_RECEIVE_BUDGET);
+}
+
+/** Append data to *receiveData. While there's only a little data already we gather
+ * it into a new flat string, but after that we append in place - copying everything
+ * on each read would be O(n^2) and need twice the memory. Flat strings can't be
+ * appended to, so a big flat string gets copied into a normal one (just once) */
+static void socketRecvAppend(JsVar **receiveData, const char *data, size_t len, size_t chunkSize) {
+  JsVar *old = *receiveData;
+  size_t oldLen = old ? jsvGetStringLength(old) : 0;
+  JsVar *newData = 0;
+  if (oldLen <= chunkSize && oldLen+len > chunkSize) {
+    newData = jsvNewFlatStringOfLength((unsigned int)(oldLen+len));
+    if (newData) {
+      char *ptr = jsvGetFlatStringPointer(newData);
+      if (oldLen) jsvGetStringChars(old, 0, ptr, oldLen);
+      memcpy(&ptr[oldLen], data, len);
+    }
+  }
+  if (!newData) { // small, already big, or not enough contiguous memory for a flat string
+    if (old && !jsvIsFlatString(old)) {
+      jsvAppendStringBuf(old, data, len);
+      return;
+    }
+    newData = jsvNewFromEmptyString();
+    if (!newData) return; // out of memory
+    if (old) jsvAppendStringVarComplete(newData, old);
+    jsvAppendStringBuf(newData, data, len);
+  }
+  jsvUnLock(old);
+  *receiveData = newData;
+}
+
+/** Read as much as we can from the socket (up to this connection's budget) onto the end
+ * of *receiveData (which is created if needed). buf must be net->chunkSize bytes. Returns
+ * the number of bytes read, or if nothing was read, what netRecv returned. UDP packets
+ * can be up to chunkSize, so we only ask for more while there's room for a whole one */
+static int socketRecv(JsNetwork *net, JsVar *connection, SocketType socketType, int sckt, char *buf, JsVar **receiveData) {
+  size_t chunkSize = (size_t)net->chunkSize;
+  int num = netRecv(net, socketType, sckt, buf, chunkSize);
+  if (num <= 0) return num;
+  size_t total = (size_t)num;
+  const char *data = buf;
+  JsVar *bigBuf = 0;
+  size_t minRead = ((socketType&ST_TYPE_MASK) == ST_UDP) ? chunkSize : 1;
+  if (total == chunkSize || minRead > 1) {
+    // we filled the buffer (or got a packet), so there's probably more waiting
+    size_t budget = socketRecvGetBudget(net, connection);
+    if (budget > chunkSize)
+      bigBuf = jsvNewFlatStringOfLength((unsigned int)budget);
+    if (bigBuf) {
+      char *ptr = jsvGetFlatStringPointer(bigBuf);
+      memcpy(ptr, buf, total);
+      while (budget-total >= minRead) {
+        num = netRecv(net, socketType, sckt, &ptr[total], budget-total);
+        if (num <= 0) break; // nothing more for now - any error will come up again next time
+        total += (size_t)num;
+      }
+      data = ptr;
+    }
+    if (budget-total < minRead) {
+      if (budget < chunkSize*SOCKET_RECV_MAX_CHUNKS)
+        socketRecvSetBudget(net, connection, budget*2);
+    } else if (total < budget/4)
+      socketRecvSetBudget(net, connection, budget/2);
+  } else if (total < chunkSize/4 && socketRecvGetBudget(net, connection) > chunkSize)
+    socketRecvSetBudget(net, connection, chunkSize);
+
+  if (bigBuf && total==jsvGetStringLength(bigBuf) && (!*receiveData || jsvIsEmptyString(*receiveData))) {
+    // we filled bigBuf and had nothing before, so just use it as-is
+    jsvUnLock(*receiveData);
+    *receiveData = bigBuf;
+    return (int)total;
+  }
+  if (!*receiveData) *receiveData = jsvNewFromEmptyString();
+  if (*receiveData) socketRecvAppend(receiveData, data, total, chunkSize);
+  jsvUnLock(bigBuf);
+  return (int)total;
+}
+
 bool socketServerConnectionsIdle(JsNetwork *net) {
   char *buf = alloca((size_t)net->chunkSize); // allocate on stack
 
@@ -509,28 +1381,22 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
     int error = 0;
 
     if (!closeConnectionNow) {
-      int num = netRecv(net, socketType, sckt, buf, (size_t)net->chunkSize);
+      JsVar *receiveData = jsvObjectGetChildIfExists(connection,HTTP_NAME_RECEIVE_DATA);
+      int num = socketRecv(net, connection, socketType, sckt, buf, &receiveData);
       if (num<0) {
         // we probably disconnected so just get rid of this
         closeConnectionNow = true;
         error = num;
-      } else {
-        if (num>0) {
-          JsVar *receiveData = jsvObjectGetChildIfExists(connection,HTTP_NAME_RECEIVE_DATA);
-          if (!receiveData) receiveData = jsvNewFromEmptyString();
-          if (receiveData) {
-            jsvAppendStringBuf(receiveData, buf, (size_t)num);
-            socketReceived(connection, socket, socketType, &receiveData, true);
-            jsvObjectSetChild(connection,HTTP_NAME_RECEIVE_DATA,receiveData);
-            jsvUnLock(receiveData);
-          }
-        }
+      } else if (num>0 && receiveData) {
+        socketReceived(connection, socket, socketType, &receiveData, true);
+        jsvObjectSetChild(connection,HTTP_NAME_RECEIVE_DATA,receiveData);
       }
+      jsvUnLock(receiveData);
 
       // send data if possible
-      JsVar *sendData = jsvObjectGetChildIfExists(socket,HTTP_NAME_SEND_DATA);
-      if (sendData && !jsvIsEmptyString(sendData)) {
-        int sent = socketSendData(net, socket, sckt, &sendData);
+      bool hasSendData = socketHasSendData(socket);
+      if (hasSendData) {
+        int sent = socketSendData(net, socket, sckt);
         // FIXME? checking for errors is a bit iffy. With the esp8266 network that returns
         // varied error codes we'd want to skip SOCKET_ERR_CLOSED and let the recv side deal
         // with normal closing so we don't miss the tail of what's received, but other drivers
@@ -540,10 +1406,10 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
           closeConnectionNow = true;
           error = sent;
         }
-        jsvObjectSetChild(socket, HTTP_NAME_SEND_DATA, sendData); // socketSendData updated sendData
+        hasSendData = socketHasSendData(socket);
       }
       // only close if we want to close, have no data to send, and aren't receiving data
-      if ((!sendData || jsvIsEmptyString(sendData)) && num<=0) {
+      if (!hasSendData && num<=0) {
         bool reallyCloseNow = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(socket,HTTP_NAME_CLOSE));
         if (isHttp) {
           bool hadHeaders = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_HAD_HEADERS));
@@ -559,7 +1425,6 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
         closeConnectionNow = reallyCloseNow;
       } else if (num > 0)
         closeConnectionNow = false; // guarantee that anything received is processed
-      jsvUnLock(sendData);
     }
     if (closeConnectionNow) {
       DBG("CLOSE NOW\n");
@@ -569,7 +1434,7 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
       if (hadHeaders) {
         // execute 'data' callback or save data
         JsVar *receiveData = jsvObjectGetChildIfExists(connection,HTTP_NAME_RECEIVE_DATA);
-        socketPushReceiveData(connection, &receiveData, isHttp, true);
+        socketPushReceiveData(connection, &receiveData, isHttp, true, true);
         jsvUnLock(receiveData);
       }
 
@@ -617,6 +1482,7 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
     JsVar *connection = jsvObjectIteratorGetValue(&it);
     SocketType socketType = socketGetType(connection);
     bool isHttp = (socketType&ST_TYPE_MASK) == ST_HTTP;
+    bool isWebSocket = websocketGetState(connection) != WS_NONE; // data is handled by websocketReceived
     JsVar *socket = isHttp ? jsvObjectGetChildIfExists(connection,HTTP_NAME_RESPONSE_VAR) : jsvLockAgain(connection);
     bool socketClosed = false;
     JsVar *receiveData = 0;
@@ -624,6 +1490,7 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
     bool hadHeaders = false;
     int error = 0; // error code received from netXxxx functions
     bool closeConnectionNow = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_CLOSENOW));
+    bool canReuse = isHttp && !closeConnectionNow; // can the connection be pooled when we're done? (keepAlive)
     bool alreadyConnected = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_CONNECTED));
     int sckt = (int)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_SOCKET))-1; // so -1 if undefined
     if (sckt>=0) {
@@ -635,28 +1502,31 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
 
       /* We do this up here because we want to wait until we have been once
        * around the idle loop (=callbacks have been executed) before we run this */
-      if (hadHeaders)
-        socketPushReceiveData(socket, &receiveData, isHttp, false);
+      if (hadHeaders && !isWebSocket) {
+        socketPushReceiveData(socket, &receiveData, isHttp, false, false);
+        jsvObjectSetChild(connection, HTTP_NAME_RECEIVE_DATA, receiveData);
+      }
 
       if (!closeConnectionNow) {
-        JsVar *sendData = jsvObjectGetChildIfExists(connection,HTTP_NAME_SEND_DATA);
+        bool hasSendData = socketHasSendData(connection);
         // send data if possible
-        if (sendData && !jsvIsEmptyString(sendData)) {
+        if (hasSendData) {
           // don't try to send if we're already in error state
           int num = 0;
           if (error == 0) {
-              num = socketSendData(net, connection, sckt, &sendData);
+              num = socketSendData(net, connection, sckt);
           }
-          if (num > 0 && !alreadyConnected && !isHttp) { // whoa, we sent something, must be connected!
+          if (num > 0 && !alreadyConnected && !isHttp && !isWebSocket) { // whoa, we sent something, must be connected!
             jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_CONNECT, &connection, 1);
             jsvObjectSetChildAndUnLock(connection, HTTP_NAME_CONNECTED, jsvNewFromBool(true));
             alreadyConnected = true;
           }
           if (num < 0) {
             closeConnectionNow = true;
+            canReuse = false;
             error = num;
           }
-          jsvObjectSetChild(connection, HTTP_NAME_SEND_DATA, sendData); // socketSendData updated sendData
+          hasSendData = socketHasSendData(connection);
         } else {
           // no data to send, do we want to close? do so.
           if (jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_CLOSE)))
@@ -673,11 +1543,12 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
           }
         }
         // Now read data if possible (and we have space for it)
-        int num = netRecv(net, socketType, sckt, buf, (size_t)net->chunkSize);
+        int num = socketRecv(net, connection, socketType, sckt, buf, &receiveData);
         if (!alreadyConnected && num == SOCKET_ERR_NO_CONN) {
           ; // ignore... it's just telling us we're not connected yet
         } else if (num < 0) {
           closeConnectionNow = true;
+          canReuse = false;
           // only error out when the response was not completely received
           if (num == SOCKET_ERR_CLOSED) {
             JsVarInt contentToReceive = jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(socket, HTTP_NAME_RECEIVE_COUNT));
@@ -691,40 +1562,41 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
           }
         } else {
           // did we just get connected?
-          if (!alreadyConnected && !isHttp) {
+          if (!alreadyConnected && !isHttp && !isWebSocket) {
             jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_CONNECT, &connection, 1);
             jsvObjectSetChildAndUnLock(connection, HTTP_NAME_CONNECTED, jsvNewFromBool(true));
             alreadyConnected = true;
             // if we do not have any data to send, issue a drain event
-            if (!sendData || jsvIsEmptyString(sendData))
+            if (!hasSendData)
               jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_DRAIN, &connection, 1);
           }
-          // got data add it to our receive buffer
-          if (num > 0) {
-            if (!receiveData)
-              receiveData = jsvNewFromEmptyString();
-            if (receiveData) { // could be out of memory
-              jsvAppendStringBuf(receiveData, buf, (size_t)num);
-              socketReceived(connection, socket, socketType, &receiveData, false);
-              jsvObjectSetChild(connection, HTTP_NAME_RECEIVE_DATA, receiveData);
-            }
+          // got data - socketRecv added it to our receive buffer
+          if (num > 0 && receiveData) { // could be out of memory
+            socketReceived(connection, socket, socketType, &receiveData, false);
+            jsvObjectSetChild(connection, HTTP_NAME_RECEIVE_DATA, receiveData);
           }
         }
-        jsvUnLock(sendData);
       }
     }
 
     if (closeConnectionNow) {
       DBG("close now\n");
 
-      socketPushReceiveData(socket, &receiveData, isHttp, true);
+      if (isWebSocket) { // any partial frame is just dropped
+        jsvUnLock(receiveData);
+        receiveData = 0;
+      } else
+        socketPushReceiveData(socket, &receiveData, isHttp, false, true);
       if (!receiveData || jsvIsEmptyString(receiveData)) {
         // If we had data to send but the socket closed, this is an error
-        JsVar *sendData = jsvObjectGetChildIfExists(connection,HTTP_NAME_SEND_DATA);
-        if (sendData && !jsvIsEmptyString(sendData) && error == SOCKET_ERR_CLOSED)
+        if (socketHasSendData(connection) && error == SOCKET_ERR_CLOSED)
           error = SOCKET_ERR_UNSENT_DATA;
-        jsvUnLock(sendData);
 
+        if (canReuse && !error && !socketHasSendData(connection) && socketPoolCanReuse(connection, socket)) {
+          JsVar *options = jsvObjectGetChildIfExists(connection, HTTP_NAME_OPTIONS_VAR);
+          socketPoolAdd(net, connection, options); // removes the socket, so _socketConnectionKill won't close it
+          jsvUnLock(options);
+        }
         _socketConnectionKill(net, connection);
         JsVar *connectionName = jsvObjectIteratorGetKey(&it);
         jsvObjectIteratorNext(&it);
@@ -761,6 +1633,7 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
 
 
 bool socketIdle(JsNetwork *net) {
+  unsigned int activity = netActivity;
   if (networkState != NETWORKSTATE_ONLINE) {
     // clear all clients and servers
     _socketCloseAllConnections(net);
@@ -832,8 +1705,27 @@ bool socketIdle(JsNetwork *net) {
 
   if (socketServerConnectionsIdle(net)) hadSockets = true;
   if (socketClientConnectionsIdle(net)) hadSockets = true;
+  socketPoolIdle(net);
   netCheckError(net);
+#ifdef LINUX
+  /* On Linux, jshSleep wakes as soon as a socket is ready, so we only need
+   * to stay busy if something actually happened */
+  NOT_USED(hadSockets);
+  return netActivity != activity;
+#else
   return hadSockets;
+#endif
+}
+
+bool socketHasConnections() {
+  const char *names[] = { HTTP_ARRAY_HTTP_SERVERS, HTTP_ARRAY_HTTP_SERVER_CONNECTIONS, HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS };
+  for (unsigned int i=0;i<sizeof(names)/sizeof(names[0]);i++) {
+    JsVar *arr = socketGetArray(names[i], false);
+    bool hasConnections = arr && !jsvArrayIsEmpty(arr);
+    jsvUnLock(arr);
+    if (hasConnections) return true;
+  }
+  return false;
 }
 
 // -----------------------------
@@ -847,8 +1739,21 @@ JsVar *serverNew(SocketType socketType, JsVar *callback) {
 }
 
 void serverAddMembership(JsNetwork *net, JsVar *server, JsVar *group, JsVar *ip) {
-  NOT_USED(net);
-  // FIXME: perhaps extend the JsNetwork with addmembership/removemembership instead of using options
+  int sckt = (int)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(server,HTTP_NAME_SOCKET))-1; // so -1 if undefined
+  if (sckt>=0 && net->addmembership) {
+    // already bound, so join the group now
+    char ipStr[18];
+    uint32_t groupIp = 0, ifIp = 0;
+    jsvGetString(group, ipStr, sizeof(ipStr));
+    networkGetHostByName(net, ipStr, &groupIp);
+    if (!jsvIsUndefined(ip)) {
+      jsvGetString(ip, ipStr, sizeof(ipStr));
+      networkGetHostByName(net, ipStr, &ifIp);
+    }
+    net->addmembership(net, sckt, groupIp, ifIp);
+    return;
+  }
+  // Otherwise store it in the options, so it's done when the socket is created
   JsVar *options = jsvObjectGetChildIfExists(server, HTTP_NAME_OPTIONS_VAR);
   if (options) {
       jsvObjectSetChild(options, "multicastGroup", group);
@@ -930,6 +1835,10 @@ JsVar *clientRequestNew(SocketType socketType, JsVar *options, JsVar *callback)
   return req;
 }
 
+static void socketAppendByte(int item, void *it) {
+  jsvStringIteratorAppend((JsvStringIterator*)it, (char)item);
+}
+
 void clientRequestWrite(JsNetwork *net, JsVar *httpClientReqVar, JsVar *data, JsVar *host, unsigned short portNumber) {
   if (!_socketConnectionOpen(httpClientReqVar)) {
     jsExceptionHere(JSET_ERROR, "This socket is closed");
@@ -937,9 +1846,9 @@ void clientRequestWrite(JsNetwork *net, JsVar *httpClientReqVar, JsVar *data, Js
   }
   SocketType socketType = socketGetType(httpClientReqVar);
 
-  // Append data to sendData
-  JsVar *sendData = jsvObjectGetChildIfExists(httpClientReqVar, HTTP_NAME_SEND_DATA);
-  if (!sendData) {
+  // Append data to the send queue
+  JsVar *sendQueue = socketGetSendQueue(httpClientReqVar, false);
+  if (!sendQueue) {
     JsVar *options = 0;
     // Only append a header if we're doing HTTP AND we haven't already connected
     if ((socketType&ST_TYPE_MASK) == ST_HTTP)
@@ -949,7 +1858,8 @@ void clientRequestWrite(JsNetwork *net, JsVar *httpClientReqVar, JsVar *data, Js
       // We're an HTTP client - make a header
       JsVar *method = jsvObjectGetChildIfExists(options, "method");
       JsVar *path = jsvObjectGetChildIfExists(options, "path");
-      sendData = jsvVarPrintf("%v %v HTTP/1.1\r\nUser-Agent: Espruino "JS_VERSION"\r\nConnection: close\r\n", method, path);
+      JsVar *sendData = jsvVarPrintf("%v %v HTTP/1.1\r\nUser-Agent: Espruino "JS_VERSION"\r\nConnection: %s\r\n",
+          method, path, socketPoolCanUse(options, socketType) ? "keep-alive" : "close");
       jsvUnLock2(method, path);
       JsVar *headers = jsvObjectGetChildIfExists(options, HTTP_NAME_HEADERS);
       bool hasHostHeader = false;
@@ -975,38 +1885,57 @@ void clientRequestWrite(JsNetwork *net, JsVar *httpClientReqVar, JsVar *data, Js
       }
       // finally add ending newline
       jsvAppendString(sendData, "\r\n");
+      sendQueue = socketGetSendQueue(httpClientReqVar, true);
+      if (sendQueue && sendData) jsvArrayPush(sendQueue, sendData);
+      jsvUnLock(sendData);
     } else { // !options
       // We're not HTTP (or were already connected), so don't send any header
-      sendData = jsvNewFromString("");
+      sendQueue = socketGetSendQueue(httpClientReqVar, true);
     }
-    jsvObjectSetChild(httpClientReqVar, HTTP_NAME_SEND_DATA, sendData);
     jsvUnLock(options);
   }
   // We have data and aren't out of memory...
-  if (data && sendData) {
+  if (data && sendQueue && (socketType&ST_TYPE_MASK) == ST_UDP) {
+    /* each packet is queued separately, with its header. We copy the data (which
+     * can be an ArrayBuffer) straight into a flat string if we can, so it can then
+     * be sent without being copied again */
+    JsVar *d = (jsvIsString(data) || jsvIsArrayBuffer(data)) ? jsvLockAgain(data) : jsvAsString(data);
+    char hostName[128];
+    jsvGetString(host, hostName, sizeof(hostName));
+    JsNetUDPPacketHeader header;
+    networkGetHostByName(net, hostName, (uint32_t*)&header.host);
+    header.port = portNumber;
+    header.length = (uint16_t)jsvIterateCallbackCount(d);
+    JsVar *packet = jsvNewFlatStringOfLength((unsigned int)(sizeof(header)+header.length));
+    if (packet) {
+      char *ptr = jsvGetFlatStringPointer(packet);
+      memcpy(ptr, &header, sizeof(header));
+      jsvIterateCallbackToBytes(d, (unsigned char*)&ptr[sizeof(header)], header.length);
+    } else if ((packet = jsvNewFromEmptyString())) { // not enough contiguous memory
+      jsvAppendStringBuf(packet, (const char*)&header, sizeof(header));
+      JsvStringIterator it;
+      jsvStringIteratorNew(&it, packet, 0);
+      jsvStringIteratorGotoEnd(&it);
+      jsvIterateCallback(d, socketAppendByte, &it);
+      jsvStringIteratorFree(&it);
+    }
+    if (packet) jsvArrayPush(sendQueue, packet);
+    jsvUnLock2(packet, d);
+  } else if (data && sendQueue) {
     // append the data to what we want to send
     JsVar *s = jsvAsString(data);
     if (s) {
       if (jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(httpClientReqVar, HTTP_NAME_CHUNKED))) {
         // If we asked to send 'chunked' data, we need to wrap it up,
         // prefixed with the length
-        jsvAppendPrintf(sendData, "%x\r\n%v\r\n", jsvGetStringLength(s), s);
+        socketQueueSendChunk(sendQueue, s);
       } else {
-        if ((socketType&ST_TYPE_MASK) == ST_UDP) {
-          char hostName[128];
-          jsvGetString(host, hostName, sizeof(hostName));
-          JsNetUDPPacketHeader header;
-          networkGetHostByName(net, hostName, (uint32_t*)&header.host);
-          header.port = portNumber;
-          header.length = (uint16_t)jsvGetStringLength(s);
-          jsvAppendStringBuf(sendData, (const char*)&header, sizeof(header));
-        }
-        jsvAppendStringVarComplete(sendData,s);
+        socketQueueSendData(sendQueue, s);
       }
       jsvUnLock(s);
     }
   }
-  jsvUnLock(sendData);
+  jsvUnLock(sendQueue);
   if ((socketType&ST_TYPE_MASK) != ST_NORMAL) {
     // on HTTP/UDP we connect on-demand with the first write/send
     clientRequestConnect(net, httpClientReqVar);
@@ -1023,6 +1952,18 @@ void clientRequestConnect(JsNetwork *net, JsVar *httpClientReqVar) {
   SocketType socketType = socketGetType(httpClientReqVar);
 
   JsVar *options = jsvObjectGetChildIfExists(httpClientReqVar, HTTP_NAME_OPTIONS_VAR);
+
+  // If we have an idle connection to the same place, use that
+  if ((socketType&ST_TYPE_MASK) == ST_HTTP && socketPoolCanUse(options, socketType)) {
+    int sckt = socketPoolTake(net, options, socketType);
+    if (sckt>=0) {
+      jsvObjectSetChildAndUnLock(httpClientReqVar, HTTP_NAME_SOCKET, jsvNewFromInteger(sckt+1));
+      jsvObjectSetChildAndUnLock(httpClientReqVar, HTTP_NAME_CONNECTED, jsvNewFromBool(true));
+      jsvUnLock(options);
+      return;
+    }
+  }
+
   unsigned short port = (unsigned short)jsvObjectGetIntegerChild(options, "port");
 
   uint32_t host_addr = 0;
@@ -1051,7 +1992,7 @@ void clientRequestConnect(JsNetwork *net, JsVar *httpClientReqVar) {
   if (socketType & ST_TLS) {
     if (port==0) port = 443;
   }
-  if ((socketType&ST_TYPE_MASK) == ST_HTTP) {
+  if ((socketType&ST_TYPE_MASK) == ST_HTTP || websocketGetState(httpClientReqVar)) {
     if (port==0) port = 80;
   }
 
@@ -1079,15 +2020,13 @@ void clientRequestEnd(JsNetwork *net, JsVar *httpClientReqVar) {
       finalData = jsvNewFromString("");
     }
     // on HTTP, this actually means we connect
-    // force sendData to be made
+    // force the send queue to be made
     clientRequestWrite(net, httpClientReqVar, finalData, NULL, 0);
     jsvUnLock(finalData);
   } else {
     // if we never sent any data, make sure we close 'now'
-    JsVar *sendData = jsvObjectGetChildIfExists(httpClientReqVar, HTTP_NAME_SEND_DATA);
-    if (!sendData || jsvIsEmptyString(sendData))
+    if (!socketHasSendData(httpClientReqVar))
       jsvObjectSetChildAndUnLock(httpClientReqVar, HTTP_NAME_CLOSENOW, jsvNewFromBool(true));
-    jsvUnLock(sendData);
   }
 
   // request close after all data sent
@@ -1111,11 +2050,11 @@ void serverResponseWriteHead(JsVar *httpServerResponseVar, int statusCode, JsVar
     return;
   }
 
-  JsVar *sendData = jsvObjectGetChildIfExists(httpServerResponseVar, HTTP_NAME_SEND_DATA);
-  if (sendData) {
-    // If sendData!=0 then we were already called
+  JsVar *sendQueue = socketGetSendQueue(httpServerResponseVar, false);
+  if (sendQueue) {
+    // If sendQueue!=0 then we were already called
     jsError("Headers have already been sent");
-    jsvUnLock(sendData);
+    jsvUnLock(sendQueue);
     return;
   }
 
@@ -1126,7 +2065,7 @@ void serverResponseWriteHead(JsVar *httpServerResponseVar, int statusCode, JsVar
   if (jsvIsObject(explicitHeaders)) jsvObjectAppendAll(headers, explicitHeaders);
 
 
-  sendData = jsvVarPrintf("HTTP/1.1 %d OK\r\nServer: Espruino "JS_VERSION"\r\n", statusCode);
+  JsVar *sendData = jsvVarPrintf("HTTP/1.1 %d OK\r\nServer: Espruino "JS_VERSION"\r\n", statusCode);
   if (headers) {
     httpAppendHeaders(sendData, headers);
     // if Transfer-Encoding:chunked was set, subsequent writes need to 'chunk' the data that is sent
@@ -1137,7 +2076,9 @@ void serverResponseWriteHead(JsVar *httpServerResponseVar, int statusCode, JsVar
   jsvUnLock(headers);
   // finally add ending newline
   jsvAppendString(sendData, "\r\n");
-  jsvObjectSetChildAndUnLock(httpServerResponseVar, HTTP_NAME_SEND_DATA, sendData);
+  sendQueue = socketGetSendQueue(httpServerResponseVar, true);
+  if (sendQueue && sendData) jsvArrayPush(sendQueue, sendData);
+  jsvUnLock2(sendQueue, sendData);
 }
 
 
@@ -1146,31 +2087,31 @@ void serverResponseWrite(JsVar *httpServerResponseVar, JsVar *data) {
     jsExceptionHere(JSET_ERROR, "This socket is closed");
     return;
   }
-  // Append data to sendData
-  JsVar *sendData = jsvObjectGetChildIfExists(httpServerResponseVar, HTTP_NAME_SEND_DATA);
-  if (!sendData) {
-    // There was no sent data, which means we haven't written headers yet.
+  // Append data to the send queue
+  JsVar *sendQueue = socketGetSendQueue(httpServerResponseVar, false);
+  if (!sendQueue) {
+    // There was no send queue, which means we haven't written headers yet.
     // Do that now with default values
     serverResponseWriteHead(httpServerResponseVar, 200, 0);
-    // sendData should now have been set
-    sendData = jsvObjectGetChildIfExists(httpServerResponseVar, HTTP_NAME_SEND_DATA);
+    // sendQueue should now have been set
+    sendQueue = socketGetSendQueue(httpServerResponseVar, false);
   }
   // check, just in case!
-  if (sendData && !jsvIsUndefined(data)) {
+  if (sendQueue && !jsvIsUndefined(data)) {
     JsVar *s = jsvAsString(data);
     if (s) {
       if (jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(httpServerResponseVar, HTTP_NAME_CHUNKED))) {
         // If we asked to send 'chunked' data, we need to wrap it up,
         // prefixed with the length
-        jsvAppendPrintf(sendData, "%x\r\n%v\r\n", jsvGetStringLength(s), s);
+        socketQueueSendChunk(sendQueue, s);
       } else {
-        jsvAppendStringVarComplete(sendData,s);
+        socketQueueSendData(sendQueue, s);
       }
     }
     jsvUnLock(s);
   }
-  DBG("serverResponseWrite %v\n", sendData);
-  jsvUnLock(sendData);
+  DBG("serverResponseWrite %v\n", sendQueue);
+  jsvUnLock(sendQueue);
 }
 
 void serverResponseEnd(JsVar *httpServerResponseVar) {
@@ -1179,9 +2120,125 @@ void serverResponseEnd(JsVar *httpServerResponseVar) {
     // If we were asked to send 'chunked' data, we need to finish up
     finalData = jsvNewFromString("");
   }
-  serverResponseWrite(httpServerResponseVar, finalData); // force connection->sendData to be created even if data not called
+  serverResponseWrite(httpServerResponseVar, finalData); // force the send queue to be created even if data not called
   jsvUnLock(finalData);
 
   jsvObjectSetChildAndUnLock(httpServerResponseVar, HTTP_NAME_CLOSE, jsvNewFromBool(true));
 }
 
+
+/// Find the request that goes with this server response
+static JsVar *serverResponseGetRequest(JsVar *httpServerResponseVar) {
+  JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_SERVER_CONNECTIONS, false);
+  JsVar *req = 0;
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, arr);
+  while (!req && jsvObjectIteratorHasValue(&it)) {
+    JsVar *connection = jsvObjectIteratorGetValue(&it);
+    JsVar *res = jsvObjectGetChildIfExists(connection, HTTP_NAME_RESPONSE_VAR);
+    if (res == httpServerResponseVar) req = jsvLockAgain(connection);
+    jsvUnLock2(res, connection);
+    jsvObjectIteratorNext(&it);
+  }
+  jsvObjectIteratorFree(&it);
+  jsvUnLock(arr);
+  return req;
+}
+
+static const char *httpGetContentType(const char *fileName) {
+  const char *ext = strrchr(fileName, '.');
+  if (!ext) return "application/octet-stream";
+  ext++;
+  const char *types[] = {
+    "html", "text/html", "htm", "text/html", "js", "application/javascript",
+    "css", "text/css", "json", "application/json", "txt", "text/plain",
+    "svg", "image/svg+xml", "png", "image/png", "jpg", "image/jpeg",
+    "ico", "image/x-icon",
+  };
+  for (unsigned int i=0;i<sizeof(types)/sizeof(const char*);i+=2)
+    if (!strcmp(ext, types[i])) return types[i+1];
+  return "application/octet-stream";
+}
+
+/* Send a file from Storage as the response. The file is queued as a flash (or
+ * native) string, so it's read out a chunk at a time as it's sent rather than
+ * copied into RAM. If there's a file called name+".gz" and the client
+ * accepts gzip, that's sent instead (even if the file itself doesn't exist). The ETag is made from the file's address
+ * and size, like jsfHashFiles, so it changes whenever the file is rewritten. */
+void serverResponseSendFile(JsVar *httpServerResponseVar, JsVar *fileName, JsVar *explicitHeaders) {
+  if (!_socketConnectionOpen(httpServerResponseVar)) {
+    jsExceptionHere(JSET_ERROR, "This socket is closed");
+    return;
+  }
+  JsVar *req = serverResponseGetRequest(httpServerResponseVar);
+  JsVar *reqHeaders = jsvObjectGetChildIfExists(req, HTTP_NAME_HEADERS);
+  JsVar *method = jsvObjectGetChildIfExists(req, "method");
+  bool isHead = jsvIsStringEqual(method, "HEAD");
+  jsvUnLock2(method, req);
+
+  char name[JSF_MAX_FILENAME_LENGTH+2]; // +1 so we can tell if the name was too long
+  jsvGetString(fileName, name, sizeof(name));
+  // a name that's too long can't be in Storage - don't truncate it and find something else
+  bool nameValid = strlen(name) <= JSF_MAX_FILENAME_LENGTH;
+  JsfFileHeader header;
+  uint32_t addr = nameValid ? jsfFindFile(jsfNameFromString(name), &header) : 0;
+  /* is there a gzipped version the client can use? We check even if there's
+   * no plain file, so a site can be stored only gzipped */
+  bool gzip = false;
+  JsVar *gzipName = jsvVarPrintf("%s.gz", name);
+  if (nameValid && gzipName && jsvGetStringLength(gzipName) <= JSF_MAX_FILENAME_LENGTH) {
+    JsfFileHeader gzipHeader;
+    uint32_t gzipAddr = jsfFindFile(jsfNameFromVar(gzipName), &gzipHeader);
+    // search the whole header - it can be long, with gzip anywhere in it
+    bool acceptsGzip = false;
+    JsVar *acceptEncoding = jsvObjectGetChildI(reqHeaders, "Accept-Encoding");
+    if (jsvIsString(acceptEncoding)) {
+      JsVar *gzipStr = jsvNewFromString("gzip");
+      acceptsGzip = jswrap_string_indexOf(acceptEncoding, gzipStr, 0, false) >= 0;
+      jsvUnLock(gzipStr);
+    }
+    jsvUnLock(acceptEncoding);
+    if (gzipAddr && acceptsGzip) {
+      gzip = true;
+      addr = gzipAddr;
+      header = gzipHeader;
+    }
+  }
+  jsvUnLock(gzipName);
+
+  JsVar *headers = jsvNewObject();
+  if (!headers) {
+    jsvUnLock(reqHeaders);
+    return;
+  }
+  int statusCode = 200;
+  JsVar *body = 0;
+  if (!addr) {
+    statusCode = 404;
+    body = jsvNewFromString("Not Found");
+  } else {
+    uint32_t size = jsfGetFileSize(&header);
+    uint32_t hash = 0xABCDDCBA;
+    hash = ((hash<<1) | (hash>>31)) ^ addr ^ size;
+    JsVar *etag = jsvVarPrintf("\"%08x\"", hash);
+    jsvObjectSetChild(headers, "ETag", etag);
+    jsvObjectSetChildAndUnLock(headers, "Vary", jsvNewFromString("Accept-Encoding"));
+    JsVar *ifNoneMatch = jsvObjectGetChildI(reqHeaders, "If-None-Match");
+    if (ifNoneMatch && jsvCompareString(ifNoneMatch, etag, 0, 0, false)==0) {
+      statusCode = 304; // Not Modified
+    } else {
+      jsvObjectSetChildAndUnLock(headers, "Content-Type", jsvNewFromString(httpGetContentType(name)));
+      jsvObjectSetChildAndUnLock(headers, "Content-Length", jsvNewFromInteger((JsVarInt)size));
+      if (gzip) jsvObjectSetChildAndUnLock(headers, "Content-Encoding", jsvNewFromString("gzip"));
+      if (!isHead) body = jsvAddressToVar(addr, size);
+    }
+    jsvUnLock2(ifNoneMatch, etag);
+  }
+  jsvUnLock(reqHeaders);
+  if (jsvIsObject(explicitHeaders)) jsvObjectAppendAll(headers, explicitHeaders);
+  serverResponseWriteHead(httpServerResponseVar, statusCode, headers);
+  jsvUnLock(headers);
+  serverResponseWrite(httpServerResponseVar, body);
+  jsvUnLock(body);
+  serverResponseEnd(httpServerResponseVar);
+}
@@ -23,6 +23,8 @@
 void socketInit();
 void socketKill(JsNetwork *net);
 bool socketIdle(JsNetwork *net);
+/// Are there any servers or connections open?
+bool socketHasConnections();
 
 // -----------------------------
 JsVar *serverNew(SocketType socketType, JsVar *callback);
@@ -39,5 +41,16 @@ void serverResponseSetHeader(JsVar *parent, JsVar *name, JsVar *value); // for H
 void serverResponseWriteHead(JsVar *httpServerResponseVar, int statusCode, JsVar *headers); // for HTTP
 void serverResponseWrite(JsVar *httpServerResponseVar, JsVar *data);
 void serverResponseEnd(JsVar *httpServerResponseVar);
+/// Send a file from Storage as the whole response (with gzip and ETag support)
+void serverResponseSendFile(JsVar *httpServerResponseVar, JsVar *fileName, JsVar *headers);
+
+// -----------------------------
+/// Connect to a WebSocket server (options as for http.request). callback is called on 'open'
+JsVar *websocketConnect(JsNetwork *net, JsVar *options, JsVar *callback);
+/// Send a message - ArrayBuffers are always sent as binary
+void websocketSend(JsVar *ws, JsVar *data, bool binary);
+void websocketPing(JsVar *ws, JsVar *data);
+/// Close the WebSocket, with the given status code (or none if code<=0)
+void websocketClose(JsVar *ws, int code);
 
 #endif // SOCKETSERVER_H
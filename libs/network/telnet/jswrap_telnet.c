@@ -52,7 +52,10 @@ bool telnetRecv(JsNetwork *net);
 #define MODE_OFF 0    // telnet console is off
 #define MODE_ON  1    // telnet console is on
 
-#define TX_CHUNK 1072         // size of chunks read from JS, buffered, and sent on socket
+#define TX_MSS 536            // output is sent in packets of this size while JS is running...
+#define TX_CHUNK (TX_MSS*2)   // size of chunks read from JS, buffered, and sent on socket
+#define TX_FLUSH_MS 20        // ...or when the oldest buffered char is this old (the rest is sent when idle)
+#define TX_BLOCK_MS 500       // if the buffer is full, wait this long for the socket before dropping output
 
 // Data structure for a telnet console server
 typedef struct {
@@ -60,6 +63,7 @@ typedef struct {
   int          cliSock;          ///< active client socket, 0=none (actual socket numbers are 1 less than this, as 0 is a valid socket)
   char         txBuf[TX_CHUNK];  ///< transmit buffer
   uint16_t     txBufLen;         ///< number of chars in tx buffer
+  JsSysTime    txBufTime;        ///< when the first char in the tx buffer was added
 } TelnetServer;
 
 /// Set if Telnet overflow
@@ -256,6 +260,7 @@ bool telnetSendBuf(JsNetwork *net) {
     // shift remaining chars up in the buffer
     memmove(tnSrv.txBuf, tnSrv.txBuf+sent, (size_t)(tnSrv.txBufLen-sent));
     tnSrv.txBufLen = (uint16_t)(tnSrv.txBufLen - sent);
+    tnSrv.txBufTime = jshGetSystemTime();
   } else if (sent < 0) {
     telnetRelease(net);
   }
@@ -267,6 +272,23 @@ bool telnetSendBuf(JsNetwork *net) {
 
 void telnetSendChar(char ch) {
   if (tnSrv.sock == 0 || tnSrv.cliSock == 0) return;
+  if (tnSrv.txBufLen >= TX_CHUNK) {
+    // buffer full - give the socket a chance to take some of it before we lose anything
+    JsNetwork net;
+    if (networkGetFromVarIfOnline(&net)) {
+      JsSysTime timeout = jshGetSystemTime() + jshGetTimeFromMilliseconds(TX_BLOCK_MS);
+      while (tnSrv.cliSock && tnSrv.txBufLen >= TX_CHUNK) {
+        JsSysTime now = jshGetSystemTime();
+        if (now >= timeout) break;
+        /* if nothing could be sent, sleep rather than spinning - on Linux we're
+         * woken as soon as the socket can be written to */
+        if (!telnetSendBuf(&net))
+          jshSleep(timeout - now);
+      }
+      networkFree(&net);
+    }
+    if (tnSrv.cliSock == 0) return;
+  }
   if (tnSrv.txBufLen >= TX_CHUNK) {
     // buffer overflow :-(
     if (!ovf) {
@@ -275,12 +297,15 @@ void telnetSendChar(char ch) {
     }
   } else {
     ovf = false;
+    if (tnSrv.txBufLen == 0) tnSrv.txBufTime = jshGetSystemTime();
     tnSrv.txBuf[tnSrv.txBufLen++] = ch;
   }
 
-  // if the buffer has a bunch of chars then try to send, else it'll happen
-  // at idle time.
-  if (tnSrv.txBufLen < TX_CHUNK/4) return;
+  /* Coalesce output into full packets - only send now if we have a whole
+   * packet's worth, or what we have has been waiting a while. Anything else
+   * is sent at idle time */
+  if (tnSrv.txBufLen < TX_MSS &&
+      jshGetSystemTime() < tnSrv.txBufTime + jshGetTimeFromMilliseconds(TX_FLUSH_MS)) return;
   JsNetwork net;
   if (!networkGetFromVarIfOnline(&net)) return;
   telnetSendBuf(&net);
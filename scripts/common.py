@@ -475,6 +475,7 @@ def get_ifdef_description(d):
   if d=="USE_CRYPTO": return "devices that support Crypto Functionality (Espruino Pico, Original, Espruino WiFi, Espruino BLE devices, Linux or ESP8266)"
   if d=="USE_TERMINAL": return "devices with VT100 terminal emulation enabled (Pixl.js only)"
   if d=="USE_TELNET": return "devices with Telnet enabled (Linux, ESP8266 and ESP32)"
+  if d=="USE_MQTT": return "devices with the native MQTT client built in (Linux)"
   if d=="USE_WIZNET": return "builds with support for WIZnet Ethernet modules built in"
   if d=="USE_NFC": return "NFC (Puck.js, Pixl.js, MDBT42Q)"
   if d=="GRAPHICS_ANTIALIAS": return "devices with Antialiasing support included (Bangle.js or Linux)"
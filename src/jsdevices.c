@@ -35,17 +35,41 @@ JshEventCallbackCallback jshEventCallbacks[EV_EXTI_MAX+1-EV_EXTI0];
 // ----------------------------------------------------------------------------
 //                                                         DATA TRANSMIT BUFFER
 
-/// A single character to be transmitted.
+/** A FIFO of characters to transmit, to be read from IRQ. Which device they
+are for is stored separately in txSegments, as a list of runs of characters:
+
+ txBuffer   ....aaaaaaaaaaaaabbbbbbbbbaaaaa.....
+                ^           ^        ^    ^
+              txTail     seg[0].end  |  seg[2].end = txHead
+                                seg[1].end
+
+* Characters are added at txHead, extending the newest segment if it's for
+  the same device, or adding a new segment if not
+* A segment starts where the one before it ends (or at txTail)
+* The newest segment is never removed, even when empty, so that the main
+  loop can keep appending to it while the IRQ is reading from it
+* Characters are removed from txTail by the IRQ - if a device's characters
+  aren't at the front, the characters before them are moved forwards
+*/
+volatile unsigned char txBuffer[TXBUFFERMASK+1];
+
+/// The head and tail of txBuffer
+volatile unsigned char txHead=0, txTail=0;
+
+#ifndef TXSEGMENTMASK
+#define TXSEGMENTMASK 15 ///< (max 255, 2^n-1) max runs of characters for different devices in txBuffer
+#endif
+
+/// A run of characters in txBuffer to be transmitted on the same device
 typedef struct {
   IOEventFlags flags; //!< Where this data should be transmitted
-  unsigned char data; //!< data to transmit
-} PACKED_FLAGS TxBufferItem;
+  unsigned char end;  //!< index in txBuffer just after the last character
+} PACKED_FLAGS TxBufferSegment;
 
-/// A FIFO of items to transmit, to be read from IRQ
-volatile TxBufferItem txBuffer[TXBUFFERMASK+1];
+volatile TxBufferSegment txSegments[TXSEGMENTMASK+1];
 
-/// The head and tail of the list.
-volatile unsigned char txHead=0, txTail=0;
+/// The head and tail of txSegments
+volatile unsigned char txSegHead=0, txSegTail=0;
 
 typedef enum {
   SDS_NONE,
@@ -67,6 +91,43 @@ Pin jshSerialDeviceCTSPins[JSHSERIALDEVICESTATUSES];
 
 // ----------------------------------------------------------------------------
 //                                                              IO EVENT BUFFER
+#ifdef IOEVENT_QUEUE_MPSC
+/** A lock-free FIFO of received events from other threads -> mainloop
+
+Any thread can push events, but only the main loop pops them. Each slot
+holds one whole event, and a sequence number that says whether it is free
+to write (seq==position) or holds an event ready to read (seq==position+1).
+Producers claim a slot by advancing ioEventsHead with compare-and-swap,
+then fill it in and publish it by updating seq.
+
+Characters can be appended to the newest event if it's for the same
+device, like ioLastHead does for the ioBuffer. Each slot's 'state' holds
+the length of its data, plus flags that say a producer is appending
+(IOEVENTSLOT_BUSY) or that the main loop has started reading it and it
+can't be appended to (IOEVENTSLOT_TAKEN). The top bits are the slot's
+position, so a slot that has been reused can't be appended to by mistake.
+
+jshPopIOEventOfType removes events from the middle of the queue by
+setting their flags to EV_NONE - these are skipped when popping.
+*/
+typedef struct {
+  volatile uint32_t seq;
+  volatile uint32_t state;
+  IOEvent evt;
+} IOEventSlot;
+
+#define IOEVENTSLOT_LEN_MASK 0xFF
+#define IOEVENTSLOT_BUSY 0x100
+#define IOEVENTSLOT_TAKEN 0x200
+#define IOEVENTSLOT_POS_SHIFT 10
+
+static IOEventSlot *ioEvents; ///< the queue, allocated by jshInitDevices
+static uint32_t ioEventsMask = IOBUFFERMASK; ///< number of slots-1 (2^n-1)
+/// Position of the next slot to write (shared by all producers)
+static volatile uint32_t ioEventsHead = 0;
+/// Position of the next slot to read (only changed by the main loop)
+static volatile uint32_t ioEventsTail = 0;
+#else
 #if IOBUFFERMASK<256
 typedef uint8_t IOBufferIdx;
 #else
@@ -103,6 +164,9 @@ volatile uint8_t ioBuffer[IOBUFFERMASK+1];
 
 /// The head and tail of the list.
 volatile IOBufferIdx ioHead=0, ioLastHead=0, ioTail=0;
+#endif
+/// Most of the queue that has ever been used, and number of events dropped because it was full
+static volatile uint32_t ioEventsMaxUsed = 0, ioEventsDropped = 0;
 
 // ----------------------------------------------------------------------------
 
@@ -111,6 +175,15 @@ volatile IOBufferIdx ioHead=0, ioLastHead=0, ioTail=0;
  * Called from jshInit */
 void jshInitDevices() {
   DEVICE_SANITY_CHECK();
+#ifdef IOEVENT_QUEUE_MPSC
+  if (!ioEvents) {
+    ioEvents = (IOEventSlot*)malloc(sizeof(IOEventSlot)*(ioEventsMask+1));
+    assert(ioEvents);
+    for (uint32_t i=0;i<=ioEventsMask;i++)
+      ioEvents[i].seq = i;
+    ioEventsHead = ioEventsTail = 0;
+  }
+#endif
   // Setup USB/Bluetooth flow control separately so
   // we don't reset it for every call to reset()
 #ifdef USB
@@ -205,6 +278,42 @@ void jshResetDevices() {
 
 // ----------------------------------------------------------------------------
 
+/// Get the index of the last segment in txSegments
+#define TXSEG_LAST() ((unsigned char)((txSegHead+TXSEGMENTMASK)&TXSEGMENTMASK))
+
+/// Find the first segment with characters in it, or return txSegHead if there are none
+static unsigned char jshTxFirstSegment() {
+  unsigned char seg = txSegTail;
+  unsigned char start = txTail;
+  while (seg != txSegHead && txSegments[seg].end == start) {
+    start = txSegments[seg].end;
+    seg = (unsigned char)((seg+1)&TXSEGMENTMASK);
+  }
+  return seg;
+}
+
+/// Remove any empty segments at the front of the list (except the newest one)
+static void jshTxRemoveEmptySegments() {
+  while (txSegTail != txSegHead && txSegTail != TXSEG_LAST() &&
+         txSegments[txSegTail].end == txTail)
+    txSegTail = (unsigned char)((txSegTail+1)&TXSEGMENTMASK);
+}
+
+/// Is there space to add a character for the given device to txBuffer?
+static bool jshTxHasSpace(IOEventFlags device) {
+  if (((txHead+1)&TXBUFFERMASK) == txTail) return false;
+  if (txSegHead!=txSegTail && txSegments[TXSEG_LAST()].flags==device) return true;
+  return ((txSegHead+1)&TXSEGMENTMASK) != txSegTail; // need a new segment
+}
+
+/// How many characters can be queued for this device right now without jshTransmitMany having to wait?
+unsigned int jshGetTransmitFree(IOEventFlags device) {
+  if (device==EV_LOOPBACKA || device==EV_LOOPBACKB) // these go straight to the input queue, at least one char per event
+    return (unsigned int)(IOBUFFERMASK - jshGetEventsUsed());
+  if (!jshTxHasSpace(device)) return 0;
+  return TXBUFFERMASK - ((txHead - txTail) & TXBUFFERMASK);
+}
+
 /**
  * Queue a character for transmission.
  */
@@ -212,8 +321,19 @@ void jshTransmit(
     IOEventFlags device, //!< The device to be used for transmission.
     unsigned char data   //!< The character to transmit.
   ) {
+  jshTransmitMany(device, &data, 1);
+}
+
+/**
+ * Queue several characters for transmission.
+ */
+void jshTransmitMany(
+    IOEventFlags device,       //!< The device to be used for transmission.
+    const unsigned char *data, //!< The characters to transmit.
+    unsigned int len           //!< The number of characters
+  ) {
   if (device==EV_LOOPBACKA || device==EV_LOOPBACKB) {
-    jshPushIOCharEvent(device==EV_LOOPBACKB ? EV_LOOPBACKA : EV_LOOPBACKB, (char)data);
+    jshPushIOCharEvents(device==EV_LOOPBACKB ? EV_LOOPBACKA : EV_LOOPBACKB, (char*)data, len);
     return;
   }
   //if (device==EV_USBSERIAL)
@@ -222,14 +342,14 @@ void jshTransmit(
   if (device == EV_TELNET) {
     // gross hack to avoid deadlocking on the network here
     extern void telnetSendChar(char c);
-    telnetSendChar((char)data);
+    while (len--) telnetSendChar((char)*(data++));
     return;
   }
 #endif
 #ifdef USE_TERMINAL
   if (device==EV_TERMINAL) {
     extern void terminalSendChar(char c);
-    terminalSendChar((char)data);
+    while (len--) terminalSendChar((char)*(data++));
     return;
   }
 #endif
@@ -248,7 +368,7 @@ void jshTransmit(
 #endif
 #else // if PC, just put to stdout
   if (device==DEFAULT_CONSOLE_DEVICE) {
-    fputc(data, stdout);
+    fwrite(data, 1, len, stdout);
     fflush(stdout);
     return;
   }
@@ -256,56 +376,72 @@ void jshTransmit(
   // If the device is EV_NONE then there is nowhere to send the data.
   if (device==EV_NONE) return;
 
-  // The txHead global points to the current item in the txBuffer.  Since we are adding a new
-  // character, we increment the head pointer.   If it has caught up with the tail, then that means
-  // we have filled the array backing the list.  What we do next is to wait for space to free up.
-  unsigned char txHeadNext = (unsigned char)((txHead+1)&TXBUFFERMASK);
-  if (txHeadNext==txTail) {
-    jsiSetBusy(BUSY_TRANSMIT, true);
-    bool wasConsoleLimbo = device==EV_LIMBO && jsiGetConsoleDevice()==EV_LIMBO;
+  while (len) {
+    // If the buffer is full (or we'd need a new segment and there are none
+    // left) then we wait for space to free up.
+    if (!jshTxHasSpace(device)) {
+      jsiSetBusy(BUSY_TRANSMIT, true);
+      bool wasConsoleLimbo = device==EV_LIMBO && jsiGetConsoleDevice()==EV_LIMBO;
 #ifdef USE_SWDCON
-    int loopCount=0; // for recovery inside swdconBusyIdle
-#endif
-    while (txHeadNext==txTail) {
-      // wait for send to finish as buffer is about to overflow
-      if (jshIsInInterrupt()) {
-        // if we're printing from an IRQ, don't wait - it's unlikely TX will ever finish
-        jsErrorFlags |= JSERR_BUFFER_FULL;
-        return;
-      }
-      jshBusyIdle();
+      int loopCount=0; // for recovery inside swdconBusyIdle
+#endif
+      while (!jshTxHasSpace(device)) {
+        // wait for send to finish as buffer is about to overflow
+        if (jshIsInInterrupt()) {
+          // if we're printing from an IRQ, don't wait - it's unlikely TX will ever finish
+          jsErrorFlags |= JSERR_BUFFER_FULL;
+          return;
+        }
+        jshBusyIdle();
 #ifdef USE_SWDCON
-      loopCount++;
-      extern bool swdconBusyIdle(int);
-      if (device == EV_SWDCON) swdconBusyIdle(loopCount);
+        loopCount++;
+        extern bool swdconBusyIdle(int);
+        if (device == EV_SWDCON) swdconBusyIdle(loopCount);
 #endif
 #ifdef USB
-      // just in case USB was unplugged while we were waiting!
-      if (!jshIsUSBSERIALConnected()) jshTransmitClearDevice(EV_USBSERIAL);
+        // just in case USB was unplugged while we were waiting!
+        if (!jshIsUSBSERIALConnected()) jshTransmitClearDevice(EV_USBSERIAL);
 #endif
+      }
+      if (wasConsoleLimbo && jsiGetConsoleDevice()!=EV_LIMBO) {
+        /* It was 'Limbo', but now it's not - see jsiOneSecondAfterStartup.
+        Basically we must have printed a bunch of stuff to LIMBO and blocked
+        with our output buffer full. But then jsiOneSecondAfterStartup
+        switches to the right console device and swaps everything we wrote
+        over to that device too. Only we're now here, still writing to the
+        old device when really we should be writing to the new one. */
+        device = jsiGetConsoleDevice();
+      }
+      jsiSetBusy(BUSY_TRANSMIT, false);
+      continue; // check again, as the device may have changed
     }
-    if (wasConsoleLimbo && jsiGetConsoleDevice()!=EV_LIMBO) {
-      /* It was 'Limbo', but now it's not - see jsiOneSecondAfterStartup.
-      Basically we must have printed a bunch of stuff to LIMBO and blocked
-      with our output buffer full. But then jsiOneSecondAfterStartup
-      switches to the right console device and swaps everything we wrote
-      over to that device too. Only we're now here, still writing to the
-      old device when really we should be writing to the new one. */
-      device = jsiGetConsoleDevice();
+    // Copy in as much as we can in one go
+    unsigned char head = txHead;
+    unsigned int space = (unsigned int)((txTail+TXBUFFERMASK-head)&TXBUFFERMASK);
+    unsigned int n = (space < len) ? space : len;
+    for (unsigned int i=0;i<n;i++) {
+      txBuffer[head] = data[i];
+      head = (unsigned char)((head+1)&TXBUFFERMASK);
     }
-    jsiSetBusy(BUSY_TRANSMIT, false);
-  }
-  // Save the device and data for the new character to be transmitted.
-  txBuffer[txHead].flags = device;
-  txBuffer[txHead].data = data;
-  txHead = txHeadNext;
+    // Now make it available to the IRQ, by setting the end of the segment before txHead
+    if (txSegHead!=txSegTail && txSegments[TXSEG_LAST()].flags==device) {
+      txSegments[TXSEG_LAST()].end = head;
+    } else {
+      txSegments[txSegHead].flags = device;
+      txSegments[txSegHead].end = head;
+      txSegHead = (unsigned char)((txSegHead+1)&TXSEGMENTMASK);
+    }
+    txHead = head;
+    data += n;
+    len -= n;
 
-  jshUSARTKick(device); // set up interrupts if required
+    jshUSARTKick(device); // set up interrupts if required
+  }
 }
 
 static void jshTransmitPrintfCallback(const char *str, void *user_data) {
   IOEventFlags device = (IOEventFlags)user_data;
-  while (*str) jshTransmit(device, (unsigned char)*(str++));
+  jshTransmitMany(device, (const unsigned char*)str, (unsigned int)strlen(str));
 }
 
 void jshTransmitPrintf(IOEventFlags device, const char *fmt, ...) {
@@ -318,7 +454,9 @@ void jshTransmitPrintf(IOEventFlags device, const char *fmt, ...) {
 // Return the device at the top of the transmit queue (or EV_NONE)
 IOEventFlags jshGetDeviceToTransmit() {
   if (!jshHasTransmitData()) return EV_NONE;
-  return IOEVENTFLAGS_GETTYPE(txBuffer[txTail].flags);
+  unsigned char seg = jshTxFirstSegment();
+  if (seg == txSegHead) return EV_NONE;
+  return IOEVENTFLAGS_GETTYPE(txSegments[seg].flags);
 }
 
 /**
@@ -338,28 +476,104 @@ int jshGetCharToTransmit(IOEventFlags device) {
     }
   }
 
-  unsigned char tempTail = txTail;
-  while (txHead != tempTail) {
-    if (IOEVENTFLAGS_GETTYPE(txBuffer[tempTail].flags) == device) {
-      unsigned char data = txBuffer[tempTail].data;
-      if (tempTail != txTail) { // so we weren't right at the back of the queue
-        // we need to work back from tempTail (until we hit tail), shifting everything forwards
-        unsigned char this = tempTail;
+  unsigned char seg = txSegTail;
+  unsigned char start = txTail;
+  while (seg != txSegHead) {
+    unsigned char end = txSegments[seg].end;
+    if (end != start && IOEVENTFLAGS_GETTYPE(txSegments[seg].flags) == device) {
+      unsigned char data = txBuffer[start];
+      if (start != txTail) { // so we weren't right at the back of the queue
+        // we need to work back from start (until we hit tail), shifting everything forwards
+        unsigned char this = start;
         unsigned char last = (unsigned char)((this+TXBUFFERMASK)&TXBUFFERMASK);
         while (this!=txTail) { // if this==txTail, then last is before it, so stop here
           txBuffer[this] = txBuffer[last];
           this = last;
           last = (unsigned char)((this+TXBUFFERMASK)&TXBUFFERMASK);
         }
-      }
+        // and the segments before this one now end one character later
+        unsigned char s = txSegTail;
+        while (s != seg) {
+          txSegments[s].end = (unsigned char)((txSegments[s].end+1)&TXBUFFERMASK);
+          s = (unsigned char)((s+1)&TXSEGMENTMASK);
+        }
+        // if this segment is now empty (and not the newest), remove it by shifting the ones before it forwards
+        if (txSegments[seg].end == ((start+1)&TXBUFFERMASK) && seg != TXSEG_LAST()) {
+          s = seg;
+          while (s != txSegTail) {
+            unsigned char prev = (unsigned char)((s+TXSEGMENTMASK)&TXSEGMENTMASK);
+            txSegments[s] = txSegments[prev];
+            s = prev;
+          }
+          txSegTail = (unsigned char)((txSegTail+1)&TXSEGMENTMASK);
+        }
+      } else // any segments before this one are empty - remove them before we move txTail past them
+        txSegTail = seg;
       txTail = (unsigned char)((txTail+1)&TXBUFFERMASK); // advance the tail
+      jshTxRemoveEmptySegments();
       return data; // return data
     }
-    tempTail = (unsigned char)((tempTail+1)&TXBUFFERMASK);
+    start = end;
+    seg = (unsigned char)((seg+1)&TXSEGMENTMASK);
   }
   return -1; // no data :(
 }
 
+/**
+ * Try and get several characters for transmission on a device in one go, so
+ * they can be sent with a single write/packet. After the first character, only
+ * characters for this device that follow on from the back of the queue are taken.
+ * \return The number of characters written to buf (0 if there are none).
+ */
+unsigned int jshGetCharsToTransmit(IOEventFlags device, unsigned char *buf, unsigned int maxLen) {
+  if (!maxLen) return 0;
+  // XON/XOFF, and characters that aren't at the back of the queue, are handled here
+  int c = jshGetCharToTransmit(device);
+  if (c<0) return 0;
+  unsigned int len = 1;
+  buf[0] = (unsigned char)c;
+  unsigned char *data;
+  unsigned int n;
+  // now copy contiguous blocks of data (up to 2 if the buffer wraps)
+  while (len<maxLen && (n = jshGetTransmitSpan(device, &data))) {
+    if (n > maxLen-len) n = maxLen-len;
+    memcpy(&buf[len], data, n);
+    jshTransmitSpanSent(device, n);
+    len += n;
+  }
+  return len;
+}
+
+/**
+ * Get a pointer to the characters for this device at the back of the
+ * transmit queue that are contiguous in memory, so they can be sent directly
+ * (eg. with DMA). When done, call jshTransmitSpanSent with how many were sent.
+ * XON/XOFF characters aren't returned, so jshGetCharToTransmit should still be
+ * called when this returns 0.
+ * \return The number of characters available at *data (0 if there are none).
+ */
+unsigned int jshGetTransmitSpan(IOEventFlags device, unsigned char **data) {
+  if (DEVICE_HAS_DEVICE_STATE(device) &&
+      (jshSerialDeviceStates[TO_SERIAL_DEVICE_STATE(device)]&(SDS_XOFF_PENDING|SDS_XON_PENDING)))
+    return 0; // flow control characters must be sent first
+  unsigned char seg = jshTxFirstSegment();
+  if (seg == txSegHead || IOEVENTFLAGS_GETTYPE(txSegments[seg].flags) != device)
+    return 0;
+  unsigned char end = txSegments[seg].end;
+  *data = (unsigned char*)&txBuffer[txTail];
+  if (end > txTail) return (unsigned int)(end - txTail);
+  return (unsigned int)(TXBUFFERMASK+1-txTail); // wraps around - just return up to the end of txBuffer
+}
+
+/// Remove characters from the transmit queue after jshGetTransmitSpan, once they've been sent
+void jshTransmitSpanSent(IOEventFlags device, unsigned int len) {
+  NOT_USED(device);
+  unsigned char seg = jshTxFirstSegment();
+  if (seg != txSegHead) txSegTail = seg; // remove empty segments before we move txTail past them
+  txTail = (unsigned char)((txTail+len)&TXBUFFERMASK);
+  jshTxRemoveEmptySegments();
+}
+
 /// Wait for all data in the transmit queue to be written
 void jshTransmitFlush() {
   jsiSetBusy(BUSY_TRANSMIT, true);
@@ -374,13 +588,15 @@ void jshTransmitFlushDevice(IOEventFlags device) {
   do {
     deviceHasData = false;
     // Check TX queue to see if there is any data to send
-    unsigned char tempTail = txTail;
-    while (txHead != tempTail) {
-      if (IOEVENTFLAGS_GETTYPE(txBuffer[tempTail].flags) == device) {
+    unsigned char seg = txSegTail;
+    unsigned char start = txTail;
+    while (seg != txSegHead) {
+      if (txSegments[seg].end != start && IOEVENTFLAGS_GETTYPE(txSegments[seg].flags) == device) {
         deviceHasData = true;
         break;
       }
-      tempTail = (unsigned char)((tempTail+1)&TXBUFFERMASK);
+      start = txSegments[seg].end;
+      seg = (unsigned char)((seg+1)&TXSEGMENTMASK);
     }
   } while (deviceHasData);
   jsiSetBusy(BUSY_TRANSMIT, false);
@@ -409,12 +625,12 @@ void jshTransmitMove(IOEventFlags from, IOEventFlags to) {
   } else {
     // Otherwise just rename the contents of the buffer
     jshInterruptOff();
-    unsigned char tempTail = txTail;
-    while (tempTail != txHead) {
-      if (IOEVENTFLAGS_GETTYPE(txBuffer[tempTail].flags) == from) {
-        txBuffer[tempTail].flags = (txBuffer[tempTail].flags&~EV_TYPE_MASK) | to;
+    unsigned char seg = txSegTail;
+    while (seg != txSegHead) {
+      if (IOEVENTFLAGS_GETTYPE(txSegments[seg].flags) == from) {
+        txSegments[seg].flags = (txSegments[seg].flags&~EV_TYPE_MASK) | to;
       }
-      tempTail = (unsigned char)((tempTail+1)&TXBUFFERMASK);
+      seg = (unsigned char)((seg+1)&TXSEGMENTMASK);
     }
     jshInterruptOn();
   }
@@ -434,6 +650,22 @@ bool jshHasTransmitData() {
 void CALLED_FROM_INTERRUPT jshIOEventOverflowed() {
   // Error here - just set flag so we don't dump a load of data out
   jsErrorFlags |= JSERR_RX_FIFO_FULL;
+#ifdef IOEVENT_QUEUE_MPSC
+  __atomic_fetch_add(&ioEventsDropped, 1, __ATOMIC_RELAXED);
+#else
+  ioEventsDropped++;
+#endif
+}
+
+/// Record how much of the IO event queue is used, for jshGetIOEventStats
+static void CALLED_FROM_INTERRUPT jshIOEventsUsed(uint32_t used) {
+#ifdef IOEVENT_QUEUE_MPSC
+  uint32_t maxUsed = __atomic_load_n(&ioEventsMaxUsed, __ATOMIC_RELAXED);
+  while (used > maxUsed &&
+         !__atomic_compare_exchange_n(&ioEventsMaxUsed, &maxUsed, used, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#else
+  if (used > ioEventsMaxUsed) ioEventsMaxUsed = used;
+#endif
 }
 
 /// Push an IO event (max IOEVENT_MAX_LEN) into the ioBuffer (designed to be called from IRQ), returns true on success, Calls jshHadEvent();
@@ -445,6 +677,31 @@ bool CALLED_FROM_INTERRUPT jshPushEvent(IOEventFlags evt, uint8_t *data, unsigne
 #endif
     length=IOEVENT_MAX_LEN;
   }
+#ifdef IOEVENT_QUEUE_MPSC
+  if (!ioEvents) return false;
+  uint32_t pos = __atomic_load_n(&ioEventsHead, __ATOMIC_RELAXED);
+  IOEventSlot *slot;
+  while (true) {
+    slot = &ioEvents[pos & ioEventsMask];
+    int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+    if (diff==0) { // slot is free - try and claim it
+      if (__atomic_compare_exchange_n(&ioEventsHead, &pos, pos+1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        break;
+      // otherwise another thread got it first, and pos is now the new head
+    } else if (diff<0) { // slot still holds an event from last time round
+      jshIOEventOverflowed();
+      return false; // queue full - dump this event!
+    } else // another thread claimed it but we haven't seen the new head yet
+      pos = __atomic_load_n(&ioEventsHead, __ATOMIC_RELAXED);
+  }
+  slot->evt.flags = evt;
+  memcpy(slot->evt.data, data, length);
+  slot->state = (pos<<IOEVENTSLOT_POS_SHIFT) | length;
+  __atomic_store_n(&slot->seq, pos+1, __ATOMIC_RELEASE); // publish it
+  jshIOEventsUsed(pos+1-__atomic_load_n(&ioEventsTail, __ATOMIC_RELAXED));
+  jshHadEvent();
+  return true;
+#else
   /* We're disabling IRQs for this bit because it's actually quite likely for
    * USB and USART data to be coming in at the same time, and it can trip
    * things up if one IRQ interrupts another. */
@@ -465,11 +722,35 @@ bool CALLED_FROM_INTERRUPT jshPushEvent(IOEventFlags evt, uint8_t *data, unsigne
   }
   ioLastHead = ioHead;
   ioHead = idx;
+  jshIOEventsUsed((uint32_t)jshGetEventsUsed());
   jshInterruptOn();
   jshHadEvent();
   return true;
+#endif
 }
 
+#ifdef IOEVENT_QUEUE_MPSC
+/// Try and add characters onto the newest event in the queue, returns true on success
+static bool jshIOEventsAppend(IOEventFlags channel, char *data, unsigned int count) {
+  if (!ioEvents) return false;
+  uint32_t pos = __atomic_load_n(&ioEventsHead, __ATOMIC_ACQUIRE) - 1;
+  IOEventSlot *slot = &ioEvents[pos & ioEventsMask];
+  if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos+1 || // not published yet, or already popped
+      slot->evt.flags != channel) return false;
+  uint32_t state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+  if ((state>>IOEVENTSLOT_POS_SHIFT) != (pos & (0xFFFFFFFF>>IOEVENTSLOT_POS_SHIFT)) || // slot was reused
+      (state & (IOEVENTSLOT_BUSY|IOEVENTSLOT_TAKEN)) ||
+      (state & IOEVENTSLOT_LEN_MASK)+count > IOEVENT_MAX_LEN) return false;
+  // claim the slot so the main loop can't read it while we're writing
+  if (!__atomic_compare_exchange_n(&slot->state, &state, state|IOEVENTSLOT_BUSY, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    return false;
+  memcpy(&slot->evt.data[state & IOEVENTSLOT_LEN_MASK], data, count);
+  __atomic_store_n(&slot->state, state+count, __ATOMIC_RELEASE);
+  jshHadEvent();
+  return true;
+}
+#endif
+
 /// Try and handle events in the IRQ itself. true if handled and shouldn't go in queue
 static bool jshPushIOCharEventsHandler(IOEventFlags channel, char *data, unsigned int count) {
   // Check for a CTRL+C
@@ -486,6 +767,11 @@ static bool jshPushIOCharEventsHandler(IOEventFlags channel, char *data, unsigne
 void jshPushIOCharEvents(IOEventFlags channel, char *data, unsigned int count) {
   // See if we need to handle this in the IRQ
   if (jshPushIOCharEventsHandler(channel, data, count)) return;
+#ifdef IOEVENT_QUEUE_MPSC
+  // See if we can add this onto an existing event
+  if (count <= IOEVENT_MAX_LEN && jshIOEventsAppend(channel, data, count)) {
+  } else
+#else
   // See if we can add this onto an existing event
   if (ioLastHead != ioHead &&  // we have a 'last head'
      ioLastHead != ioTail && // it's not something that'll be processed immediately (we're in IRQ so main loop might be in the process right now)
@@ -500,7 +786,10 @@ void jshPushIOCharEvents(IOEventFlags channel, char *data, unsigned int count) {
       ioBuffer[ioHead] = (uint8_t)data[i];
       ioHead = (ioHead+1) & IOBUFFERMASK;
     }
-  } else {
+    jshIOEventsUsed((uint32_t)jshGetEventsUsed());
+  } else
+#endif
+  {
     // Push the event (split into IOEVENT_MAX_LEN chunks just in case)
     while (count) {
       unsigned int c = (count > IOEVENT_MAX_LEN) ? IOEVENT_MAX_LEN : count;
@@ -565,6 +854,126 @@ void CALLED_FROM_INTERRUPT jshPushIOEvent(
   jshPushEvent(channel, (uint8_t*)&t, 4);
 }
 
+#ifdef IOEVENT_QUEUE_MPSC
+/// Free the slot at ioEventsTail so it can be written again, and move on to the next
+static void jshIOEventsRelease(IOEventSlot *slot) {
+  uint32_t pos = ioEventsTail;
+  __atomic_store_n(&slot->seq, pos+ioEventsMask+1, __ATOMIC_RELEASE);
+  __atomic_store_n(&ioEventsTail, pos+1, __ATOMIC_RELEASE);
+}
+
+/** Mark a published slot as being read, so nothing more can be appended to it,
+ * and set evt.length. Returns false if a producer is appending to it right now */
+static bool jshIOEventsTake(IOEventSlot *slot) {
+  uint32_t state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+  if (!(state & IOEVENTSLOT_TAKEN)) {
+    if ((state & IOEVENTSLOT_BUSY) ||
+        !__atomic_compare_exchange_n(&slot->state, &state, state|IOEVENTSLOT_TAKEN, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+      return false;
+  }
+  slot->evt.length = (uint8_t)(state & IOEVENTSLOT_LEN_MASK);
+  return true;
+}
+
+/// Get the slot for the next event to be popped (skipping removed events), or 0 if there isn't one
+static IOEventSlot *jshIOEventsPeek() {
+  if (!ioEvents) return 0;
+  while (true) {
+    uint32_t pos = ioEventsTail;
+    IOEventSlot *slot = &ioEvents[pos & ioEventsMask];
+    if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos+1 ||
+        !jshIOEventsTake(slot))
+      return 0; // empty (or the next event is still being written)
+    if (slot->evt.flags != EV_NONE) return slot;
+    jshIOEventsRelease(slot); // removed by jshPopIOEventOfType
+  }
+}
+
+// pop an IO event, returns EV_NONE on failure
+IOEventFlags jshPopIOEvent(uint8_t *data, unsigned int *length) {
+  IOEventSlot *slot = jshIOEventsPeek();
+  if (!slot) return EV_NONE;
+  IOEventFlags evt = slot->evt.flags;
+  if (length) *length = slot->evt.length;
+  if (data) memcpy(data, slot->evt.data, slot->evt.length);
+  jshIOEventsRelease(slot);
+  return evt;
+}
+
+unsigned int jshPopIOEvents(IOEvent *events, unsigned int maxEvents) {
+  unsigned int n = 0;
+  IOEventSlot *slot;
+  while (n<maxEvents && (slot = jshIOEventsPeek())) {
+    events[n].flags = slot->evt.flags;
+    events[n].length = slot->evt.length;
+    memcpy(events[n].data, slot->evt.data, slot->evt.length);
+    jshIOEventsRelease(slot);
+    n++;
+  }
+  return n;
+}
+
+// pop an IO event of type eventType, returns true on success
+IOEventFlags jshPopIOEventOfType(IOEventFlags eventType, uint8_t *data, unsigned int *length) {
+  if (!ioEvents) return EV_NONE;
+  for (uint32_t pos = ioEventsTail;; pos++) {
+    IOEventSlot *slot = &ioEvents[pos & ioEventsMask];
+    if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos+1)
+      return EV_NONE; // reached the end
+    IOEventFlags evt = slot->evt.flags;
+    if (evt != EV_NONE && IOEVENTFLAGS_GETTYPE(evt) == eventType) {
+      if (!jshIOEventsTake(slot)) return EV_NONE; // being appended to - get it next time
+      if (length) *length = slot->evt.length;
+      if (data) memcpy(data, slot->evt.data, slot->evt.length);
+      /* Producers never touch a slot once it's published, so we can just
+      mark it as removed and it'll be skipped when we get to it */
+      slot->evt.flags = EV_NONE;
+      if (pos == ioEventsTail) jshIOEventsRelease(slot);
+      return evt;
+    }
+  }
+}
+
+/**
+ * Determine if we have I/O events to process.
+ * \return True if there are I/O events to be processed.
+ */
+bool jshHasEvents() {
+  return ioEventsHead != ioEventsTail;
+}
+
+/// Check if the top event is for the given device
+bool jshIsTopEvent(IOEventFlags eventType) {
+  IOEventSlot *slot = jshIOEventsPeek();
+  return slot && IOEVENTFLAGS_GETTYPE(slot->evt.flags) == eventType;
+}
+
+/* We scale the number of events to the same range as the ioBuffer so that
+ * anything comparing it with IOBUFFERMASK, IOBUFFER_XOFF, etc still works */
+int jshGetEventsUsed() {
+  uint32_t used = ioEventsHead - ioEventsTail;
+  return (int)(((uint64_t)used*(IOBUFFERMASK+1)) / (ioEventsMask+1));
+}
+
+int jshGetIOCharEventsFree() {
+  int slotsLeft = (int)(ioEventsMask+1) - (int)(ioEventsHead - ioEventsTail);
+  return (slotsLeft-1)*IOEVENT_MAX_LEN; // be sensible - leave a little spare
+}
+
+void jshSetIOEventQueueSize(unsigned int events) {
+  if (ioEvents) return; // already allocated
+  uint32_t size = 16;
+  while (size < events && size < 0x10000) size <<= 1;
+  ioEventsMask = size-1;
+}
+
+void jshGetIOEventStats(unsigned int *size, unsigned int *used, unsigned int *maxUsed, unsigned int *dropped) {
+  *size = ioEventsMask+1;
+  *used = ioEventsHead - ioEventsTail;
+  *maxUsed = ioEventsMaxUsed;
+  *dropped = ioEventsDropped;
+}
+#else
 // pop an IO event, returns EV_NONE on failure
 IOEventFlags jshPopIOEvent(uint8_t *data, unsigned int *length) {
   if (ioHead==ioTail) return EV_NONE;
@@ -584,6 +993,15 @@ IOEventFlags jshPopIOEvent(uint8_t *data, unsigned int *length) {
   return evt;
 }
 
+unsigned int jshPopIOEvents(IOEvent *events, unsigned int maxEvents) {
+  unsigned int n = 0, len;
+  while (n<maxEvents && (events[n].flags = jshPopIOEvent(events[n].data, &len)) != EV_NONE) {
+    events[n].length = (uint8_t)len;
+    n++;
+  }
+  return n;
+}
+
 // pop an IO event of type eventType, returns true on success
 IOEventFlags jshPopIOEventOfType(IOEventFlags eventType, uint8_t *data, unsigned int *length) {
   IOBufferIdx i = ioTail;
@@ -649,6 +1067,14 @@ int jshGetIOCharEventsFree() {
   return spaceLeft-4; // be sensible - leave a little spare
 }
 
+void jshGetIOEventStats(unsigned int *size, unsigned int *used, unsigned int *maxUsed, unsigned int *dropped) {
+  *size = IOBUFFERMASK+1;
+  *used = (unsigned int)jshGetEventsUsed();
+  *maxUsed = ioEventsMaxUsed;
+  *dropped = ioEventsDropped;
+}
+#endif
+
 bool jshHasEventSpaceForChars(int n) {
   return jshGetIOCharEventsFree() > n;
 }
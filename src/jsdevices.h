@@ -181,6 +181,30 @@ typedef enum {
 #define IOEVENT_MAX_LEN (NRF_SDH_BLE_GATT_MAX_MTU_SIZE+3)
 #endif
 
+/* On hosted targets the IO event queue is filled from several threads (stdin,
+ * devices, sockets, GPIO) as well as the main loop, and interrupts can't be
+ * disabled, so we use a lock-free multi-producer/single-consumer queue of
+ * fixed size event slots rather than the byte-packed ioBuffer */
+#if defined(LINUX) && !defined(IOEVENT_QUEUE_RING)
+#define IOEVENT_QUEUE_MPSC
+#endif
+
+/// How many events jsiIdle pops from the queue at once (see jshPopIOEvents)
+#ifndef IOEVENT_POP_BATCH
+#ifdef IOEVENT_QUEUE_MPSC
+#define IOEVENT_POP_BATCH 16
+#else
+#define IOEVENT_POP_BATCH 1
+#endif
+#endif
+
+/// An IO event, as returned by jshPopIOEvents
+typedef struct {
+  IOEventFlags flags;
+  uint8_t data[IOEVENT_MAX_LEN]; ///< word aligned, as EV_EXTIx events contain a uint32_t
+  uint8_t length;
+} IOEvent;
+
 #include "jspin.h"
 
 /// Push an IO event (max IOEVENT_MAX_LEN) into the ioBuffer (designed to be called from IRQ), returns true on success, Calls jshHadEvent();
@@ -196,6 +220,8 @@ void jshPushIOCharEvents(IOEventFlags channel, char *data, unsigned int count);
 
 /// pop an IO event, returns EV_NONE on failure. data must be IOEVENT_MAX_LEN bytes
 IOEventFlags jshPopIOEvent(uint8_t *data, unsigned int *length);
+/// pop up to maxEvents IO events into 'events', returns the number popped
+unsigned int jshPopIOEvents(IOEvent *events, unsigned int maxEvents);
 // pop an IO event of type eventType, returns true on success. data must be IOEVENT_MAX_LEN bytes
 IOEventFlags jshPopIOEventOfType(IOEventFlags eventType, uint8_t *data, unsigned int *length);
 /// Do we have any events pending? Will jshPopIOEvent return true?
@@ -205,6 +231,14 @@ bool jshIsTopEvent(IOEventFlags eventType);
 
 /// How many event blocks are left? compare this to IOBUFFERMASK
 int jshGetEventsUsed();
+#ifdef IOEVENT_QUEUE_MPSC
+/// Set how many events the IO event queue can hold (rounded up to a power of 2). Call before jshInit
+void jshSetIOEventQueueSize(unsigned int events);
+#endif
+/** Get the size of the IO event queue, how much of it is used now, the most that
+ * has ever been used, and how many events were dropped because it was full. Sizes
+ * are in events for IOEVENT_QUEUE_MPSC, or bytes for the ioBuffer */
+void jshGetIOEventStats(unsigned int *size, unsigned int *used, unsigned int *maxUsed, unsigned int *dropped);
 
 /// Do we have enough space for N characters?
 bool jshHasEventSpaceForChars(int n);
@@ -221,6 +255,10 @@ JsVar *jshGetDeviceObject(IOEventFlags device);
 //                                                         DATA TRANSMIT BUFFER
 /// Queue a character for transmission
 void jshTransmit(IOEventFlags device, unsigned char data);
+/// Queue several characters for transmission
+void jshTransmitMany(IOEventFlags device, const unsigned char *data, unsigned int len);
+/// How many characters can be queued for this device right now without jshTransmitMany having to wait?
+unsigned int jshGetTransmitFree(IOEventFlags device);
 // Queue a formatted string for transmission
 void jshTransmitPrintf(IOEventFlags device, const char *fmt, ...);
 /// Wait for transmit to finish
@@ -237,6 +275,12 @@ bool jshHasTransmitData();
 IOEventFlags jshGetDeviceToTransmit();
 /// Try and get a character for transmission - could just return -1 if nothing
 int jshGetCharToTransmit(IOEventFlags device);
+/// Try and get up to maxLen characters for transmission in one go. Returns how many were written to buf
+unsigned int jshGetCharsToTransmit(IOEventFlags device, unsigned char *buf, unsigned int maxLen);
+/// Get a pointer to contiguous characters waiting to be sent on this device (eg. for DMA), returns how many there are (0 if none)
+unsigned int jshGetTransmitSpan(IOEventFlags device, unsigned char **data);
+/// Remove characters from the transmit queue after jshGetTransmitSpan, once they've been sent
+void jshTransmitSpanSent(IOEventFlags device, unsigned int len);
 
 
 /// Set whether the host should transmit or not
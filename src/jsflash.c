@@ -40,7 +40,13 @@
 
 #ifdef USE_HEATSHRINK
   #include "compress_heatshrink.h"
-  #define COMPRESS heatshrink_encode
+  // A 9 bit window compresses var images much better than 8 (see benchmark/heatshrink_varimage.js) if the build supports it
+  #if HEATSHRINK_STATIC_WINDOW_BITS >= 9
+  #define HEATSHRINK_VARIMAGE_WINDOW_BITS 9
+  #else
+  #define HEATSHRINK_VARIMAGE_WINDOW_BITS HEATSHRINK_STATIC_WINDOW_BITS
+  #endif
+  #define COMPRESS(data, len, cb, cbdata) heatshrink_encode(data, len, cb, cbdata, HEATSHRINK_VARIMAGE_WINDOW_BITS, 0)
   #define DECOMPRESS heatshrink_decode
 #else
   #include "compress_rle.h"
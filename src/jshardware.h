@@ -262,7 +262,9 @@ int jshSPISend(IOEventFlags device, int data);
 /** Send 16 bit data through the given SPI device. */
 void jshSPISend16(IOEventFlags device, int data);
 /** Send data in tx through the given SPI device and return the response in
- * rx (if supplied). Returns true on success. A weak version of this function is provided in jshardware_common.c */
+ * rx (if supplied). Returns true on success. If callback is set, this may return
+ * before the transfer has finished (callback is called, possibly from an IRQ, when it has),
+ * so tx and rx must stay valid until then. A weak version of this function is provided in jshardware_common.c */
 bool jshSPISendMany(IOEventFlags device, unsigned char *tx, unsigned char *rx, size_t count, void (*callback)());
 /** Set whether to send 16 bits or 8 over SPI */
 void jshSPISet16(IOEventFlags device, bool is16);
@@ -297,6 +299,12 @@ void jshI2CUnSetup(IOEventFlags device);
 void jshI2CWrite(IOEventFlags device, unsigned char address, int nBytes, const unsigned char *data, bool sendStop);
 /** Read a number of bytes from the I2C device. */
 void jshI2CRead(IOEventFlags device, unsigned char address, int nBytes, unsigned char *data, bool sendStop);
+/** Write to the I2C device without waiting. callback is called (possibly from an IRQ or another thread)
+ * when finished, and data must stay valid until then. Returns false if the transfer couldn't be started.
+ * A weak version of this function that works synchronously is provided in jshardware_common.c */
+bool jshI2CWriteAsync(IOEventFlags device, unsigned char address, int nBytes, const unsigned char *data, bool sendStop, void (*callback)());
+/** Read from the I2C device without waiting - see jshI2CWriteAsync */
+bool jshI2CReadAsync(IOEventFlags device, unsigned char address, int nBytes, unsigned char *data, bool sendStop, void (*callback)());
 
 /** Return start address and size of the flash page the given address resides in. Returns false if
   * the page is outside of the flash address range */
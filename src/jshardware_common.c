@@ -119,6 +119,22 @@ __attribute__((weak)) bool jshSPISendMany(IOEventFlags device, unsigned char *tx
   return true;
 }
 
+/** Write to the I2C device without waiting. This version just does it
+ * synchronously and then calls the callback */
+__attribute__((weak)) bool jshI2CWriteAsync(IOEventFlags device, unsigned char address, int nBytes, const unsigned char *data, bool sendStop, void (*callback)()) {
+  jshI2CWrite(device, address, nBytes, data, sendStop);
+  callback();
+  return true;
+}
+
+/** Read from the I2C device without waiting. This version just does it
+ * synchronously and then calls the callback */
+__attribute__((weak)) bool jshI2CReadAsync(IOEventFlags device, unsigned char address, int nBytes, unsigned char *data, bool sendStop, void (*callback)()) {
+  jshI2CRead(device, address, nBytes, data, sendStop);
+  callback();
+  return true;
+}
+
 // Only define this if it's not used elsewhere
 __attribute__((weak)) void jshBusyIdle() {
 }
@@ -21,6 +21,7 @@
 #include "jswrap_json.h"
 #include "jswrap_io.h"
 #include "jswrap_stream.h"
+#include "jsserial.h" // Serial rxBuffer
 #include "jswrap_espruino.h" // jswrap_espruino_getErrorFlagArray
 #include "jsflash.h" // load and save to flash
 #include "jswrap_interactive.h" // jswrap_interactive_setTimeout
@@ -105,9 +106,52 @@ Espruino.Core.Serial.write("\x10\x01\x80\x0Bhello world")
 #define ASCII_DLE (16)
 #define ASCII_SOH (1)
 
-JsVar *events = 0; // Array of events to execute
+JsVar *events = 0; // Array of events to execute that didn't fit in jsiEventRing
+#if JSI_EVENT_QUEUE_SIZE>0
+/* Ring of compact event records, executed before anything in `events`. Each
+ * record holds refs (not locks) to func, this and up to JSI_EVENT_INLINE_ARGS
+ * arguments - GC and defrag find them with jsiGetEventQueueRefs. Unused refs
+ * are always 0. */
+JsVarRef jsiEventRing[JSI_EVENT_QUEUE_SIZE][JSI_EVENT_REFS];
+uint8_t jsiEventRingArgs[JSI_EVENT_QUEUE_SIZE]; ///< argument count for each record
+uint8_t jsiEventRingHead, jsiEventRingCount; ///< index of the oldest record, and how many records there are
+#endif
+unsigned int jsiEventsSpilled; ///< How many events are in the `events` array
+unsigned int jsiEventsMax; ///< Most events that have been queued at once
+unsigned int jsiEventsDropped; ///< Events dropped because we were out of memory
 JsVarRef timerArray = 0; // Linked List of timers to check and run
 JsVarRef watchArray = 0; // Linked List of input watches to check and run
+/* Native copy of the watches in watchArray, with a list of watches for each
+ * EXTI channel so an event can go straight to its watches. Pin state and
+ * lastTime are kept here and only written back to the watch objects when the
+ * table is rebuilt (after watchArray changes) */
+typedef struct {
+  JsVar *watch; ///< the watch object in watchArray (locked while it's in the table)
+  JsSysTime lastTime; ///< time of the last edge (if hasLastTime)
+  JsVarInt debounce; ///< debounce time (in JsSysTime units), or 0
+  Pin pin;
+  int8_t edge; ///< 1 = rising, -1 = falling, 0 = both
+  bool state, recur, hasLastTime;
+  bool changed; ///< state/lastTime need writing back to the watch object
+  uint8_t next; ///< next watch for the same EXTI channel, or JSI_WATCH_NONE
+} JsiWatch;
+#define JSI_WATCH_NONE 0xFF
+typedef enum {
+  JSIWT_REBUILD, ///< table needs building from watchArray
+  JSIWT_VALID, ///< table matches watchArray
+  JSIWT_CHANGED, ///< watchArray changed while the table was in use - free it when done
+  JSIWT_OVERFLOW, ///< too many watches for the table - search watchArray instead
+} JsiWatchTableState;
+JsiWatch jsiWatches[JSI_WATCH_TABLE_SIZE];
+uint8_t jsiWatchCount; ///< number of items used in jsiWatches
+uint8_t jsiWatchFirst[ESPR_EXTI_COUNT]; ///< first watch in jsiWatches for each EXTI, or JSI_WATCH_NONE
+JsiWatchTableState jsiWatchTableState = JSIWT_REBUILD;
+bool jsiWatchTableInUse; ///< set while jsiHandleWatchEvent is going through the table
+static void jsiWatchTableFree();
+#ifndef SAVE_ON_FLASH
+static void jsiWatchCaptureStop(int ch);
+static void jsiWatchCaptureCheck();
+#endif
 // ----------------------------------------------------------------------------
 IOEventFlags consoleDevice = DEFAULT_CONSOLE_DEVICE; ///< The console device for user interaction
 #ifndef SAVE_ON_FLASH
@@ -278,8 +322,15 @@ NO_INLINE void jsiConsolePrintChar(char data) {
  */
 NO_INLINE void jsiConsolePrintString(const char *str) {
   while (*str) {
-    if (*str == '\n') jsiConsolePrintChar('\r');
-    jsiConsolePrintChar(*(str++));
+    // send everything up to the next newline in one go
+    const char *end = str;
+    while (*end && *end != '\n') end++;
+    if (end != str) jshTransmitMany(consoleDevice, (const unsigned char*)str, (unsigned int)(end-str));
+    if (*end == '\n') {
+      jsiConsolePrintChar('\r');
+      jsiConsolePrintChar(*(end++));
+    }
+    str = end;
   }
 }
 
@@ -501,6 +552,7 @@ void jsiSoftInit(bool hasBeenReset) {
   jsErrorFlags = 0;
   lastJsErrorFlags = 0;
   events = jsvNewEmptyArray();
+  jsiEventsSpilled = 0;
   inputLine = jsvNewFromEmptyString();
   inputCursorPos = 0;
   jsiInputLineCursorMoved();
@@ -554,7 +606,15 @@ void jsiSoftInit(bool hasBeenReset) {
       JsVar *watch = jsvObjectIteratorGetValue(&it);
       JsVar *watchPin = jsvObjectGetChildIfExists(watch, "pin");
       bool highAcc = jsvObjectGetBoolChild(watch, "hispeed");
-      jshPinWatch(jshGetPinFromVar(watchPin), true, highAcc?JSPW_HIGH_SPEED:JSPW_NONE);
+      IOEventFlags exti = jshPinWatch(jshGetPinFromVar(watchPin), true, highAcc?JSPW_HIGH_SPEED:JSPW_NONE);
+#ifndef SAVE_ON_FLASH
+      JsVar *capture = jsvObjectGetChildIfExists(watch, "capture");
+      if (exti && capture)
+        jsiWatchCaptureStart(exti, watch);
+      jsvUnLock(capture);
+#else
+      NOT_USED(exti);
+#endif
       jsvUnLock2(watchPin, watch);
       jsvObjectIteratorNext(&it);
     }
@@ -805,10 +865,26 @@ void jsiSoftKill() {
     jsvUnLock(events);
     events=0;
   }
+#if JSI_EVENT_QUEUE_SIZE>0
+  for (int i=0;i<JSI_EVENT_QUEUE_SIZE;i++)
+    for (int r=0;r<JSI_EVENT_REFS;r++)
+      if (jsiEventRing[i][r]) {
+        jsvUnRefRef(jsiEventRing[i][r]);
+        jsiEventRing[i][r] = 0;
+      }
+  jsiEventRingHead = 0;
+  jsiEventRingCount = 0;
+#endif
+  jsiEventsSpilled = 0;
   if (timerArray) {
     jsvUnRefRef(timerArray);
     timerArray=0;
   }
+  jsiWatchTableFree();
+#ifndef SAVE_ON_FLASH
+  for (int ch=0;ch<ESPR_EXTI_COUNT;ch++)
+    jsiWatchCaptureStop(ch);
+#endif
   if (watchArray) {
     // Check any existing watches and disable interrupts for them
     JsVar *watchArrayPtr = jsvLock(watchArray);
@@ -1980,20 +2056,77 @@ static void jsiHandleConsoleChar(char ch) {
   }
 }
 
+#if JSI_EVENT_QUEUE_SIZE>0
+/// Can we hold a ref to this var from jsiEventRing? If it's near max refs, we couldn't unref it reliably
+static bool jsiCanRefForEvent(JsVar *v) {
+  return !v || (jsvHasRef(v) && jsvGetRefs(v) < JSVARREFCOUNT_MAX-JSI_EVENT_REFS);
+}
+
+/// Try and add an event to jsiEventRing, return false if it won't fit
+static bool jsiQueueEventInRing(JsVar *object, JsVar *callback, JsVar **args, int argCount) {
+  // if anything is in `events` then we must go after it to keep the order
+  if (jsiEventRingCount>=JSI_EVENT_QUEUE_SIZE || argCount>JSI_EVENT_INLINE_ARGS || jsiEventsSpilled)
+    return false;
+  if (!jsiCanRefForEvent(object) || !jsiCanRefForEvent(callback)) return false;
+  for (int i=0;i<argCount;i++)
+    if (!jsiCanRefForEvent(args[i])) return false;
+  unsigned int idx = (unsigned int)(jsiEventRingHead+jsiEventRingCount) % JSI_EVENT_QUEUE_SIZE;
+  JsVarRef *refs = jsiEventRing[idx];
+  refs[0] = callback ? jsvGetRef(jsvRef(callback)) : 0;
+  refs[1] = object ? jsvGetRef(jsvRef(object)) : 0;
+  for (int i=0;i<argCount;i++)
+    refs[2+i] = args[i] ? jsvGetRef(jsvRef(args[i])) : 0;
+  jsiEventRingArgs[idx] = (uint8_t)argCount;
+  jsiEventRingCount++;
+  return true;
+}
+#endif
+
+JsVarRef *jsiGetEventQueueRefs(unsigned int *count) {
+#if JSI_EVENT_QUEUE_SIZE>0
+  *count = JSI_EVENT_QUEUE_SIZE*JSI_EVENT_REFS;
+  return &jsiEventRing[0][0];
+#else
+  *count = 0;
+  return 0;
+#endif
+}
+
+void jsiGetEventQueueStats(unsigned int *depth, unsigned int *maxDepth, unsigned int *dropped) {
+#if JSI_EVENT_QUEUE_SIZE>0
+  *depth = jsiEventRingCount + jsiEventsSpilled;
+#else
+  *depth = jsiEventsSpilled;
+#endif
+  *maxDepth = jsiEventsMax;
+  *dropped = jsiEventsDropped;
+}
+
 /// Queue a function, string, or array (of funcs/strings) to be executed next time around the idle loop
 void jsiQueueEvents(JsVar *object, JsVar *callback, JsVar **args, int argCount) { // an array of functions, a string, or a single function
   assert(argCount<10);
-  JsVar *event = jsvNewObject();
-  if (event) { // Could be out of memory error!
-    jsvUnLock(jsvAddNamedChild(event, callback, "func"));
-    if (argCount) {
-      JsVar *arr = jsvNewArray(args, argCount);
-      if (arr)
-        jsvAddNamedChildAndUnLock(event, arr, "args");
-    }
-    if (object) jsvUnLock(jsvAddNamedChild(event, object, "this"));
-    jsvArrayPushAndUnLock(events, event);
+  unsigned int depth, maxDepth, dropped;
+#if JSI_EVENT_QUEUE_SIZE>0
+  if (!jsiQueueEventInRing(object, callback, args, argCount)) {
+#endif
+    JsVar *event = jsvNewObject();
+    if (event) { // Could be out of memory error!
+      jsvUnLock(jsvAddNamedChild(event, callback, "func"));
+      if (argCount) {
+        JsVar *arr = jsvNewArray(args, argCount);
+        if (arr)
+          jsvAddNamedChildAndUnLock(event, arr, "args");
+      }
+      if (object) jsvUnLock(jsvAddNamedChild(event, object, "this"));
+      jsvArrayPushAndUnLock(events, event);
+      jsiEventsSpilled++;
+    } else
+      jsiEventsDropped++;
+#if JSI_EVENT_QUEUE_SIZE>0
   }
+#endif
+  jsiGetEventQueueStats(&depth, &maxDepth, &dropped);
+  if (depth > jsiEventsMax) jsiEventsMax = depth;
 }
 
 bool jsiObjectHasCallbacks(JsVar *object, const char *callbackName) {
@@ -2010,11 +2143,40 @@ void jsiQueueObjectCallbacks(JsVar *object, const char *callbackName, JsVar **ar
   jsvUnLock(callback);
 }
 
+/// Is there anything in the event queue?
+static bool jsiHasQueuedEvents() {
+#if JSI_EVENT_QUEUE_SIZE>0
+  if (jsiEventRingCount) return true;
+#endif
+  return jsiEventsSpilled || !jsvArrayIsEmpty(events);
+}
+
 void jsiExecuteEvents() {
-  bool hasEvents = !jsvArrayIsEmpty(events);
+  bool hasEvents = jsiHasQueuedEvents();
   if (hasEvents) jsiSetBusy(BUSY_INTERACTIVE, true);
-  while (!jsvArrayIsEmpty(events)) {
+  while (true) {
+#if JSI_EVENT_QUEUE_SIZE>0
+    // Anything in the ring is older than anything in `events`
+    if (jsiEventRingCount) {
+      JsVarRef *refs = jsiEventRing[jsiEventRingHead];
+      unsigned int argCount = jsiEventRingArgs[jsiEventRingHead];
+      JsVar *vars[JSI_EVENT_REFS];
+      // lock before unref so nothing gets freed, and clear the record before we run code that could queue more events
+      for (unsigned int i=0;i<argCount+2;i++) {
+        vars[i] = jsvLockSafe(refs[i]);
+        if (vars[i]) jsvUnRef(vars[i]);
+        refs[i] = 0;
+      }
+      jsiEventRingHead = (uint8_t)((jsiEventRingHead+1) % JSI_EVENT_QUEUE_SIZE);
+      jsiEventRingCount--;
+      jsiExecuteEventCallback(vars[1], vars[0], argCount, &vars[2]);
+      jsvUnLockMany(argCount+2, vars);
+      continue;
+    }
+#endif
+    if (jsvArrayIsEmpty(events)) break;
     JsVar *event = jsvSkipNameAndUnLock(jsvArrayPopFirst(events));
+    if (jsiEventsSpilled) jsiEventsSpilled--;
     // Get function to execute
     JsVar *func = jsvObjectGetChildIfExists(event, "func");
     JsVar *thisVar = jsvObjectGetChildIfExists(event, "this");
@@ -2135,12 +2297,461 @@ bool jsiHasTimers() {
   return hasTimers;
 }
 
-/// Is the given watch object meant to be executed when the current value of the pin is pinIsHigh
-bool jsiShouldExecuteWatch(JsVar *watchPtr, bool pinIsHigh) {
-  int watchEdge = (int)jsvObjectGetIntegerChild(watchPtr, "edge");
-  return watchEdge==0 || // any edge
-      (pinIsHigh && watchEdge>0) || // rising edge
-      (!pinIsHigh && watchEdge<0); // falling edge
+/// Is the given watch meant to be executed when the current value of the pin is pinIsHigh
+static bool jsiShouldExecuteWatch(JsiWatch *w, bool pinIsHigh) {
+  return w->edge==0 || // any edge
+      (pinIsHigh && w->edge>0) || // rising edge
+      (!pinIsHigh && w->edge<0); // falling edge
+}
+
+/// Fill in a JsiWatch from the watch object in watchArray
+static void jsiWatchLoad(JsiWatch *w, JsVar *watchPtr) {
+  w->watch = watchPtr;
+  w->pin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(watchPtr, "pin"));
+  w->edge = (int8_t)jsvObjectGetIntegerChild(watchPtr, "edge");
+  w->debounce = jsvObjectGetIntegerChild(watchPtr, "debounce");
+  w->recur = jsvObjectGetBoolChild(watchPtr, "recur");
+  w->state = jsvObjectGetBoolChild(watchPtr, "state");
+  JsVar *lastTime = jsvObjectGetChildIfExists(watchPtr, "lastTime");
+  w->hasLastTime = lastTime!=0;
+  w->lastTime = lastTime ? jshGetTimeFromMilliseconds(jsvGetFloatAndUnLock(lastTime)*1000) : 0;
+  w->changed = false;
+  w->next = JSI_WATCH_NONE;
+}
+
+/// Write the state we keep in C back into the watch object (if it changed)
+static void jsiWatchSave(JsiWatch *w) {
+  if (!w->changed) return;
+  jsvObjectSetChildAndUnLock(w->watch, "state", jsvNewFromBool(w->state));
+  if (w->hasLastTime)
+    jsvObjectSetChildAndUnLock(w->watch, "lastTime", jsvNewFromFloat(jshGetMillisecondsFromTime(w->lastTime)/1000));
+  w->changed = false;
+}
+
+/// Save and unlock everything in the watch table, and mark it as needing to be rebuilt
+static void jsiWatchTableFree() {
+  for (unsigned int i=0;i<jsiWatchCount;i++) {
+    jsiWatchSave(&jsiWatches[i]);
+    jsvUnLock(jsiWatches[i].watch);
+  }
+  jsiWatchCount = 0;
+  jsiWatchTableState = JSIWT_REBUILD;
+}
+
+void jsiWatchesChanged() {
+#ifndef SAVE_ON_FLASH
+  jsiWatchCaptureCheck();
+#endif
+  if (jsiWatchTableInUse) {
+    // jsiHandleWatchEvent is using the table, so it'll free it when done
+    if (jsiWatchTableState == JSIWT_VALID)
+      jsiWatchTableState = JSIWT_CHANGED;
+  } else if (jsiWatchTableState != JSIWT_REBUILD) {
+    // unlock watches now so cleared ones can be freed - we'll rebuild when we next need to
+    jsiWatchTableFree();
+  }
+}
+
+/// Make sure the watch table matches watchArray (or is marked as JSIWT_OVERFLOW)
+static void jsiWatchTableUpdate() {
+  if (jsiWatchTableState==JSIWT_VALID || jsiWatchTableState==JSIWT_OVERFLOW) return;
+  jsiWatchTableFree();
+  for (int i=0;i<ESPR_EXTI_COUNT;i++)
+    jsiWatchFirst[i] = JSI_WATCH_NONE;
+  jsiWatchTableState = JSIWT_VALID;
+  if (!watchArray) return;
+  JsVar *watchArrayPtr = jsvLock(watchArray);
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, watchArrayPtr);
+  while (jsvObjectIteratorHasValue(&it)) {
+    if (jsiWatchCount >= JSI_WATCH_TABLE_SIZE) {
+      // too many watches - we'll just have to search watchArray
+      jsiWatchTableFree();
+      jsiWatchTableState = JSIWT_OVERFLOW;
+      break;
+    }
+    JsiWatch *w = &jsiWatches[jsiWatchCount++];
+    jsiWatchLoad(w, jsvObjectIteratorGetValue(&it)); // keep the lock while it's in the table
+    // link it onto the end of the list for its EXTI channel
+    for (int ch=0;ch<ESPR_EXTI_COUNT;ch++) {
+      if (jshIsEventForPin((IOEventFlags)(EV_EXTI0+ch), w->pin)) {
+        uint8_t *link = &jsiWatchFirst[ch];
+        while (*link != JSI_WATCH_NONE)
+          link = &jsiWatches[*link].next;
+        *link = (uint8_t)(jsiWatchCount-1);
+        break;
+      }
+    }
+    jsvObjectIteratorNext(&it);
+  }
+  jsvObjectIteratorFree(&it);
+  jsvUnLock(watchArrayPtr);
+}
+
+/** Get the JsiWatch for a watch object - from the table if it's there,
+ * or loaded into tmp if not. Call jsiWatchPut when done */
+static JsiWatch *jsiWatchGet(JsVar *watchPtr, JsiWatch *tmp) {
+  jsiWatchTableUpdate();
+  if (jsiWatchTableState == JSIWT_VALID)
+    for (unsigned int i=0;i<jsiWatchCount;i++)
+      if (jsiWatches[i].watch == watchPtr)
+        return &jsiWatches[i];
+  jsiWatchLoad(tmp, watchPtr);
+  return tmp;
+}
+
+static void jsiWatchPut(JsiWatch *w, JsiWatch *tmp) {
+  if (w == tmp) jsiWatchSave(tmp);
+}
+
+/// Remove a (non-recurring) watch from watchArray, and stop watching the pin if nothing else is
+static void jsiWatchRemove(JsiWatch *w) {
+  JsVar *watchArrayPtr = jsvLock(watchArray);
+  JsVar *watchNamePtr = jsvGetIndexOf(watchArrayPtr, w->watch, true);
+  if (watchNamePtr)
+    jsvRemoveChildAndUnLock(watchArrayPtr, watchNamePtr);
+  jsvUnLock(watchArrayPtr);
+  jsiWatchesChanged();
+  if (!jsiIsWatchingPin(w->pin))
+    jshPinWatch(w->pin, false, JSPW_NONE);
+}
+
+/** Handle an EXTI event for the given watch. Only touches JS variables
+ * if the callback is called or a debounce timeout is needed. Returns false
+ * if the watch should now be removed */
+static bool jsiWatchHandleEvent(JsiWatch *w, IOEventFlags eventFlags, JsSysTime eventTime) {
+  // Now actually process the event
+  bool pinIsHigh = (eventFlags&EV_EXTI_IS_HIGH)!=0;
+  bool ignoreEvent = false;
+#ifdef BANGLEJS
+  /* This is a bodge for Bangle.js. We want to get events for any button press here so
+  we can keep our debounce state machine up to date, but for some button presses we
+  may not want to actually forward them to user-facing code. */
+  ignoreEvent = (eventFlags&EV_EXTI_DATA_PIN_HIGH)!=0;
+#endif
+
+  bool executeNow = false;
+  if (w->debounce<=0) {
+    executeNow = !ignoreEvent;
+    w->state = pinIsHigh; // set the state anyway
+    w->changed = true;
+  } else { // Debouncing - use timeouts to ensure we only fire at the right time
+    // store the current state of the pin
+    bool oldWatchState = w->state;
+    JsVar *timeout = jsvObjectGetChildIfExists(w->watch, "timeout");
+    if (timeout) { // if we had a timeout, update the callback time
+      JsSysTime timeoutTime = jsiLastIdleTime + (JsSysTime)jsvGetLongIntegerAndUnLock(jsvObjectGetChildIfExists(timeout, "time"));
+      jsvUnLock(jsvObjectSetChild(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiLastIdleTime) + w->debounce)));
+      jsvObjectSetChildAndUnLock(timeout, "state", jsvNewFromBool(pinIsHigh));
+      if (ignoreEvent || ((eventTime > timeoutTime) && (pinIsHigh!=oldWatchState))) {
+        // timeout should have fired, but we didn't get around to executing it!
+        // Do it now (with the old timeout time)
+        executeNow = !ignoreEvent;
+        eventTime = timeoutTime - w->debounce;
+        w->state = pinIsHigh;
+        w->changed = true;
+        // Remove the timeout
+        jsiClearTimeout(timeout);
+        jsvObjectRemoveChild(w->watch, "timeout");
+      }
+    } else if (!ignoreEvent && pinIsHigh!=oldWatchState) { // else create a new timeout
+      timeout = jsvNewObject();
+      if (timeout) {
+        jsvObjectSetChild(timeout, "watch", w->watch); // no unlock
+        jsvObjectSetChildAndUnLock(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiLastIdleTime) + w->debounce));
+        jsvObjectSetChildAndUnLock(timeout, "cb", jsvObjectGetChildIfExists(w->watch, "cb"));
+        jsvObjectSetChildAndUnLock(timeout, "pin", jsvNewFromPin(w->pin));
+        jsvObjectSetChildAndUnLock(timeout, "state", jsvNewFromBool(pinIsHigh));
+        // Add to timer array
+        jsiTimerAdd(timeout);
+        // Add to our watch
+        jsvObjectSetChild(w->watch, "timeout", timeout); // no unlock
+      }
+    } else if (ignoreEvent) {
+      w->state = pinIsHigh;
+      w->changed = true;
+    }
+    jsvUnLock(timeout);
+  }
+
+  // If we want to execute this watch right now...
+  bool keepWatch = true;
+  if (executeNow) {
+    JsVar *data = 0;
+    bool execute = jsiShouldExecuteWatch(w, pinIsHigh); // edge triggering
+    if (execute) {
+      data = jsvNewObject();
+      if (data) {
+        jsvObjectSetChildAndUnLock(data, "state", jsvNewFromBool(pinIsHigh));
+        if (w->hasLastTime)
+          jsvObjectSetChildAndUnLock(data, "lastTime", jsvNewFromFloat(jshGetMillisecondsFromTime(w->lastTime)/1000));
+        jsvObjectSetChildAndUnLock(data, "time", jsvNewFromFloat(jshGetMillisecondsFromTime(eventTime)/1000));
+        jsvObjectSetChildAndUnLock(data, "pin", jsvNewFromPin(w->pin));
+        Pin dataPin = jshGetEventDataPin(IOEVENTFLAGS_GETTYPE(eventFlags));
+        if (jshIsPinValid(dataPin))
+          jsvObjectSetChildAndUnLock(data, "data", jsvNewFromBool((eventFlags&EV_EXTI_DATA_PIN_HIGH)!=0));
+      }
+    }
+    // Update lastTime regardless of which edge we're watching
+    w->lastTime = eventTime;
+    w->hasLastTime = true;
+    w->changed = true;
+    if (execute) {
+      JsVar *watchCallback = jsvObjectGetChildIfExists(w->watch, "cb");
+      keepWatch = w->recur;
+      if (!jsiExecuteEventCallback(0, watchCallback, 1, &data) && keepWatch) {
+        jsError("Ctrl-C while processing watch - removing it.");
+        jsErrorFlags |= JSERR_CALLBACK;
+        keepWatch = false;
+      }
+      jsvUnLock2(data, watchCallback);
+    }
+  }
+  return keepWatch;
+}
+
+#ifndef SAVE_ON_FLASH
+/* Edge capture for setWatch's `capture` option. Edges are written into
+ * a Uint32Array from the EXTI callback, without going via the event queue.
+ * Each item is the time in microseconds (bits 0..30) and the new pin state
+ * (bit 31). JS gets one callback when the array is half full, or when there
+ * have been no edges for `captureGap`. */
+typedef struct {
+  uint32_t *buf; ///< data of the Uint32Array we're writing into, or 0 if not capturing
+  JsVar *backing; ///< locked string backing buf, so it can't move or be freed while we write to it
+  uint32_t len; ///< number of items in buf
+  volatile uint32_t head; ///< total edges written (only changed by jsiWatchCaptureIRQ)
+  uint32_t tail; ///< total edges passed to JS (only changed by jsiWatchCaptureFlush)
+  volatile uint32_t overflow; ///< total edges dropped because buf was full (only changed by jsiWatchCaptureIRQ)
+  uint32_t overflowReported; ///< total dropped edges passed to JS (only changed by jsiWatchCaptureFlush)
+  volatile JsSysTime lastEdge; ///< time of the last edge
+  JsSysTime gap; ///< call JS after no edges for this long
+  Pin pin;
+  volatile bool pending; ///< we've pushed an event to ask for the data to be handled
+} JsiWatchCapture;
+JsiWatchCapture jsiCaptures[ESPR_EXTI_COUNT];
+
+static void CALLED_FROM_INTERRUPT jsiWatchCaptureIRQ(bool state, IOEventFlags channel) {
+  JsiWatchCapture *c = &jsiCaptures[IOEVENTFLAGS_GETTYPE(channel)-EV_EXTI0];
+  if (!c->buf) return;
+  JsSysTime time = jshGetSystemTime();
+  c->lastEdge = time;
+  uint32_t used = c->head - c->tail;
+  if (used >= c->len) {
+    c->overflow++;
+    return;
+  }
+  uint32_t us = (uint32_t)(JsSysTime)(jshGetMillisecondsFromTime(time)*1000);
+  c->buf[c->head % c->len] = (us & 0x7FFFFFFF) | (state ? 0x80000000 : 0);
+  c->head++;
+  if (used+1 >= c->len/2 && !c->pending) {
+    c->pending = true;
+    jshPushIOEvent(IOEVENTFLAGS_GETTYPE(channel), time);
+  }
+}
+
+bool jsiWatchCaptureStart(IOEventFlags exti, JsVar *watchPtr) {
+  JsVar *arr = jsvObjectGetChildIfExists(watchPtr, "capture");
+  JsVar *backing = jsvIsArrayBuffer(arr) ? jsvGetArrayBufferBackingString(arr, NULL) : 0;
+  size_t len = 0;
+  uint32_t *buf = (uint32_t*)jsvGetDataPointer(arr, &len);
+  bool isUint32 = jsvIsArrayBuffer(arr) && arr->varData.arraybuffer.type==ARRAYBUFFERVIEW_UINT32;
+  jsvUnLock(arr);
+  if (!isUint32 || !buf || ((size_t)buf)&3 || len<2 ||
+      jsvIsNativeString(backing) || jsvIsFlashString(backing)) {
+    jsvUnLock(backing);
+    return false;
+  }
+  JsiWatchCapture *c = &jsiCaptures[exti-EV_EXTI0];
+  c->backing = backing; // keep the lock
+  c->len = (uint32_t)len;
+  c->head = 0;
+  c->tail = 0;
+  c->overflow = 0;
+  c->overflowReported = 0;
+  c->pending = false;
+  c->lastEdge = jshGetSystemTime();
+  c->gap = (JsSysTime)jsvObjectGetIntegerChild(watchPtr, "captureGap");
+  c->pin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(watchPtr, "pin"));
+  c->buf = buf;
+  jshSetEventCallback(exti, jsiWatchCaptureIRQ);
+  return true;
+}
+
+static void jsiWatchCaptureStop(int ch) {
+  JsiWatchCapture *c = &jsiCaptures[ch];
+  if (!c->buf) return;
+  jshSetEventCallback((IOEventFlags)(EV_EXTI0+ch), 0);
+  c->buf = 0;
+  jsvUnLock(c->backing);
+  c->backing = 0;
+}
+
+/// Stop capturing edges for any watch that's been removed (or for all if watchArray is gone)
+static void jsiWatchCaptureCheck() {
+  bool found[ESPR_EXTI_COUNT];
+  memset(found, 0, sizeof(found));
+  if (watchArray) {
+    JsVar *watchArrayPtr = jsvLock(watchArray);
+    JsvObjectIterator it;
+    jsvObjectIteratorNew(&it, watchArrayPtr);
+    while (jsvObjectIteratorHasValue(&it)) {
+      JsVar *watchPtr = jsvObjectIteratorGetValue(&it);
+      JsVar *capture = jsvObjectGetChildIfExists(watchPtr, "capture");
+      if (capture) {
+        Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(watchPtr, "pin"));
+        for (int ch=0;ch<ESPR_EXTI_COUNT;ch++)
+          if (jsiCaptures[ch].buf && jsiCaptures[ch].pin==pin)
+            found[ch] = true;
+      }
+      jsvUnLock2(capture, watchPtr);
+      jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+    jsvUnLock(watchArrayPtr);
+  }
+  for (int ch=0;ch<ESPR_EXTI_COUNT;ch++)
+    if (!found[ch]) jsiWatchCaptureStop(ch);
+}
+
+/// Call the watch's callback with any edges that have been captured
+static void jsiWatchCaptureFlush(int ch) {
+  JsiWatchCapture *c = &jsiCaptures[ch];
+  c->pending = false; // clear first, so edges after this will ask again
+  uint32_t head = c->head;
+  uint32_t count = head - c->tail;
+  uint32_t overflow = c->overflow - c->overflowReported;
+  if (!count && !overflow) return;
+  // find the watch
+  JsVar *watchPtr = 0;
+  JsVar *watchArrayPtr = jsvLock(watchArray);
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, watchArrayPtr);
+  while (!watchPtr && jsvObjectIteratorHasValue(&it)) {
+    JsVar *w = jsvObjectIteratorGetValue(&it);
+    JsVar *capture = jsvObjectGetChildIfExists(w, "capture");
+    if (capture && jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(w, "pin"))==c->pin)
+      watchPtr = jsvLockAgain(w);
+    jsvUnLock2(capture, w);
+    jsvObjectIteratorNext(&it);
+  }
+  jsvObjectIteratorFree(&it);
+  jsvUnLock(watchArrayPtr);
+  if (!watchPtr) return;
+  JsVar *data = jsvNewObject();
+  if (data) {
+    jsvObjectSetChildAndUnLock(data, "pin", jsvNewFromPin(c->pin));
+    jsvObjectSetChildAndUnLock(data, "buffer", jsvObjectGetChildIfExists(watchPtr, "capture"));
+    jsvObjectSetChildAndUnLock(data, "start", jsvNewFromInteger((JsVarInt)(c->tail % c->len)));
+    jsvObjectSetChildAndUnLock(data, "count", jsvNewFromInteger((JsVarInt)count));
+    jsvObjectSetChildAndUnLock(data, "overflow", jsvNewFromInteger((JsVarInt)overflow));
+    JsVar *cb = jsvObjectGetChildIfExists(watchPtr, "cb");
+    jsiExecuteEventCallback(0, cb, 1, &data);
+    jsvUnLock2(cb, data);
+  }
+  jsvUnLock(watchPtr);
+  // The callback is done with these now, so the IRQ can reuse the space
+  if (c->buf) {
+    c->tail = head;
+    c->overflowReported += overflow;
+  }
+}
+
+/// Flush any captures that haven't had an edge for their gap time. Returns true if any callbacks were called
+static bool jsiWatchCaptureIdle(JsSysTime *minTimeUntilNext) {
+  bool wasBusy = false;
+  JsSysTime time = jshGetSystemTime();
+  for (int ch=0;ch<ESPR_EXTI_COUNT;ch++) {
+    JsiWatchCapture *c = &jsiCaptures[ch];
+    if (!c->buf || (c->head==c->tail && c->overflow==c->overflowReported)) continue;
+    JsSysTime timeUntilGap = c->lastEdge + c->gap - time;
+    if (timeUntilGap<=0) {
+      jsiWatchCaptureFlush(ch);
+      wasBusy = true;
+    } else if (timeUntilGap < *minTimeUntilNext)
+      *minTimeUntilNext = timeUntilGap;
+  }
+  return wasBusy;
+}
+#endif
+
+/// Handle an EXTI event, passing it to any watches for its pin
+static void jsiHandleWatchEvent(IOEventFlags eventFlags, uint32_t eventTime32) {
+  /** Work out event time. Events time is only stored in 32 bits, so we need to
+   * use the correct 'high' 32 bits from the current time.
+   *
+   * We know that the current time is always newer than the event time, so
+   * if the bottom 32 bits of the current time is less than the bottom
+   * 32 bits of the event time, we need to subtract a full 32 bits worth
+   * from the current time.
+   */
+  JsSysTime time = jshGetSystemTime();
+  if (((uint32_t)time) < eventTime32)
+    time = time - 0x100000000LL;
+  // finally, mask in the event's time
+  JsSysTime eventTime = (time & ~0xFFFFFFFFLL) | (JsSysTime)eventTime32;
+
+#ifndef SAVE_ON_FLASH
+  // capturing edges - this event just means there's data to handle
+  int ch = IOEVENTFLAGS_GETTYPE(eventFlags)-EV_EXTI0;
+  if (jsiCaptures[ch].buf) {
+    jsiWatchCaptureFlush(ch);
+    return;
+  }
+#endif
+  jsiWatchTableUpdate();
+  if (jsiWatchTableState == JSIWT_VALID) {
+    // go straight to the watches for this EXTI
+    jsiWatchTableInUse = true;
+    uint8_t idx = jsiWatchFirst[IOEVENTFLAGS_GETTYPE(eventFlags)-EV_EXTI0];
+    while (idx != JSI_WATCH_NONE) {
+      JsiWatch *w = &jsiWatches[idx];
+      idx = w->next;
+      /* if a callback changed the watches (eg. clearWatch) the table is
+       * still valid for now, but check the watch still exists */
+      if (jsiWatchTableState == JSIWT_CHANGED) {
+        JsVar *watchArrayPtr = jsvLock(watchArray);
+        JsVar *watchNamePtr = jsvGetIndexOf(watchArrayPtr, w->watch, true);
+        jsvUnLock(watchArrayPtr);
+        if (!watchNamePtr) continue;
+        jsvUnLock(watchNamePtr);
+      }
+      if (!jsiWatchHandleEvent(w, eventFlags, eventTime))
+        jsiWatchRemove(w);
+    }
+    jsiWatchTableInUse = false;
+    if (jsiWatchTableState == JSIWT_CHANGED)
+      jsiWatchTableFree();
+  } else {
+    // Too many watches for the table - check everything in our Watch array
+    JsVar *watchArrayPtr = jsvLock(watchArray);
+    JsvObjectIterator it;
+    jsvObjectIteratorNew(&it, watchArrayPtr);
+    while (jsvObjectIteratorHasValue(&it)) {
+      bool hasDeletedWatch = false;
+      JsVar *watchPtr = jsvObjectIteratorGetValue(&it);
+      Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(watchPtr, "pin"));
+      if (jshIsEventForPin(eventFlags, pin)) {
+        JsiWatch w;
+        jsiWatchLoad(&w, watchPtr);
+        if (jsiWatchHandleEvent(&w, eventFlags, eventTime)) {
+          jsiWatchSave(&w);
+        } else {
+          // free all
+          jsvObjectIteratorRemoveAndGotoNext(&it, watchArrayPtr);
+          hasDeletedWatch = true;
+          jsiWatchesChanged();
+          if (!jsiIsWatchingPin(pin))
+            jshPinWatch(pin, false, JSPW_NONE);
+        }
+      }
+      jsvUnLock(watchPtr);
+      if (!hasDeletedWatch)
+        jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+    jsvUnLock(watchArrayPtr);
+  }
 }
 
 bool jsiIsWatchingPin(Pin pin) {
@@ -2171,24 +2782,53 @@ void jsiCtrlC() {
   execInfo.execute |= EXEC_CTRL_C;
 }
 
-/** Take an event for a UART and handle the characters we're getting, potentially
- * grabbing more characters as well if it's easy. If more character events are
- * grabbed, the number of extra events (not characters) is returned */
-int jsiHandleIOEventForSerial(JsVar *usartClass, IOEventFlags eventFlags, uint8_t *data, unsigned int length) {
-  int eventsHandled = length+2;
-  JsVar *stringData = length ? jsvNewStringOfLength(length, (char*)data) : NULL;
+/** Take events for a UART and handle the characters we're getting. Any
+ * following entries in 'events' for the same device are handled too, and if
+ * that's all of them we grab any more from the top of the event queue.
+ * Returns the number of entries in 'events' that were handled */
+unsigned int jsiHandleIOEventForSerial(JsVar *usartClass, IOEvent *events, unsigned int count) {
+  IOEventFlags device = IOEVENTFLAGS_GETTYPE(events[0].flags);
+  if (!events[0].length) return 1;
+  unsigned int i, handled = 1;
+  while (handled<count && IOEVENTFLAGS_GETTYPE(events[handled].flags)==device)
+    handled++;
+  bool fromQueue = handled==count; // no other devices' events in between
+  IOEvent *event = &events[handled-1]; // we pop any more events into this once it's handled
+  unsigned int length;
+#ifndef SAVE_ON_FLASH
+  JsSerialRxBuffer *rb;
+  JsVar *rxBuf = jsserialGetRxBuffer(usartClass, &rb);
+  if (rxBuf) {
+    // copy straight into the receive ring buffer rather than making strings
+    for (i=0;i<handled;i++)
+      jsserialRxBufferPush(usartClass, rxBuf, rb, events[i].data, events[i].length);
+    while (fromQueue && jshIsTopEvent(device)) {
+      jshPopIOEvent(event->data, &length);
+      jsserialRxBufferPush(usartClass, rxBuf, rb, event->data, length);
+    }
+    jsserialRxBufferDispatch(usartClass, rxBuf, rb);
+    jsvUnLock(rxBuf);
+    return handled;
+  }
+#endif
+  JsVar *stringData;
+  if (handled==1 && !(fromQueue && jshIsTopEvent(device))) // just one event - may be able to use a flat string
+    stringData = jsvNewStringOfLength(events[0].length, (char*)events[0].data);
+  else // we're appending, so we need a normal string (flat strings can't be appended to)
+    stringData = jsvNewFromEmptyString();
   if (stringData) {
-    while (jshIsTopEvent(IOEVENTFLAGS_GETTYPE(eventFlags))) {
-      jshPopIOEvent(data, &length); // we know data/length are big enough
-      eventsHandled += length+2;
-      jsvAppendStringBuf(stringData, (char*)data, length);
+    for (i=(jsvGetStringLength(stringData) ? 1 : 0);i<handled;i++)
+      jsvAppendStringBuf(stringData, (char*)events[i].data, events[i].length);
+    while (fromQueue && jshIsTopEvent(device)) {
+      jshPopIOEvent(event->data, &length); // we know data/length are big enough
+      jsvAppendStringBuf(stringData, (char*)event->data, length);
       // don't use an iterator for appending as we just assume we're probably not handling *that* much data this way - normally it'll come in big chunks
     }
     // Now run the handler
     jswrap_stream_pushData(usartClass, stringData, true);
     jsvUnLock(stringData);
   }
-  return length+2;
+  return handled;
 }
 
 void jsiHandleIOEventForConsole(uint8_t *eventData, int eventLen) {
@@ -2204,14 +2844,24 @@ void jsiIdle() {
 
   // Handle hardware-related idle stuff (like checking for pin events)
   bool wasBusy = false;
-  IOEventFlags eventFlags;
-  uint8_t eventData[IOEVENT_MAX_LEN];
-  unsigned int eventLen;
+  IOEvent events[IOEVENT_POP_BATCH];
+  unsigned int eventCount = 0, eventIdx = 0;
   // ensure we can't get totally swamped by having more events than we can process.
   // Just process what was in the event queue at the start
   int maxEvents = jshGetEventsUsed();
 
-  while ((maxEvents--)>0 && ((eventFlags=jshPopIOEvent(eventData, &eventLen))!=EV_NONE)) {
+  while (true) {
+    if (eventIdx>=eventCount) { // get the next batch of events
+      if (maxEvents<=0) break;
+      eventCount = jshPopIOEvents(events, IOEVENT_POP_BATCH);
+      eventIdx = 0;
+      if (!eventCount) break;
+    }
+    IOEvent *event = &events[eventIdx++];
+    maxEvents--;
+    IOEventFlags eventFlags = event->flags;
+    uint8_t *eventData = event->data;
+    unsigned int eventLen = event->length;
     jsiSetBusy(BUSY_INTERACTIVE, true);
     wasBusy = true;
 
@@ -2226,7 +2876,9 @@ void jsiIdle() {
       // ------------------------------------------------------------------------ SERIAL CALLBACK
       JsVar *usartClass = jsvSkipNameAndUnLock(jsiGetClassNameFromDevice(eventType));
       if (jsvIsObject(usartClass)) {
-        maxEvents -= jsiHandleIOEventForSerial(usartClass, eventFlags, eventData, eventLen);
+        unsigned int handled = jsiHandleIOEventForSerial(usartClass, event, eventCount+1-eventIdx);
+        eventIdx += handled-1;
+        maxEvents -= (int)handled-1;
       }
       jsvUnLock(usartClass);
 #if ESPR_USART_COUNT>0
@@ -2271,126 +2923,7 @@ void jsiIdle() {
 #endif
     } else if (DEVICE_IS_EXTI(eventType)) { // ---------------------------------------------------------------- PIN WATCH
       // we have an event... find out what it was for...
-      // Check everything in our Watch array
-      JsVar *watchArrayPtr = jsvLock(watchArray);
-      JsvObjectIterator it;
-      jsvObjectIteratorNew(&it, watchArrayPtr);
-      while (jsvObjectIteratorHasValue(&it)) {
-        bool hasDeletedWatch = false;
-        JsVar *watchPtr = jsvObjectIteratorGetValue(&it);
-        Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(watchPtr, "pin"));
-
-        if (jshIsEventForPin(eventFlags, pin)) {
-          /** Work out event time. Events time is only stored in 32 bits, so we need to
-           * use the correct 'high' 32 bits from the current time.
-           *
-           * We know that the current time is always newer than the event time, so
-           * if the bottom 32 bits of the current time is less than the bottom
-           * 32 bits of the event time, we need to subtract a full 32 bits worth
-           * from the current time.
-           */
-          JsSysTime time = jshGetSystemTime();
-          uint32_t eventTime32 = *(uint32_t*)eventData;
-          if (((uint32_t)time) < eventTime32)
-            time = time - 0x100000000LL;
-          // finally, mask in the event's time
-          JsSysTime eventTime = (time & ~0xFFFFFFFFLL) | (JsSysTime)eventTime32;
-
-          // Now actually process the event
-          bool pinIsHigh = (eventFlags&EV_EXTI_IS_HIGH)!=0;
-          bool ignoreEvent = false;
-#ifdef BANGLEJS
-          /* This is a bodge for Bangle.js. We want to get events for any button press here so
-          we can keep our debounce state machine up to date, but for some button presses we
-          may not want to actually forward them to user-facing code. */
-          ignoreEvent = (eventFlags&EV_EXTI_DATA_PIN_HIGH)!=0;
-#endif
-
-          bool executeNow = false;
-          JsVarInt debounce = jsvObjectGetIntegerChild(watchPtr, "debounce");
-          if (debounce<=0) {
-            executeNow = !ignoreEvent;
-            jsvObjectSetChildAndUnLock(watchPtr, "state", jsvNewFromBool(pinIsHigh)); // set the state anyway
-          } else { // Debouncing - use timeouts to ensure we only fire at the right time
-            // store the current state of the pin
-            bool oldWatchState = jsvObjectGetBoolChild(watchPtr, "state");
-            JsVar *timeout = jsvObjectGetChildIfExists(watchPtr, "timeout");
-            if (timeout) { // if we had a timeout, update the callback time
-              JsSysTime timeoutTime = jsiLastIdleTime + (JsSysTime)jsvGetLongIntegerAndUnLock(jsvObjectGetChildIfExists(timeout, "time"));
-              jsvUnLock(jsvObjectSetChild(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiLastIdleTime) + debounce)));
-              jsvObjectSetChildAndUnLock(timeout, "state", jsvNewFromBool(pinIsHigh));
-              if (ignoreEvent || ((eventTime > timeoutTime) && (pinIsHigh!=oldWatchState))) {
-                // timeout should have fired, but we didn't get around to executing it!
-                // Do it now (with the old timeout time)
-                executeNow = !ignoreEvent;
-                eventTime = timeoutTime - debounce;
-                jsvObjectSetChildAndUnLock(watchPtr, "state", jsvNewFromBool(pinIsHigh));
-                // Remove the timeout
-                jsiClearTimeout(timeout);
-                jsvObjectRemoveChild(watchPtr, "timeout");
-              }
-            } else if (!ignoreEvent && pinIsHigh!=oldWatchState) { // else create a new timeout
-              timeout = jsvNewObject();
-              if (timeout) {
-                jsvObjectSetChild(timeout, "watch", watchPtr); // no unlock
-                jsvObjectSetChildAndUnLock(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiLastIdleTime) + debounce));
-                jsvObjectSetChildAndUnLock(timeout, "cb", jsvObjectGetChildIfExists(watchPtr, "cb"));
-                jsvObjectSetChildAndUnLock(timeout, "lastTime", jsvObjectGetChildIfExists(watchPtr, "lastTime"));
-                jsvObjectSetChildAndUnLock(timeout, "pin", jsvNewFromPin(pin));
-                jsvObjectSetChildAndUnLock(timeout, "state", jsvNewFromBool(pinIsHigh));
-                // Add to timer array
-                jsiTimerAdd(timeout);
-                // Add to our watch
-                jsvObjectSetChild(watchPtr, "timeout", timeout); // no unlock
-              }
-            } else if (ignoreEvent) {
-              jsvObjectSetChildAndUnLock(watchPtr, "state", jsvNewFromBool(pinIsHigh));
-            }
-            jsvUnLock(timeout);
-          }
-
-          // If we want to execute this watch right now...
-          if (executeNow) {
-            JsVar *timePtr = jsvNewFromFloat(jshGetMillisecondsFromTime(eventTime)/1000);
-            if (jsiShouldExecuteWatch(watchPtr, pinIsHigh)) { // edge triggering
-              JsVar *watchCallback = jsvObjectGetChildIfExists(watchPtr, "cb");
-              bool watchRecurring = jsvObjectGetBoolChild(watchPtr,  "recur");
-              JsVar *data = jsvNewObject();
-              if (data) {
-                jsvObjectSetChildAndUnLock(data, "state", jsvNewFromBool(pinIsHigh));
-                jsvObjectSetChildAndUnLock(data, "lastTime", jsvObjectGetChildIfExists(watchPtr, "lastTime"));
-                // set both data.time, and watch.lastTime in one go
-                jsvObjectSetChild(data, "time", timePtr); // no unlock
-                jsvObjectSetChildAndUnLock(data, "pin", jsvNewFromPin(pin));
-                Pin dataPin = jshGetEventDataPin(eventType);
-                if (jshIsPinValid(dataPin))
-                  jsvObjectSetChildAndUnLock(data, "data", jsvNewFromBool((eventFlags&EV_EXTI_DATA_PIN_HIGH)!=0));
-              }
-              if (!jsiExecuteEventCallback(0, watchCallback, 1, &data) && watchRecurring) {
-                jsError("Ctrl-C while processing watch - removing it.");
-                jsErrorFlags |= JSERR_CALLBACK;
-                watchRecurring = false;
-              }
-              jsvUnLock(data);
-              if (!watchRecurring) {
-                // free all
-                jsvObjectIteratorRemoveAndGotoNext(&it, watchArrayPtr);
-                hasDeletedWatch = true;
-                if (!jsiIsWatchingPin(pin))
-                  jshPinWatch(pin, false, JSPW_NONE);
-              }
-              jsvUnLock(watchCallback);
-            }
-            jsvObjectSetChildAndUnLock(watchPtr, "lastTime", timePtr);
-          }
-        }
-
-        jsvUnLock(watchPtr);
-        if (!hasDeletedWatch)
-          jsvObjectIteratorNext(&it);
-      }
-      jsvObjectIteratorFree(&it);
-      jsvUnLock(watchArrayPtr);
+      jsiHandleWatchEvent(eventFlags, *(uint32_t*)eventData);
     }
   }
 
@@ -2441,33 +2974,36 @@ void jsiIdle() {
         JsVar *watchPtr = jsvObjectGetChildIfExists(timerPtr, "watch"); // for debounce - may be undefined
         bool exec = true;
         JsVar *data = 0;
+        JsiWatch watchTmp, *watch = 0;
         if (watchPtr) {
-          bool watchState = jsvObjectGetBoolChild(watchPtr, "state");
+          watch = jsiWatchGet(watchPtr, &watchTmp);
+          bool watchState = watch->state;
           bool timerState = jsvObjectGetBoolChild(timerPtr, "state");
-          jsvObjectSetChildAndUnLock(watchPtr, "state", jsvNewFromBool(timerState));
+          watch->state = timerState;
+          watch->changed = true;
           exec = false;
           if (watchState!=timerState) {
-            // Create the 'time' variable that will be passed to the user and stored as last time
-            JsVarInt delay = jsvObjectGetIntegerChild(watchPtr, "debounce");
-            JsVar *timePtr = jsvNewFromFloat(jshGetMillisecondsFromTime(jsiLastIdleTime+timerTime-delay)/1000);
+            // if we were from a watch then we were delayed by the debounce time...
+            JsSysTime eventTime = jsiLastIdleTime+timerTime-watch->debounce;
             // If it's the right edge...
-            if (jsiShouldExecuteWatch(watchPtr, timerState)) {
+            if (jsiShouldExecuteWatch(watch, timerState)) {
               data = jsvNewObject();
-              // if we were from a watch then we were delayed by the debounce time...
               if (data) {
                 exec = true;
                 // if it was a watch, set the last state up
                 jsvObjectSetChildAndUnLock(data, "state", jsvNewFromBool(timerState));
                 // set up the lastTime variable of data to what was in the watch
-                jsvObjectSetChildAndUnLock(data, "lastTime", jsvObjectGetChildIfExists(watchPtr, "lastTime"));
-                // set up the watches lastTime to this one
-                jsvObjectSetChild(data, "time", timePtr); // don't unlock - use this later
-                jsvObjectSetChildAndUnLock(data, "pin", jsvObjectGetChildIfExists(watchPtr, "pin"));
+                if (watch->hasLastTime)
+                  jsvObjectSetChildAndUnLock(data, "lastTime", jsvNewFromFloat(jshGetMillisecondsFromTime(watch->lastTime)/1000));
+                jsvObjectSetChildAndUnLock(data, "time", jsvNewFromFloat(jshGetMillisecondsFromTime(eventTime)/1000));
+                jsvObjectSetChildAndUnLock(data, "pin", jsvNewFromPin(watch->pin));
               }
             }
             // Update lastTime regardless of which edge we're watching
-            jsvObjectSetChildAndUnLock(watchPtr, "lastTime", timePtr);
+            watch->lastTime = eventTime;
+            watch->hasLastTime = true;
           }
+          jsiWatchPut(watch, &watchTmp);
         }
         bool removeTimer = false;
         if (exec) {
@@ -2493,19 +3029,10 @@ void jsiIdle() {
         if (watchPtr) { // if we had a watch pointer, be sure to remove us from it
           jsvObjectRemoveChild(watchPtr, "timeout");
           // Deal with non-recurring watches
-          if (exec) {
-            bool watchRecurring = jsvObjectGetBoolChild(watchPtr,  "recur");
-            if (!watchRecurring) {
-              JsVar *watchArrayPtr = jsvLock(watchArray);
-              JsVar *watchNamePtr = jsvGetIndexOf(watchArrayPtr, watchPtr, true);
-              if (watchNamePtr) {
-                jsvRemoveChildAndUnLock(watchArrayPtr, watchNamePtr);
-              }
-              jsvUnLock(watchArrayPtr);
-              Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(watchPtr, "pin"));
-              if (!jsiIsWatchingPin(pin))
-                jshPinWatch(pin, false, JSPW_NONE);
-            }
+          if (exec && !jsvObjectGetBoolChild(watchPtr, "recur")) {
+            JsiWatch w;
+            jsiWatchLoad(&w, watchPtr);
+            jsiWatchRemove(&w);
           }
           jsvUnLock(watchPtr);
         }
@@ -2540,11 +3067,16 @@ void jsiIdle() {
    * loop again before sleeping.
    */
 
+#ifndef SAVE_ON_FLASH
+  // Pass captured edges to JS if there haven't been any for a while
+  if (jsiWatchCaptureIdle(&minTimeUntilNext)) wasBusy = true;
+#endif
+
   // Check for events that might need to be processed from other libraries
   if (jswIdle()) wasBusy = true;
 
   // Just in case we got any events to do and didn't clear loopsIdling before
-  if (wasBusy || !jsvArrayIsEmpty(events) )
+  if (wasBusy || jsiHasQueuedEvents())
     loopsIdling = 0;
 
   if (wasBusy)
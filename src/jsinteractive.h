@@ -26,6 +26,30 @@
 #define JSI_JSFLAGS_NAME "flags"
 #define JSI_ONINIT_NAME "onInit"
 
+/* Queued events are stored as compact records in a fixed-size ring (see
+ * jsiQueueEvents). Events with more arguments, or queued when the ring is
+ * full, spill over into a JS array. */
+#ifndef JSI_EVENT_QUEUE_SIZE
+#ifdef SAVE_ON_FLASH
+#define JSI_EVENT_QUEUE_SIZE 0 ///< no ring - everything goes in the JS array
+#else
+#define JSI_EVENT_QUEUE_SIZE 32 ///< how many events fit in the ring (max 255)
+#endif
+#endif
+#ifndef JSI_EVENT_INLINE_ARGS
+#define JSI_EVENT_INLINE_ARGS 3 ///< Max args for an event to be stored in the ring
+#endif
+#define JSI_EVENT_REFS (2+JSI_EVENT_INLINE_ARGS) ///< refs per ring record (func, this, args)
+
+/// Max watches in the native table used to dispatch pin events (more than this and watchArray is searched)
+#ifndef JSI_WATCH_TABLE_SIZE
+#ifdef SAVE_ON_FLASH
+#define JSI_WATCH_TABLE_SIZE 4
+#else
+#define JSI_WATCH_TABLE_SIZE 32
+#endif
+#endif
+
 /// autoLoad = do we load the current state if it exists?
 void jsiInit(bool autoLoad);
 void jsiKill();
@@ -44,12 +68,22 @@ bool jsiFreeMoreMemory();
 
 bool jsiHasTimers(); // are there timers still left to run?
 bool jsiIsWatchingPin(Pin pin); // are there any watches for the given pin?
+/// Call when items are added to or removed from watchArray, so the native watch table gets rebuilt
+void jsiWatchesChanged();
+/** Start capturing edges on the given EXTI into the watch's `capture` Uint32Array.
+ * Returns false if `capture` isn't a Uint32Array we can write into directly */
+bool jsiWatchCaptureStart(IOEventFlags exti, JsVar *watchPtr);
 
 /// Ctrl-C - force interrupt of execution
 void jsiCtrlC();
 
 /// Queue a function, string, or array (of funcs/strings) to be executed next time around the idle loop
 void jsiQueueEvents(JsVar *object, JsVar *callback, JsVar **args, int argCount);
+/** Return all the refs held by the event queue's ring (unused ones are 0) and set count
+ * to how many there are - so GC can mark them as used and defrag can update them */
+JsVarRef *jsiGetEventQueueRefs(unsigned int *count);
+/// Get the number of events queued right now, the most there have ever been, and how many were dropped because we were out of memory
+void jsiGetEventQueueStats(unsigned int *depth, unsigned int *maxDepth, unsigned int *dropped);
 /// Return true if the object has callbacks...
 bool jsiObjectHasCallbacks(JsVar *object, const char *callbackName);
 /// Queue up callbacks for other things (touchscreen? network?)
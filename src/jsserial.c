@@ -16,12 +16,18 @@
 #include "jstimer.h"
 #include "jswrap_espruino.h"
 #include "jswrap_stream.h"
+#include "jswrap_arraybuffer.h"
 
 void jsserialHardwareFunc(int data, serial_sender_data *info) {
   IOEventFlags device = *(IOEventFlags*)info;
   jshTransmit(device, (unsigned char)data);
 }
 
+void jsserialHardwareBufferFunc(unsigned char *data, unsigned int len, void *info) {
+  IOEventFlags device = *(IOEventFlags*)info;
+  jshTransmitMany(device, data, len);
+}
+
 #ifndef ESPR_NO_SOFTWARE_SERIAL
 /**
  * Send a single byte through Serial.
@@ -113,6 +119,9 @@ bool jsserialPopulateUSARTInfo(
       {"parity", JSV_OBJECT /* a variable */, &parity},
       {"flow", JSV_OBJECT /* a variable */, &flow},
       {"errors", JSV_BOOLEAN, &inf->errorHandling},
+#ifndef SAVE_ON_FLASH
+      {"rxBuffer", JSV_INTEGER, 0}, // handled in jswrap_serial_setup
+#endif
   };
 
   if (!jsvIsUndefined(baud)) {
@@ -293,7 +302,17 @@ bool jsserialEventCallbackIdle() {
           busy = true; // waiting for this byte to finish
       }
       if (data->bufLen) {
-        JsVar *stringData = jsvNewStringOfLength(data->bufLen, data->buf);
+#ifndef SAVE_ON_FLASH
+        JsSerialRxBuffer *rb;
+        JsVar *rxBuf = jsserialGetRxBuffer(parent, &rb);
+        if (rxBuf) {
+          jsserialRxBufferPush(parent, rxBuf, rb, (unsigned char*)data->buf, data->bufLen);
+          data->bufLen = 0;
+          jsserialRxBufferDispatch(parent, rxBuf, rb);
+          jsvUnLock(rxBuf);
+        }
+#endif
+        JsVar *stringData = data->bufLen ? jsvNewStringOfLength(data->bufLen, data->buf) : 0;
         data->bufLen = 0;
         if (stringData) {
           jswrap_stream_pushData(parent, stringData, true);
@@ -340,3 +359,117 @@ void jsserialEventCallback(bool state, IOEventFlags channel) {
 
 }
 #endif // ESPR_NO_SOFTWARE_SERIAL
+
+#ifndef SAVE_ON_FLASH
+bool jsserialSetRxBuffer(JsVar *serial, int size) {
+  if (size<=0) {
+    jsvObjectRemoveChild(serial, SERIAL_RX_BUFFER_NAME);
+    return true;
+  }
+  JsSerialRxBuffer *rb;
+  JsVar *rxBuf = jsserialGetRxBuffer(serial, &rb);
+  if (rxBuf && rb->size==(uint32_t)size) { // already set up - keep any data
+    jsvUnLock(rxBuf);
+    return true;
+  }
+  jsvUnLock(rxBuf);
+  rxBuf = jsvNewArrayBufferWithPtr((unsigned int)(sizeof(JsSerialRxBuffer)+(size_t)size), (char**)&rb);
+  if (!rxBuf) {
+    jsExceptionHere(JSET_ERROR, "Not enough memory for Serial rxBuffer");
+    return false;
+  }
+  rb->size = (uint32_t)size;
+  rb->start = 0;
+  rb->count = 0;
+  jsvObjectSetChildAndUnLock(serial, SERIAL_RX_BUFFER_NAME, rxBuf);
+  return true;
+}
+
+JsVar *jsserialGetRxBuffer(JsVar *serial, JsSerialRxBuffer **rb) {
+  JsVar *rxBuf = jsvObjectGetChildIfExists(serial, SERIAL_RX_BUFFER_NAME);
+  size_t len = 0;
+  *rb = rxBuf ? (JsSerialRxBuffer*)jsvGetDataPointer(rxBuf, &len) : 0;
+  if (!*rb || len<sizeof(JsSerialRxBuffer)) {
+    jsvUnLock(rxBuf);
+    *rb = 0;
+    return 0;
+  }
+  return rxBuf;
+}
+
+void jsserialRxBufferPush(JsVar *serial, JsVar *rxBuf, JsSerialRxBuffer *rb, const unsigned char *data, unsigned int len) {
+  unsigned char *buf = (unsigned char*)(rb+1);
+  while (len) {
+    if (rb->count == rb->size) {
+      JsVar *callback = jsvObjectGetChildIfExists(serial, STREAM_CALLBACK_NAME);
+      jsvUnLock(callback);
+      if (!callback) { // nobody to give it to - drop the new data
+        jsErrorFlags |= JSERR_BUFFER_FULL;
+        return;
+      }
+      jsserialRxBufferDispatch(serial, rxBuf, rb);
+    }
+    uint32_t head = (rb->start + rb->count) % rb->size;
+    uint32_t n = rb->size - rb->count; // free space
+    if (n > rb->size - head) n = rb->size - head; // contiguous
+    if (n > len) n = len;
+    memcpy(&buf[head], data, n);
+    rb->count += n;
+    data += n;
+    len -= n;
+  }
+}
+
+void jsserialRxBufferDispatch(JsVar *serial, JsVar *rxBuf, JsSerialRxBuffer *rb) {
+  JsVar *callback = jsvObjectGetChildIfExists(serial, STREAM_CALLBACK_NAME);
+  if (!callback) return;
+  while (rb->count) {
+    uint32_t n = rb->size - rb->start; // contiguous
+    if (n > rb->count) n = rb->count;
+    JsVar *view = jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT8, rxBuf, (JsVarInt)(sizeof(JsSerialRxBuffer)+rb->start), (JsVarInt)n);
+    // remove the data first, so any read in the callback doesn't see it again
+    rb->start = (rb->start + n) % rb->size;
+    rb->count -= n;
+    bool ok = view && jsiExecuteEventCallback(serial, callback, 1, &view);
+    jsvUnLock(view);
+    if (!ok) {
+      jsError("Error processing Serial data handler - removing it.");
+      jsErrorFlags |= JSERR_CALLBACK;
+      jsvObjectRemoveChild(serial, STREAM_CALLBACK_NAME);
+      break;
+    }
+  }
+  jsvUnLock(callback);
+}
+
+unsigned int jsserialRxBufferRead(JsSerialRxBuffer *rb, unsigned int offset, unsigned char *dst, unsigned int len, bool remove) {
+  unsigned char *buf = (unsigned char*)(rb+1);
+  if (offset >= rb->count) return 0;
+  if (len > rb->count - offset) len = rb->count - offset;
+  unsigned int i;
+  uint32_t idx = (rb->start + offset) % rb->size;
+  if (dst) {
+    for (i=0;i<len;i++) {
+      dst[i] = buf[idx];
+      if (++idx == rb->size) idx = 0;
+    }
+  }
+  if (remove && !offset) {
+    rb->start = (rb->start + len) % rb->size;
+    rb->count -= len;
+  }
+  return len;
+}
+
+int jsserialRxBufferIndexOf(JsSerialRxBuffer *rb, const unsigned char *find, unsigned int findLen, unsigned int fromIndex) {
+  unsigned char *buf = (unsigned char*)(rb+1);
+  if (!findLen) return (fromIndex <= rb->count) ? (int)fromIndex : -1;
+  unsigned int i, j;
+  for (i=fromIndex; i+findLen <= rb->count; i++) {
+    for (j=0;j<findLen;j++)
+      if (buf[(rb->start + i + j) % rb->size] != find[j]) break;
+    if (j==findLen) return (int)i;
+  }
+  return -1;
+}
+#endif
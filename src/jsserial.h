@@ -24,6 +24,10 @@ bool jsserialPopulateUSARTInfo(JshUSARTInfo *inf, JsVar *baud,  JsVar *options);
 
 // Get the correct Serial send function (and the data to send to it).
 bool jsserialGetSendFunction(JsVar *serialDevice, serial_sender *serialSend, serial_sender_data *serialSendData);
+/// serial_sender for hardware Serial devices
+void jsserialHardwareFunc(int data, serial_sender_data *info);
+/// Send a block of data to a hardware Serial device (for jsvIterateBufferCallback with jsserialHardwareFunc's serial_sender_data)
+void jsserialHardwareBufferFunc(unsigned char *data, unsigned int len, void *info);
 
 /// Start watching serial RX pin and setup data for it
 bool jsserialEventCallbackInit(JsVar *parent, JshUSARTInfo *inf);
@@ -35,5 +39,30 @@ bool jsserialEventCallbackIdle();
 // This is used with jshSetEventCallback to allow Serial data to be received in software
 void jsserialEventCallback(bool state, IOEventFlags flags);
 
+#ifndef SAVE_ON_FLASH
+/// Hidden child of a Serial object containing an ArrayBuffer used as a receive ring buffer (see the rxBuffer option)
+#define SERIAL_RX_BUFFER_NAME JS_HIDDEN_CHAR_STR"rxb"
+
+/// The start of the receive ring buffer's ArrayBuffer - the data follows this
+typedef struct {
+  uint32_t size;  ///< size of the data area
+  uint32_t start; ///< index of the first byte of received data
+  uint32_t count; ///< amount of received data
+} JsSerialRxBuffer;
+
+/// Set up a receive ring buffer of the given size, or remove it if size==0. Returns false on failure
+bool jsserialSetRxBuffer(JsVar *serial, int size);
+/// Get the receive ring buffer's ArrayBuffer (or 0 if there isn't one), and a pointer to it
+JsVar *jsserialGetRxBuffer(JsVar *serial, JsSerialRxBuffer **rb);
+/// Add received data to the ring buffer, dispatching it to any 'data' listener if the buffer fills up
+void jsserialRxBufferPush(JsVar *serial, JsVar *rxBuf, JsSerialRxBuffer *rb, const unsigned char *data, unsigned int len);
+/// Send everything in the ring buffer to any 'data' listener (as Uint8Array views on the buffer itself)
+void jsserialRxBufferDispatch(JsVar *serial, JsVar *rxBuf, JsSerialRxBuffer *rb);
+/// Copy up to len bytes (from offset) out of the ring buffer (dst may be 0), optionally removing them if offset==0. Returns the amount copied
+unsigned int jsserialRxBufferRead(JsSerialRxBuffer *rb, unsigned int offset, unsigned char *dst, unsigned int len, bool remove);
+/// Return the index of the given bytes in the ring buffer, starting at fromIndex, or -1
+int jsserialRxBufferIndexOf(JsSerialRxBuffer *rb, const unsigned char *find, unsigned int findLen, unsigned int fromIndex);
+#endif
+
 
 #endif // JSSERIAL_H_
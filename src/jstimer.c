@@ -64,6 +64,7 @@ static void jstUtilTimerInterruptHandlerNextByte(UtilTimerTask *task) {
         JsVarRef t = task->data.buffer.nextBuffer;
         task->data.buffer.nextBuffer = task->data.buffer.currentBuffer;
         task->data.buffer.currentBuffer = t;
+        task->data.buffer.swaps++;
         // Setup new buffer
         jstUtilTimerSetupBuffer(task);
       } else {
@@ -625,6 +626,7 @@ bool jstStartSignal(JsSysTime startTime, JsSysTime period, Pin pin, Pin npin, Js
     // then we're not repeating
     task.data.buffer.nextBuffer = 0;
   }
+  task.data.buffer.swaps = 0;
   jstUtilTimerSetupBuffer(&task);
 
   return utilTimerInsertTask(&task, NULL);
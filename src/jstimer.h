@@ -74,7 +74,8 @@ typedef struct UtilTimerTaskBuffer {
   unsigned short endIdx; ///< Final index before we skip to the next var
   Pin pin; ///< Pin to read from/write to
   Pin npin; ///< If we're doing 2 pin output, the pin to write the negated value to
-} PACKED_FLAGS UtilTimerTaskBuffer; // ~16 bytes
+  unsigned char swaps; ///< Incremented each time we flip to nextBuffer (so the idle loop can spot if it missed one)
+} PACKED_FLAGS UtilTimerTaskBuffer; // ~17 bytes
 
 typedef void (*UtilTimerTaskExecFn)(JsSysTime time, void* userdata);
 
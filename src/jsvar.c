@@ -4275,6 +4275,17 @@ int jsvGarbageCollect() {
     if (jsvIsFlatString(var))
       i = (JsVarRef)(i+jsvGetFlatStringBlocks(var));
   }
+  /* queued events only hold refs, so mark them too */
+  unsigned int eventRefCount;
+  JsVarRef *eventRefs = jsiGetEventQueueRefs(&eventRefCount);
+  for (i=0;i<eventRefCount;i++) {
+    if (!eventRefs[i]) continue;
+    JsVar *var = jsvGetAddressOf(eventRefs[i]);
+    if ((var->flags & JSV_GARBAGE_COLLECT) && !jsvGarbageCollectMarkUsed(var)) {
+      isMemoryBusy = MEM_NOT_BUSY;
+      return 0;
+    }
+  }
   /* now sweep for things that we can GC!
    * Also update the free list - this means that every new variable that
    * gets allocated gets allocated towards the start of memory, which
@@ -4408,6 +4419,11 @@ void jsvDefragment() {
     *defragTo = *defragFrom;
     defragFrom->flags = JSV_UNUSED;
     // find references!
+    unsigned int eventRefCount;
+    JsVarRef *eventRefs = jsiGetEventQueueRefs(&eventRefCount);
+    for (unsigned int i=0;i<eventRefCount;i++)
+      if (eventRefs[i]==defragFromRef)
+        eventRefs[i] = defragToRef;
     for (unsigned int i=0;i<jsvGetMemoryTotal();i++) {
       JsVarRef vr = (JsVarRef)(i+1);
       JsVar *v = _jsvGetAddressOf(vr);
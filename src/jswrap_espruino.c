@@ -883,7 +883,7 @@ their values.
   "params" : [
     ["source","JsVar","The source file/stream that will send content. As of 2v19 this can also be a `String`"],
     ["destination","JsVar","The destination file/stream that will receive content from the source."],
-    ["options","JsVar",["[optional] An object `{ chunkSize : int=64, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
+    ["options","JsVar",["[optional] An object `{ chunkSize : int, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time (chosen automatically if not specified)","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
   ],
   "typescript" : "pipe(source: any, destination: any, options?: PipeOptions): void"
 }
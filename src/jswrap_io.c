@@ -690,7 +690,7 @@ void jswrap_io_shiftOut(JsVar *pins, JsVar *options, JsVar *data) {
     ["options", "JsVar","If a boolean or integer, it determines whether to call this once (false = default) or every time a change occurs (true). Can be an object of the form `{ repeat: true/false(default), edge:'rising'/'falling'/'both', debounce:10}` - see below for more information."]
   ],
   "return" : ["JsVar","An ID that can be passed to clearWatch"],
-  "typescript" : "declare function setWatch(func: ((arg: { state: boolean, time: number, lastTime: number }) => void) | string, pin: Pin, options?: boolean | { repeat?: boolean, edge?: \"rising\" | \"falling\" | \"both\", debounce?: number, irq?: boolean, data?: Pin, hispeed?: boolean }): number;"
+  "typescript" : "declare function setWatch(func: ((arg: { state: boolean, time: number, lastTime: number }) => void) | ((arg: { pin: Pin, buffer: Uint32Array, start: number, count: number, overflow: number }) => void) | string, pin: Pin, options?: boolean | { repeat?: boolean, edge?: \"rising\" | \"falling\" | \"both\", debounce?: number, irq?: boolean, data?: Pin, hispeed?: boolean, capture?: Uint32Array, captureGap?: number }): number;"
 }
 Call the function specified when the pin changes. Watches set with `setWatch`
 can be removed using `clearWatch`.
@@ -718,6 +718,11 @@ information (all optional):
    // high speed pulses (less than 25us) may not be reliably received. Setting hispeed=true
    // allows for detecting high speed pulses at the expense of higher idle power consumption
    hispeed : true
+   // Advanced: Record edges into this Uint32Array rather than calling the function
+   // for each one - see below
+   capture : new Uint32Array(256),
+   // When capturing, call the function after this many milliseconds with no edges
+   captureGap : 100(default)
 }
 ```
 
@@ -745,6 +750,28 @@ function `void (bool state)` then you can add `irq:true` to options, which will
 cause the function to be called from within the IRQ. When doing this, interrupts
 will happen on both edges and there will be no debouncing.
 
+For fast signals (pulse counting, IR/RF decoding), one callback per edge can't
+keep up. Use `capture: new Uint32Array(n)` and each edge is written into the
+array from the interrupt instead. Each item is the time in microseconds in the
+bottom 31 bits (so it wraps around - use `(b-a)&0x7FFFFFFF` to get the time
+between edges) and the new state of the pin in the top bit. The array is used as
+a ring buffer, and the function is called when it is half full, or when there
+have been no edges for `captureGap` milliseconds, with
+`{pin, buffer, start, count, overflow}`. The `count` new items start at
+`buffer[start]` (wrapping around to `buffer[0]`), and `overflow` is the number
+of edges that were lost because the buffer was full. `repeat`, `edge` and
+`debounce` are ignored when capturing, and the pin can't be watched by anything
+else.
+
+```
+setWatch(function(e) {
+  for (var i=0;i<e.count;i++) {
+    var v = e.buffer[(e.start+i)%e.buffer.length];
+    console.log((v>>>31) ? "high" : "low", v&0x7FFFFFFF);
+  }
+}, A0, { capture: new Uint32Array(128) });
+```
+
 **Note:** if you didn't call `pinMode` beforehand then this function will reset
 pin's state to `"input"`
 
@@ -776,6 +803,8 @@ JsVar *jswrap_interface_setWatch(
   int edge = 0;
   bool isIRQ = false, isHighSpeed = false;
   Pin dataPin = PIN_UNDEFINED;
+  JsVar *capture = 0;
+  JsVarFloat captureGap = 100;
   if (IS_PIN_A_BUTTON(pin)) {
     edge = 1;
     debounce = 25;
@@ -811,6 +840,23 @@ JsVar *jswrap_interface_setWatch(
     isHighSpeed = jsvObjectGetBoolChild(repeatOrObject, "hispeed");
 #endif
     dataPin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(repeatOrObject, "data"));
+#ifndef SAVE_ON_FLASH
+    capture = jsvObjectGetChildIfExists(repeatOrObject, "capture");
+    v = jsvObjectGetChildIfExists(repeatOrObject, "captureGap");
+    if (v) captureGap = jsvGetFloatAndUnLock(v);
+    if (isnan(captureGap) || captureGap<0) captureGap=0;
+    if (capture && (isIRQ || jshIsPinValid(dataPin))) {
+      jsExceptionHere(JSET_ERROR, "Can't have capture with irq:true or a data pin");
+      jsvUnLock(capture);
+      return 0;
+    }
+    if (capture) {
+      // edges all go into the array, so no debouncing and always repeat
+      repeat = true;
+      debounce = 0;
+      edge = 0;
+    }
+#endif
   } else
     repeat = jsvGetBool(repeatOrObject);
 
@@ -828,6 +874,10 @@ JsVar *jswrap_interface_setWatch(
       jsvObjectSetChildAndUnLock(watchPtr, "state", jsvNewFromBool(jshPinInput(pin)));
       if (isHighSpeed)
         jsvObjectSetChildAndUnLock(watchPtr, "hispeed", jsvNewFromBool(true));
+      if (capture) {
+        jsvObjectSetChild(watchPtr, "capture", capture);
+        jsvObjectSetChildAndUnLock(watchPtr, "captureGap", jsvNewFromLongInteger(jshGetTimeFromMilliseconds(captureGap)));
+      }
     }
 
     // If nothing already watching the pin, set up a watch
@@ -852,14 +902,27 @@ JsVar *jswrap_interface_setWatch(
       if (isIRQ)
         jsExceptionHere(JSET_ERROR, "irq=true set, but watch is already used");
     }
+#ifndef SAVE_ON_FLASH
+    if (capture && watchPtr && (!exti || !jsiWatchCaptureStart(exti, watchPtr))) {
+      if (exti)
+        jsExceptionHere(JSET_ERROR, "capture must be a Uint32Array in RAM, with at least 2 elements");
+      else
+        jsExceptionHere(JSET_ERROR, "capture=... set, but watch is already used");
+      if (exti) jshPinWatch(pin, false, JSPW_NONE);
+      jsvUnLock2(watchPtr, capture);
+      return 0;
+    }
+#endif
 
 
     JsVar *watchArrayPtr = jsvLock(watchArray);
     itemIndex = jsvArrayAddToEnd(watchArrayPtr, watchPtr, 1) - 1;
     jsvUnLock2(watchArrayPtr, watchPtr);
+    jsiWatchesChanged();
 
 
   }
+  jsvUnLock(capture);
   return (itemIndex>=0) ? jsvNewFromInteger(itemIndex) : 0/*undefined*/;
 }
 
@@ -897,6 +960,7 @@ void jswrap_interface_clearWatch(JsVar *idVarArr) {
     // remove all items
     jsvRemoveAllChildren(watchArrayPtr);
     jsvUnLock(watchArrayPtr);
+    jsiWatchesChanged();
   } else {
     JsVar *idVar = jsvGetArrayItem(idVarArr, 0);
     if (jsvIsUndefined(idVar)) {
@@ -914,6 +978,7 @@ void jswrap_interface_clearWatch(JsVar *idVarArr) {
       JsVar *watchArrayPtr = jsvLock(watchArray);
       jsvRemoveChildAndUnLock(watchArrayPtr, watchNamePtr);
       jsvUnLock(watchArrayPtr);
+      jsiWatchesChanged();
 
       // Now check if this pin is still being watched
       if (!jsiIsWatchingPin(pin))
@@ -16,9 +16,14 @@
  *   On idle, data is read from the source stream
  *    * If this returns undefined, the stream is considered finished and is closed
  *    * If this returns "" we just assume that it's waiting for more data
- *    * If it returns some data, 'write' is called with it
+ *    * If it returns some data, 'write' is called with it (the same variable
+ *       is passed on, so no copy is made)
  *    * And if 'write' returns the boolean false then we stall the pipe until
  *       the destination emits a 'drain' signal
+ *    * Otherwise we carry on reading, up to PIPE_MAX_CHUNKS_PER_IDLE chunks
+ *    * If 'chunkSize' isn't specified, we read PIPE_DEFAULT_CHUNK_SIZE, but
+ *       if the destination is a Serial device we only read as much as will fit
+ *       in its transmit buffer (so 'write' never has to wait)
  *    * If the destination emits a 'close' signal we close the pipe
  *    * When the pipe closes, unless 'end=false' on initialisation, we call
  *      'end' on destination, and 'close' on source.
@@ -30,6 +35,13 @@
 #include "jswrap_object.h"
 #include "jswrap_stream.h"
 
+/// How much data to read at a time if 'chunkSize' isn't specified
+#ifndef PIPE_DEFAULT_CHUNK_SIZE
+#define PIPE_DEFAULT_CHUNK_SIZE 256
+#endif
+/// The most chunks we'll move through each pipe in one go around the idle loop
+#define PIPE_MAX_CHUNKS_PER_IDLE 8
+
 static JsVar* pipeGetArray(bool create) {
   return jsvObjectGetChild(execInfo.hiddenRoot, "pipes", create ? JSV_ARRAY : 0);
 }
@@ -95,32 +107,63 @@ static void handlePipeClose(JsVar *arr, JsvObjectIterator *it, JsVar* pipe) {
   jsvRemoveChildAndUnLock(arr,idx);
 }
 
+/// Did a pipe find its destination's transmit buffer full during the last idle?
+static bool pipeWaitingForTransmit = false;
+
+/// How much should we read from the source right now? 0 if the destination has no space
+static JsVarInt pipeGetChunkSize(JsVar *pipe, JsVar *destination) {
+  JsVarInt chunkSize = jsvObjectGetIntegerChild(pipe,"chunkSize");
+  if (chunkSize<=0) chunkSize = PIPE_DEFAULT_CHUNK_SIZE;
+  // Serial.write would block if the transmit buffer filled up
+  IOEventFlags device = jsiGetDeviceFromClass(destination);
+  if (device != EV_NONE) {
+    JsVarInt txFree = (JsVarInt)jshGetTransmitFree(device);
+    if (chunkSize > txFree) chunkSize = txFree;
+  }
+  return chunkSize;
+}
+
 static bool handlePipe(JsVar *arr, JsvObjectIterator *it, JsVar* pipe) {
   bool paused = jsvObjectGetBoolChild(pipe,"drainWait");
   if (paused) return false;
 
-  JsVar *chunkSize = jsvObjectGetChildIfExists(pipe,"chunkSize");
   JsVar *source = jsvObjectGetChildIfExists(pipe,"source");
   JsVar *destination = jsvObjectGetChildIfExists(pipe,"destination");
 
-  bool dataTransferred = false;
-  if(source && destination && chunkSize) {
+  bool dataTransferred = false; // false if the pipe should be closed
+  bool busy = false; // did we read anything?
+  if(source && destination) {
     JsVar *readFunc = jspGetNamedField(source, "read", false);
     JsVar *writeFunc = jspGetNamedField(destination, "write", false);
     if (jsvIsFunction(readFunc) && jsvIsFunction(writeFunc)) { // do the objects have the necessary methods on them?
-      JsVar *buffer = jspExecuteFunction(readFunc, source, 1, &chunkSize);
-      if(buffer) {
-        JsVarInt bufferSize = jsvGetLength(buffer);
-        if (bufferSize>0) {
+      dataTransferred = true; // so we don't close the pipe if we get an empty string or the destination is full
+      int chunks = PIPE_MAX_CHUNKS_PER_IDLE;
+      while (chunks--) {
+        JsVarInt size = pipeGetChunkSize(pipe, destination);
+        if (!size) { // destination is full - try again next time (without keeping us awake)
+          pipeWaitingForTransmit = true;
+          break;
+        }
+        busy = true;
+        JsVar *chunkSize = jsvNewFromInteger(size);
+        JsVar *buffer = jspExecuteFunction(readFunc, source, 1, &chunkSize);
+        jsvUnLock(chunkSize);
+        if (!buffer) { // source has finished
+          dataTransferred = false;
+          break;
+        }
+        bool wait = jsvGetLength(buffer)<=0; // source is waiting for more data
+        if (!wait) {
           JsVar *response = jspExecuteFunction(writeFunc, destination, 1, &buffer);
           if (jsvIsBoolean(response) && jsvGetBool(response)==false) {
             // If boolean false was returned, wait for drain event (http://nodejs.org/api/stream.html#stream_writable_write_chunk_encoding_callback)
             jsvObjectSetChildAndUnLock(pipe,"drainWait",jsvNewFromBool(true));
+            wait = true;
           }
           jsvUnLock(response);
         }
         jsvUnLock(buffer);
-        dataTransferred = true; // so we don't close the pipe if we get an empty string
+        if (wait || jspHasError()) break;
       }
     } else {
       if(!jsvIsFunction(readFunc))
@@ -134,8 +177,8 @@ static bool handlePipe(JsVar *arr, JsvObjectIterator *it, JsVar* pipe) {
   if(!dataTransferred) { // when no more chunks are possible, execute the callback
     handlePipeClose(arr, it, pipe);
   }
-  jsvUnLock3(source, destination, chunkSize);
-  return dataTransferred;
+  jsvUnLock2(source, destination);
+  return dataTransferred && busy;
 }
 
 /*JSON{
@@ -145,6 +188,7 @@ static bool handlePipe(JsVar *arr, JsvObjectIterator *it, JsVar* pipe) {
 }*/
 bool jswrap_pipe_idle() {
   bool wasBusy = false;
+  pipeWaitingForTransmit = false;
   JsVar *arr = pipeGetArray(false);
   if (arr) {
     JsvObjectIterator it;
@@ -161,6 +205,12 @@ bool jswrap_pipe_idle() {
   return wasBusy;
 }
 
+/** True if a pipe is waiting for space in a transmit buffer. It isn't reported
+ * as busy by jswrap_pipe_idle, so we don't spin while the data goes out */
+bool jswrap_pipe_isWaitingForTransmit() {
+  return pipeWaitingForTransmit;
+}
+
 /*JSON{
   "type" : "kill",
   "generate" : "jswrap_pipe_kill",
@@ -245,7 +295,7 @@ type PipeOptions = {
   "params" : [
     ["source","JsVar","The source file/stream that will send content."],
     ["destination","JsVar","The destination file/stream that will receive content from the source."],
-    ["options","JsVar",["[optional] An object `{ chunkSize : int=64, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
+    ["options","JsVar",["[optional] An object `{ chunkSize : int, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time (chosen automatically if not specified)","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
   ],
   "typescript": "pipe(destination: any, options?: PipeOptions): void"
 }
@@ -266,7 +316,7 @@ void jswrap_pipe(JsVar* source, JsVar* dest, JsVar* options) {
     JsVar *writeFunc = jspGetNamedField(dest, "write", false);
     if(jsvIsFunction(readFunc)) {
       if(jsvIsFunction(writeFunc)) {
-        JsVarInt chunkSize = 64;
+        JsVarInt chunkSize = 0; // automatic
         bool callEnd = true;
         // parse Options Object
         if (jsvIsObject(options)) {
@@ -291,7 +341,7 @@ void jswrap_pipe(JsVar* source, JsVar* dest, JsVar* options) {
         }
         // set up our event listeners
         jswrap_object_addEventListener(source, "close", jswrap_pipe_src_close_listener, JSWAT_THIS_ARG);
-        jswrap_object_addEventListener(dest, "drain", jswrap_pipe_drain_listener, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)));
+        jswrap_object_addEventListener(dest, "drain", jswrap_pipe_drain_listener, JSWAT_THIS_ARG);
         jswrap_object_addEventListener(dest, "close", jswrap_pipe_dst_close_listener, JSWAT_THIS_ARG);
         // set up the rest of the pipe
         jsvObjectSetChildAndUnLock(pipe, "chunkSize", jsvNewFromInteger(chunkSize));
@@ -21,6 +21,7 @@
 
 bool jswrap_pipe_idle();
 void jswrap_pipe_kill();
+bool jswrap_pipe_isWaitingForTransmit();
 
 void jswrap_pipe(JsVar* source, JsVar* dest, JsVar* options);
 
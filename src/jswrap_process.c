@@ -186,6 +186,16 @@ memory usage.
 * `gc` : Memory freed during the GC pass
 * `gctime` : Time taken for GC pass (in milliseconds)
 * `blocksize` : Size of a block (variable) in bytes
+* `events` : Number of events currently queued to be executed
+* `eventsMax` : The most events that have been queued at once since startup
+* `eventsDropped` : Number of events dropped since startup because there wasn't
+  enough memory to queue them
+* `ioSize` : Size of the queue of received IO events (characters, pin changes,
+  etc). This is in events on Linux, or bytes on other devices
+* `ioUsed` : How much of the IO event queue is used right now
+* `ioMax` : The most of the IO event queue that has been used since startup
+* `ioDropped` : Number of IO events dropped since startup because the IO event
+  queue was full
 * `stackEndAddress` : (on ARM) the address (that can be used with peek/poke/etc)
   of the END of the stack. The stack grows down, so unless you do a lot of
   recursion the bytes above this can be used.
@@ -234,6 +244,17 @@ JsVar *jswrap_process_memory(JsVar *gc) {
       jsvObjectSetChildAndUnLock(obj, "gctime", jsvNewFromFloat(jshGetMillisecondsFromTime(time2-time1)));
     }
     jsvObjectSetChildAndUnLock(obj, "blocksize", jsvNewFromInteger(sizeof(JsVar)));
+    unsigned int events, eventsMax, eventsDropped;
+    jsiGetEventQueueStats(&events, &eventsMax, &eventsDropped);
+    jsvObjectSetChildAndUnLock(obj, "events", jsvNewFromInteger((JsVarInt)events));
+    jsvObjectSetChildAndUnLock(obj, "eventsMax", jsvNewFromInteger((JsVarInt)eventsMax));
+    jsvObjectSetChildAndUnLock(obj, "eventsDropped", jsvNewFromInteger((JsVarInt)eventsDropped));
+    unsigned int ioSize, ioUsed, ioMax, ioDropped;
+    jshGetIOEventStats(&ioSize, &ioUsed, &ioMax, &ioDropped);
+    jsvObjectSetChildAndUnLock(obj, "ioSize", jsvNewFromInteger((JsVarInt)ioSize));
+    jsvObjectSetChildAndUnLock(obj, "ioUsed", jsvNewFromInteger((JsVarInt)ioUsed));
+    jsvObjectSetChildAndUnLock(obj, "ioMax", jsvNewFromInteger((JsVarInt)ioMax));
+    jsvObjectSetChildAndUnLock(obj, "ioDropped", jsvNewFromInteger((JsVarInt)ioDropped));
 
 #ifdef ARM
     extern uint32_t LINKER_END_VAR; // end of ram used (variables) - should be 'void', but 'int' avoids warnings
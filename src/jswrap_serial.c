@@ -17,6 +17,9 @@
 #include "jsdevices.h"
 #include "jsinteractive.h"
 #include "jsserial.h"
+#include "jswrap_stream.h"
+#include "jswrap_string.h"
+#include "jswrap_arraybuffer.h"
 #ifdef USE_TELNET
 #include "jswrap_telnet.h"
 #endif
@@ -55,12 +58,16 @@ JsVar *jswrap_serial_constructor() {
   "class" : "Serial",
   "name" : "data",
   "params" : [
-    ["data","JsVar","A string containing one or more characters of received data"]
+    ["data","JsVar","A string containing one or more characters of received data (or a `Uint8Array` if `rxBuffer` was used in `Serial.setup`)"]
   ]
 }
 The `data` event is called when data is received. If a handler is defined with
 `X.on('data', function(data) { ... })` then it will be called, otherwise data
 will be stored in an internal buffer, where it can be retrieved with `X.read()`
+
+If `rxBuffer` was used in `Serial.setup`, `data` is a `Uint8Array` that is a
+view of the receive buffer itself. It will be overwritten by later data, so use
+`new Uint8Array(data)` if you need to keep a copy.
  */
 
 /*JSON{
@@ -262,6 +269,7 @@ The second argument can contain:
   flow:null/undefined/'none'/'xon', // (default none) software flow control
   path:null/undefined/string        // Linux Only - the path to the Serial device to use
   errors:false                      // (default false) whether to forward framing/parity errors
+  rxBuffer:0                        // (default 0) if >0, size in bytes of a binary receive buffer (see below)
 }
 ```
 
@@ -300,6 +308,14 @@ s.setup(9600,{rx:a_pin, tx:a_pin});
 
 However software serial doesn't use `ck`, `cts`, `parity`, `flow` or `errors`
 parts of the initialisation object.
+
+For high speed binary protocols, `rxBuffer:bytes` makes received data go
+straight into a ring buffer of that size rather than being turned into Strings.
+`data` events are then given `Uint8Array` views of the buffer,
+`Serial.read`/`Serial.peek` return `Uint8Array`s, and `Serial.indexOf` can be
+used to search for a delimiter in the received data. If there is no `data`
+listener and the buffer is full, new data is dropped and `E.getErrorFlags()`
+will return `BUFFER_FULL`.
 */
 void jswrap_serial_setup(JsVar *parent, JsVar *baud, JsVar *options) {
   if (!jsvIsObject(parent)) return;
@@ -322,6 +338,13 @@ void jswrap_serial_setup(JsVar *parent, JsVar *baud, JsVar *options) {
     return;
   }
 
+#ifndef SAVE_ON_FLASH
+  if (!jsserialSetRxBuffer(parent, jsvIsObject(options) ? jsvObjectGetIntegerChild(options, "rxBuffer") : 0)) {
+    jsvUnLock(options);
+    return;
+  }
+#endif
+
   // Set baud rate in object, so we can initialise it on startup
   jsvObjectSetChildAndUnLock(parent, USART_BAUDRATE_NAME, jsvNewFromInteger(inf.baudRate));
   // Do the same for options
@@ -386,6 +409,7 @@ void jswrap_serial_unsetup(JsVar *parent) {
   }
   jsvUnLock2(options, baud);
   // Remove stored settings
+  jsserialSetRxBuffer(parent, 0);
   jsvObjectRemoveChild(parent, USART_BAUDRATE_NAME);
   jsvObjectRemoveChild(parent, DEVICE_OPTIONS_NAME);
 
@@ -417,7 +441,10 @@ void _jswrap_serial_print(JsVar *parent, JsVar *arg, bool isPrint, bool newLine)
     return;
 
   if (isPrint) arg = jsvAsString(arg);
-  jsvIterateCallback(arg, (void (*)(int,  void *))serialSend, (void*)&serialSendData);
+  if (serialSend == jsserialHardwareFunc) // send blocks of data straight into the transmit buffer
+    jsvIterateBufferCallback(arg, jsserialHardwareBufferFunc, (void*)&serialSendData);
+  else
+    jsvIterateCallback(arg, (void (*)(int,  void *))serialSend, (void*)&serialSendData);
   if (isPrint) jsvUnLock(arg);
   if (newLine) {
     serialSend((unsigned char)'\r', &serialSendData);
@@ -515,25 +542,154 @@ void jswrap_serial_inject(JsVar *parent, JsVar *args) {
   "type" : "method",
   "class" : "Serial",
   "name" : "available",
-  "generate" : "jswrap_stream_available",
+  "generate" : "jswrap_serial_available",
   "return" : ["int","How many bytes are available"]
 }
 Return how many bytes are available to read. If there is already a listener for
 data, this will always return 0.
  */
+JsVarInt jswrap_serial_available(JsVar *parent) {
+#ifndef SAVE_ON_FLASH
+  JsSerialRxBuffer *rb;
+  JsVar *rxBuf = jsserialGetRxBuffer(parent, &rb);
+  if (rxBuf) {
+    jsvUnLock(rxBuf);
+    return (JsVarInt)rb->count;
+  }
+#endif
+  return jswrap_stream_available(parent);
+}
 
 /*JSON{
   "type" : "method",
   "class" : "Serial",
   "name" : "read",
-  "generate" : "jswrap_stream_read",
+  "generate" : "jswrap_serial_read",
   "params" : [
     ["chars","int","The number of characters to read, or undefined/0 for all available"]
   ],
-  "return" : ["JsVar","A string containing the required bytes."]
+  "return" : ["JsVar","A string containing the required bytes (or a `Uint8Array` if `rxBuffer` was used in `Serial.setup`)."]
 }
 Return a string containing characters that have been received
  */
+#ifndef SAVE_ON_FLASH
+/// Copy data out of the receive ring buffer into a new Uint8Array
+static JsVar *jswrap_serial_readRxBuffer(JsSerialRxBuffer *rb, JsVarInt chars, bool remove) {
+  unsigned int len = rb->count;
+  if (chars>0 && (unsigned int)chars<len) len = (unsigned int)chars;
+  JsVar *arr = jsvNewTypedArray(ARRAYBUFFERVIEW_UINT8, (JsVarInt)len);
+  size_t l;
+  char *ptr = arr ? jsvGetDataPointer(arr, &l) : 0;
+  if (ptr) {
+    jsserialRxBufferRead(rb, 0, (unsigned char*)ptr, len, remove);
+  } else if (arr) {
+    JsvArrayBufferIterator it;
+    jsvArrayBufferIteratorNew(&it, arr, 0);
+    unsigned int i;
+    for (i=0;i<len;i++) {
+      unsigned char ch;
+      jsserialRxBufferRead(rb, i, &ch, 1, false);
+      jsvArrayBufferIteratorSetByteValue(&it, (char)ch);
+      jsvArrayBufferIteratorNext(&it);
+    }
+    jsvArrayBufferIteratorFree(&it);
+    if (remove) jsserialRxBufferRead(rb, 0, NULL, len, true);
+  }
+  return arr;
+}
+#endif
+
+JsVar *jswrap_serial_read(JsVar *parent, JsVarInt chars) {
+#ifndef SAVE_ON_FLASH
+  JsSerialRxBuffer *rb;
+  JsVar *rxBuf = jsserialGetRxBuffer(parent, &rb);
+  if (rxBuf) {
+    jsvUnLock(rxBuf);
+    return jswrap_serial_readRxBuffer(rb, chars, true);
+  }
+#endif
+  return jswrap_stream_read(parent, chars);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Serial",
+  "name" : "peek",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_serial_peek",
+  "params" : [
+    ["chars","int","The number of characters to return, or undefined/0 for all available"]
+  ],
+  "return" : ["JsVar","A string containing the bytes (or a `Uint8Array` if `rxBuffer` was used in `Serial.setup`)."]
+}
+Return characters that have been received, like `Serial.read`, but without
+removing them.
+ */
+#ifndef SAVE_ON_FLASH
+JsVar *jswrap_serial_peek(JsVar *parent, JsVarInt chars) {
+  if (!jsvIsObject(parent)) return 0;
+  JsSerialRxBuffer *rb;
+  JsVar *rxBuf = jsserialGetRxBuffer(parent, &rb);
+  if (rxBuf) {
+    jsvUnLock(rxBuf);
+    return jswrap_serial_readRxBuffer(rb, chars, false);
+  }
+  JsVar *buf = jsvObjectGetChildIfExists(parent, STREAM_BUFFER_NAME);
+  JsVar *data = jsvIsString(buf) ? jsvNewFromStringVar(buf, 0, (chars>0) ? (size_t)chars : JSVAPPENDSTRINGVAR_MAXLENGTH) : jsvNewFromEmptyString();
+  jsvUnLock(buf);
+  return data;
+}
+#endif
+
+/*JSON{
+  "type" : "method",
+  "class" : "Serial",
+  "name" : "indexOf",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_serial_indexOf",
+  "params" : [
+    ["search","JsVar","A String, byte value, or array of bytes to search for"],
+    ["fromIndex","int","(optional) The index to start searching from"]
+  ],
+  "return" : ["int","The index of `search` in the data that has been received but not read, or -1"]
+}
+Search the data that has been received (but not read) for the given String or
+bytes. For example to read a line at a time:
+
+```
+Serial1.setup(115200, {rxBuffer:1024});
+setInterval(function() {
+  var i = Serial1.indexOf("\n");
+  if (i>=0) handleLine(E.toString(Serial1.read(i+1)));
+}, 100);
+```
+ */
+#ifndef SAVE_ON_FLASH
+JsVarInt jswrap_serial_indexOf(JsVar *parent, JsVar *search, JsVarInt fromIndex) {
+  if (!jsvIsObject(parent)) return -1;
+  if (fromIndex<0) fromIndex = 0;
+  unsigned int len = (unsigned int)jsvIterateCallbackCount(search);
+  if ((size_t)len+256 > jsuGetFreeStack()) {
+    jsExceptionHere(JSET_ERROR, "Not enough stack memory for search");
+    return -1;
+  }
+  unsigned char *find = (unsigned char*)alloca(len);
+  jsvIterateCallbackToBytes(search, find, len);
+  JsSerialRxBuffer *rb;
+  JsVar *rxBuf = jsserialGetRxBuffer(parent, &rb);
+  if (rxBuf) {
+    jsvUnLock(rxBuf);
+    return jsserialRxBufferIndexOf(rb, find, len, (unsigned int)fromIndex);
+  }
+  // no rxBuffer - search the String buffer
+  JsVar *buf = jsvObjectGetChildIfExists(parent, STREAM_BUFFER_NAME);
+  JsVar *str = jsvNewStringOfLength(len, (char*)find);
+  JsVar *from = jsvNewFromInteger(fromIndex);
+  int idx = (jsvIsString(buf) && str) ? jswrap_string_indexOf(buf, str, from, false) : -1;
+  jsvUnLock3(buf, str, from);
+  return idx;
+}
+#endif
 
 /*JSON{
   "type" : "method",
@@ -543,7 +699,7 @@ Return a string containing characters that have been received
   "generate" : "jswrap_pipe",
   "params" : [
     ["destination","JsVar","The destination file/stream that will receive content from the source."],
-    ["options","JsVar",["[optional] An object `{ chunkSize : int=32, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
+    ["options","JsVar",["[optional] An object `{ chunkSize : int, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time (chosen automatically if not specified)","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
   ],
   "typescript": "pipe(destination: any, options?: PipeOptions): void"
 }
@@ -25,6 +25,10 @@ void jswrap_serial_print(JsVar *parent, JsVar *str);
 void jswrap_serial_println(JsVar *parent, JsVar *str);
 void jswrap_serial_write(JsVar *parent, JsVar *data);
 void jswrap_serial_inject(JsVar *parent, JsVar *args);
+JsVarInt jswrap_serial_available(JsVar *parent);
+JsVar *jswrap_serial_read(JsVar *parent, JsVarInt chars);
+JsVar *jswrap_serial_peek(JsVar *parent, JsVarInt chars);
+JsVarInt jswrap_serial_indexOf(JsVar *parent, JsVar *search, JsVarInt fromIndex);
 void jswrap_serial_flush(JsVar *parent);
 bool jswrap_serial_isConnected(JsVar *parent);
 
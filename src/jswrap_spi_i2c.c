@@ -19,6 +19,106 @@
 #include "jsdevices.h"
 #include "jsinteractive.h"
 #include "jswrap_arraybuffer.h"
+#include "jswrap_promise.h"
+#include "jstimer.h"
+
+#ifndef SAVE_ON_FLASH
+/// An SPI or I2C transfer that's happening in the background (see SPI.sendAsync)
+typedef struct {
+  JsVar *promise;     ///< Promise to resolve when finished (locked), or 0 if nothing is in progress
+  JsVar *result;      ///< What to resolve the promise with (locked)
+  JsVar *txStorage;   ///< String containing the data being sent (locked so it isn't freed)
+  Pin nss_pin;        ///< nSS pin to raise when finished
+  volatile bool done; ///< Set by the callback (maybe from an IRQ or another thread) when the hardware is finished
+} JswrapAsyncTransfer;
+
+/* The HAL's completion callbacks don't take an argument, so we can only have
+ * one transfer of each type in progress at once */
+static JswrapAsyncTransfer spiAsync, i2cAsync;
+
+static void jswrap_spi_async_done() {
+  spiAsync.done = true;
+  jshHadEvent();
+}
+
+static void jswrap_i2c_async_done() {
+  i2cAsync.done = true;
+  jshHadEvent();
+}
+
+/// Wait for the hardware to finish with an async transfer, and free everything (but don't resolve the promise)
+static JsVar *jswrap_async_wait(JswrapAsyncTransfer *t, JsVar **result) {
+  JsVar *promise = t->promise;
+  if (!promise) return 0;
+  while (!t->done) jshBusyIdle(); // the hardware is still using our buffers
+  if (t->nss_pin!=PIN_UNDEFINED) jshPinOutput(t->nss_pin, true);
+  jsvUnLock(t->txStorage);
+  *result = t->result;
+  t->promise = 0;
+  t->result = 0;
+  t->txStorage = 0;
+  return promise;
+}
+
+/// If an async transfer is in progress, wait for it to finish and then resolve its promise
+static void jswrap_async_finish(JswrapAsyncTransfer *t) {
+  JsVar *result = 0;
+  JsVar *promise = jswrap_async_wait(t, &result);
+  if (!promise) return;
+  jspromise_resolve(promise, result);
+  jsvUnLock2(promise, result);
+}
+
+/// Start an async transfer, returning the Promise for it
+static JsVar *jswrap_async_start(JswrapAsyncTransfer *t, JsVar *txStorage, JsVar *result, Pin nss_pin) {
+  jswrap_async_finish(t); // one at a time
+  JsVar *promise = jspromise_create();
+  if (!promise) return 0;
+  t->promise = jsvLockAgain(promise);
+  t->result = jsvLockAgainSafe(result);
+  t->txStorage = jsvLockAgainSafe(txStorage);
+  t->nss_pin = nss_pin;
+  t->done = false;
+  return promise;
+}
+
+/** Get a pointer to the bytes in data that won't move while *storage is locked.
+ * Flat/native strings and ArrayBuffers on them are used directly, anything else
+ * is copied into a new flat string */
+static unsigned char *jswrap_async_get_tx(JsVar *data, JsVar **storage, size_t *len) {
+  JsVar *backing = 0;
+  if (jsvIsArrayBuffer(data) && JSV_ARRAYBUFFER_GET_SIZE(data->varData.arraybuffer.type)==1)
+    backing = jsvGetArrayBufferBackingString(data, NULL);
+  else if (jsvIsString(data))
+    backing = jsvLockAgain(data);
+  if (jsvIsFlatString(backing) || jsvIsNativeString(backing)) {
+    char *ptr = jsvGetDataPointer(data, len);
+    if (ptr) {
+      *storage = backing;
+      return (unsigned char*)ptr;
+    }
+  }
+  jsvUnLock(backing);
+  *len = (size_t)jsvIterateCallbackCount(data);
+  *storage = *len ? jsvNewFlatStringOfLength((unsigned int)*len) : 0;
+  if (!*storage) return 0;
+  unsigned char *ptr = (unsigned char*)jsvGetFlatStringPointer(*storage);
+  jsvIterateCallbackToBytes(data, ptr, (unsigned int)*len);
+  return ptr;
+}
+
+/// Create a Uint8Array with flat storage, returning a pointer to its data
+static JsVar *jswrap_async_new_rx(size_t len, unsigned char **ptr) {
+  JsVar *ab = jsvNewArrayBufferWithPtr((unsigned int)len, (char**)ptr);
+  if (!ab) {
+    jsExceptionHere(JSET_ERROR, "Not enough memory for receive buffer");
+    return 0;
+  }
+  JsVar *arr = jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT8, ab, 0, 0);
+  jsvUnLock(ab);
+  return arr;
+}
+#endif
 
 /*JSON{
   "type" : "class",
@@ -194,7 +294,8 @@ typedef struct {
   spi_sender_data spiSendData; //!< Control information on the nature of the SPI interface.
   int rxAmt;                   //!<
   int txAmt;                   //!<
-  JsvArrayBufferIterator it;   //!< A buffer to hold the response data from MISO
+  unsigned char *rxPtr;        //!< If set, the memory to write the response into directly
+  JsvArrayBufferIterator it;   //!< Otherwise, an iterator for the buffer to hold the response data from MISO
 } jswrap_spi_send_data;
 
 
@@ -205,11 +306,17 @@ void jswrap_spi_send_cb(
     unsigned char *data, unsigned int len,
     jswrap_spi_send_data *callbackData
   ) {
+  if (callbackData->rxPtr) {
+    callbackData->spiSend(data, callbackData->rxPtr + callbackData->rxAmt, len, &callbackData->spiSendData);
+    callbackData->txAmt += (int)len;
+    callbackData->rxAmt += (int)len;
+    return;
+  }
   unsigned char *rx = alloca(len);
   // TODO: alloc check?
   callbackData->spiSend(data, rx, len, &callbackData->spiSendData);
-  callbackData->txAmt += len;
-  callbackData->rxAmt += len;
+  callbackData->txAmt += (int)len;
+  callbackData->rxAmt += (int)len;
   while (len--) {
     jsvArrayBufferIteratorSetByteValue(&callbackData->it, *(rx++));
     jsvArrayBufferIteratorNext(&callbackData->it);
@@ -238,6 +345,9 @@ JsVar *jswrap_spi_send(
   jswrap_spi_send_data data;
   if (!jsspiGetSendFunction(parent, &data.spiSend, &data.spiSendData))
     return 0;
+#ifndef SAVE_ON_FLASH
+  jswrap_async_finish(&spiAsync);
+#endif
 
   JsVar *dst = 0;
 
@@ -280,9 +390,11 @@ JsVar *jswrap_spi_send(
     dst = jsvNewTypedArray(ARRAYBUFFERVIEW_UINT8, nBytes);
     if (dst) {
       data.rxAmt = data.txAmt = 0;
-      jsvArrayBufferIteratorNew(&data.it, dst, 0);
+      size_t dstLen;
+      data.rxPtr = (unsigned char*)jsvGetDataPointer(dst, &dstLen);
+      if (!data.rxPtr) jsvArrayBufferIteratorNew(&data.it, dst, 0);
       jsvIterateBufferCallback(srcdata, (jsvIterateBufferCallbackFn)jswrap_spi_send_cb, &data);
-      jsvArrayBufferIteratorFree(&data.it);
+      if (!data.rxPtr) jsvArrayBufferIteratorFree(&data.it);
     }
   }
 
@@ -329,6 +441,9 @@ void jswrap_spi_write(
   spi_sender_data spiSendData;
   if (!jsspiGetSendFunction(parent, &spiSend, &spiSendData))
     return;
+#ifndef SAVE_ON_FLASH
+  jswrap_async_finish(&spiAsync);
+#endif
 
   jswrap_spi_write_data spi_write_data;
   spi_write_data.spiSend = spiSend;
@@ -359,6 +474,86 @@ void jswrap_spi_write(
   // de-assert NSS
   if (nss_pin!=PIN_UNDEFINED) jshPinOutput(nss_pin, true);
 }
+/*JSON{
+  "type" : "method",
+  "class" : "SPI",
+  "name" : "sendAsync",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_spi_sendAsync",
+  "params" : [
+    ["data","JsVar","The data to send - an Integer, Array, String, or Object of the form `{data: ..., count:#}`"],
+    ["nss_pin","pin","An nSS pin - this will be lowered before SPI output and raised afterwards (optional)"]
+  ],
+  "return" : ["JsVar","A Promise that resolves with a `Uint8Array` of the data that was returned"],
+  "return_object" : "Promise",
+  "typescript" : "sendAsync(data: any, nss_pin?: Pin): Promise<Uint8Array>;"
+}
+Send data down SPI in the background, and return a Promise that resolves with
+the data that was received as a `Uint8Array`. JavaScript carries on executing
+while the transfer happens, which is useful for large transfers (e.g. to
+displays).
+
+Where the hardware supports it (e.g. with DMA) data is sent directly from, and
+received directly into, flat `ArrayBuffer` memory, so passing a `Uint8Array` or
+a String is faster than an Array. Software SPI (and hardware without
+asynchronous support) sends the data straight away, but the Promise still
+resolves afterwards.
+
+Only one asynchronous SPI transfer can be in progress at once - if another
+transfer is started, Espruino will wait for the first one to finish.
+
+```
+SPI1.sendAsync(new Uint8Array(1024), B0).then(function(data) {
+  // transfer finished
+});
+```
+ */
+#ifndef SAVE_ON_FLASH
+JsVar *jswrap_spi_sendAsync(JsVar *parent, JsVar *srcdata, Pin nss_pin) {
+  if (!jsvIsObject(parent)) return 0;
+  IOEventFlags device = jsiGetDeviceFromClass(parent);
+
+  spi_sender spiSend;
+  spi_sender_data spiSendData;
+  if (!jsspiGetSendFunction(parent, &spiSend, &spiSendData))
+    return 0;
+  jswrap_async_finish(&spiAsync);
+
+  JsVar *txStorage = 0;
+  size_t len = 0;
+  unsigned char *tx = jswrap_async_get_tx(srcdata, &txStorage, &len);
+  if (!tx && len) {
+    jsExceptionHere(JSET_ERROR, "Not enough memory for transmit buffer");
+    return 0;
+  }
+  unsigned char *rx = 0;
+  JsVar *dst = len ? jswrap_async_new_rx(len, &rx) : jsvNewTypedArray(ARRAYBUFFERVIEW_UINT8, 0);
+  if (!dst) {
+    jsvUnLock(txStorage);
+    return 0;
+  }
+  JsVar *promise = jswrap_async_start(&spiAsync, txStorage, dst, nss_pin);
+  jsvUnLock2(txStorage, dst);
+  if (!promise) return 0;
+
+  // assert NSS
+  if (nss_pin!=PIN_UNDEFINED) jshPinOutput(nss_pin, false);
+  if (!len) {
+    spiAsync.done = true;
+  } else if (DEVICE_IS_SPI(device)) {
+    jshSPISetReceive(device, true);
+    if (!jshSPISendMany(device, tx, rx, len, jswrap_spi_async_done)) {
+      spiAsync.done = true;
+      jsExceptionHere(JSET_ERROR, "SPI transfer failed");
+    }
+  } else {
+    // software - just do it now
+    spiSend(tx, rx, (unsigned int)len, &spiSendData);
+    spiAsync.done = true;
+  }
+  return promise;
+}
+#endif
 
 /*JSON{
   "type" : "method",
@@ -649,6 +844,9 @@ Transmit to the slave device with the given address. This is like Arduino's
 beginTransmission, write, and endTransmission rolled up into one.
  */
 void _jswrap_i2c_writeTo(JsVar *parent, IOEventFlags device, int address, bool sendStop, int dataLen, unsigned char *dataPtr) {
+#ifndef SAVE_ON_FLASH
+  jswrap_async_finish(&i2cAsync);
+#endif
   if (DEVICE_IS_I2C(device)) {
     jshI2CWrite(device, (unsigned char)address, (int)dataLen, (unsigned char*)dataPtr, sendStop);
   } else if (device == EV_NONE) {
@@ -691,16 +889,8 @@ Request bytes from the given slave device, and return them as a `Uint8Array`
 (packed array of bytes). This is like using Arduino Wire's requestFrom,
 available and read functions. Sends a STOP unless `{address:X, stop:false}` is used.
  */
-JsVar *_jswrap_i2c_readFrom(JsVar *parent, IOEventFlags device, int address,  bool sendStop, int nBytes) {
-
-  if (nBytes<=0)
-    return 0;
-  if ((unsigned int)nBytes+256 > jsuGetFreeStack()) {
-    jsExceptionHere(JSET_ERROR, "Not enough stack memory for data");
-    return 0;
-  }
-  unsigned char *buf = (unsigned char *)alloca((size_t)nBytes);
-
+/// Read nBytes into buf, using hardware or software I2C
+static void _jswrap_i2c_read(JsVar *parent, IOEventFlags device, int address,  bool sendStop, int nBytes, unsigned char *buf) {
   if (DEVICE_IS_I2C(device)) {
     jshI2CRead(device, (unsigned char)address, nBytes, buf, sendStop);
   } else if (device == EV_NONE) {
@@ -714,19 +904,43 @@ JsVar *_jswrap_i2c_readFrom(JsVar *parent, IOEventFlags device, int address,  bo
     }
     jsvUnLock2(jsvObjectSetChild(parent, "started", jsvNewFromBool(inf.started)), options);
 #endif
-  } else return 0;
+  }
+}
+
+JsVar *_jswrap_i2c_readFrom(JsVar *parent, IOEventFlags device, int address,  bool sendStop, int nBytes) {
+  if (nBytes<=0)
+    return 0;
+  if (!DEVICE_IS_I2C(device) && device!=EV_NONE)
+    return 0;
+#ifndef SAVE_ON_FLASH
+  jswrap_async_finish(&i2cAsync);
+#endif
 
   JsVar *array = jsvNewTypedArray(ARRAYBUFFERVIEW_UINT8, nBytes);
-  if (array) {
-    JsvArrayBufferIterator it;
-    jsvArrayBufferIteratorNew(&it, array, 0);
-    unsigned int i;
-    for (i=0;i<(unsigned)nBytes;i++) {
-      jsvArrayBufferIteratorSetByteValue(&it, (char)buf[i]);
-      jsvArrayBufferIteratorNext(&it);
-    }
-    jsvArrayBufferIteratorFree(&it);
+  if (!array) return 0;
+  // if we can, read straight into the array's memory
+  size_t len;
+  unsigned char *buf = (unsigned char *)jsvGetDataPointer(array, &len);
+  if (buf) {
+    _jswrap_i2c_read(parent, device, address, sendStop, nBytes, buf);
+    return array;
   }
+
+  if ((unsigned int)nBytes+256 > jsuGetFreeStack()) {
+    jsExceptionHere(JSET_ERROR, "Not enough stack memory for data");
+    jsvUnLock(array);
+    return 0;
+  }
+  buf = (unsigned char *)alloca((size_t)nBytes);
+  _jswrap_i2c_read(parent, device, address, sendStop, nBytes, buf);
+  JsvArrayBufferIterator it;
+  jsvArrayBufferIteratorNew(&it, array, 0);
+  unsigned int i;
+  for (i=0;i<(unsigned)nBytes;i++) {
+    jsvArrayBufferIteratorSetByteValue(&it, (char)buf[i]);
+    jsvArrayBufferIteratorNext(&it);
+  }
+  jsvArrayBufferIteratorFree(&it);
   return array;
 }
 JsVar *jswrap_i2c_readFrom(JsVar *parent, JsVar *addressVar, int nBytes) {
@@ -772,3 +986,702 @@ JsVar *jswrap_i2c_readReg(JsVar *parent, int address, int reg, int nBytes) {
   _jswrap_i2c_writeTo(parent, device, address, sendStop, 1, &i2cReg);
   return _jswrap_i2c_readFrom(parent, device, address, sendStop, nBytes);
 }
+
+/*JSON{
+  "type" : "method",
+  "class" : "I2C",
+  "name" : "writeToAsync",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_i2c_writeToAsync",
+  "params" : [
+    ["address","JsVar","The 7 bit address of the device to transmit to, or an object of the form `{address:12, stop:false}` to send this data without a STOP signal."],
+    ["data","JsVarArray","One or more items to write. May be ints, strings, arrays, or special objects (see `E.toUint8Array` for more info)."]
+  ],
+  "return" : ["JsVar","A Promise that resolves when the data has been sent"],
+  "return_object" : "Promise",
+  "typescript" : "writeToAsync(address: any, ...data: any[]): Promise<void>;"
+}
+The same as `I2C.writeTo`, but the transfer happens in the background (where
+the hardware supports it) and a Promise is returned that resolves when it has
+finished. See `SPI.sendAsync` for more information.
+ */
+#ifndef SAVE_ON_FLASH
+JsVar *jswrap_i2c_writeToAsync(JsVar *parent, JsVar *addressVar, JsVar *args) {
+  if (!jsvIsObject(parent)) return 0;
+  IOEventFlags device = jsiGetDeviceFromClass(parent);
+  bool sendStop = true;
+  int address = i2c_get_address(addressVar, &sendStop);
+  if (!DEVICE_IS_I2C(device)) {
+    // software - just do it now
+    jswrap_i2c_writeTo(parent, addressVar, args);
+    return jswrap_promise_resolve(NULL);
+  }
+  jswrap_async_finish(&i2cAsync);
+
+  JsVar *txStorage = 0;
+  size_t len = 0;
+  unsigned char *tx = jswrap_async_get_tx(args, &txStorage, &len);
+  if (!tx && len) {
+    jsExceptionHere(JSET_ERROR, "Not enough memory for transmit buffer");
+    return 0;
+  }
+  JsVar *promise = jswrap_async_start(&i2cAsync, txStorage, 0, PIN_UNDEFINED);
+  jsvUnLock(txStorage);
+  if (!promise) return 0;
+  if (!len) {
+    i2cAsync.done = true;
+  } else if (!jshI2CWriteAsync(device, (unsigned char)address, (int)len, tx, sendStop, jswrap_i2c_async_done)) {
+    i2cAsync.done = true;
+    jsExceptionHere(JSET_ERROR, "I2C transfer failed");
+  }
+  return promise;
+}
+#endif
+
+/*JSON{
+  "type" : "method",
+  "class" : "I2C",
+  "name" : "readFromAsync",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_i2c_readFromAsync",
+  "params" : [
+    ["address","JsVar","The 7 bit address of the device to request bytes from, or an object of the form `{address:12, stop:false}` to send this data without a STOP signal."],
+    ["quantity","int32","The number of bytes to request"]
+  ],
+  "return" : ["JsVar","A Promise that resolves with the data that was returned - as a `Uint8Array`"],
+  "return_object" : "Promise",
+  "typescript" : "readFromAsync(address: any, quantity: number): Promise<Uint8Array>;"
+}
+The same as `I2C.readFrom`, but the transfer happens in the background (where
+the hardware supports it) and a Promise is returned that resolves with the
+data. Data is read directly into the memory of the resulting `Uint8Array`. See
+`SPI.sendAsync` for more information.
+
+```
+I2C1.writeTo({address:0x68, stop:false}, 0x3B);
+I2C1.readFromAsync(0x68, 14).then(function(data) {
+  // ...
+});
+```
+ */
+#ifndef SAVE_ON_FLASH
+JsVar *jswrap_i2c_readFromAsync(JsVar *parent, JsVar *addressVar, int nBytes) {
+  if (!jsvIsObject(parent)) return 0;
+  IOEventFlags device = jsiGetDeviceFromClass(parent);
+  bool sendStop = true;
+  int address = i2c_get_address(addressVar, &sendStop);
+  if (nBytes<=0) return 0;
+  if (!DEVICE_IS_I2C(device)) {
+    // software - just do it now
+    JsVar *data = _jswrap_i2c_readFrom(parent, device, address, sendStop, nBytes);
+    JsVar *promise = data ? jswrap_promise_resolve(data) : 0;
+    jsvUnLock(data);
+    return promise;
+  }
+  jswrap_async_finish(&i2cAsync);
+
+  unsigned char *rx = 0;
+  JsVar *dst = jswrap_async_new_rx((size_t)nBytes, &rx);
+  if (!dst) return 0;
+  JsVar *promise = jswrap_async_start(&i2cAsync, 0, dst, PIN_UNDEFINED);
+  jsvUnLock(dst);
+  if (!promise) return 0;
+  if (!jshI2CReadAsync(device, (unsigned char)address, nBytes, rx, sendStop, jswrap_i2c_async_done)) {
+    i2cAsync.done = true;
+    jsExceptionHere(JSET_ERROR, "I2C transfer failed");
+  }
+  return promise;
+}
+
+/* Compiled bus programs (see SPI.compile/I2C.compile). These are a 3 byte
+ * header (magic, then the number of bytes that get read as uint16 LE)
+ * followed by operations, and are run without touching any JsVars so they
+ * can be executed from the utility timer. */
+#define BUSPROG_MAGIC_SPI 0xB5
+#define BUSPROG_MAGIC_I2C 0xB2
+#define BUSPROG_HEADER 3
+typedef enum {
+  BUSPROG_END,
+  BUSPROG_WRITE, ///< I2C: address, stop, len16, data. SPI: len16, data (received data is ignored)
+  BUSPROG_READ,  ///< I2C: address, stop, len16. SPI: len16 (zeros are sent)
+  BUSPROG_SEND,  ///< SPI only: len16, data (received data is stored)
+  BUSPROG_DELAY, ///< uint32 microseconds
+  BUSPROG_PIN,   ///< pin, value
+} JswrapBusProgOp;
+
+/// What a bus program is run on
+typedef struct {
+  IOEventFlags device;
+  JsVar *parent;               ///< For software I2C. 0 if we're in the utility timer, where only hardware I2C can be used
+  spi_sender spiSend;          ///< For SPI, hardware or software
+  spi_sender_data spiSendData;
+} JswrapBusProgTarget;
+
+/** Compile a single operation into out (if out!=0), returning the number of bytes it
+ * needs, or -1 on error. readLen is incremented by the number of bytes it reads */
+static int jswrap_busprog_compile_op(JsVar *op, bool isSPI, int *address, unsigned char *out, int *readLen) {
+  if (!jsvIsObject(op)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting an object for each operation, got %t", op);
+    return -1;
+  }
+  JsVar *v;
+  if ((v = jsvObjectGetChildIfExists(op, "delay"))) {
+    uint32_t us = (uint32_t)jsvGetIntegerAndUnLock(v);
+    if (out) {
+      out[0] = BUSPROG_DELAY;
+      out[1] = (unsigned char)us;
+      out[2] = (unsigned char)(us>>8);
+      out[3] = (unsigned char)(us>>16);
+      out[4] = (unsigned char)(us>>24);
+    }
+    return 5;
+  }
+  if ((v = jsvObjectGetChildIfExists(op, "pin"))) {
+    Pin pin = jshGetPinFromVarAndUnLock(v);
+    if (!jshIsPinValid(pin)) {
+      jsExceptionHere(JSET_ERROR, "Invalid pin");
+      return -1;
+    }
+    if (out) {
+      out[0] = BUSPROG_PIN;
+      out[1] = (unsigned char)pin;
+      out[2] = jsvObjectGetBoolChild(op, "value");
+    }
+    return 3;
+  }
+  JswrapBusProgOp type = BUSPROG_END;
+  JsVar *data = 0;
+  int len = 0;
+  if ((data = jsvObjectGetChildIfExists(op, "write"))) {
+    type = BUSPROG_WRITE;
+  } else if (isSPI && (data = jsvObjectGetChildIfExists(op, "send"))) {
+    type = BUSPROG_SEND;
+  } else if ((v = jsvObjectGetChildIfExists(op, "read"))) {
+    type = BUSPROG_READ;
+    len = jsvGetIntegerAndUnLock(v);
+  } else {
+    jsExceptionHere(JSET_ERROR, "Unknown operation %j", op);
+    return -1;
+  }
+  if (data) len = (int)jsvIterateCallbackCount(data);
+  if (len<0 || len>65535) {
+    jsExceptionHere(JSET_ERROR, "Invalid length %d", len);
+    jsvUnLock(data);
+    return -1;
+  }
+  if (type!=BUSPROG_WRITE) *readLen += len;
+  int headerLen = 3;
+  if (!isSPI) {
+    JsVar *addr = jsvObjectGetChildIfExists(op, "address");
+    if (addr) *address = jsvGetIntegerAndUnLock(addr);
+    if (*address<0 || *address>127) {
+      jsExceptionHere(JSET_ERROR, "I2C address needed");
+      jsvUnLock(data);
+      return -1;
+    }
+    headerLen = 5;
+  }
+  if (out) {
+    unsigned char *p = out;
+    *(p++) = (unsigned char)type;
+    if (!isSPI) {
+      *(p++) = (unsigned char)*address;
+      JsVar *stop = jsvObjectGetChildIfExists(op, "stop");
+      *(p++) = stop ? jsvGetBoolAndUnLock(stop) : true;
+    }
+    *(p++) = (unsigned char)len;
+    *(p++) = (unsigned char)(len>>8);
+    if (data) jsvIterateCallbackToBytes(data, p, (unsigned int)len);
+  }
+  jsvUnLock(data);
+  return headerLen + (data ? len : 0);
+}
+
+static JsVar *jswrap_busprog_compile(JsVar *ops, bool isSPI) {
+  if (!jsvIsArray(ops)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting an array of operations, got %t", ops);
+    return 0;
+  }
+  // first pass works out the size, second actually writes the data
+  unsigned char *out = 0;
+  JsVar *prog = 0;
+  int pass, size = 0;
+  for (pass=0;pass<2;pass++) {
+    int address = -1, readLen = 0;
+    int pos = BUSPROG_HEADER;
+    JsvObjectIterator it;
+    jsvObjectIteratorNew(&it, ops);
+    while (jsvObjectIteratorHasValue(&it)) {
+      JsVar *op = jsvObjectIteratorGetValue(&it);
+      int l = jswrap_busprog_compile_op(op, isSPI, &address, out ? &out[pos] : 0, &readLen);
+      jsvUnLock(op);
+      if (l<0) break;
+      pos += l;
+      jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+    if (jspHasError() || readLen>65535) {
+      if (readLen>65535) jsExceptionHere(JSET_ERROR, "Program reads too much data");
+      jsvUnLock(prog);
+      return 0;
+    }
+    if (out) {
+      out[0] = isSPI ? BUSPROG_MAGIC_SPI : BUSPROG_MAGIC_I2C;
+      out[1] = (unsigned char)readLen;
+      out[2] = (unsigned char)(readLen>>8);
+    } else {
+      size = pos;
+      prog = jswrap_async_new_rx((size_t)size, &out);
+      if (!prog) return 0;
+    }
+  }
+  return prog;
+}
+
+/// Return the number of bytes the program reads, or -1 if it's not a valid program for this bus
+static int jswrap_busprog_get_read_length(const unsigned char *prog, size_t progLen, bool isSPI) {
+  if (!prog || progLen<BUSPROG_HEADER || prog[0]!=(isSPI ? BUSPROG_MAGIC_SPI : BUSPROG_MAGIC_I2C)) {
+    jsExceptionHere(JSET_ERROR, "Not a compiled %s program", isSPI ? "SPI" : "I2C");
+    return -1;
+  }
+  return prog[1] | (prog[2]<<8);
+}
+
+/** Run a compiled program, putting any data that was read into out (which
+ * must be big enough). Doesn't use any JsVars unless t->parent is set */
+static void jswrap_busprog_run(const unsigned char *prog, size_t progLen, unsigned char *out, JswrapBusProgTarget *t) {
+  bool isSPI = prog[0]==BUSPROG_MAGIC_SPI;
+  size_t i = BUSPROG_HEADER;
+  while (i<progLen) {
+    JswrapBusProgOp op = (JswrapBusProgOp)prog[i++];
+    if (op==BUSPROG_DELAY && i+4<=progLen) {
+      jshDelayMicroseconds((int)(prog[i] | (prog[i+1]<<8) | (prog[i+2]<<16) | ((uint32_t)prog[i+3]<<24)));
+      i += 4;
+    } else if (op==BUSPROG_PIN && i+2<=progLen) {
+      jshPinOutput((Pin)prog[i], prog[i+1]);
+      i += 2;
+    } else if (op>=BUSPROG_WRITE && op<=BUSPROG_SEND) {
+      unsigned char address = 0;
+      bool sendStop = true;
+      if (!isSPI && i+2<=progLen) {
+        address = prog[i++];
+        sendStop = prog[i++];
+      }
+      if (i+2>progLen) return;
+      size_t len = prog[i] | (prog[i+1]<<8);
+      i += 2;
+      const unsigned char *data = &prog[i];
+      if (op!=BUSPROG_READ) {
+        if (i+len>progLen) return;
+        i += len;
+      }
+      if (isSPI) {
+        if (op==BUSPROG_READ) {
+          unsigned char zeros[16];
+          memset(zeros, 0, sizeof(zeros));
+          size_t n = 0;
+          while (n<len) {
+            unsigned int l = (unsigned int)((len-n > sizeof(zeros)) ? sizeof(zeros) : len-n);
+            t->spiSend(zeros, &out[n], l, &t->spiSendData);
+            n += l;
+          }
+        } else
+          t->spiSend((unsigned char*)data, op==BUSPROG_SEND ? out : NULL, (unsigned int)len, &t->spiSendData);
+      } else if (DEVICE_IS_I2C(t->device)) {
+        if (op==BUSPROG_WRITE) jshI2CWrite(t->device, address, (int)len, data, sendStop);
+        else jshI2CRead(t->device, address, (int)len, out, sendStop);
+      } else if (t->parent) {
+        if (op==BUSPROG_WRITE) _jswrap_i2c_writeTo(t->parent, t->device, address, sendStop, (int)len, (unsigned char*)data);
+        else _jswrap_i2c_read(t->parent, t->device, address, sendStop, (int)len, out);
+      }
+      if (op!=BUSPROG_WRITE) out += len;
+    } else return; // BUSPROG_END or invalid
+  }
+}
+
+/// Set up a target for a program. Returns false (with an exception) if this device can't be used
+static bool jswrap_busprog_get_target(JsVar *parent, bool isSPI, JswrapBusProgTarget *t) {
+  if (!jsvIsObject(parent)) return false;
+  t->device = jsiGetDeviceFromClass(parent);
+  t->parent = parent;
+  if (isSPI) {
+    if (!jsspiGetSendFunction(parent, &t->spiSend, &t->spiSendData)) return false;
+    if (DEVICE_IS_SPI(t->device)) jshSPISetReceive(t->device, true);
+  } else if (!DEVICE_IS_I2C(t->device) && t->device!=EV_NONE)
+    return false;
+  return true;
+}
+
+/// Get a pointer to the memory of a flat/native ArrayBuffer or String, and the (locked) string it's stored in
+static unsigned char *jswrap_busprog_get_memory(JsVar *v, JsVar **storage, size_t *len) {
+  *storage = 0;
+  if (!jsvIsArrayBuffer(v) && !jsvIsString(v)) return 0;
+  char *ptr = jsvGetDataPointer(v, len);
+  if (ptr) *storage = jsvIsArrayBuffer(v) ? jsvGetArrayBufferBackingString(v, NULL) : jsvLockAgain(v);
+  return (unsigned char*)ptr;
+}
+
+static JsVar *jswrap_busprog_run_now(JsVar *parent, JsVar *program, JsVar *buffer, bool isSPI) {
+  JswrapBusProgTarget t;
+  if (!jswrap_busprog_get_target(parent, isSPI, &t)) return 0;
+  JsVar *progStorage;
+  size_t progLen;
+  unsigned char *prog = jswrap_busprog_get_memory(program, &progStorage, &progLen);
+  int readLen = jswrap_busprog_get_read_length(prog, progLen, isSPI);
+  if (readLen<0) {
+    jsvUnLock(progStorage);
+    return 0;
+  }
+  unsigned char *out = 0;
+  size_t outLen = 0;
+  if (jsvIsUndefined(buffer)) {
+    buffer = readLen ? jswrap_async_new_rx((size_t)readLen, &out) : jsvNewTypedArray(ARRAYBUFFERVIEW_UINT8, 0);
+    outLen = (size_t)readLen;
+  } else {
+    buffer = jsvLockAgain(buffer);
+    if (!jsvIsArrayBuffer(buffer) || !(out = (unsigned char*)jsvGetDataPointer(buffer, &outLen)))
+      outLen = 0;
+  }
+  if (buffer && outLen >= (size_t)readLen) {
+    jswrap_async_finish(isSPI ? &spiAsync : &i2cAsync);
+    jswrap_busprog_run(prog, progLen, out, &t);
+  } else if (buffer) {
+    jsExceptionHere(JSET_ERROR, "Buffer must be a flat ArrayBuffer of at least %d bytes", readLen);
+    jsvUnLock(buffer);
+    buffer = 0;
+  }
+  jsvUnLock(progStorage);
+  return buffer;
+}
+
+/// A bus program that's being run repeatedly by the utility timer
+typedef struct {
+  JsVar *parent;       ///< SPI/I2C object (locked), or 0 if this slot is unused
+  JsVar *progStorage;  ///< String the program is stored in (locked)
+  JsVar *buffer;       ///< ArrayBuffer results go into (locked)
+  JsVar *bufStorage;   ///< String the buffer is stored in (locked)
+  JsVar *callback;     ///< Function to call when the buffer is full (locked)
+  JswrapBusProgTarget target;
+  unsigned char *prog, *out;
+  size_t progLen, outLen, sampleLen;
+  volatile size_t pos;           ///< Where in out the next sample goes
+  volatile unsigned int filled;  ///< How many times the buffer has been filled (from the timer)
+  unsigned int notified;         ///< Value of filled when we last called the callback
+} JswrapBusSchedule;
+
+#define JSWRAP_BUS_SCHEDULES 4
+static JswrapBusSchedule busSchedules[JSWRAP_BUS_SCHEDULES];
+
+static void jswrap_busprog_timer(JsSysTime time, void *userdata) {
+  NOT_USED(time);
+  JswrapBusSchedule *s = (JswrapBusSchedule*)userdata;
+  size_t pos = s->pos;
+  jswrap_busprog_run(s->prog, s->progLen, &s->out[pos], &s->target);
+  pos += s->sampleLen;
+  if (s->sampleLen && pos+s->sampleLen > s->outLen) {
+    pos = 0;
+    s->filled++;
+    jshHadEvent();
+  }
+  s->pos = pos;
+}
+
+static void jswrap_busprog_unschedule(JswrapBusSchedule *s) {
+  if (!s->parent) return;
+  jstStopExecuteFn(jswrap_busprog_timer, s);
+  jsvUnLock3(s->parent, s->progStorage, s->buffer);
+  jsvUnLock2(s->bufStorage, s->callback);
+  memset(s, 0, sizeof(JswrapBusSchedule));
+}
+
+static void jswrap_busprog_schedule(JsVar *parent, JsVar *program, JsVar *buffer, JsVarFloat interval, JsVar *callback, bool isSPI) {
+  JswrapBusSchedule *s = 0;
+  int i;
+  for (i=0;i<JSWRAP_BUS_SCHEDULES;i++)
+    if (!busSchedules[i].parent) s = &busSchedules[i];
+  if (!s) {
+    jsExceptionHere(JSET_ERROR, "Too many scheduled programs");
+    return;
+  }
+  if (!jswrap_busprog_get_target(parent, isSPI, &s->target)) return;
+  s->target.parent = 0; // can't use JsVars from the timer
+  if (!isSPI && !DEVICE_IS_I2C(s->target.device)) {
+    jsExceptionHere(JSET_ERROR, "Only hardware I2C can be scheduled");
+    return;
+  }
+  if (!(interval>0)) {
+    jsExceptionHere(JSET_ERROR, "Interval must be above 0");
+    return;
+  }
+  s->prog = jswrap_busprog_get_memory(program, &s->progStorage, &s->progLen);
+  int readLen = jswrap_busprog_get_read_length(s->prog, s->progLen, isSPI);
+  if (readLen>=0) {
+    s->out = jsvIsArrayBuffer(buffer) ? jswrap_busprog_get_memory(buffer, &s->bufStorage, &s->outLen) : 0;
+    if (!s->out || s->outLen<(size_t)readLen)
+      jsExceptionHere(JSET_ERROR, "Buffer must be a flat ArrayBuffer of at least %d bytes", readLen);
+  }
+  JsSysTime period = jshGetTimeFromMilliseconds(interval);
+  if (jspHasError() ||
+      !jstExecuteFn(jswrap_busprog_timer, s, period, (uint32_t)period, NULL)) {
+    jsvUnLock2(s->progStorage, s->bufStorage);
+    memset(s, 0, sizeof(JswrapBusSchedule));
+    return;
+  }
+  s->parent = jsvLockAgain(parent);
+  s->buffer = jsvLockAgain(buffer);
+  s->callback = jsvIsFunction(callback) ? jsvLockAgain(callback) : 0;
+  s->sampleLen = (size_t)readLen;
+}
+
+/// Stop any scheduled programs on this device that use the given program (or all, if program is undefined)
+void jswrap_spi_i2c_unschedule(JsVar *parent, JsVar *program) {
+  JsVar *storage = 0;
+  size_t len;
+  if (!jsvIsUndefined(program))
+    jswrap_busprog_get_memory(program, &storage, &len);
+  int i;
+  for (i=0;i<JSWRAP_BUS_SCHEDULES;i++) {
+    JswrapBusSchedule *s = &busSchedules[i];
+    if (s->parent==parent && (!storage || s->progStorage==storage))
+      jswrap_busprog_unschedule(s);
+  }
+  jsvUnLock(storage);
+}
+#endif
+
+/*JSON{
+  "type" : "method",
+  "class" : "SPI",
+  "name" : "compile",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_spi_compile",
+  "params" : [
+    ["operations","JsVar","An array of operations (see below)"]
+  ],
+  "return" : ["JsVar","A compiled program that can be used with `SPI.run` or `SPI.schedule`"],
+  "return_object" : "Uint8Array",
+  "typescript" : "compile(operations: ({ write: any } | { send: any } | { read: number } | { delay: number } | { pin: Pin, value: boolean })[]): Uint8Array;"
+}
+Compile a list of SPI operations into a program that can be run quickly and
+repeatedly with `SPI.run`, or periodically without any JavaScript with
+`SPI.schedule`. Operations can be:
+
+* `{write:data}` - send data, ignoring what's received
+* `{send:data}` - send data, storing what's received
+* `{read:n}` - send `n` zeros, storing what's received
+* `{delay:us}` - wait for the given number of microseconds
+* `{pin:pin, value:bool}` - set a pin (e.g. a chip select)
+
+`data` can be anything accepted by `SPI.write`.
+
+```
+var prog = SPI1.compile([
+  {pin:B0, value:0}, {write:0x8F}, {read:6}, {pin:B0, value:1}
+]);
+var data = SPI1.run(prog); // Uint8Array(6)
+```
+ */
+/*JSON{
+  "type" : "method",
+  "class" : "I2C",
+  "name" : "compile",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_i2c_compile",
+  "params" : [
+    ["operations","JsVar","An array of operations (see below)"]
+  ],
+  "return" : ["JsVar","A compiled program that can be used with `I2C.run` or `I2C.schedule`"],
+  "return_object" : "Uint8Array",
+  "typescript" : "compile(operations: ({ address?: number, write: any, stop?: boolean } | { address?: number, read: number, stop?: boolean } | { delay: number } | { pin: Pin, value: boolean })[]): Uint8Array;"
+}
+Compile a list of I2C operations into a program that can be run quickly and
+repeatedly with `I2C.run`, or periodically without any JavaScript with
+`I2C.schedule`. Operations can be:
+
+* `{address:a, write:data, stop:bool}` - write data (anything accepted by `I2C.writeTo`)
+* `{address:a, read:n, stop:bool}` - read `n` bytes
+* `{delay:us}` - wait for the given number of microseconds
+* `{pin:pin, value:bool}` - set a pin
+
+If `address` isn't specified, the previous one is used. `stop` defaults to `true`.
+
+```
+// read accelerometer and gyro from an MPU6050
+var prog = I2C1.compile([
+  {address:0x68, write:0x3B, stop:false}, {read:6},
+  {write:0x43, stop:false}, {read:6}
+]);
+var data = new Uint8Array(12);
+setInterval(function() {
+  I2C1.run(prog, data);
+}, 100);
+```
+ */
+#ifndef SAVE_ON_FLASH
+JsVar *jswrap_spi_compile(JsVar *parent, JsVar *ops) {
+  NOT_USED(parent);
+  return jswrap_busprog_compile(ops, true);
+}
+JsVar *jswrap_i2c_compile(JsVar *parent, JsVar *ops) {
+  NOT_USED(parent);
+  return jswrap_busprog_compile(ops, false);
+}
+#endif
+
+/*JSON{
+  "type" : "method",
+  "class" : "SPI",
+  "name" : "run",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_spi_run",
+  "params" : [
+    ["program","JsVar","A program from `SPI.compile`"],
+    ["buffer","JsVar","(optional) A flat `ArrayBuffer`/`Uint8Array` to put received data in"]
+  ],
+  "return" : ["JsVar","`buffer`, or a new `Uint8Array` containing received data if no buffer was supplied"],
+  "typescript" : "run(program: Uint8Array, buffer?: ArrayBufferView): Uint8Array;"
+}
+Run a program created with `SPI.compile`. Data that's received is written
+into `buffer` in the order the operations were specified.
+ */
+/*JSON{
+  "type" : "method",
+  "class" : "I2C",
+  "name" : "run",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_i2c_run",
+  "params" : [
+    ["program","JsVar","A program from `I2C.compile`"],
+    ["buffer","JsVar","(optional) A flat `ArrayBuffer`/`Uint8Array` to put received data in"]
+  ],
+  "return" : ["JsVar","`buffer`, or a new `Uint8Array` containing received data if no buffer was supplied"],
+  "typescript" : "run(program: Uint8Array, buffer?: ArrayBufferView): Uint8Array;"
+}
+Run a program created with `I2C.compile`. Data that's read is written into
+`buffer` in the order the operations were specified.
+ */
+#ifndef SAVE_ON_FLASH
+JsVar *jswrap_spi_run(JsVar *parent, JsVar *program, JsVar *buffer) {
+  return jswrap_busprog_run_now(parent, program, buffer, true);
+}
+JsVar *jswrap_i2c_run(JsVar *parent, JsVar *program, JsVar *buffer) {
+  return jswrap_busprog_run_now(parent, program, buffer, false);
+}
+#endif
+
+/*JSON{
+  "type" : "method",
+  "class" : "SPI",
+  "name" : "schedule",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_spi_schedule",
+  "params" : [
+    ["program","JsVar","A program from `SPI.compile`"],
+    ["buffer","JsVar","A flat `ArrayBuffer`/`Uint8Array` to put received data in"],
+    ["interval","float","The time in milliseconds between each run"],
+    ["callback","JsVar","(optional) A function to call with `buffer` each time it has been filled"]
+  ],
+  "typescript" : "schedule(program: Uint8Array, buffer: ArrayBufferView, interval: number, callback?: (buffer: ArrayBufferView) => void): void;"
+}
+Run a program created with `SPI.compile` every `interval` milliseconds, from
+the utility timer. No JavaScript is executed for each run - the data from each
+one is written after the last in `buffer`, and when `buffer` is full `callback`
+is called and it starts again from the beginning.
+
+Use `SPI.unschedule(program)` to stop.
+ */
+/*JSON{
+  "type" : "method",
+  "class" : "I2C",
+  "name" : "schedule",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_i2c_schedule",
+  "params" : [
+    ["program","JsVar","A program from `I2C.compile`"],
+    ["buffer","JsVar","A flat `ArrayBuffer`/`Uint8Array` to put received data in"],
+    ["interval","float","The time in milliseconds between each run"],
+    ["callback","JsVar","(optional) A function to call with `buffer` each time it has been filled"]
+  ],
+  "typescript" : "schedule(program: Uint8Array, buffer: ArrayBufferView, interval: number, callback?: (buffer: ArrayBufferView) => void): void;"
+}
+Run a program created with `I2C.compile` every `interval` milliseconds, from
+the utility timer. See `SPI.schedule` for more information.
+
+Only hardware I2C can be used. On most devices I2C is blocking, so the utility
+timer (and anything else scheduled on it) will be delayed while each program
+runs.
+ */
+#ifndef SAVE_ON_FLASH
+void jswrap_spi_schedule(JsVar *parent, JsVar *program, JsVar *buffer, JsVarFloat interval, JsVar *callback) {
+  jswrap_busprog_schedule(parent, program, buffer, interval, callback, true);
+}
+void jswrap_i2c_schedule(JsVar *parent, JsVar *program, JsVar *buffer, JsVarFloat interval, JsVar *callback) {
+  jswrap_busprog_schedule(parent, program, buffer, interval, callback, false);
+}
+#endif
+
+/*JSON{
+  "type" : "method",
+  "class" : "SPI",
+  "name" : "unschedule",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_spi_i2c_unschedule",
+  "params" : [
+    ["program","JsVar","(optional) The program passed to `SPI.schedule`. If not supplied, all scheduled programs for this device are stopped"]
+  ],
+  "typescript" : "unschedule(program?: Uint8Array): void;"
+}
+Stop running a program started with `SPI.schedule`
+ */
+/*JSON{
+  "type" : "method",
+  "class" : "I2C",
+  "name" : "unschedule",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_spi_i2c_unschedule",
+  "params" : [
+    ["program","JsVar","(optional) The program passed to `I2C.schedule`. If not supplied, all scheduled programs for this device are stopped"]
+  ],
+  "typescript" : "unschedule(program?: Uint8Array): void;"
+}
+Stop running a program started with `I2C.schedule`
+ */
+#ifndef SAVE_ON_FLASH
+/*JSON{
+  "type" : "idle",
+  "generate" : "jswrap_spi_i2c_idle",
+  "ifndef" : "SAVE_ON_FLASH"
+}*/
+bool jswrap_spi_i2c_idle() {
+  if (spiAsync.promise && spiAsync.done)
+    jswrap_async_finish(&spiAsync);
+  if (i2cAsync.promise && i2cAsync.done)
+    jswrap_async_finish(&i2cAsync);
+  int i;
+  for (i=0;i<JSWRAP_BUS_SCHEDULES;i++) {
+    JswrapBusSchedule *s = &busSchedules[i];
+    if (s->parent && s->filled!=s->notified) {
+      s->notified = s->filled;
+      if (s->callback) jsiQueueEvents(s->parent, s->callback, &s->buffer, 1);
+    }
+  }
+  // stay awake until the transfers have finished so we can resolve the promises
+  return spiAsync.promise || i2cAsync.promise;
+}
+
+/*JSON{
+  "type" : "kill",
+  "generate" : "jswrap_spi_i2c_kill",
+  "ifndef" : "SAVE_ON_FLASH"
+}*/
+void jswrap_spi_i2c_kill() {
+  // wait for the hardware to finish, but don't resolve the promises
+  JsVar *result = 0;
+  jsvUnLock2(jswrap_async_wait(&spiAsync, &result), result);
+  result = 0;
+  jsvUnLock2(jswrap_async_wait(&i2cAsync, &result), result);
+  int i;
+  for (i=0;i<JSWRAP_BUS_SCHEDULES;i++)
+    jswrap_busprog_unschedule(&busSchedules[i]);
+}
+#endif
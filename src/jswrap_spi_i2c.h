@@ -23,11 +23,23 @@ JsVar *jswrap_spi_send(JsVar *parent, JsVar *data, Pin nss_pin);
 void jswrap_spi_send4bit(JsVar *parent, JsVar *srcdata, int bit0, int bit1, Pin nss_pin);
 void jswrap_spi_send8bit(JsVar *parent, JsVar *srcdata, int bit0, int bit1, Pin nss_pin);
 void jswrap_spi_write(JsVar *parent, JsVar *args);
+JsVar *jswrap_spi_sendAsync(JsVar *parent, JsVar *srcdata, Pin nss_pin);
 
 JsVar *jswrap_i2c_constructor();
 void jswrap_i2c_setup(JsVar *parent, JsVar *options);
 void jswrap_i2c_writeTo(JsVar *parent, JsVar *addressVar, JsVar *data);
 JsVar *jswrap_i2c_readFrom(JsVar *parent, JsVar *addressVar, int nBytes);
 JsVar *jswrap_i2c_readReg(JsVar *parent, int address, int reg, int nBytes);
+JsVar *jswrap_i2c_writeToAsync(JsVar *parent, JsVar *addressVar, JsVar *args);
+JsVar *jswrap_i2c_readFromAsync(JsVar *parent, JsVar *addressVar, int nBytes);
+JsVar *jswrap_spi_compile(JsVar *parent, JsVar *ops);
+JsVar *jswrap_i2c_compile(JsVar *parent, JsVar *ops);
+JsVar *jswrap_spi_run(JsVar *parent, JsVar *program, JsVar *buffer);
+JsVar *jswrap_i2c_run(JsVar *parent, JsVar *program, JsVar *buffer);
+void jswrap_spi_schedule(JsVar *parent, JsVar *program, JsVar *buffer, JsVarFloat interval, JsVar *callback);
+void jswrap_i2c_schedule(JsVar *parent, JsVar *program, JsVar *buffer, JsVarFloat interval, JsVar *callback);
+void jswrap_spi_i2c_unschedule(JsVar *parent, JsVar *program);
+bool jswrap_spi_i2c_idle();
+void jswrap_spi_i2c_kill();
 
 #endif // JSWRAP_SPI_I2C_H_
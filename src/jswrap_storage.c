@@ -686,6 +686,104 @@ to detect the end of a file. As such you should not write character code 255
 (`"\xFF"`) to these files.
 */
 
+/// Name of the hidden child of a StorageFile that caches the flash address of each chunk
+#define STORAGEFILE_INDEX_NAME JS_HIDDEN_CHAR_STR"idx"
+
+/// Get the filename of a StorageFile, and return the index of the chunk number character within it
+static int jswrap_storagefile_getName(JsVar *f, JsfFileName *fname) {
+  *fname = jsfNameFromVarAndUnLock(jsvObjectGetChildIfExists(f,"name"));
+  int fnamei = sizeof(JsfFileName)-1;
+  while (fnamei && fname->c[fnamei-1]==0) fnamei--;
+  return fnamei;
+}
+
+/** Find the given chunk of a StorageFile (1..255). This uses a small index of chunk
+addresses cached in the StorageFile so that we don't have to search all of Storage
+for every chunk. Cached addresses are checked against the file header, so if Storage
+has been compacted or the file rewritten we just fall back to jsfFindFile. */
+static uint32_t jswrap_storagefile_findChunk(JsVar *f, JsfFileName fname, int fnamei, int chunk, JsfFileHeader *header) {
+  fname.c[fnamei]=(char)chunk;
+  JsVar *idx = jsvObjectGetChildIfExists(f,STORAGEFILE_INDEX_NAME);
+  int entries = jsvIsFlatString(idx) ? (int)(jsvGetCharactersInVar(idx)/sizeof(uint32_t)) : 0;
+  if (chunk<=entries) {
+    uint32_t addr = ((uint32_t*)jsvGetFlatStringPointer(idx))[chunk-1];
+    if (addr) {
+      jshFlashRead(header, addr-(uint32_t)sizeof(JsfFileHeader), sizeof(JsfFileHeader));
+      if (jsfIsNameEqual(header->name, fname)) {
+        jsvUnLock(idx);
+        return addr;
+      }
+    }
+  }
+  uint32_t addr = jsfFindFile(fname, header);
+  if (addr && chunk>entries) {
+    // grow the index - round up so we're not reallocating for every chunk
+    int newEntries = (chunk+7)&~7;
+    JsVar *newIdx = jsvNewFlatStringOfLength((unsigned int)newEntries*sizeof(uint32_t));
+    if (newIdx) {
+      char *ptr = jsvGetFlatStringPointer(newIdx);
+      memset(ptr, 0, (size_t)newEntries*sizeof(uint32_t));
+      if (entries) memcpy(ptr, jsvGetFlatStringPointer(idx), (size_t)entries*sizeof(uint32_t));
+      jsvObjectSetChild(f,STORAGEFILE_INDEX_NAME,newIdx);
+      jsvUnLock(idx);
+      idx = newIdx;
+      entries = newEntries;
+    }
+  }
+  if (chunk<=entries)
+    ((uint32_t*)jsvGetFlatStringPointer(idx))[chunk-1] = addr;
+  jsvUnLock(idx);
+  return addr;
+}
+
+/** Given a chunk of a StorageFile, return how many bytes of data it contains. Chunks are
+filled from the start and the file can't contain 255, so we can binary search for the
+first 255 rather than reading the whole chunk */
+static int jswrap_storagefile_getChunkDataLength(uint32_t addr, int fileLen) {
+  int lo = 0, hi = fileLen; // data ends somewhere in lo..hi
+  while (lo<hi) {
+    int mid = (lo+hi)>>1;
+    unsigned char ch;
+    jshFlashRead(&ch, addr+(uint32_t)mid, 1);
+    if (ch==255) hi = mid;
+    else lo = mid+1;
+  }
+  return lo;
+}
+
+/** Find where the byte at 'pos' in a StorageFile is stored. Sets chunk and offset (within
+the chunk), and returns the actual position used (which is clamped to the end of the file) */
+static int jswrap_storagefile_findPosition(JsVar *f, int pos, int *chunk, int *offset) {
+  JsfFileName fname;
+  int fnamei = jswrap_storagefile_getName(f, &fname);
+  JsfFileHeader header;
+  int c = 1;
+  int chunkStart = 0; // position in the file of the start of this chunk
+  int chunkLen = 0; // size of this chunk (0 if there was no file)
+  uint32_t addr = jswrap_storagefile_findChunk(f, fname, fnamei, c, &header);
+  if (pos<0) pos=0;
+  while (addr) {
+    chunkLen = (int)jsfGetFileSize(&header);
+    int dataLen = jswrap_storagefile_getChunkDataLength(addr, chunkLen);
+    if (dataLen<chunkLen || pos<chunkStart+chunkLen) {
+      // this is the last chunk, or the chunk containing pos
+      if (pos>chunkStart+dataLen) pos = chunkStart+dataLen;
+      *chunk = c;
+      *offset = pos-chunkStart;
+      return pos;
+    }
+    if (c==255) break;
+    addr = jswrap_storagefile_findChunk(f, fname, fnamei, c+1, &header);
+    if (!addr) break; // this chunk was full, and it's the last one
+    chunkStart += chunkLen;
+    c++;
+  }
+  // we've gone off the end of the last chunk (or there was no file)
+  *chunk = c;
+  *offset = chunkLen;
+  return chunkStart + chunkLen;
+}
+
 JsVar *jswrap_storagefile_read_internal(JsVar *f, int len) {
   bool isReadLine = len<0;
   char mode = (char)jsvObjectGetIntegerChild(f,"mode");
@@ -695,12 +793,10 @@ JsVar *jswrap_storagefile_read_internal(JsVar *f, int len) {
   }
 
   int chunk = jsvObjectGetIntegerChild(f,"chunk");
-  JsfFileName fname = jsfNameFromVarAndUnLock(jsvObjectGetChildIfExists(f,"name"));
-  int fnamei = sizeof(fname)-1;
-  while (fnamei && fname.c[fnamei-1]==0) fnamei--;
-  fname.c[fnamei]=(char)chunk;
+  JsfFileName fname;
+  int fnamei = jswrap_storagefile_getName(f, &fname);
   JsfFileHeader header;
-  uint32_t addr = jsfFindFile(fname, &header);
+  uint32_t addr = jswrap_storagefile_findChunk(f, fname, fnamei, chunk, &header);
   if (!addr) return 0; // end of file/no file chunk found
   int fileLen = (int)jsfGetFileSize(&header);
   int offset = jsvObjectGetIntegerChild(f,"offset");
@@ -716,8 +812,7 @@ JsVar *jswrap_storagefile_read_internal(JsVar *f, int len) {
         addr=0; // end of file!
       } else {
         chunk++;
-        fname.c[fnamei]=(char)chunk;
-        addr = jsfFindFile(fname, &header);
+        addr = jswrap_storagefile_findChunk(f, fname, fnamei, chunk, &header);
         fileLen = (int)jsfGetFileSize(&header);
       }
       jsvObjectSetChildAndUnLock(f,"offset",jsvNewFromInteger(offset));
@@ -808,61 +903,153 @@ JsVar *jswrap_storagefile_readLine(JsVar *f) {
 }
 Return the length of the current file.
 
-This requires Espruino to read the file from scratch, which is not a fast
-operation.
+This requires Espruino to find every chunk of the file, which is not a fast
+operation the first time it is called (chunk locations are then cached).
 */
 int jswrap_storagefile_getLength(JsVar *f) {
-  // Get name and position of name digit
-  JsVar *n = jsvObjectGetChildIfExists(f,"name");
-  JsfFileName fname = jsfNameFromVar(n);
-  jsvUnLock(n);
-  int fnamei = sizeof(fname)-1;
-  while (fnamei && fname.c[fnamei-1]==0) fnamei--;
-  int chunk = 1;
-  fname.c[fnamei]=(char)chunk;
+  int chunk, offset;
+  return jswrap_storagefile_findPosition(f, 0x7FFFFFFF, &chunk, &offset);
+}
 
-  int length = 0; // actual length
-  int offset = 0; // offset in file
-  JsfFileHeader header;
-  uint32_t addr = jsfFindFile(fname, &header);
-  // Find the last free page
-  unsigned char lastCh = 255;
-  if (addr) jshFlashRead(&lastCh, addr+jsfGetFileSize(&header)-1, 1);
-  while (addr && lastCh!=255 && chunk<255) {
-    length += (int)jsfGetFileSize(&header);
-    chunk++;
-    fname.c[fnamei]=(char)chunk;
-    addr = jsfFindFile(fname, &header);
-    if (addr) jshFlashRead(&lastCh, addr+jsfGetFileSize(&header)-1, 1);
+/*JSON{
+  "type" : "method",
+  "ifndef" : "SAVE_ON_FLASH",
+  "class" : "StorageFile",
+  "name" : "seek",
+  "generate" : "jswrap_storagefile_seek",
+  "params" : [
+    ["offset","int","The position in the file (in bytes) to move to. Negative values are counted back from the end of the file"]
+  ],
+  "return" : ["int","The new position in the file"]
+}
+Move the current read position to the given offset in the file, so that subsequent
+calls to `read`/`readLine`/`readPrevLine` start from there. The position is clamped
+to the end of the file.
+
+To start reading from the end of the file (for example to read the last lines
+of a log with `readPrevLine`) use `f.seek(f.getLength())`.
+*/
+int jswrap_storagefile_seek(JsVar *f, int offset) {
+  char mode = (char)jsvObjectGetIntegerChild(f,"mode");
+  if (mode!='r') {
+    jsExceptionHere(JSET_ERROR, "Can't seek in this mode");
+    return 0;
+  }
+  int chunk, chunkOffset;
+  if (offset<0) {
+    offset += jswrap_storagefile_getLength(f);
+    if (offset<0) offset = 0;
+  }
+  offset = jswrap_storagefile_findPosition(f, offset, &chunk, &chunkOffset);
+  jsvObjectSetChildAndUnLock(f,"chunk",jsvNewFromInteger(chunk));
+  jsvObjectSetChildAndUnLock(f,"offset",jsvNewFromInteger(chunkOffset));
+  return offset;
+}
+
+/*JSON{
+  "type" : "method",
+  "ifndef" : "SAVE_ON_FLASH",
+  "class" : "StorageFile",
+  "name" : "readAt",
+  "generate" : "jswrap_storagefile_readAt",
+  "params" : [
+    ["offset","int","The position in the file (in bytes) to read from"],
+    ["len","int","How many bytes to read"]
+  ],
+  "return" : ["JsVar","A String, or undefined "],
+  "return_object" : "String"
+}
+Read 'len' bytes of data from the given offset in the file, and return a String
+containing those bytes. This doesn't change the current read position.
+
+If the end of the file is reached, the String may be smaller than the amount of
+bytes requested, or if the offset is at or past the end of the file, `undefined` is returned.
+*/
+JsVar *jswrap_storagefile_readAt(JsVar *f, int offset, int len) {
+  char mode = (char)jsvObjectGetIntegerChild(f,"mode");
+  if (mode!='r') {
+    jsExceptionHere(JSET_ERROR, "Can't read in this mode");
+    return 0;
   }
-  if (addr) {
-    // if we have a page, try and find the end of it
-    char buf[64];
-    bool foundEnd = false;
-    while (!foundEnd) {
-      int l = (int)jsfGetFileSize(&header) - offset;
-      if (l<=0) {
-        foundEnd = true;
+  JsVar *chunk = jsvObjectGetChildIfExists(f,"chunk");
+  JsVar *chunkOffset = jsvObjectGetChildIfExists(f,"offset");
+  jswrap_storagefile_seek(f, offset);
+  JsVar *result = jswrap_storagefile_read(f, len);
+  jsvObjectSetChildAndUnLock(f,"chunk",chunk);
+  jsvObjectSetChildAndUnLock(f,"offset",chunkOffset);
+  return result;
+}
+
+/*JSON{
+  "type" : "method",
+  "ifndef" : "SAVE_ON_FLASH",
+  "class" : "StorageFile",
+  "name" : "readPrevLine",
+  "generate" : "jswrap_storagefile_readPrevLine",
+  "return" : ["JsVar","A line of data, or undefined"],
+  "return_object" : "String"
+}
+Read the line of data (up to and including `"\n"`) that ends at the current read
+position, and move the read position back to the start of that line. If the read
+position is already at the start of the file, `undefined` is returned.
+
+This allows a log file to be read backwards from the end without reading everything
+before it:
+
+```
+f = require("Storage").open("log","r");
+f.seek(f.getLength());
+f.readPrevLine() // last line of the file
+f.readPrevLine() // the line before that
+```
+*/
+JsVar *jswrap_storagefile_readPrevLine(JsVar *f) {
+  char mode = (char)jsvObjectGetIntegerChild(f,"mode");
+  if (mode!='r') {
+    jsExceptionHere(JSET_ERROR, "Can't read in this mode");
+    return 0;
+  }
+  int chunk = jsvObjectGetIntegerChild(f,"chunk");
+  int offset = jsvObjectGetIntegerChild(f,"offset");
+  JsfFileName fname;
+  int fnamei = jswrap_storagefile_getName(f, &fname);
+  JsfFileHeader header;
+  uint32_t addr = jswrap_storagefile_findChunk(f, fname, fnamei, chunk, &header);
+  if (!addr) return 0;
+  // work backwards until we find the newline that ends the previous line
+  int len = 0;
+  bool foundStart = false;
+  char buf[32];
+  while (!foundStart) {
+    if (offset<=0) { // previous page (which will be full)
+      if (chunk<=1) break; // start of file
+      chunk--;
+      addr = jswrap_storagefile_findChunk(f, fname, fnamei, chunk, &header);
+      if (!addr) break;
+      offset = (int)jsfGetFileSize(&header);
+    }
+    int l = offset;
+    if (l>(int)sizeof(buf)) l=(int)sizeof(buf);
+    jshFlashRead(buf, addr+(uint32_t)(offset-l), (uint32_t)l);
+    for (int i=l-1;i>=0;i--) {
+      if (buf[i]=='\n' && len) {
+        foundStart = true;
         break;
       }
-      if (l>(int)sizeof(buf)) l=(int)sizeof(buf);
-      jshFlashRead(buf, addr+(uint32_t)offset, (uint32_t)l);
-      for (int i=0;i<l;i++) {
-        if (buf[i]==(char)255) {
-          l = i;
-          foundEnd = true;
-          break;
-        }
-      }
-      offset += l;
+      offset--;
+      len++;
     }
   }
-  length += offset;
-  return length;
+  if (!len) return 0;
+  // now read forwards from the start of the line
+  jsvObjectSetChildAndUnLock(f,"chunk",jsvNewFromInteger(chunk));
+  jsvObjectSetChildAndUnLock(f,"offset",jsvNewFromInteger(offset));
+  JsVar *result = jswrap_storagefile_read_internal(f, len);
+  jsvObjectSetChildAndUnLock(f,"chunk",jsvNewFromInteger(chunk));
+  jsvObjectSetChildAndUnLock(f,"offset",jsvNewFromInteger(offset));
+  return result;
 }
 
-
-
 /*JSON{
   "type" : "method",
   "ifndef" : "SAVE_ON_FLASH",
@@ -1000,7 +1187,7 @@ void jswrap_storagefile_erase(JsVar *f) {
   "generate" : "jswrap_pipe",
   "params" : [
     ["destination","JsVar","The destination file/stream that will receive content from the source."],
-    ["options","JsVar",["[optional] An object `{ chunkSize : int=32, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
+    ["options","JsVar",["[optional] An object `{ chunkSize : int, end : bool=true, complete : function }`","chunkSize : The amount of data to pipe from source to destination at a time (chosen automatically if not specified)","complete : a function to call when the pipe activity is complete","end : call the 'end' function on the destination when the source is finished"]]
   ],
   "typescript": "pipe(destination: any, options?: PipeOptions): void"
 }
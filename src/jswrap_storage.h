@@ -37,6 +37,9 @@ JsVar *jswrap_storage_open(JsVar *name, JsVar *mode);
 JsVar *jswrap_storagefile_read(JsVar *f, int len);
 JsVar *jswrap_storagefile_readLine(JsVar *f);
 int jswrap_storagefile_getLength(JsVar *f);
+int jswrap_storagefile_seek(JsVar *f, int offset);
+JsVar *jswrap_storagefile_readAt(JsVar *f, int offset, int len);
+JsVar *jswrap_storagefile_readPrevLine(JsVar *f);
 void jswrap_storagefile_write(JsVar *parent, JsVar *_data);
 void jswrap_storagefile_erase(JsVar *f);
 
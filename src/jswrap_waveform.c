@@ -15,6 +15,7 @@
  */
 #include "jswrap_waveform.h"
 #include "jswrap_arraybuffer.h"
+#include "jswrap_error.h"
 #include "jsvar.h"
 #include "jsparse.h"
 #include "jsinteractive.h"
@@ -49,6 +50,20 @@ Event emitted when playback has finished
   "ifdef" : "BANGLEJS"
 }
 When in double-buffered mode, this event is emitted when the `Waveform` class swaps to playing a new buffer - so you should then fill this current buffer up with new data.
+
+This isn't emitted when streaming with the `stream` option, as buffers are then
+filled or written out automatically.
+ */
+/*JSON{
+  "type" : "event",
+  "class" : "Waveform",
+  "name" : "error",
+  "params" : [["error","JsVar","An Error object"]],
+  "ifdef" : "BANGLEJS"
+}
+Emitted when streaming with the `stream` option if the stream's `read`/`write`
+threw an exception (in which case the Waveform stops), or if buffers couldn't be
+filled or written out before they were needed (which means some data was lost).
  */
 
 static JsVar *jswrap_waveform_getBuffer(JsVar *waveform, int bufferNumber, bool *is16Bit) {
@@ -65,6 +80,148 @@ static JsVar *jswrap_waveform_getBuffer(JsVar *waveform, int bufferNumber, bool
   return backingString;
 }
 
+/* Streaming: when startInput/startOutput is given a `stream`, each time the
+ * timer flips buffers the idle loop writes the buffer that was just recorded
+ * to `stream.write`, or refills the buffer that was just played from
+ * `stream.read`. We keep:
+ *
+ *  stream    - the stream object
+ *  swaps     - the last value of UtilTimerTaskBuffer.swaps we saw
+ *  streamEnd - when playing, the number of swaps left before the data runs out
+ */
+
+typedef struct {
+  JsvStringIterator *it; ///< where to write data
+  size_t remaining;      ///< bytes left in the destination
+} WaveformCopyInfo;
+
+static void jswrap_waveform_copyCallback(unsigned char *data, unsigned int len, void *callbackData) {
+  WaveformCopyInfo *info = (WaveformCopyInfo*)callbackData;
+  while (len-- && info->remaining) {
+    jsvStringIteratorSetCharAndNext(info->it, (char)*(data++));
+    info->remaining--;
+  }
+}
+
+/** Fill the backing string of a buffer from `stream.read` (if `readStream`),
+ * and pad what's left with silence (the middle of the sample range). Returns
+ * the number of bytes read from the stream */
+static size_t jswrap_waveform_streamFill(JsVar *stream, JsVar *buffer, bool is16Bit, bool readStream) {
+  size_t len = jsvGetStringLength(buffer);
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, buffer, 0);
+  WaveformCopyInfo info = { &it, len };
+  JsVar *readFunc = readStream ? jspGetNamedField(stream, "read", false) : 0;
+  while (readFunc && info.remaining && !jspHasError()) {
+    JsVar *lenVar = jsvNewFromInteger((JsVarInt)info.remaining);
+    JsVar *data = jspExecuteFunction(readFunc, stream, 1, &lenVar);
+    jsvUnLock(lenVar);
+    size_t before = info.remaining;
+    if (jsvIsIterable(data))
+      jsvIterateBufferCallback(data, jswrap_waveform_copyCallback, &info);
+    jsvUnLock(data);
+    if (info.remaining == before) break; // no more data
+  }
+  jsvUnLock(readFunc);
+  size_t filled = len - info.remaining;
+  for (size_t i=filled;i<len;i++) // 16 bit samples are LSB first
+    jsvStringIteratorSetCharAndNext(&it, (char)((is16Bit && !(i&1)) ? 0 : 0x80));
+  jsvStringIteratorFree(&it);
+  return filled;
+}
+
+/// Write the first `len` bytes of a buffer's backing string to `stream.write`
+static void jswrap_waveform_streamWrite(JsVar *stream, JsVar *buffer, size_t len) {
+  if (!len) return;
+  // copy, as the timer will start overwriting the buffer again soon
+  JsVar *data = jsvNewFromStringVar(buffer, 0, len);
+  JsVar *writeFunc = jspGetNamedField(stream, "write", false);
+  if (data && writeFunc)
+    jsvUnLock(jspExecuteFunction(writeFunc, stream, 1, &data));
+  jsvUnLock2(data, writeFunc);
+}
+
+static void jswrap_waveform_emitError(JsVar *waveform, const char *msg) {
+  JsVar *msgVar = jsvNewFromString(msg);
+  JsVar *error = jswrap_error_constructor(msgVar);
+  jsiQueueObjectCallbacks(waveform, JS_EVENT_PREFIX"error", &error, 1);
+  jsvUnLock2(msgVar, error);
+}
+
+/// If the stream's read/write failed, emit the exception as an 'error' event and return true
+static bool jswrap_waveform_streamFailed(JsVar *waveform) {
+  if (!jspHasError()) return false;
+  JsVar *exception = jspGetException();
+  if (exception) {
+    execInfo.execute &= (JsExecFlags)~EXEC_EXCEPTION;
+    jsiQueueObjectCallbacks(waveform, JS_EVENT_PREFIX"error", &exception, 1);
+    jsvUnLock(exception);
+  }
+  return true;
+}
+
+/// How many bytes into its current buffer is this task?
+static size_t jswrap_waveform_getBufferPosition(UtilTimerTask *task) {
+  JsVar *buffer = jsvLock(task->data.buffer.currentBuffer);
+  size_t pos;
+  if (!task->data.buffer.var) { // finished
+    pos = jsvGetStringLength(buffer);
+  } else if (jsvIsFlatString(buffer)) {
+    pos = task->data.buffer.charIdx - sizeof(JsVar);
+  } else { // add up the blocks before the current one
+    pos = task->data.buffer.charIdx;
+    JsVar *block = jsvLockAgain(buffer);
+    while (block && block != task->data.buffer.var) {
+      pos += jsvGetCharactersInVar(block);
+      JsVarRef next = jsvGetLastChild(block);
+      jsvUnLock(block);
+      block = next ? jsvLock(next) : 0;
+    }
+    jsvUnLock(block);
+  }
+  jsvUnLock(buffer);
+  return pos;
+}
+
+/** Called from idle when streaming, to handle any buffer swaps since we last
+ * looked. Returns false if the Waveform should now stop */
+static bool jswrap_waveform_streamIdle(JsVar *waveform, JsVar *stream, UtilTimerTask *task) {
+  unsigned char lastSwaps = (unsigned char)jsvObjectGetIntegerChild(waveform, "swaps");
+  unsigned char swaps = (unsigned char)(task->data.buffer.swaps - lastSwaps);
+  if (!swaps) return true;
+  jsvObjectSetChildAndUnLock(waveform, "swaps", jsvNewFromInteger(task->data.buffer.swaps));
+  if (swaps>1)
+    jswrap_waveform_emitError(waveform, "Waveform buffer overrun");
+
+  bool is16Bit = false;
+  JsVar *buffer = jswrap_waveform_getBuffer(waveform, 0, &is16Bit);
+  // the buffer that isn't being used right now is the one we just finished
+  JsVar *finished = (jsvGetRef(buffer) == task->data.buffer.currentBuffer) ?
+                    jswrap_waveform_getBuffer(waveform, 1, 0) : jsvLockAgain(buffer);
+  jsvUnLock(buffer);
+  bool keepGoing = true;
+  if (UET_IS_BUFFER_READ_EVENT(task->type)) {
+    jswrap_waveform_streamWrite(stream, finished, jsvGetStringLength(finished));
+    keepGoing = !jswrap_waveform_streamFailed(waveform);
+  } else {
+    int streamEnd = (int)jsvObjectGetIntegerChild(waveform, "streamEnd");
+    if (streamEnd) { // we're already out of data
+      streamEnd -= swaps;
+      if (streamEnd>0) jswrap_waveform_streamFill(stream, finished, is16Bit, false);
+      else keepGoing = false;
+    } else {
+      size_t filled = jswrap_waveform_streamFill(stream, finished, is16Bit, true);
+      if (jswrap_waveform_streamFailed(waveform))
+        keepGoing = false;
+      else if (filled < jsvGetStringLength(finished))
+        streamEnd = filled ? 2 : 1; // stop once this buffer has played, or now if it's empty
+    }
+    jsvObjectSetChildAndUnLock(waveform, "streamEnd", jsvNewFromInteger(streamEnd));
+  }
+  jsvUnLock(finished);
+  return keepGoing;
+}
+
 
 /*JSON{
   "type" : "idle",
@@ -82,16 +239,26 @@ bool jswrap_waveform_idle() {
       bool running = jsvObjectGetBoolChild(waveform, "running");
       if (running) {
         JsVar *buffer = jswrap_waveform_getBuffer(waveform,0,0);
+        JsVar *stream = jsvObjectGetChildIfExists(waveform, "stream");
         UtilTimerTask task;
         // Search for a timer task
-        if (!jstGetLastBufferTimerTask(buffer, &task)) {
+        bool hasTask = jstGetLastBufferTimerTask(buffer, &task);
+        if (hasTask && stream && !jswrap_waveform_streamIdle(waveform, stream, &task)) {
+          jstStopBufferTimerTask(buffer); // stream finished or failed
+          hasTask = false;
+        }
+        if (!hasTask) {
           // if the timer task is now gone...
           JsVar *arrayBuffer = jsvObjectGetChildIfExists(waveform, "buffer");
           jsiQueueObjectCallbacks(waveform, JS_EVENT_PREFIX"finish", &arrayBuffer, 1);
           jsvUnLock(arrayBuffer);
           running = false;
           jsvObjectSetChildAndUnLock(waveform, "running", jsvNewFromBool(running));
-        } else {
+          if (stream) {
+            jsvObjectRemoveChild(waveform, "stream");
+            jsvObjectRemoveChild(waveform, "streamEnd");
+          }
+        } else if (!stream) {
           // If the timer task is still there...
           if (task.data.buffer.nextBuffer &&
               task.data.buffer.nextBuffer != task.data.buffer.currentBuffer) {
@@ -107,7 +274,7 @@ bool jswrap_waveform_idle() {
             }
           }
         }
-        jsvUnLock(buffer);
+        jsvUnLock2(buffer, stream);
       }
       jsvUnLock(waveform);
       // if not running, remove waveform from this list
@@ -265,19 +432,67 @@ static void jswrap_waveform_start(JsVar *waveform, Pin pin, JsVarFloat freq, JsV
   JsSysTime startTime = 0;
   bool repeat = false;
   Pin npin = PIN_UNDEFINED;
+  JsVar *stream = 0;
   if (jsvIsObject(options)) {
     JsVarFloat t = jsvObjectGetFloatChild(options, "time");
     if (isfinite(t) && t>0)
       startTime = jshGetTimeFromMilliseconds(t*1000) - jshGetSystemTime();
     repeat = jsvObjectGetBoolChild(options, "repeat");
     npin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(options, "npin"));
+    stream = jsvObjectGetChildIfExists(options, "stream");
   } else if (!jsvIsUndefined(options)) {
     jsExceptionHere(JSET_ERROR, "Expecting options to be undefined or an Object, not %t", options);
   }
 
   bool is16Bit = false;
   JsVar *buffer = jswrap_waveform_getBuffer(waveform,0, &is16Bit);
+  if (stream) {
+    const char *fnName = isWriting ? "read" : "write";
+    JsVar *fn = jspGetNamedField(stream, fnName, false);
+    bool hasFn = jsvIsFunction(fn);
+    jsvUnLock(fn);
+    if (!hasFn) {
+      jsExceptionHere(JSET_TYPEERROR, "Expecting stream to have a '%s' method", fnName);
+      jsvUnLock2(buffer, stream);
+      return;
+    }
+    if (jsvIsNativeString(buffer) || jsvIsFlashString(buffer)) {
+      jsExceptionHere(JSET_ERROR, "Waveform buffer must be in RAM to stream");
+      jsvUnLock2(buffer, stream);
+      return;
+    }
+    // streaming always flips between two buffers, so add a second if needed
+    JsVar *arrayBuffer2 = jsvObjectGetChildIfExists(waveform, "buffer2");
+    if (!arrayBuffer2) {
+      JsVar *arrayBuffer = jsvObjectGetChildIfExists(waveform, "buffer");
+      jsvObjectSetChildAndUnLock(waveform, "buffer2", jsvNewTypedArray(
+          is16Bit ? ARRAYBUFFERVIEW_UINT16 : ARRAYBUFFERVIEW_UINT8, jsvGetLength(arrayBuffer)));
+      jsvUnLock(arrayBuffer);
+    }
+    jsvUnLock(arrayBuffer2);
+    repeat = true;
+  }
   JsVar *buffer2 = jswrap_waveform_getBuffer(waveform,1,0);
+  if (stream && !buffer2) { // out of memory
+    jsvUnLock2(buffer, stream);
+    return;
+  }
+  if (stream && isWriting) {
+    // read ahead into both buffers before we start playing
+    int streamEnd = 0;
+    if (jswrap_waveform_streamFill(stream, buffer, is16Bit, true) < jsvGetStringLength(buffer)) {
+      jswrap_waveform_streamFill(stream, buffer2, is16Bit, false);
+      streamEnd = 1;
+    } else {
+      size_t filled = jswrap_waveform_streamFill(stream, buffer2, is16Bit, true);
+      if (filled < jsvGetStringLength(buffer2)) streamEnd = filled ? 2 : 1;
+    }
+    if (jspHasError()) {
+      jsvUnLock3(buffer, buffer2, stream);
+      return;
+    }
+    jsvObjectSetChildAndUnLock(waveform, "streamEnd", jsvNewFromInteger(streamEnd));
+  }
 
   UtilTimerEventType eventType;
 
@@ -295,6 +510,10 @@ static void jswrap_waveform_start(JsVar *waveform, Pin pin, JsVarFloat freq, JsV
 
   jsvObjectSetChildAndUnLock(waveform, "running", jsvNewFromBool(true));
   jsvObjectSetChildAndUnLock(waveform, "freq", jsvNewFromFloat(freq));
+  if (stream) {
+    jsvObjectSetChildAndUnLock(waveform, "stream", stream);
+    jsvObjectSetChildAndUnLock(waveform, "swaps", jsvNewFromInteger(0));
+  }
   // Add to our list of active waveforms
   JsVar *waveforms = jsvObjectGetChild(execInfo.hiddenRoot, JSI_WAVEFORM_NAME, JSV_ARRAY);
   if (waveforms) {
@@ -312,7 +531,7 @@ static void jswrap_waveform_start(JsVar *waveform, Pin pin, JsVarFloat freq, JsV
   "params" : [
     ["output","pin","The pin to output on"],
     ["freq","float","The frequency to output each sample at"],
-    ["options","JsVar","[optional] options struct `{time:float, repeat:bool, npin:Pin}` (see below)"]
+    ["options","JsVar","[optional] options struct `{time:float, repeat:bool, npin:Pin, stream:object}` (see below)"]
   ]
 }
 Will start outputting the waveform on the given pin - the pin must have
@@ -324,9 +543,24 @@ previously been initialised with analogWrite. If not repeating, it'll emit a
   time : float,        // the that the waveform with start output at, e.g. `getTime()+1` (otherwise it is immediate)
   repeat : bool,       // whether to repeat the given sample
   npin : Pin,          // If specified, the waveform is output across two pins (see below)
+  stream : object,     // (2v27+) If specified, play data read from this (eg. a StorageFile) - see below
 }
 ```
 
+If `stream` is specified, both buffers are filled with `stream.read(length)`
+before playback starts, and each time a buffer has been played it is refilled
+from the stream. This happens natively, so long files can be played without
+any JS code running per buffer (a second buffer is added if the Waveform
+wasn't created with `doubleBuffer:true`). When the stream returns no more
+data, `finish` is emitted once the last buffer has played.
+
+```
+var w = new Waveform(1024, {doubleBuffer:true});
+analogWrite(H0, 0.5, {freq:80000});
+w.on("finish", () => print("Done!"));
+w.startOutput(H0, 8000, {stream:require("Storage").open("sound.pcm","r")});
+```
+
 Using `npin` allows you to split the Waveform output between two pins and hence avoid
 any DC bias (or need to capacitor), for instance you could attach a speaker to `H0` and
 `H1` on Jolt.js. When the value in the waveform was at 50% both outputs would be 0,
@@ -345,11 +579,23 @@ void jswrap_waveform_startOutput(JsVar *waveform, Pin pin, JsVarFloat freq, JsVa
   "params" : [
     ["output","pin","The pin to output on"],
     ["freq","float","The frequency to output each sample at"],
-    ["options","JsVar","[optional] options struct `{time:float,repeat:bool}` where: `time` is the that the waveform with start output at, e.g. `getTime()+1` (otherwise it is immediate), `repeat` is a boolean specifying whether to repeat the give sample"]
+    ["options","JsVar","[optional] options struct `{time:float,repeat:bool,stream:object}` where: `time` is the that the waveform with start output at, e.g. `getTime()+1` (otherwise it is immediate), `repeat` is a boolean specifying whether to repeat the give sample, `stream` (2v27+) is an object with a `write` method to record to (see below)"]
   ]
 }
 Will start inputting the waveform on the given pin that supports analog. If not
 repeating, it'll emit a `finish` event when it is done.
+
+If `stream` is specified (eg. a StorageFile opened for writing, or a Socket),
+recording continues until `stop()` is called, and each time a buffer is full
+it is passed natively to `stream.write` (with whatever was recorded of the
+current buffer written out on `stop()`).
+
+```
+var w = new Waveform(1024, {doubleBuffer:true});
+w.on("error", e => print(e)); // eg. buffer overruns
+w.startInput(A0, 4000, {stream:require("Storage").open("rec.pcm","w")});
+setTimeout(() => w.stop(), 60000); // record for a minute
+```
  */
 void jswrap_waveform_startInput(JsVar *waveform, Pin pin, JsVarFloat freq, JsVar *options) {
   // Setup analog, and also bail out on failure
@@ -374,10 +620,21 @@ void jswrap_waveform_stop(JsVar *waveform) {
     return;
   }
   JsVar *buffer = jswrap_waveform_getBuffer(waveform,0,0);
+  UtilTimerTask task;
+  bool hasTask = jstGetLastBufferTimerTask(buffer, &task);
   if (!jstStopBufferTimerTask(buffer)) {
     jsExceptionHere(JSET_ERROR, "Waveform couldn't be stopped");
   }
-  jsvUnLock(buffer);
+  JsVar *stream = jsvObjectGetChildIfExists(waveform, "stream");
+  if (stream && hasTask && UET_IS_BUFFER_READ_EVENT(task.type)) {
+    // write out any full buffer we haven't handled yet, then what we have of the current one
+    jswrap_waveform_streamIdle(waveform, stream, &task);
+    JsVar *current = (jsvGetRef(buffer) == task.data.buffer.currentBuffer) ?
+                     jsvLockAgain(buffer) : jswrap_waveform_getBuffer(waveform, 1, 0);
+    jswrap_waveform_streamWrite(stream, current, jswrap_waveform_getBufferPosition(&task));
+    jsvUnLock(current);
+  }
+  jsvUnLock2(stream, buffer);
   // now run idle loop as this will issue the finish event and will clean up
   jswrap_waveform_idle();
 }
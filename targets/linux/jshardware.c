@@ -22,7 +22,18 @@
  #include <sys/select.h>
  #include <termios.h>
  #include <fcntl.h>
+ #include <poll.h>
+ #include <errno.h>
 #endif//__MINGW32__
+#ifdef __linux__
+ #include <sys/epoll.h>
+ #define USE_EPOLL
+ #include <sys/ioctl.h>
+ #include <linux/spi/spidev.h>
+ #include <linux/i2c.h>
+ #include <linux/i2c-dev.h>
+ #define USE_LINUX_SPI_I2C
+#endif
  #include <signal.h>
  #include <inttypes.h>
 
@@ -31,6 +42,8 @@
 #include "jsutils.h"
 #include "jsparse.h"
 #include "jsinteractive.h"
+#include "jshardware_linux.h"
+#include "jstimer.h"
 
 #include <pthread.h>
 
@@ -59,6 +72,7 @@
 
 // ----------------------------------------------------------------------------
 int ioDevices[EV_DEVICE_MAX+1]; // list of open IO devices (or 0)
+static int busFds[EV_DEVICE_MAX+1]; ///< open spidev/i2c-dev file for SPI/I2C devices, or -1
 JshPinState gpioState[JSH_PIN_COUNT]; // will be set to UNDEFINED if it isn't exported
 
 #ifdef SYSFS_GPIO_DIR
@@ -68,6 +82,7 @@ JshPinState gpioState[JSH_PIN_COUNT]; // will be set to UNDEFINED if it isn't ex
 
 bool gpioShouldWatch[JSH_PIN_COUNT]; // whether we should watch this pin for changes
 bool gpioLastState[JSH_PIN_COUNT]; // the last state of this pin
+int gpioWatchFd[JSH_PIN_COUNT]; // open 'value' file if the kernel will tell us about edges on this pin, or -1 if we must poll
 
 
 // functions for accessing the sysfs GPIO
@@ -157,6 +172,36 @@ IOEventFlags pinToEVEXTI(Pin pin) {
   return gpioEventFlags[pin];
 }
 
+#ifndef USE_WIRINGPI
+/* Pins with no GPIO behind them (eg. when running on a desktop) are 'virtual'.
+ * Their value is just stored, and writing to one that is being watched creates
+ * a watch event - so a stream of edges can be replayed into setWatch */
+bool gpioVirtualState[JSH_PIN_COUNT];
+
+#ifdef SYSFS_GPIO_DIR
+#define GPIO_VIRTUAL_UNKNOWN 0 ///< we haven't checked sysfs for this pin since it was last exported
+#define GPIO_VIRTUAL_NO 1
+#define GPIO_VIRTUAL_YES 2
+/// Whether each pin is virtual - this is checked often (even by the input thread) so we cache it
+uint8_t gpioIsVirtual[JSH_PIN_COUNT];
+#endif
+
+static bool jshPinIsVirtual(Pin pin) {
+#ifdef SYSFS_GPIO_DIR
+  if (gpioIsVirtual[pin] == GPIO_VIRTUAL_UNKNOWN) {
+    char path[64] = SYSFS_GPIO_DIR"/gpio";
+    itostr(pin, &path[strlen(path)], 10);
+    strcat(&path[strlen(path)], "/value");
+    gpioIsVirtual[pin] = (access(path, F_OK)!=0) ? GPIO_VIRTUAL_YES : GPIO_VIRTUAL_NO;
+  }
+  return gpioIsVirtual[pin] == GPIO_VIRTUAL_YES;
+#else
+  NOT_USED(pin);
+  return true;
+#endif
+}
+#endif
+
 IOEventFlags getNewEVEXTI() {
   int i;
   for (i=0;i<16;i++) {
@@ -191,6 +236,7 @@ bool jshGetDevicePath(IOEventFlags device, char *buf, size_t bufSize) {
 
 // ----------------------------------------------------------------------------
 // for non-blocking IO
+#define GETCH_EOF (-2) ///< returned by getch at the end of stdin
 #ifdef __MINGW32__
 void reset_terminal_mode() {}
 void set_conio_terminal_mode() {}
@@ -243,32 +289,244 @@ int getch()
     unsigned char c;
     if ((r = (int)read(STDIN_FILENO, &c, sizeof(c))) < 0) {
         return r;
+    } else if (r == 0) {
+        return GETCH_EOF;
     } else {
         return c;
     }
 }
 #endif//__MINGW32__
 
+// ----------------------------------------------------------------------------
+//                                                    WAITING ON FILE DESCRIPTORS
+#ifndef __MINGW32__
+typedef struct {
+  int fd;
+  unsigned char events; ///< JSH_LINUX_FD_* that we want to wake for
+  unsigned char ready; ///< JSH_LINUX_FD_* that were ready last time we checked
+} JshLinuxFd;
+
+static JshLinuxFd *watchedFds = 0; ///< fds that jshSleep should wake up for (main thread only)
+static int watchedFdCount = 0, watchedFdSize = 0;
+static int wakePipe[2] = {-1,-1}; ///< written by the input thread when it has pushed events, to wake jshSleep
+static int inputWakePipe[2] = {-1,-1}; ///< written by the main thread when the input thread has something to do
+#ifdef USE_EPOLL
+static int epollFd = -1;
+#endif
+
+static void pipeWake(int fd) {
+  char c = 0;
+  if (fd>=0) (void)!write(fd, &c, 1); // if the pipe is full, it'll wake anyway
+}
+
+static void pipeDrain(int fd) {
+  char buf[32];
+  while (read(fd, buf, sizeof(buf)) > 0);
+}
+
+static void pipeOpen(int *p) {
+  if (pipe(p)) {
+    p[0] = p[1] = -1;
+    return;
+  }
+  fcntl(p[0], F_SETFL, O_NONBLOCK);
+  fcntl(p[1], F_SETFL, O_NONBLOCK);
+}
+
+static void pipeClose(int *p) {
+  if (p[0]>=0) close(p[0]);
+  if (p[1]>=0) close(p[1]);
+  p[0] = p[1] = -1;
+}
+
+static JshLinuxFd *jshLinuxFindFd(int fd) {
+  for (int i=0;i<watchedFdCount;i++)
+    if (watchedFds[i].fd == fd) return &watchedFds[i];
+  return 0;
+}
+
+#ifdef USE_EPOLL
+static void jshLinuxEpollCtl(int op, int fd, int events) {
+  if (epollFd<0) return;
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  if (events & JSH_LINUX_FD_READ) ev.events |= EPOLLIN;
+  if (events & JSH_LINUX_FD_WRITE) ev.events |= EPOLLOUT;
+  ev.data.fd = fd;
+  epoll_ctl(epollFd, op, fd, &ev);
+}
+#endif
+
+void jshLinuxWatchFd(int fd, int events) {
+  if (fd<0) return;
+  JshLinuxFd *w = jshLinuxFindFd(fd);
+  if (!events) {
+    if (!w) return;
+#ifdef USE_EPOLL
+    jshLinuxEpollCtl(EPOLL_CTL_DEL, fd, 0);
+#endif
+    *w = watchedFds[--watchedFdCount];
+    return;
+  }
+  if (w) {
+    w->events = (unsigned char)events;
+#ifdef USE_EPOLL
+    jshLinuxEpollCtl(EPOLL_CTL_MOD, fd, events);
+#endif
+    return;
+  }
+  if (watchedFdCount >= watchedFdSize) {
+    int newSize = watchedFdSize ? watchedFdSize*2 : 16;
+    JshLinuxFd *newFds = (JshLinuxFd*)realloc(watchedFds, sizeof(JshLinuxFd)*(size_t)newSize);
+    if (!newFds) return; // we won't wake for this fd, but recv/accept will still check it directly
+    watchedFds = newFds;
+    watchedFdSize = newSize;
+  }
+  w = &watchedFds[watchedFdCount++];
+  w->fd = fd;
+  w->events = (unsigned char)events;
+  w->ready = 0;
+#ifdef USE_EPOLL
+  jshLinuxEpollCtl(EPOLL_CTL_ADD, fd, events);
+#endif
+}
+
+void jshLinuxWatchFdWrite(int fd) {
+  JshLinuxFd *w = jshLinuxFindFd(fd);
+  if (w && !(w->events & JSH_LINUX_FD_WRITE))
+    jshLinuxWatchFd(fd, w->events | JSH_LINUX_FD_WRITE);
+}
+
+int jshLinuxGetFdReady(int fd) {
+  JshLinuxFd *w = jshLinuxFindFd(fd);
+  return w ? w->ready : -1;
+}
+
+/// We got an event for an fd - update its ready flags
+static void jshLinuxFdEvent(int fd, bool canRead, bool canWrite) {
+  if (fd == wakePipe[0]) {
+    pipeDrain(fd);
+    return;
+  }
+  JshLinuxFd *w = jshLinuxFindFd(fd);
+  if (!w) return;
+  if (canRead) w->ready |= JSH_LINUX_FD_READ;
+  if (canWrite) {
+    w->ready |= JSH_LINUX_FD_WRITE;
+    // only wake once for writes - whoever wanted to write will ask again if they need to
+    if (w->events & JSH_LINUX_FD_WRITE)
+      jshLinuxWatchFd(fd, w->events & ~JSH_LINUX_FD_WRITE);
+  }
+}
+
+void jshLinuxWaitFds(int timeoutMs) {
+  for (int i=0;i<watchedFdCount;i++)
+    watchedFds[i].ready = 0;
+#ifdef USE_EPOLL
+  if (epollFd>=0) {
+    struct epoll_event evs[32];
+    int n = epoll_wait(epollFd, evs, sizeof(evs)/sizeof(evs[0]), timeoutMs);
+    while (n>0) {
+      for (int i=0;i<n;i++)
+        jshLinuxFdEvent(evs[i].data.fd,
+            (evs[i].events & (EPOLLIN|EPOLLHUP|EPOLLERR))!=0,
+            (evs[i].events & EPOLLOUT)!=0);
+      // if we filled the buffer, there may be more - get them without waiting
+      n = (n==sizeof(evs)/sizeof(evs[0])) ? epoll_wait(epollFd, evs, n, 0) : 0;
+    }
+    return;
+  }
+#endif
+  // poll fallback
+  size_t fdCount = (size_t)watchedFdCount+1;
+  struct pollfd *fds = (struct pollfd*)alloca(sizeof(struct pollfd)*fdCount);
+  fds[0].fd = wakePipe[0];
+  fds[0].events = POLLIN;
+  for (int i=0;i<watchedFdCount;i++) {
+    fds[i+1].fd = watchedFds[i].fd;
+    fds[i+1].events = (short)(((watchedFds[i].events & JSH_LINUX_FD_READ) ? POLLIN : 0) |
+                              ((watchedFds[i].events & JSH_LINUX_FD_WRITE) ? POLLOUT : 0));
+  }
+  if (poll(fds, (nfds_t)fdCount, timeoutMs) <= 0) return;
+  for (size_t i=0;i<fdCount;i++)
+    if (fds[i].revents)
+      jshLinuxFdEvent(fds[i].fd,
+          (fds[i].revents & (POLLIN|POLLHUP|POLLERR))!=0,
+          (fds[i].revents & POLLOUT)!=0);
+}
+
+static void jshLinuxWaitInit() {
+  pipeOpen(wakePipe);
+  pipeOpen(inputWakePipe);
+#ifdef USE_EPOLL
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (epollFd>=0 && wakePipe[0]>=0) {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = wakePipe[0];
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakePipe[0], &ev);
+  }
+#endif
+}
+
+static void jshLinuxWaitKill() {
+#ifdef USE_EPOLL
+  if (epollFd>=0) close(epollFd);
+  epollFd = -1;
+#endif
+  pipeClose(wakePipe);
+  pipeClose(inputWakePipe);
+  free(watchedFds);
+  watchedFds = 0;
+  watchedFdCount = watchedFdSize = 0;
+}
+#else//__MINGW32__
+void jshLinuxWatchFd(int fd, int events) {}
+void jshLinuxWatchFdWrite(int fd) {}
+int jshLinuxGetFdReady(int fd) { return -1; }
+void jshLinuxWaitFds(int timeoutMs) { if (timeoutMs) jshDelayMicroseconds((timeoutMs<0 || timeoutMs>50) ? 50000 : timeoutMs*1000); }
+static void pipeWake(int fd) {}
+static void jshLinuxWaitInit() {}
+static void jshLinuxWaitKill() {}
+#endif//__MINGW32__
+
+bool jshLinuxSleepForConsole = true;
+
 pthread_t inputThread;
 bool isInitialised;
+bool stdinClosed; ///< set when stdin reaches end of file - no point watching it any more
 
 void *jshInputThread() {
   while (isInitialised) {
-    bool shortSleep = false;
+    bool pushedEvents = false;
+    int sleepMs = -1; // forever - we'll be woken by file descriptors
     /* Handle the delayed Ctrl-C -> interrupt behaviour (see description by EXEC_CTRL_C's definition)  */
     if (execInfo.execute & EXEC_CTRL_C_WAIT)
       execInfo.execute = (execInfo.execute & ~EXEC_CTRL_C_WAIT) | EXEC_INTERRUPTED;
     if (execInfo.execute & EXEC_CTRL_C)
       execInfo.execute = (execInfo.execute & ~EXEC_CTRL_C) | EXEC_CTRL_C_WAIT;
+    if (execInfo.execute & (EXEC_CTRL_C|EXEC_CTRL_C_WAIT))
+      sleepMs = 50; // come back round to turn Ctrl-C into an interrupt
     // Read from the console if we have space
-    while (kbhit() && (jshGetEventsUsed()<IOBUFFERMASK/2)) {
-      int ch = getch();
-      if (ch<0) break;
-      if (ch==4) exit(0); // exit on Ctrl-D
-      jshPushIOCharEvent(EV_USBSERIAL, (char)ch);
+    while (!stdinClosed && kbhit() && (jshGetEventsUsed()<IOBUFFERMASK/2)) {
+      // push what we have in one event rather than one event per character
+      char buf[IOEVENT_MAX_LEN];
+      unsigned int len = 0;
+      while (len<sizeof(buf) && (len==0 || kbhit())) {
+        int ch = getch();
+        if (ch==GETCH_EOF) stdinClosed = true;
+        if (ch<0) break;
+        if (ch==4) exit(0); // exit on Ctrl-D
+        buf[len++] = (char)ch;
+      }
+      if (!len) break;
+      jshPushIOCharEvents(EV_USBSERIAL, buf, len);
+      pushedEvents = true;
     }
     // Read from any open devices - if we have space
-    if (jshGetEventsUsed() < IOBUFFERMASK/2) {
+    bool hasSpace = jshGetEventsUsed() < IOBUFFERMASK/2;
+    if (hasSpace) {
       int i;
       for (i=0;i<=EV_DEVICE_MAX;i++) {
         if (ioDevices[i]) {
@@ -278,39 +536,90 @@ void *jshInputThread() {
           if (bytes>0) {
             //int j; for (j=0;j<bytes;j++) printf("]] '%c'\r\n", buf[j]);
             jshPushIOCharEvents(i, buf, (unsigned int)bytes);
-            shortSleep = true;
+            pushedEvents = true;
           }
         }
       }
-    }
+    } else
+      sleepMs = 1; // no space - wait for the main thread to handle some events
     // Write any data we have
     IOEventFlags device = jshGetDeviceToTransmit();
     while (device != EV_NONE) {
-      char ch = (char)jshGetCharToTransmit(device);
-      //printf("[[ '%c'\r\n", ch);
-      if (ioDevices[device]) {
-        write(ioDevices[device], &ch, 1);
-        shortSleep = true;
+      unsigned char *data;
+      unsigned int len = jshGetTransmitSpan(device, &data);
+      if (len) { // write straight from the transmit buffer
+        if (ioDevices[device])
+          write(ioDevices[device], data, len);
+        jshTransmitSpanSent(device, len);
+      } else { // XON/XOFF or data from further up the queue
+        unsigned char buf[64];
+        len = jshGetCharsToTransmit(device, buf, sizeof(buf));
+        if (ioDevices[device])
+          write(ioDevices[device], buf, len);
       }
       device = jshGetDeviceToTransmit();
+      pushedEvents = true; // wake the main thread, as something may be waiting for transmit buffer space
     }
 
 
 #ifdef SYSFS_GPIO_DIR
     Pin pin;
     for (pin=0;pin<JSH_PIN_COUNT;pin++)
-      if (gpioShouldWatch[pin]) {
-        shortSleep = true;
+      if (gpioShouldWatch[pin] && !jshPinIsVirtual(pin)) { // virtual pins create their own events
+        if (gpioWatchFd[pin]<0) sleepMs = 1; // no edge interrupts, so we have to poll
         bool state = jshPinGetValue(pin);
         if (state != gpioLastState[pin]) {
-          jshPushIOEvent(pinToEVEXTI(pin) | (state?EV_EXTI_IS_HIGH:0), jshGetSystemTime());
+          jshPushIOWatchEvent(pinToEVEXTI(pin)); // so any event callback (eg. edge capture) gets called
           gpioLastState[pin] = state;
+          pushedEvents = true;
         }
       }
 #endif
 
-    jshDelayMicroseconds(shortSleep ? 1000 : 50000);
+    if (pushedEvents)
+      pipeWake(wakePipe[1]); // wake up jshSleep
+
+#ifdef __MINGW32__
+    jshDelayMicroseconds(pushedEvents ? 1000 : 50000);
+#else
+    // Wait until there's something to do
+    struct pollfd fds[2+EV_DEVICE_MAX+1+JSH_PIN_COUNT];
+    nfds_t fdCount = 0;
+    fds[fdCount].fd = inputWakePipe[0];
+    fds[fdCount++].events = POLLIN;
+    if (hasSpace) {
+      if (!stdinClosed) {
+        fds[fdCount].fd = STDIN_FILENO;
+        fds[fdCount++].events = POLLIN;
+      }
+      for (int i=0;i<=EV_DEVICE_MAX;i++)
+        if (ioDevices[i]) {
+          fds[fdCount].fd = ioDevices[i];
+          fds[fdCount++].events = POLLIN;
+        }
+    }
+#ifdef SYSFS_GPIO_DIR
+    for (pin=0;pin<JSH_PIN_COUNT;pin++)
+      if (gpioShouldWatch[pin] && gpioWatchFd[pin]>=0) {
+        fds[fdCount].fd = gpioWatchFd[pin];
+        fds[fdCount++].events = POLLPRI|POLLERR; // sysfs reports edges as 'priority' data
+      }
+#endif
+    if (poll(fds, fdCount, sleepMs) > 0) {
+      if (fds[0].revents) pipeDrain(inputWakePipe[0]);
+#ifdef SYSFS_GPIO_DIR
+      // sysfs GPIO needs us to read the value again before it'll tell us about another edge
+      for (nfds_t i=1;i<fdCount;i++)
+        if (fds[i].revents & POLLPRI) {
+          char buf[4];
+          lseek(fds[i].fd, 0, SEEK_SET);
+          (void)!read(fds[i].fd, buf, sizeof(buf));
+        }
+#endif
+    }
+#endif
   }
+  return 0;
 }
 
 
@@ -328,8 +637,10 @@ void jshInit() {
 #endif
 
   int i;
-  for (i=0;i<=EV_DEVICE_MAX;i++)
+  for (i=0;i<=EV_DEVICE_MAX;i++) {
     ioDevices[i] = 0;
+    busFds[i] = -1;
+  }
 
   jshInitDevices();
 #ifndef __MINGW32__
@@ -354,9 +665,13 @@ void jshInit() {
 #ifdef SYSFS_GPIO_DIR
   for (i=0;i<JSH_PIN_COUNT;i++) {
     gpioShouldWatch[i] = false;
+    gpioWatchFd[i] = -1;
+    gpioIsVirtual[i] = GPIO_VIRTUAL_UNKNOWN;
   }
 #endif
 
+  jshLinuxWaitInit();
+  stdinClosed = false;
   isInitialised = true;
   int err = pthread_create(&inputThread, NULL, &jshInputThread, NULL);
   if (err != 0)
@@ -372,8 +687,10 @@ void jshKill() {
 
   // Request that the input thread finishes
   isInitialised = false;
+  pipeWake(inputWakePipe[1]);
   // wait for thread to finish
   pthread_join(inputThread, NULL);
+  jshLinuxWaitKill();
 
   for (i=0;i<=EV_DEVICE_MAX;i++)
     if (ioDevices[i]) {
@@ -384,14 +701,44 @@ void jshKill() {
 #ifdef SYSFS_GPIO_DIR
 
   // unexport any GPIO that we exported
-  for (i=0;i<JSH_PIN_COUNT;i++)
+  for (i=0;i<JSH_PIN_COUNT;i++) {
+    if (gpioWatchFd[i]>=0) {
+      close(gpioWatchFd[i]);
+      gpioWatchFd[i] = -1;
+    }
     if (gpioState[i] != JSHPINSTATE_UNDEFINED)
       sysfs_write_int(SYSFS_GPIO_DIR"/unexport", i);
+  }
 #endif
 }
 
+/* There's no timer interrupt, so the utility timer (jstimer.c) is run from
+ * the main loop. jshSleep makes sure we wake up in time for it. */
+static bool utilTimerActive = false;
+static JsSysTime utilTimerDue; ///< when the utility timer should next fire
+
+static void jshUtilTimerPoll() {
+  int n = 0;
+  while (utilTimerActive && jshGetSystemTime() >= utilTimerDue) {
+    if (++n > 100) { // we're too far behind - just carry on from now
+      utilTimerDue = jshGetSystemTime();
+      break;
+    }
+    utilTimerActive = false; // set again by jshUtilTimerReschedule if there's more to do
+    jstUtilTimerInterruptHandler();
+  }
+}
+
+#if defined(USE_LINUX_SPI_I2C) && ESPR_I2C_COUNT>=1
+static void jshI2CFlushPending();
+#endif
+
 void jshIdle() {
-  // all done in the thread now...
+  // IO is all done in the thread now...
+  jshUtilTimerPoll();
+#if defined(USE_LINUX_SPI_I2C) && ESPR_I2C_COUNT>=1
+  jshI2CFlushPending();
+#endif
 }
 
 // ----------------------------------------------------------------------------
@@ -457,8 +804,10 @@ void jshDelayMicroseconds(int microsec) {
 void jshPinSetState(Pin pin, JshPinState state) {
 #ifdef SYSFS_GPIO_DIR
   if (gpioState[pin] != state) {
-    if (gpioState[pin] == JSHPINSTATE_UNDEFINED)
+    if (gpioState[pin] == JSHPINSTATE_UNDEFINED) {
       sysfs_write_int(SYSFS_GPIO_DIR"/export", pin);
+      gpioIsVirtual[pin] = GPIO_VIRTUAL_UNKNOWN; // it may have a GPIO now
+    }
     char path[64] = SYSFS_GPIO_DIR"/gpio";
     itostr(pin, &path[strlen(path)], 10);
     strcat(&path[strlen(path)], "/direction");
@@ -497,10 +846,21 @@ void jshPinSetValue(Pin pin, bool value) {
 #endif
 #ifdef USE_WIRINGPI
   digitalWrite(pin,value);
+#else
+  if (jshIsPinValid(pin) && jshPinIsVirtual(pin)) {
+    bool changed = gpioVirtualState[pin] != value;
+    gpioVirtualState[pin] = value;
+    if (changed && gpioEventFlags[pin])
+      jshPushIOWatchEvent(gpioEventFlags[pin]);
+  }
 #endif
 }
 
 bool jshPinGetValue(Pin pin) {
+#ifndef USE_WIRINGPI
+  if (jshIsPinValid(pin) && jshPinIsVirtual(pin))
+    return gpioVirtualState[pin];
+#endif
 #ifdef SYSFS_GPIO_DIR
   char path[64] = SYSFS_GPIO_DIR"/gpio";
   itostr(pin, &path[strlen(path)], 10);
@@ -598,6 +958,21 @@ IOEventFlags jshPinWatch(Pin pin, bool shouldWatch, JshPinWatchFlags flags) {
 #ifdef SYSFS_GPIO_DIR
         gpioShouldWatch[pin] = true;
         gpioLastState[pin] = jshPinGetValue(pin);
+        // ask sysfs to tell us about edges, so the input thread doesn't have to poll
+        if (gpioWatchFd[pin]<0) {
+          char path[64] = SYSFS_GPIO_DIR"/gpio";
+          itostr(pin, &path[strlen(path)], 10);
+          char *pathEnd = &path[strlen(path)];
+          strcpy(pathEnd, "/edge");
+          sysfs_write(path, "both");
+          char edge[8];
+          sysfs_read(path, edge, sizeof(edge));
+          if (strncmp(edge, "both", 4)==0) {
+            strcpy(pathEnd, "/value");
+            gpioWatchFd[pin] = open(path, O_RDONLY);
+          }
+        }
+        pipeWake(inputWakePipe[1]); // make sure the input thread starts watching
 #endif
 #ifdef USE_WIRINGPI
         wiringPiISR(pin, INT_EDGE_BOTH, irqEXTIs[exti-EV_EXTI0]);
@@ -609,6 +984,11 @@ IOEventFlags jshPinWatch(Pin pin, bool shouldWatch, JshPinWatchFlags flags) {
       gpioEventFlags[pin] = 0;
 #ifdef SYSFS_GPIO_DIR
       gpioShouldWatch[pin] = false;
+      if (gpioWatchFd[pin]>=0) {
+        pipeWake(inputWakePipe[1]); // stop the input thread polling the fd
+        close(gpioWatchFd[pin]);
+        gpioWatchFd[pin] = -1;
+      }
 #endif
 #ifdef USE_WIRINGPI
       wiringPiISR(pin, INT_EDGE_BOTH, irqEXTIDoNothing);
@@ -726,33 +1106,71 @@ void jshUSARTSetup(IOEventFlags device, JshUSARTInfo *inf) {
  * to set up interrupts */
 void jshUSARTKick(IOEventFlags device) {
   assert(DEVICE_IS_USART(device) || DEVICE_IS_SPI(device));
-  // all done by the idle loop
+  // sending is done by the input thread - wake it up
+  if (ioDevices[device]) pipeWake(inputWakePipe[1]);
+}
+
+// ----------------------------------------------------------------------------
+/* SPI and I2C use spidev/i2c-dev if a path has been set on the device object
+ * (eg. `SPI1.path="/dev/spidev0.0"`). Without one, SPI loops back whatever was
+ * sent and I2C talks to a simulated 256 byte memory (the first byte written
+ * sets the address, like a 24C02 EEPROM) so code can be tested without hardware.
+ * Transfers with a callback are done on a separate thread. */
+#if ESPR_I2C_COUNT>=1
+static unsigned char i2cSimMemory[ESPR_I2C_COUNT][256]; ///< simulated I2C memory when there's no i2c-dev
+static unsigned char i2cSimAddr[ESPR_I2C_COUNT]; ///< current address in i2cSimMemory
+#endif
+static pthread_mutex_t busMutex = PTHREAD_MUTEX_INITIALIZER; ///< only one transfer at a time (async ones are on other threads)
+
+static void jshBusOpen(IOEventFlags device) {
+  if (busFds[device]>=0) close(busFds[device]);
+  busFds[device] = -1;
+  char path[256];
+  if (jshGetDevicePath(device, path, sizeof(path))) {
+    busFds[device] = open(path, O_RDWR);
+    if (busFds[device]<0)
+      jsError("Open of path %s failed", path);
+  }
+}
+
+static void jshSPITransfer(IOEventFlags device, unsigned char *tx, unsigned char *rx, size_t count) {
+  pthread_mutex_lock(&busMutex);
+#ifdef USE_LINUX_SPI_I2C
+  if (busFds[device]>=0) {
+    struct spi_ioc_transfer tr;
+    memset(&tr, 0, sizeof(tr));
+    tr.tx_buf = (unsigned long)tx;
+    tr.rx_buf = (unsigned long)rx;
+    tr.len = (uint32_t)count;
+    if (ioctl(busFds[device], SPI_IOC_MESSAGE(1), &tr) < 0 && rx)
+      memset(rx, 0xFF, count);
+  } else
+#endif
+  if (rx && rx!=tx) memcpy(rx, tx, count); // loopback
+  pthread_mutex_unlock(&busMutex);
 }
 
 void jshSPISetup(IOEventFlags device, JshSPIInfo *inf) {
   assert(DEVICE_IS_SPI(device));
-   if (ioDevices[device]) close(ioDevices[device]);
-   ioDevices[device] = 0;
-   char path[256];
-   if (jshGetDevicePath(device, path, sizeof(path))) {
-     ioDevices[device] = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
-     if (!ioDevices[device]) {
-       jsError("Open of path %s failed", path);
-     } else {
-     }
-   } else {
-     jsError("No path defined for device");
-   }
+  jshBusOpen(device);
+#ifdef USE_LINUX_SPI_I2C
+  if (busFds[device]>=0) {
+    uint8_t mode = (uint8_t)inf->spiMode;
+    uint32_t speed = (uint32_t)inf->baudRate;
+    ioctl(busFds[device], SPI_IOC_WR_MODE, &mode);
+    ioctl(busFds[device], SPI_IOC_WR_MAX_SPEED_HZ, &speed);
+  }
+#endif
 }
 
 /** Send data through the given SPI device (if data>=0), and return the result
  * of the previous send (or -1). If data<0, no data is sent and the function
  * waits for data to be returned */
 int jshSPISend(IOEventFlags device, int data) {
-  jshTransmit(device, (unsigned char)data);
-  // FIXME
-  // use jshPopIOEventOfType(device) but be aware that it may return >1 char!
-  return -1;
+  if (data<0) return -1;
+  unsigned char b = (unsigned char)data;
+  jshSPITransfer(device, &b, &b, 1);
+  return b;
 }
 
 /** Send 16 bit data through the given SPI device. */
@@ -761,6 +1179,55 @@ void jshSPISend16(IOEventFlags device, int data) {
   jshSPISend(device, data&255);
 }
 
+typedef struct {
+  IOEventFlags device;
+  unsigned char *tx, *rx;
+  int count;
+  unsigned char address;
+  bool isRead, sendStop;
+  void (*callback)();
+} JshBusTransfer;
+
+static void jshI2CTransfer(JshBusTransfer *t);
+
+static void *jshBusTransferThread(void *arg) {
+  JshBusTransfer *t = (JshBusTransfer*)arg;
+  if (DEVICE_IS_SPI(t->device))
+    jshSPITransfer(t->device, t->tx, t->rx, (size_t)t->count);
+  else
+    jshI2CTransfer(t);
+  t->callback();
+  free(t);
+  return 0;
+}
+
+/// Run the transfer on a new thread, calling t->callback from it when done. Returns false on failure
+static bool jshBusTransferAsync(JshBusTransfer *t) {
+  JshBusTransfer *copy = (JshBusTransfer*)malloc(sizeof(JshBusTransfer));
+  if (!copy) return false;
+  *copy = *t;
+  pthread_t thread;
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  bool ok = pthread_create(&thread, &attr, jshBusTransferThread, copy)==0;
+  pthread_attr_destroy(&attr);
+  if (!ok) free(copy);
+  return ok;
+}
+
+/** Send data in tx through the given SPI device and return the response in
+ * rx (if supplied). If a callback is given, this returns immediately and the
+ * callback is called from another thread when the transfer is complete. */
+bool jshSPISendMany(IOEventFlags device, unsigned char *tx, unsigned char *rx, size_t count, void (*callback)()) {
+  if (!callback) {
+    jshSPITransfer(device, tx, rx, count);
+    return true;
+  }
+  JshBusTransfer t = { .device=device, .tx=tx, .rx=rx, .count=(int)count, .callback=callback };
+  return jshBusTransferAsync(&t);
+}
+
 /** Set whether to send 16 bits or 8 over SPI */
 void jshSPISet16(IOEventFlags device, bool is16) {
 }
@@ -773,42 +1240,158 @@ void jshSPISetReceive(IOEventFlags device, bool isReceive) {
 void jshSPIWait(IOEventFlags device) {
 }
 
+#if defined(USE_LINUX_SPI_I2C) && ESPR_I2C_COUNT>=1
+/* i2c-dev sends a stop at the end of every ioctl, so a write with sendStop=false
+ * is held here and sent in the same I2C_RDWR as the next transfer on that bus.
+ * That gives a repeated start between them, which is what devices expect when
+ * a register address is written and then read. If nothing follows before we
+ * next go idle, jshIdle sends the write on its own. */
+static struct {
+  unsigned char *data; ///< malloc'd copy of the data to write, or 0 if there's nothing held
+  uint16_t len;
+  unsigned char address;
+} i2cPendingWrite[ESPR_I2C_COUNT];
+
+/** Send any held write for this bus, followed by msg (if set), in one I2C_RDWR.
+ * Call with busMutex locked. Returns false on error */
+static bool jshI2CSendMessages(int bus, struct i2c_msg *msg) {
+  struct i2c_msg msgs[2];
+  unsigned int count = 0;
+  if (i2cPendingWrite[bus].data) {
+    msgs[count].addr = i2cPendingWrite[bus].address;
+    msgs[count].flags = 0;
+    msgs[count].len = i2cPendingWrite[bus].len;
+    msgs[count].buf = i2cPendingWrite[bus].data;
+    count++;
+  }
+  if (msg) msgs[count++] = *msg;
+  struct i2c_rdwr_ioctl_data data = { .msgs = msgs, .nmsgs = count };
+  bool ok = count==0 || ioctl(busFds[EV_I2C1+bus], I2C_RDWR, &data) >= 0;
+  free(i2cPendingWrite[bus].data);
+  i2cPendingWrite[bus].data = 0;
+  return ok;
+}
+
+/// Send any writes that are still being held for a repeated start
+static void jshI2CFlushPending() {
+  pthread_mutex_lock(&busMutex);
+  for (int bus=0;bus<ESPR_I2C_COUNT;bus++)
+    if (i2cPendingWrite[bus].data)
+      jshI2CSendMessages(bus, 0);
+  pthread_mutex_unlock(&busMutex);
+}
+#endif
+
 void jshI2CSetup(IOEventFlags device, JshI2CInfo *inf) {
+  assert(DEVICE_IS_I2C(device));
+#if defined(USE_LINUX_SPI_I2C) && ESPR_I2C_COUNT>=1
+  // anything held was for the old setup
+  pthread_mutex_lock(&busMutex);
+  int bus = device - EV_I2C1;
+  free(i2cPendingWrite[bus].data);
+  i2cPendingWrite[bus].data = 0;
+  pthread_mutex_unlock(&busMutex);
+#endif
+  jshBusOpen(device);
+}
+
+static void jshI2CTransfer(JshBusTransfer *t) {
+  pthread_mutex_lock(&busMutex);
+#if defined(USE_LINUX_SPI_I2C) && ESPR_I2C_COUNT>=1
+  if (busFds[t->device]>=0) {
+    int bus = t->device - EV_I2C1;
+    if (!t->isRead && !t->sendStop && !i2cPendingWrite[bus].data && t->count>0) {
+      // hold this write back so it's sent along with the next transfer
+      unsigned char *copy = (unsigned char*)malloc((size_t)t->count);
+      if (copy) {
+        memcpy(copy, t->tx, (size_t)t->count);
+        i2cPendingWrite[bus].data = copy;
+        i2cPendingWrite[bus].len = (uint16_t)t->count;
+        i2cPendingWrite[bus].address = t->address;
+        pthread_mutex_unlock(&busMutex);
+        return;
+      }
+    }
+    struct i2c_msg msg;
+    msg.addr = t->address;
+    msg.flags = t->isRead ? I2C_M_RD : 0;
+    msg.len = (uint16_t)t->count;
+    msg.buf = t->isRead ? t->rx : t->tx;
+    if (!jshI2CSendMessages(bus, &msg) && t->isRead)
+      memset(t->rx, 0xFF, (size_t)t->count);
+  } else
+#endif
+  {
+#if ESPR_I2C_COUNT>=1
+    int bus = t->device - EV_I2C1;
+    int i = 0;
+    if (!t->isRead && t->count>0)
+      i2cSimAddr[bus] = t->tx[i++];
+    for (;i<t->count;i++) {
+      if (t->isRead) t->rx[i] = i2cSimMemory[bus][i2cSimAddr[bus]++];
+      else i2cSimMemory[bus][i2cSimAddr[bus]++] = t->tx[i];
+    }
+#endif
+  }
+  pthread_mutex_unlock(&busMutex);
 }
 
 void jshI2CWrite(IOEventFlags device, unsigned char address, int nBytes, const unsigned char *data, bool sendStop) {
+  JshBusTransfer t = { .device=device, .tx=(unsigned char*)data, .count=nBytes, .address=address, .isRead=false, .sendStop=sendStop };
+  jshI2CTransfer(&t);
 }
 
 void jshI2CRead(IOEventFlags device, unsigned char address, int nBytes, unsigned char *data, bool sendStop) {
+  JshBusTransfer t = { .device=device, .rx=data, .count=nBytes, .address=address, .isRead=true, .sendStop=sendStop };
+  jshI2CTransfer(&t);
+}
+
+bool jshI2CWriteAsync(IOEventFlags device, unsigned char address, int nBytes, const unsigned char *data, bool sendStop, void (*callback)()) {
+  JshBusTransfer t = { .device=device, .tx=(unsigned char*)data, .count=nBytes, .address=address, .isRead=false, .sendStop=sendStop, .callback=callback };
+  return jshBusTransferAsync(&t);
+}
+
+bool jshI2CReadAsync(IOEventFlags device, unsigned char address, int nBytes, unsigned char *data, bool sendStop, void (*callback)()) {
+  JshBusTransfer t = { .device=device, .rx=data, .count=nBytes, .address=address, .isRead=true, .sendStop=sendStop, .callback=callback };
+  return jshBusTransferAsync(&t);
 }
 
 /// Enter simple sleep mode (can be woken up by interrupts). Returns true on success
 bool jshSleep(JsSysTime timeUntilWake) {
-  bool hasWatches = false;
-#ifdef SYSFS_GPIO_DIR
-  Pin pin;
-  for (pin=0;pin<JSH_PIN_COUNT;pin++)
-    if (gpioShouldWatch[pin]) hasWatches = true;
-#endif
-
-  JsVarFloat usecfloat = jshGetMillisecondsFromTime(timeUntilWake)*1000;
-  unsigned int usecs = (usecfloat < 0xFFFFFFFF) ? (unsigned int)usecfloat : 0xFFFFFFFF;
-  if (hasWatches && usecs>1000)
-    usecs=1000; // don't sleep much if we have watches - we need to keep polling them
-  if (usecs > 50000)
-    usecs = 50000; // don't want to sleep too much (user input/HTTP/etc)
-  if (usecs >= 1000)
-    jshDelayMicroseconds(usecs);
+  /* The input thread wakes us when it has pushed events (console, devices
+   * and pin watches), and sockets are registered with jshLinuxWatchFd, so
+   * we can sleep right up until the next timer */
+  JsVarFloat ms = jshGetMillisecondsFromTime(timeUntilWake);
+#ifdef USE_SDL
+  if (ms > 50) ms = 50; // SDL events have to be polled
+#endif
+#ifndef __MINGW32__
+  if (ms > 10 && !jshLinuxSleepForConsole && !watchedFdCount)
+    ms = 10; // only the console could wake us, so come back and check if we're finished
+#endif
+  if (utilTimerActive) {
+    JsVarFloat utilMs = jshGetMillisecondsFromTime(utilTimerDue - jshGetSystemTime());
+    if (utilMs < ms) ms = utilMs;
+  }
+  if (ms >= 1)
+    jshLinuxWaitFds((ms < 0x7FFFFFFF) ? (int)ms : -1);
+  jshUtilTimerPoll();
   return true;
 }
 
 void jshUtilTimerDisable() {
+  utilTimerActive = false;
 }
 
+/// Called from the utility timer 'interrupt' - period is relative to when it fired
 void jshUtilTimerReschedule(JsSysTime period) {
+  utilTimerDue += period;
+  utilTimerActive = true;
 }
 
 void jshUtilTimerStart(JsSysTime period) {
+  utilTimerDue = jshGetSystemTime() + period;
+  utilTimerActive = true;
 }
 
 JshPinFunction jshGetCurrentPinFunction(Pin pin) {
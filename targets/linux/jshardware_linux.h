@@ -0,0 +1,43 @@
+/*
+ * This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+ *
+ * Copyright (C) 2013 Gordon Williams <gw@pur3.co.uk>
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * ----------------------------------------------------------------------------
+ * Linux-specific parts of the Hardware interface Layer
+ *
+ * File descriptors (eg. sockets) can be registered here so that jshSleep
+ * wakes up as soon as any of them are ready, rather than polling. Uses
+ * epoll where available, and poll otherwise. Only to be used from the main
+ * (JS) thread.
+ * ----------------------------------------------------------------------------
+ */
+#ifndef JSHARDWARE_LINUX_H_
+#define JSHARDWARE_LINUX_H_
+
+#include <stdbool.h>
+
+#define JSH_LINUX_FD_READ  1 ///< wake when the fd has data to read (or has closed/errored)
+#define JSH_LINUX_FD_WRITE 2 ///< wake (once) when the fd can be written to
+
+/// Start/stop watching an fd. events is JSH_LINUX_FD_READ|JSH_LINUX_FD_WRITE, or 0 to stop watching
+void jshLinuxWatchFd(int fd, int events);
+/// Add JSH_LINUX_FD_WRITE to the events for an fd we're already watching (it's removed again after the fd is writable)
+void jshLinuxWatchFdWrite(int fd);
+/** Return the events that were ready for this fd the last time jshLinuxWaitFds was
+ * called, or -1 if the fd isn't being watched */
+int jshLinuxGetFdReady(int fd);
+/** Wait for up to timeoutMs (-1 = forever) for any watched fd to be ready, or for
+ * the input thread to push an event. Updates the values returned by jshLinuxGetFdReady */
+void jshLinuxWaitFds(int timeoutMs);
+
+/** If false, jshSleep won't wait indefinitely when only console input could
+ * wake it up (no timers or watched fds). Cleared when running a script to
+ * completion, so we get back to checking whether we're done */
+extern bool jshLinuxSleepForConsole;
+
+#endif /* JSHARDWARE_LINUX_H_ */
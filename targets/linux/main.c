@@ -16,6 +16,11 @@
 #include "jsinteractive.h"
 #include "jswrapper.h"
 #include "jsflags.h"
+#include "jshardware_linux.h"
+#include "jswrap_pipe.h"
+#ifdef USE_NET
+#include "socketserver.h"
+#endif
 
 #ifdef ESPR_JIT
 #include "jsjit.h"
@@ -134,6 +139,21 @@ void nativeQuit() { isRunning = false; }
 
 void nativeInterrupt() { jspSetInterrupted(true); }
 
+/// After running code, should we keep going around the idle loop?
+static bool shouldKeepRunning(bool isBusy) {
+  jshLinuxSleepForConsole = false; // don't wait for console input, we're just running code
+  if (jsiHasTimers() || isBusy) return true;
+#ifndef SAVE_ON_FLASH
+  // neither are pipes waiting for space in a Serial transmit buffer
+  if (jswrap_pipe_isWaitingForTransmit()) return true;
+#endif
+#ifdef USE_NET
+  // sockets don't keep us busy while they're waiting for data, so check them explicitly
+  if (socketHasConnections()) return true;
+#endif
+  return false;
+}
+
 static char *read_file(const char *filename) {
   FILE *f;
   char *buf;
@@ -194,7 +214,7 @@ bool run_test(const char *filename) {
 
   isRunning = true;
   bool isBusy = true;
-  while (isRunning && (jsiHasTimers() || isBusy))
+  while (isRunning && shouldKeepRunning(isBusy))
     isBusy = jsiLoop();
 
   JsVar *result = jsvObjectGetChildIfExists(execInfo.root, "result");
@@ -369,6 +389,7 @@ void show_help() {
   warning(
       "   --telnet                Enable internal telnet server on port 2323");
 #endif
+  warning("   --iobuffer n            Set the size of the IO event queue (in events)");
   warning("   --test-all              Run all tests (in 'tests' directory)");
   warning("   --test-dir dir          Run all tests in directory 'dir'");
   warning("   --test test.js          Run the supplied test");
@@ -432,7 +453,7 @@ int main(int argc, char **argv) {
         int errCode = handleErrors();
         isRunning = !errCode;
         bool isBusy = true;
-        while (isRunning && (jsiHasTimers() || isBusy))
+        while (isRunning && shouldKeepRunning(isBusy))
           isBusy = jsiLoop();
         jsiKill();
         jsvKill();
@@ -443,6 +464,10 @@ int main(int argc, char **argv) {
         extern bool telnetEnabled;
         telnetEnabled = true;
 #endif
+      } else if (!strcmp(a, "--iobuffer")) {
+        if (i + 1 >= argc)
+          fatal(1, "Expecting an extra argument");
+        jshSetIOEventQueueSize((unsigned int)atoi(argv[++i]));
       } else if (!strcmp(a, "--test")) {
         bool ok;
         if (i + 1 >= argc) {
@@ -519,7 +544,7 @@ int main(int argc, char **argv) {
     free(buffer);
     isRunning = !errCode;
     bool isBusy = true;
-    while (isRunning && (jsiHasTimers() || isBusy))
+    while (isRunning && shouldKeepRunning(isBusy))
       isBusy = jsiLoop();
     jsiKill();
     jsvKill();
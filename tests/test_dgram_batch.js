@@ -0,0 +1,59 @@
+// Lots of small UDP packets sent at once should all arrive (in order), both
+// as separate 'message' events and as one 'messages' batch, and ArrayBuffers
+// can be sent directly
+
+var result = 0;
+var dgram = require('dgram');
+var ok = true;
+var N = 40;
+
+var got = [];
+var srv = dgram.createSocket('udp4');
+srv.bind(8092, function(bsrv) {
+  bsrv.on('message', function(msg, info) {
+    got.push(msg);
+  });
+});
+
+var batches = 0, batched = [];
+var bsrv = dgram.createSocket({ type:'udp4', batch:true });
+bsrv.bind(8093, function() {
+  bsrv.on('messages', function(data, info) {
+    batches++;
+    for (var i=0;i<info.length;i+=4) {
+      if (info[i+2]!=0x0100007F) { console.log("address", info[i+2].toString(16)); ok = false; }
+      batched.push(E.toString(new Uint8Array(data, info[i], info[i+1])));
+    }
+  });
+});
+
+var client = dgram.createSocket('udp4');
+for (var i=0;i<N;i++) {
+  client.send("msg"+i, 8092, 'localhost');
+  client.send("msg"+i, 8093, 'localhost');
+}
+var buf = new Uint8Array([0,65,66,67,0]);
+client.send(buf.buffer, 1, 3, 8093, 'localhost'); // part of an ArrayBuffer
+client.send(new Uint8Array([68,69]), 8093, 'localhost'); // a typed array
+
+setTimeout(function() {
+  var expected = [];
+  for (var i=0;i<N;i++) expected.push("msg"+i);
+  if (got.join()!=expected.join()) {
+    console.log("message", got.join());
+    ok = false;
+  }
+  expected.push("ABC", "DE");
+  if (batched.join()!=expected.join()) {
+    console.log("messages", batched.join());
+    ok = false;
+  }
+  if (!batches || batches >= N) { // should have been batched up
+    console.log("batches", batches);
+    ok = false;
+  }
+  srv.close();
+  bsrv.close();
+  client.close();
+  result = ok;
+}, 500);
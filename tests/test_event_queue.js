@@ -0,0 +1,45 @@
+// A burst of queued events (more than fit in the native event queue, and
+// with more args than fit inline) must run in order with the right
+// arguments, even if GC or defrag happens while they're queued
+
+var result = 0;
+var ok = true;
+var got = [];
+var o = {};
+o.on('ev', function() {
+  got.push(JSON.stringify([].slice.call(arguments)));
+});
+
+var expected = [];
+for (var i=0;i<100;i++) {
+  var args = [];
+  // objects/strings that are only referenced from the queue
+  for (var a=0;a<i%5;a++) args.push(a&1 ? {n:i, a:a} : "s"+i+"_"+a);
+  expected.push(JSON.stringify(args));
+  o.emit.apply(o, ['ev'].concat(args));
+  if (i==50) {
+    var m = process.memory();
+    if (m.events!=51) { console.log("events", m.events); ok = false; }
+    E.defrag();
+  }
+}
+
+var before = process.memory();
+setTimeout(function() {
+  if (got.length!=expected.length) {
+    console.log("got", got.length, "events, expected", expected.length);
+    ok = false;
+  }
+  for (var i=0;i<expected.length;i++)
+    if (got[i]!=expected[i]) {
+      console.log("event", i, "got", got[i], "expected", expected[i]);
+      ok = false;
+      break;
+    }
+  var m = process.memory();
+  if (before.events!=100 || m.events!=0 || m.eventsMax<100 || m.eventsDropped) {
+    console.log("stats", before.events, m.events, m.eventsMax, m.eventsDropped);
+    ok = false;
+  }
+  result = ok;
+}, 10);
@@ -0,0 +1,64 @@
+// Check the in-memory drawImage fast path (row copy/palette expansion) gives
+// the same result as drawing pixel by pixel. zigzag buffers aren't flat, so
+// they always take the slow path and act as a reference.
+
+var ok = true;
+var seed = 1;
+function rnd(n) {
+  seed = (seed*1103515245 + 12345) & 0x7FFFFFFF;
+  return (seed>>8) % n;
+}
+
+function makeImage(w,h,bpp,opts) {
+  var b = new Uint8Array((w*h*bpp+7)>>3);
+  for (var i=0;i<b.length;i++) b[i] = rnd(256);
+  var img = { width:w, height:h, bpp:bpp, buffer:b.buffer };
+  if (opts.transparent!==undefined) img.transparent = opts.transparent;
+  if (opts.palette) {
+    var p = new Uint16Array(1<<bpp);
+    for (var i=0;i<p.length;i++) p[i] = (i*7+3)&((1<<opts.gbpp)-1);
+    img.palette = p;
+  }
+  return img;
+}
+
+function check(gbpp, bpp, opts) {
+  var W = 37, H = 23;
+  var fast = Graphics.createArrayBuffer(W,H,gbpp,{msb:true});
+  var slow = Graphics.createArrayBuffer(W,H,gbpp,{msb:true,zigzag:true});
+  [fast,slow].forEach(g=>{g.setBgColor(0).setColor(-1);g.clear();});
+  if (opts.clip) {
+    fast.setClipRect(3,2,30,19);
+    slow.setClipRect(3,2,30,19);
+  }
+  for (var n=0;n<6;n++) {
+    var img = makeImage(1+rnd(30),1+rnd(20),bpp,opts);
+    var x = rnd(W+10)-10, y = rnd(H+10)-10;
+    fast.drawImage(img,x,y);
+    slow.drawImage(img,x,y);
+  }
+  for (var y=0;y<H;y++)
+    for (var x=0;x<W;x++)
+      if (fast.getPixel(x,y)!=slow.getPixel(x,y)) {
+        console.log("Mismatch",gbpp,bpp,JSON.stringify(opts),"at",x,y,fast.getPixel(x,y),slow.getPixel(x,y));
+        ok = false;
+        return;
+      }
+}
+
+[1,2,4,8,16].forEach(gbpp=>{
+  [1,2,4,8,16].forEach(bpp=>{
+    if (bpp>gbpp) return;
+    check(gbpp,bpp,{gbpp:gbpp});
+    check(gbpp,bpp,{gbpp:gbpp,clip:true});
+    check(gbpp,bpp,{gbpp:gbpp,transparent:1});
+    if (bpp<=2) check(gbpp,bpp,{gbpp:gbpp,palette:true});
+  });
+});
+
+// 16 bit graphics with an MSB flat buffer is big endian, like Images
+var g = Graphics.createArrayBuffer(4,1,16,{msb:true});
+g.drawImage({width:2,height:1,bpp:16,buffer:new Uint8Array([0x12,0x34,0x56,0x78]).buffer},1,0);
+if (g.getPixel(1,0)!=0x1234 || g.getPixel(2,0)!=0x5678) ok = false;
+
+result = ok;
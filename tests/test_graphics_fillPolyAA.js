@@ -0,0 +1,62 @@
+// Check polygons with lots of points, and antialiased polygon fill
+var ok = true;
+function SHOULD_BE(a,b,msg) {
+  if (a!=b) {
+    console.log(msg+" GOT :"+a+", SHOULD BE:"+b);
+    ok = false;
+  }
+}
+
+var g = Graphics.createArrayBuffer(64,64,8);
+function count(fn) {
+  var n = 0;
+  for (var y=0;y<g.getHeight();y++)
+    for (var x=0;x<g.getWidth();x++)
+      if (fn(g.getPixel(x,y))) n++;
+  return n;
+}
+
+// more than 64 points (and crossings) is fine
+var p = [];
+for (var i=0;i<200;i++) {
+  p.push(i&1 ? 63 : 60, i*64/200);
+  p.push(i&1 ? 63 : 60, (i+1)*64/200);
+}
+p.push(0,64,0,0);
+g.clear().setColor(255).fillPoly(p);
+SHOULD_BE(count(c=>c==255)>=60*64, true, "fillPoly 200 points");
+// comb with lots of crossings on one scanline
+var wide = Graphics.createArrayBuffer(256,8,8);
+p = [0,8];
+for (var i=0;i<100;i++) p.push(i*2,0, i*2+1,0, i*2+1,4, i*2+2,4);
+p.push(200,8);
+wide.setColor(255).fillPoly(p);
+var n = 0;
+for (var x=0;x<256;x++) n += (wide.getPixel(x,2)?1:0) + (wide.getPixel(x,6)?1:0)*1000;
+SHOULD_BE(n, 200*1000 + 100, "fillPoly comb");
+
+// pixel-aligned polygons fill exactly the same as fillPoly
+g.clear().fillPoly([10,10,30,10,30,20,10,20]);
+var solid = count(c=>c==255);
+g.clear().fillPolyAA([10,10,30,10,30,20,10,20]);
+SHOULD_BE(count(c=>c==255), solid, "fillPolyAA aligned");
+SHOULD_BE(count(c=>c!=0 && c!=255), 0, "fillPolyAA aligned partial");
+
+// half pixel offset gives half-covered edges
+g.clear().fillPolyAA([10.5,10,30,10,30,20,10.5,20]);
+SHOULD_BE(g.getPixel(10,15), 127, "fillPolyAA half pixel");
+SHOULD_BE(g.getPixel(11,15), 255, "fillPolyAA inside");
+SHOULD_BE(g.getPixel(9,15), 0, "fillPolyAA outside");
+
+// a slanted triangle has partially covered pixels, and blends from the background
+g.setBgColor(0).clear().fillPolyAA([0,0,63,20,0,40]);
+SHOULD_BE(count(c=>c!=0 && c!=255)>40, true, "fillPolyAA slanted partial");
+SHOULD_BE(g.getPixel(5,20), 255, "fillPolyAA slanted inside");
+SHOULD_BE(g.getPixel(62,40), 0, "fillPolyAA slanted outside");
+
+// clipped to screen/clip rect
+g.clear().setClipRect(20,20,40,40).fillPolyAA([-100,-100,200,-50,200,200,-50,200]);
+SHOULD_BE(count(c=>c!=0), 21*21, "fillPolyAA clip");
+g.setClipRect(0,0,63,63);
+
+result = ok;
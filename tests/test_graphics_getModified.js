@@ -0,0 +1,47 @@
+// Check modified areas are tracked as separate rectangles
+var g = Graphics.createArrayBuffer(64,64,8);
+var ok = true;
+function SHOULD_BE(a,b) {
+  var as = JSON.stringify(a), bs = JSON.stringify(b);
+  if (as!=bs) {
+    console.log("GOT :"+as+"\nSHOULD BE:"+bs);
+    ok = false;
+  }
+}
+
+g.getModified(true);
+SHOULD_BE(g.getModified(false,true), []);
+SHOULD_BE(g.getModified(), undefined);
+
+// two small changes in opposite corners stay separate
+g.fillRect(1,1,3,3);
+g.setPixel(60,60);
+SHOULD_BE(g.getModified(), {x1:1,y1:1,x2:60,y2:60});
+SHOULD_BE(g.getModified(true,true), [{x1:1,y1:1,x2:3,y2:3},{x1:60,y1:60,x2:60,y2:60}]);
+SHOULD_BE(g.getModified(false,true), []);
+
+// a line drawn pixel by pixel ends up as one area
+g.drawLine(10,10,20,20);
+SHOULD_BE(g.getModified(true,true), [{x1:10,y1:10,x2:20,y2:20}]);
+
+// touching areas are merged
+g.fillRect(0,0,9,9);
+g.fillRect(10,0,19,9);
+g.fillRect(40,40,45,45);
+SHOULD_BE(g.getModified(true,true), [{x1:0,y1:0,x2:19,y2:9},{x1:40,y1:40,x2:45,y2:45}]);
+
+// if there are too many, the closest get merged
+g.setPixel(0,0);
+g.setPixel(63,0);
+g.setPixel(0,63);
+g.setPixel(63,63);
+g.setPixel(60,62);
+var l = g.getModified(true,true);
+SHOULD_BE(l.length, 4);
+SHOULD_BE(l.filter(r=>r.x1==60 && r.y1==62 && r.x2==63 && r.y2==63).length, 1);
+
+// offscreen drawing doesn't add anything
+g.fillRect(-10,-10,-5,-5);
+SHOULD_BE(g.getModified(true,true), []);
+
+result = ok;
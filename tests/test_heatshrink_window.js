@@ -0,0 +1,29 @@
+// heatshrink with non-default window/lookahead sizes
+var hs = require("heatshrink");
+var source = "";
+for (var i=0;i<1000;i++) source += String.fromCharCode((i*i*7)&255) + (i%13?"":"Hello World ");
+var ok = true;
+function check(options) {
+  var c = hs.compress(source, options);
+  if (E.toString(hs.decompress(c)) != source) {
+    console.log("Failed", options);
+    ok = false;
+  }
+  return new Uint8Array(c);
+}
+// default sizes don't add a header - data starting with zeros gives a backreference
+check({window:8,lookahead:6});
+if (new Uint8Array(hs.compress("\0\0\0\0\0\0abc"))[0] != 0) ok = false;
+if (E.CRC32(hs.compress(source)) != E.CRC32(hs.compress(source,{window:8,lookahead:6}))) ok = false;
+// others do
+if (check({window:4,lookahead:3})[0] != ((4<<3)|0)) ok = false;
+if (check({window:6,lookahead:5})[0] != ((6<<3)|2)) ok = false;
+check({window:7});
+// small windows with no lookahead given use window-1
+if (check({window:4})[0] != ((4<<3)|0)) ok = false;
+if (check({window:6})[0] != ((6<<3)|2)) ok = false;
+// bad sizes throw an error
+try { hs.compress(source, {window:3}); ok = false; } catch (e) {}
+try { hs.compress(source, {window:6,lookahead:6}); ok = false; } catch (e) {}
+
+result = ok;
@@ -0,0 +1,71 @@
+// HTTP request and chunked response that arrive split up in awkward places
+// (mid-line, mid-CRLF, mid chunk size) must still be parsed correctly
+
+var result = 0;
+var http = require("http");
+var net = require("net");
+var ok = true;
+
+function sendInPieces(sock, pieces, done) {
+  var i = 0;
+  function next() {
+    sock.write(pieces[i++]);
+    if (i<pieces.length) setTimeout(next, 20);
+    else if (done) done();
+  }
+  next();
+}
+
+// HTTP server, fed by a raw socket
+var server = http.createServer(function (req, res) {
+  var body = "";
+  req.on('data', function(d) { body += d; });
+  req.on('end', function() {
+    if (req.method!="POST" || req.url!="/a/b?c=d" ||
+        req.headers["X-One"]!="1" || req.headers["X-Two"]!="two words" || body!="Hello World!") {
+      console.log("Server got", req.method, req.url, JSON.stringify(req.headers), JSON.stringify(body));
+      ok = false;
+    }
+    res.end("ok");
+  });
+});
+server.listen(8083);
+
+var reply = "";
+var client = net.connect({port: 8083}, function() {
+  client.on('data', function(d) { reply += d; });
+  sendInPieces(client, [
+    "PO", "ST /a/b?c=d HT", "TP/1.1\r", "\nX-One: 1\r\nX-Tw", "o:   two words\r\n",
+    "Transfer-Encoding: chunked\r\n\r", "\n5\r", "\nHello\r\n", "1", "\r\n \r\n6;ext=1\r\nWorld!",
+    "\r\n0\r\n\r\n"]);
+});
+
+// raw server, read by the HTTP client
+var rawServer = net.createServer(function(c) {
+  sendInPieces(c, [
+    "HTTP/1.1 200 OK\r\nTransfer-Encoding: chu", "nked\r\nX-Resp: yes\r\n", "\r\n",
+    "3\r\nabc\r\n1", "0\r\n0123456789", "abcdef\r", "\n0\r\n\r\n"], function() {
+    setTimeout(function() { c.end(); }, 20);
+  });
+});
+rawServer.listen(8084);
+
+http.get("http://localhost:8084/", function(res) {
+  var body = "";
+  res.on('data', function(d) { body += d; });
+  res.on('close', function() {
+    if (res.statusCode!="200" || res.statusMessage!="OK" || res.headers["X-Resp"]!="yes" || body!="abc0123456789abcdef") {
+      console.log("Client got", res.statusCode, res.statusMessage, JSON.stringify(res.headers), JSON.stringify(body));
+      ok = false;
+    }
+    setTimeout(function() {
+      if (reply.indexOf("\r\n\r\nok")<0) {
+        console.log("Raw client got", JSON.stringify(reply));
+        ok = false;
+      }
+      server.close();
+      rawServer.close();
+      result = ok;
+    }, 200);
+  });
+});
@@ -0,0 +1,23 @@
+// HTTP server that sits idle for a while before a request arrives, and
+// replies later from a timeout - the interpreter must sleep and then wake
+// up for both
+
+var result = 0;
+var http = require("http");
+
+var server = http.createServer(function (req, res) {
+  setTimeout(function() {
+    res.writeHead(200, {'Content-Type': 'text/plain'});
+    res.end('42');
+  }, 100);
+});
+server.listen(8081);
+
+setTimeout(function() {
+  http.get("http://localhost:8081/", function(res) {
+    res.on('data', function(data) {
+      result = data=="42";
+      server.close();
+    });
+  });
+}, 200);
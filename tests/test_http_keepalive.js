@@ -0,0 +1,72 @@
+// HTTP client requests with keepAlive:true should reuse the connection for
+// the next request to the same server, unless the server closes it
+
+var result = 0;
+var http = require("http");
+var net = require("net");
+var ok = true;
+var connections = 0, requests = 0;
+
+// raw server that answers any number of requests on each connection
+var rawServer = net.createServer(function(c) {
+  connections++;
+  var data = "";
+  c.on('data', function(d) {
+    data += d;
+    var end;
+    while ((end = data.indexOf("\r\n\r\n"))>=0) {
+      var req = data.substr(0,end);
+      data = data.substr(end+4);
+      requests++;
+      if (req.indexOf("Connection: keep-alive")<0) {
+        console.log("Request without keep-alive", JSON.stringify(req));
+        ok = false;
+      }
+      if (req.indexOf("/close")>0) {
+        c.write("HTTP/1.1 200 OK\r\nContent-Length: 5\r\nConnection: close\r\n\r\nclose");
+      } else if (req.indexOf("/chunked")>0) {
+        c.write("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n0\r\n\r\n");
+      } else {
+        c.write("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello");
+      }
+    }
+  });
+});
+rawServer.listen(8085);
+
+function get(path, expected, callback) {
+  http.get({host:"localhost", port:8085, path:path, keepAlive:true, keepAliveTimeout:100}, function(res) {
+    var body = "";
+    res.on('data', function(d) { body += d; });
+    res.on('close', function() {
+      if (body!=expected) {
+        console.log(path, "got", JSON.stringify(body));
+        ok = false;
+      }
+      callback();
+    });
+  });
+}
+
+function check(c, r, msg) {
+  if (connections!=c || requests!=r) {
+    console.log(msg, "connections", connections, "requests", requests);
+    ok = false;
+  }
+}
+
+get("/a", "hello", function() {
+  get("/b", "hello", function() {
+    get("/chunked", "abc", function() {
+      check(1, 3, "after reuse");
+      // server says 'close', so the next request needs a new connection
+      get("/close", "close", function() {
+        get("/c", "hello", function() {
+          check(2, 5, "after close");
+          rawServer.close();
+          result = ok;
+        });
+      });
+    });
+  });
+});
@@ -0,0 +1,54 @@
+// HTTP server sending big responses made from a mix of normal, flat and
+// native strings plus lots of small writes - everything must arrive in order
+
+var result = 0;
+var http = require("http");
+
+function pattern(n, seed) {
+  var s = "";
+  for (var i=0;i<n;i++) s += String.fromCharCode(33+((i*7+seed)%90));
+  return s;
+}
+var normal = pattern(6000, 1); // a normal string
+var flat = E.toString(new Uint8Array(E.toUint8Array(pattern(7000, 2)))); // a flat string
+var small = pattern(20, 3);
+require("Storage").write("bigresp", pattern(5000, 4));
+var file = require("Storage").read("bigresp"); // memory mapped on most devices
+var native = E.memoryArea(E.getAddressOf(flat,true)+100, 3000); // native string
+var expected = "start"+normal+flat+file+native;
+for (var i=0;i<50;i++) expected += small;
+expected += "end";
+
+var server = http.createServer(function (req, res) {
+  var chunked = req.url=="/chunked";
+  res.writeHead(200, chunked ? {'Transfer-Encoding': 'chunked'} : {'Content-Length': expected.length});
+  res.write("start");
+  res.write(normal);
+  res.write(flat);
+  res.write(file);
+  res.write(native);
+  for (var i=0;i<50;i++) res.write(small);
+  res.end("end");
+});
+server.listen(8082);
+
+var done = 0, ok = true;
+function get(path) {
+  http.get("http://localhost:8082"+path, function(res) {
+    var body = "";
+    res.on('data', function(data) { body += data; });
+    res.on('close', function() {
+      if (body!=expected) {
+        console.log(path, "got", body.length, "expected", expected.length);
+        ok = false;
+      }
+      if (++done==2) {
+        server.close();
+        require("Storage").erase("bigresp");
+        result = ok;
+      }
+    });
+  });
+}
+get("/");
+get("/chunked");
@@ -0,0 +1,87 @@
+// HTTP server sending files straight from Storage with res.sendFile, with
+// gzipped variants (with or without the plain file), ETags and 404s, including
+// names too long for Storage and a long Accept-Encoding header
+var result = 0;
+var http = require("http");
+var storage = require("Storage");
+var ok = true;
+
+function pattern(n) {
+  var s = "";
+  for (var i=0;i<n;i++) s += String.fromCharCode(33+((i*7)%90));
+  return s;
+}
+var page = "<html>"+pattern(5000)+"</html>";
+storage.write("index.html", page);
+storage.write("app.js", "console.log('hello')");
+storage.write("app.js.gz", "\x1f\x8b\x08\x00gzipped");
+storage.write("style.css.gz", "\x1f\x8b\x08\x00css"); // only stored gzipped
+var longName = "abcdefghijklmnopqrstuvwx.txt"; // as long as a Storage filename can be
+storage.write(longName, "long");
+
+var server = http.createServer(function (req, res) {
+  res.sendFile(req.url.substr(1), {"Cache-Control":"max-age=60"});
+});
+server.listen(8089);
+
+function get(path, headers, callback) {
+  http.get({host:"localhost", port:8089, path:path, headers:headers}, function(res) {
+    var body = "";
+    res.on('data', function(d) { body += d; });
+    res.on('close', function() { callback(res, body); });
+  });
+}
+function check(what, got, expected) {
+  if (got!==expected) {
+    console.log(what, "got", JSON.stringify(got), "expected", JSON.stringify(expected));
+    ok = false;
+  }
+}
+
+get("/index.html", {}, function(res, body) {
+  check("page", body, page);
+  check("type", res.headers["Content-Type"], "text/html");
+  check("cache", res.headers["Cache-Control"], "max-age=60");
+  var etag = res.headers.ETag;
+  get("/index.html", {"If-None-Match":etag}, function(res, body) {
+    check("304", res.statusCode, "304");
+    check("304 body", body, "");
+    get("/app.js", {"Accept-Encoding":"gzip, deflate"}, function(res, body) {
+      check("gzip", body, "\x1f\x8b\x08\x00gzipped");
+      check("encoding", res.headers["Content-Encoding"], "gzip");
+      get("/app.js", {}, function(res, body) {
+        check("no gzip", body, "console.log('hello')");
+        check("no encoding", res.headers["Content-Encoding"], undefined);
+        get("/missing.txt", {}, function(res, body) {
+          check("404", res.statusCode, "404");
+          get("/style.css", {"Accept-Encoding":"gzip"}, function(res, body) {
+            check("gzip only", body, "\x1f\x8b\x08\x00css");
+            check("gzip only type", res.headers["Content-Type"], "text/css");
+            check("gzip only encoding", res.headers["Content-Encoding"], "gzip");
+            get("/style.css", {}, function(res, body) {
+              check("gzip only, not accepted", res.statusCode, "404");
+              var acceptEncoding = "";
+              for (var i=0;i<10;i++) acceptEncoding += "x-encoding-"+i+";q=0.5, ";
+              get("/app.js", {"Accept-Encoding":acceptEncoding+"gzip"}, function(res, body) {
+                check("gzip, long header", res.headers["Content-Encoding"], "gzip");
+                get("/"+longName, {}, function(res, body) {
+                  check("long name", body, "long");
+                  get("/"+longName+"xx", {}, function(res, body) {
+                    check("name too long", res.statusCode, "404");
+                    server.close();
+                    storage.erase("index.html");
+                    storage.erase("app.js");
+                    storage.erase("app.js.gz");
+                    storage.erase("style.css.gz");
+                    storage.erase(longName);
+                    result = ok;
+                  });
+                });
+              });
+            });
+          });
+        });
+      });
+    });
+  });
+});
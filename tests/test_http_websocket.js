@@ -0,0 +1,99 @@
+// Native WebSocket server and client exchanging text, binary, fragmented
+// and big messages, plus pings
+var result = 0;
+var http = require("http");
+var net = require("net");
+var ok = true;
+var log = [];
+
+function pattern(n) {
+  var s = "";
+  for (var i=0;i<n;i++) s += String.fromCharCode(33+((i*7)%90));
+  return s;
+}
+var big = pattern(70000); // needs a 64 bit length
+var medium = pattern(300); // needs a 16 bit length
+
+var server = http.createServer(function(req, res) {
+  res.end("not a websocket");
+});
+server.on('websocket', function(ws, req) {
+  log.push("server "+req.url);
+  ws.on('message', function(msg) {
+    if (msg instanceof ArrayBuffer) ws.send(new Uint8Array(msg).reverse().buffer);
+    else ws.send("echo:"+msg);
+  });
+});
+server.listen(8086);
+
+// raw client sending a masked message in two fragments
+function rawClient(done) {
+  var c = net.connect({port:8086}, function() {
+    var reply = "";
+    c.on('data', function(d) {
+      reply += d;
+      var i = reply.indexOf("\r\n\r\n");
+      if (i>=0 && reply.length>=i+4+9) {
+        var frame = reply.substr(i+4);
+        if (reply.indexOf("Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=")<0 ||
+            frame!="\x81\x07echo:ab") {
+          console.log("Raw client got", JSON.stringify(reply));
+          ok = false;
+        }
+        c.end();
+        done();
+      }
+    });
+    c.write("GET /raw HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"+
+            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n");
+    setTimeout(function() {
+      // "a" (not final) then "b" (final continuation), both masked with 1,2,3,4
+      c.write("\x01\x81\x01\x02\x03\x04"+String.fromCharCode(97^1)+
+              "\x80\x81\x01\x02\x03\x04"+String.fromCharCode(98^1));
+    }, 50);
+  });
+}
+
+function client() {
+  var replies = [];
+  var ws = http.connectWebSocket("ws://localhost:8086/a/b?c=1", function(w) {
+    log.push("open");
+    ws.send("hello");
+    ws.send(new Uint8Array([1,2,3]).buffer);
+    ws.send(medium);
+    ws.send(big);
+    ws.ping("p");
+  });
+  ws.on('pong', function(d) { log.push("pong "+d); });
+  ws.on('message', function(msg) {
+    replies.push(msg);
+    if (replies.length<4) return;
+    if (replies[0]!="echo:hello" ||
+        !(replies[1] instanceof ArrayBuffer) || new Uint8Array(replies[1]).join()!="3,2,1" ||
+        replies[2]!="echo:"+medium || replies[3]!="echo:"+big) {
+      console.log("Client got", replies.map(r=>(r instanceof ArrayBuffer)?"AB":r.length));
+      ok = false;
+    }
+    ws.close(1000);
+  });
+  ws.on('close', function() {
+    log.push("close");
+    rawClient(function() {
+      // normal HTTP requests still work
+      http.get("http://localhost:8086/", function(res) {
+        var body = "";
+        res.on('data', function(d) { body += d; });
+        res.on('close', function() {
+          if (body!="not a websocket") ok = false;
+          server.close();
+          if (log.join()!="server /a/b?c=1,open,pong p,close,server /raw") {
+            console.log("Log", log.join());
+            ok = false;
+          }
+          result = ok;
+        });
+      });
+    });
+  });
+}
+client();
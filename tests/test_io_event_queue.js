@@ -0,0 +1,33 @@
+// Lots of received data should go through the IO event queue in order and
+// without being dropped, and process.memory() should report the queue usage
+
+var result = 0;
+var ok = true;
+function check(a, b, msg) {
+  if (a!=b) {
+    console.log(msg, "got", JSON.stringify(a), "expected", JSON.stringify(b));
+    ok = false;
+  }
+}
+
+var m = process.memory();
+check(m.ioSize>0, true, "ioSize");
+check(m.ioUsed<=m.ioSize && m.ioMax<=m.ioSize, true, "ioUsed/ioMax in range");
+var dropped = m.ioDropped;
+
+var expected = "";
+for (var i=0;i<200;i++) expected += "Line "+i+" of the test data\n";
+var received = "";
+LoopbackB.on('data', function(d) { received += d; });
+// write in bits, so the queue holds many events from the same device
+for (i=0;i<expected.length;i+=50) LoopbackA.write(expected.substr(i,50));
+
+setTimeout(function() {
+  check(received.length, expected.length, "received length");
+  check(received==expected, true, "received data");
+  m = process.memory();
+  check(m.ioMax>0, true, "ioMax");
+  check(m.ioUsed, 0, "ioUsed after processing");
+  check(m.ioDropped, dropped, "ioDropped");
+  result = ok;
+}, 100);
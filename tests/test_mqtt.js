@@ -0,0 +1,101 @@
+// Native MQTT client against a minimal stand-in broker: QoS 0/1 publish and
+// subscribe, keepalive pings, and the offline queue (kept in Storage) being
+// sent after a reconnect and after the client is recreated
+var result = 0;
+var net = require("net");
+var storage = require("Storage");
+var ok = true;
+function SHOULD_BE(a,b,msg) {
+  if (JSON.stringify(a)!=JSON.stringify(b)) {
+    console.log(msg, "GOT", JSON.stringify(a), "SHOULD BE", JSON.stringify(b));
+    ok = false;
+  }
+}
+storage.erase("mqttq");
+
+var log = []; // what the broker got
+var ackPublish = true;
+var brokerSocket;
+var broker = net.createServer(function(c) {
+  brokerSocket = c;
+  var data = "";
+  c.on('data', function(d) {
+    data += d;
+    while (data.length>=2) {
+      var len = 0, mul = 1, i = 1, b;
+      do { b = data.charCodeAt(i++); len += (b&127)*mul; mul *= 128; } while (b&128);
+      if (data.length < i+len) break;
+      var type = data.charCodeAt(0), body = data.substr(i, len);
+      data = data.substr(i+len);
+      if ((type>>4)==1) { // CONNECT
+        log.push("CONNECT "+body.substr(12, body.charCodeAt(11)));
+        c.write("\x20\x02\x00\x00");
+      } else if ((type>>4)==3) { // PUBLISH
+        var qos = (type>>1)&3, tl = body.charCodeAt(1), topic = body.substr(2, tl);
+        var msg = body.substr(2+tl+(qos?2:0));
+        log.push("PUBLISH "+topic+" "+msg+" "+qos+((type&8)?" dup":""));
+        if (qos && ackPublish) c.write("\x40\x02"+body.substr(2+tl, 2));
+        if (topic=="t/echo") // echo to the subscriber with QoS 1
+          c.write("\x32"+String.fromCharCode(4+tl+msg.length)+body.substr(0,2+tl)+"\x12\x34"+msg);
+      } else if ((type>>4)==4) { // PUBACK
+        log.push("PUBACK "+(body.charCodeAt(0)*256+body.charCodeAt(1)).toString(16));
+      } else if ((type>>4)==8) { // SUBSCRIBE
+        log.push("SUBSCRIBE "+body.substr(4, body.charCodeAt(3))+" "+body.charCodeAt(body.length-1));
+        c.write("\x90\x03"+body.substr(0,2)+"\x01");
+      } else if ((type>>4)==12) { // PINGREQ
+        if (log[log.length-1]!="PINGREQ") log.push("PINGREQ");
+        c.write("\xD0\x00");
+      } else if ((type>>4)==14) { // DISCONNECT
+        log.push("DISCONNECT");
+      }
+    }
+  });
+});
+broker.listen(8088);
+
+var received = [];
+var mqtt = require("MQTT").create("localhost", {port:8088, client_id:"test", keep_alive:1, queue:"mqttq"});
+// published while offline - queued in Storage until we connect
+mqtt.publish("t/offline", "a");
+SHOULD_BE(storage.read("mqttq")!==undefined, true, "queued offline");
+mqtt.on('message', function(topic, message) { received.push(topic+" "+message); });
+mqtt.on('subscribed', function() {
+  mqtt.publish("t/echo", "hi", {qos:1});
+});
+mqtt.on('connected', function() {
+  SHOULD_BE(mqtt.connected, true, "connected");
+  mqtt.subscribe("t/#", {qos:1});
+  setTimeout(step2, 1200); // long enough for a keepalive ping
+});
+mqtt.connect();
+
+function step2() {
+  SHOULD_BE(received, ["t/echo hi"], "received");
+  SHOULD_BE(storage.read("mqttq"), undefined, "queue empty once all acknowledged");
+  // now the broker doesn't acknowledge, and drops the connection
+  ackPublish = false;
+  mqtt.publish("t/noack", "x", {qos:1});
+  mqtt.on('disconnected', function() {
+    SHOULD_BE(mqtt.connected, false, "disconnected");
+    SHOULD_BE(storage.read("mqttq")!==undefined, true, "unacknowledged kept in Storage");
+    // a new client (eg. after a reboot) picks the message up from Storage
+    ackPublish = true;
+    var mqtt2 = require("MQTT").create("localhost", {port:8088, client_id:"test2", queue:"mqttq"});
+    mqtt2.on('connected', function() {
+      setTimeout(function() {
+        mqtt2.disconnect();
+      }, 100);
+    });
+    mqtt2.on('disconnected', function() {
+      broker.close();
+      SHOULD_BE(storage.read("mqttq"), undefined, "queue empty at end");
+      SHOULD_BE(log, ["CONNECT test", "PUBLISH t/offline a 0", "SUBSCRIBE t/# 1",
+                      "PUBLISH t/echo hi 1", "PUBACK 1234", "PINGREQ",
+                      "PUBLISH t/noack x 1",
+                      "CONNECT test2", "PUBLISH t/noack x 1 dup", "DISCONNECT"], "broker log");
+      result = ok;
+    });
+    mqtt2.connect();
+  });
+  setTimeout(function() { brokerSocket.end(); }, 100);
+}
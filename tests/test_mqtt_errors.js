@@ -0,0 +1,69 @@
+// Native MQTT client: packets with a bad or huge 'remaining length' close the
+// connection with an error (rather than waiting for data forever), and packet
+// ids that wrap around skip ones still waiting to be acknowledged
+var result = 0;
+var net = require("net");
+var ok = true;
+function SHOULD_BE(a,b,msg) {
+  if (JSON.stringify(a)!=JSON.stringify(b)) {
+    console.log(msg, "GOT", JSON.stringify(a), "SHOULD BE", JSON.stringify(b));
+    ok = false;
+  }
+}
+
+var badPackets = [
+  "\x30\xFF\xFF\xFF\xFF\x01", // 5 byte remaining length
+  "\x30\xFF\xFF\xFF\x7F"      // 256MB
+];
+var ids = []; // packet ids of PUBLISH packets the broker got
+var brokerSocket;
+var broker = net.createServer(function(c) {
+  brokerSocket = c;
+  var data = "";
+  c.on('data', function(d) {
+    data += d;
+    while (data.length>=2) {
+      var len = 0, mul = 1, i = 1, b;
+      do { b = data.charCodeAt(i++); len += (b&127)*mul; mul *= 128; } while (b&128);
+      if (data.length < i+len) break;
+      var type = data.charCodeAt(0), body = data.substr(i, len);
+      data = data.substr(i+len);
+      if ((type>>4)==1) { // CONNECT
+        c.write("\x20\x02\x00\x00");
+      } else if ((type>>4)==3) { // PUBLISH - never acknowledged
+        var tl = body.charCodeAt(1);
+        ids.push(body.charCodeAt(2+tl)*256+body.charCodeAt(3+tl));
+      }
+    }
+  });
+});
+broker.listen(8087);
+
+var mqtt = require("MQTT").create("localhost", {port:8087, client_id:"err"});
+var errors = [];
+var done = false;
+mqtt.on('error', function(e) { errors.push(e); });
+mqtt.on('connected', function() {
+  if (badPackets.length) {
+    brokerSocket.write(badPackets.shift());
+    return;
+  }
+  // packet ids: 1 is still waiting for an acknowledgement when we wrap around
+  mqtt.publish("t", "a", {qos:1});
+  mqtt.pid = 0xFFFF;
+  mqtt.publish("t", "b", {qos:1});
+  setTimeout(function() {
+    SHOULD_BE(ids, [1, 2], "packet ids");
+    SHOULD_BE(errors, ["invalid packet header", "packet too large"], "errors");
+    done = true;
+    mqtt.disconnect();
+    broker.close();
+    result = ok;
+  }, 100);
+});
+mqtt.on('disconnected', function() {
+  if (done) return;
+  SHOULD_BE(mqtt.connected, false, "disconnected after error");
+  setTimeout(function() { mqtt.connect(); }, 10);
+});
+mqtt.connect();
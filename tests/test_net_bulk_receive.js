@@ -0,0 +1,70 @@
+// Bulk uploads should be read in big batches (not one small chunk per idle
+// loop) and must still arrive complete and in order - for raw sockets and
+// for an HTTP request body
+
+var result = 0;
+var net = require("net");
+var http = require("http");
+var ok = true;
+
+function pattern(n, seed) {
+  var s = "";
+  for (var i=0;i<n;i++) s += String.fromCharCode(33+((i*7+seed)%90));
+  return s;
+}
+var upload = pattern(40000, 1);
+
+var biggest = 0, events = 0;
+var server = net.createServer(function(c) {
+  var got = "";
+  c.on('data', function(d) {
+    events++;
+    if (d.length > biggest) biggest = d.length;
+    got += d;
+  });
+  c.on('close', function() {
+    if (got!=upload) {
+      console.log("net got", got.length, "expected", upload.length);
+      ok = false;
+    }
+    server.close();
+    postTest();
+  });
+});
+server.listen(8090);
+var client = net.connect({port: 8090}, function() {
+  client.end(upload);
+});
+
+function postTest() {
+  var hServer = http.createServer(function (req, res) {
+    var body = "";
+    req.on('data', function(d) { body += d; });
+    req.on('end', function() {
+      res.end(body.length.toString());
+      if (body!=upload) {
+        console.log("http got", body.length, "expected", upload.length);
+        ok = false;
+      }
+    });
+  });
+  hServer.listen(8091);
+  var req = http.request({host:"localhost", port:8091, method:"POST", path:"/",
+                          headers:{"Content-Length":upload.length}}, function(res) {
+    var reply = "";
+    res.on('data', function(d) { reply += d; });
+    res.on('close', function() {
+      if (reply!=upload.length) {
+        console.log("http reply", JSON.stringify(reply));
+        ok = false;
+      }
+      if (biggest <= 536) {
+        console.log("biggest data event", biggest, "of", events);
+        ok = false;
+      }
+      hServer.close();
+      result = ok;
+    });
+  });
+  req.end(upload);
+}
@@ -0,0 +1,68 @@
+// Pipes should move several chunks per idle loop, choose a chunk size when
+// none is given, wait for 'drain' when write returns false, and not read more
+// than will fit in a Serial port's transmit buffer
+var result = 0;
+var ok = true;
+function check(a, b, msg) {
+  if (a!=b) {
+    console.log(msg, "got", JSON.stringify(a), "expected", JSON.stringify(b));
+    ok = false;
+  }
+}
+
+var data = E.toString({data:"0123456789abcdef", count:256}); // 4k
+
+// destination that accepts everything
+var got = "", writes = 0, maxChunk = 0;
+E.pipe(data, {write:function(d) {
+  got += d; writes++;
+  if (d.length>maxChunk) maxChunk = d.length;
+}}, {complete:function() {
+  check(got, data, "plain pipe data");
+  check(maxChunk, 256, "default chunk size");
+  check(writes, 16, "plain pipe writes");
+  testDrain();
+}});
+// first idle should have moved more than one chunk
+setTimeout(function() {
+  if (writes<2) { console.log("Only", writes, "chunks moved"); ok = false; }
+}, 0);
+
+// destination that asks us to wait after every write
+function testDrain() {
+  var got = "", waiting = false;
+  var dst = {write:function(d) {
+    if (waiting) { console.log("write while waiting for drain"); ok = false; }
+    got += d;
+    waiting = true;
+    setTimeout(function() { waiting = false; dst.emit("drain"); }, 1);
+    return false;
+  }};
+  E.pipe(data, dst, {chunkSize:1000, complete:function() {
+    check(got, data, "drain pipe data");
+    testSerial();
+  }});
+}
+
+// Serial port: never read more than the transmit buffer has space for
+function testSerial() {
+  var file = "tests/Serial_Pipe.txt";
+  require("fs").writeFileSync(file, "");
+  Serial1.setup(9600, {path:file});
+  var biggest = 0;
+  var write = Serial1.write;
+  Serial1.write = function(d) {
+    if (d.length>biggest) biggest = d.length;
+    write.call(Serial1, d);
+  };
+  E.pipe(data, Serial1, {chunkSize:10000, end:false, complete:function() {
+    delete Serial1.write;
+    if (biggest<1 || biggest>=1024) { console.log("Serial chunk", biggest); ok = false; }
+    setTimeout(function() {
+      check(require("fs").readFileSync(file), data, "serial pipe data");
+      Serial1.unsetup();
+      require("fs").unlink(file);
+      result = ok;
+    }, 500);
+  }});
+}
@@ -0,0 +1,55 @@
+// Serial.setup with rxBuffer should receive into a binary ring buffer:
+// read/peek/indexOf work on it, 'data' gets Uint8Array views (split where the
+// ring wraps) and with no listener new data is dropped when it's full
+
+var result = 0;
+var ok = true;
+function check(a, b, msg) {
+  if (a!=b) {
+    console.log(msg, "got", JSON.stringify(a), "expected", JSON.stringify(b));
+    ok = false;
+  }
+}
+function str(d) { return d ? E.toString(d) : d; }
+
+LoopbackB.setup(9600, {rxBuffer:16});
+LoopbackA.write("hello\nworld");
+setTimeout(function() {
+  check(LoopbackB.available(), 11, "available");
+  check(LoopbackB.indexOf("\n"), 5, "indexOf");
+  check(LoopbackB.indexOf("o", 5), 7, "indexOf fromIndex");
+  check(LoopbackB.indexOf("x"), -1, "indexOf missing");
+  var p = LoopbackB.peek(3);
+  check(p instanceof Uint8Array, true, "peek type");
+  check(str(p), "hel", "peek");
+  check(str(LoopbackB.read(6)), "hello\n", "read");
+  check(LoopbackB.available(), 5, "available after read");
+  // fill past the end of the ring, so it wraps
+  LoopbackA.write("0123456789");
+  setTimeout(function() {
+    check(LoopbackB.available(), 15, "available after wrap");
+    check(LoopbackB.indexOf("d0"), 4, "indexOf across wrap");
+    check(str(LoopbackB.read()), "world0123456789", "read across wrap");
+    // overflow with no listener drops new data
+    E.getErrorFlags();
+    LoopbackA.write("ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    setTimeout(function() {
+      check(LoopbackB.available(), 16, "available after overflow");
+      check(str(LoopbackB.read()), "ABCDEFGHIJKLMNOP", "data kept on overflow");
+      check(E.getErrorFlags().indexOf("BUFFER_FULL")>=0, true, "BUFFER_FULL flag");
+      // data events get views onto the ring, split where it wraps
+      var got = [];
+      LoopbackB.on('data', function(d) {
+        check(d instanceof Uint8Array, true, "data type");
+        got.push(str(d));
+      });
+      LoopbackA.write("abcdefghijklmnopqrstuvwxyz");
+      setTimeout(function() {
+        check(got.join(""), "abcdefghijklmnopqrstuvwxyz", "data events");
+        check(got.length>1, true, "data split at wrap");
+        check(LoopbackB.available(), 0, "available with listener");
+        result = ok;
+      }, 10);
+    }, 10);
+  }, 10);
+}, 10);
@@ -0,0 +1,48 @@
+// Data written to several Serial devices at once (big writes, small writes
+// and single characters, interleaved) should all arrive, in order, on the
+// right device. On Linux, Serial devices with a 'path' write to that file
+
+var result = 0;
+var fs = require("fs");
+var files = ["tests/Serial_TX_1.txt", "tests/Serial_TX_2.txt"];
+files.forEach(function(f) { fs.writeFileSync(f, ""); });
+Serial1.setup(115200, {path:files[0]});
+Serial2.setup(115200, {path:files[1]});
+
+function pattern(n, seed) {
+  var s = "";
+  for (var i=0;i<n;i++) s += String.fromCharCode(33+((i*7+seed)%90));
+  return s;
+}
+var expected = ["", ""];
+function send(n, data) {
+  [Serial1,Serial2][n].write(data);
+  expected[n] += E.toString(data);
+}
+send(0, pattern(4000, 1)); // much bigger than the transmit buffer
+for (var i=0;i<100;i++) {
+  send(0, pattern(i, i));
+  send(1, pattern(100-i, i));
+  send(1, "x");
+  send(0, "y");
+}
+send(1, new Uint8Array(E.toUint8Array(pattern(3000, 2))));
+Serial2.print("a\nb");
+expected[1] += "a\nb";
+Serial1.println("end");
+expected[0] += "end\r\n";
+
+setTimeout(function() {
+  var ok = true;
+  files.forEach(function(f, n) {
+    var got = fs.readFileSync(f);
+    if (got!=expected[n]) {
+      console.log(f, "got", got.length, "expected", expected[n].length);
+      ok = false;
+    }
+  });
+  Serial1.unsetup();
+  Serial2.unsetup();
+  files.forEach(function(f) { fs.unlink(f); });
+  result = ok;
+}, 500);
@@ -0,0 +1,48 @@
+// SPI.sendAsync and I2C.readFromAsync/writeToAsync should resolve with the
+// same data as the blocking versions. On Linux, SPI without a path loops back
+// and I2C without a path is a simulated 256 byte memory
+
+var result = 0;
+var ok = true;
+function check(a, b, msg) {
+  if (a!=b) {
+    console.log(msg, "got", JSON.stringify(a), "expected", JSON.stringify(b));
+    ok = false;
+  }
+}
+
+SPI1.setup({});
+I2C1.setup({});
+
+var big = new Uint8Array(E.toUint8Array({data:[1,2,3,4,5,6,7,8], count:200}));
+var resolved = false;
+var p = SPI1.sendAsync(big);
+check(p instanceof Promise, true, "sendAsync returns Promise");
+p.then(function(d) {
+  resolved = true;
+  check(d instanceof Uint8Array, true, "SPI result type");
+  check(d.length, 1600, "SPI result length");
+  check(E.toString(d)==E.toString(big), true, "SPI loopback data");
+  return SPI1.sendAsync([1,[2,3],"ab"]);
+}).then(function(d) {
+  check(d.join(","), "1,2,3,97,98", "SPI mixed data");
+  return I2C1.writeToAsync(0x50, 16, [10,20,30], "x");
+}).then(function(d) {
+  check(d, undefined, "writeToAsync result");
+  I2C1.writeTo(0x50, 16);
+  return I2C1.readFromAsync(0x50, 4);
+}).then(function(d) {
+  check(d.join(","), "10,20,30,120", "I2C readFromAsync");
+  // blocking calls give the same results
+  check(SPI1.send([5,6,7]).join(","), "5,6,7", "SPI.send");
+  check(I2C1.readReg(0x50, 17, 2).join(","), "20,30", "I2C.readReg");
+  // starting a second transfer waits for the first
+  var a = SPI1.sendAsync("hello");
+  var b = SPI1.sendAsync("world");
+  return Promise.all([a,b]);
+}).then(function(r) {
+  check(E.toString(r[0])+E.toString(r[1]), "helloworld", "two transfers");
+  result = ok;
+});
+// resolution always happens later, never during the call
+check(resolved, false, "resolved synchronously");
@@ -0,0 +1,57 @@
+// I2C/SPI.compile programs should give the same results as the individual
+// calls when run directly, and when scheduled on the utility timer. On Linux,
+// SPI without a path loops back and I2C without a path is a simulated memory
+
+var result = 0;
+var ok = true;
+function check(a, b, msg) {
+  if (a!=b) {
+    console.log(msg, "got", JSON.stringify(a), "expected", JSON.stringify(b));
+    ok = false;
+  }
+}
+
+SPI1.setup({});
+I2C1.setup({});
+I2C1.writeTo(0x50, 0, [1,2,3,4,5,6,7,8]);
+
+var i2cProg = I2C1.compile([
+  {address:0x50, write:2, stop:false}, {read:3},
+  {delay:10},
+  {write:[6]}, {read:2}
+]);
+check(i2cProg instanceof Uint8Array, true, "compile result");
+check(I2C1.run(i2cProg).join(","), "3,4,5,7,8", "I2C run");
+var buf = new Uint8Array(7);
+check(I2C1.run(i2cProg, new Uint8Array(buf.buffer, 1)).join(","), "3,4,5,7,8,0", "I2C run into buffer");
+check(buf.join(","), "0,3,4,5,7,8,0", "I2C buffer contents");
+
+var spiProg = SPI1.compile([
+  {pin:D10, value:0}, {write:[9,9]}, {send:"ab"}, {read:2}, {send:[3]}, {pin:D10, value:1}
+]);
+check(SPI1.run(spiProg).join(","), "97,98,0,0,3", "SPI run");
+check(digitalRead(D10), 1, "CS pin");
+
+// errors
+var err = 0;
+try { SPI1.run(i2cProg); } catch (e) { err++; }
+try { I2C1.run(i2cProg, new Uint8Array(2)); } catch (e) { err++; }
+try { I2C1.compile([{read:1}]); } catch (e) { err++; }
+try { I2C1.compile([{foo:1}]); } catch (e) { err++; }
+check(err, 4, "errors");
+
+// scheduled - 4 samples of 5 bytes
+var sampleBuf = new Uint8Array(20);
+var fills = 0;
+I2C1.schedule(i2cProg, sampleBuf, 5, function(b) {
+  fills++;
+  if (fills==2) {
+    I2C1.unschedule(i2cProg);
+    check(b, sampleBuf, "callback argument");
+    check(b.join(","), "3,4,5,7,8,3,4,5,7,8,3,4,5,7,8,3,4,5,7,8", "scheduled samples");
+  }
+});
+setTimeout(function() {
+  check(fills, 2, "buffer fills");
+  result = ok;
+}, 300);
@@ -0,0 +1,73 @@
+var tests=0,testsPass=0;
+function test(a,b) {
+  tests++;
+  if (a===b) testsPass++;
+  else console.log("Test "+tests+" failed", JSON.stringify(a), JSON.stringify(b));
+}
+
+var s = require("Storage");
+s.eraseAll();
+var f = s.open("log","w");
+var lines = [], all = "";
+// enough data that we span several chunks
+for (var i=0;i<200;i++) {
+  var l = "Line "+i+" "+"-".repeat(i%20)+"\n";
+  lines.push(l);
+  all += l;
+  f.write(l);
+}
+test(f.getLength(), all.length);
+
+f = s.open("log","r");
+test(f.readAt(0,10), all.substr(0,10));
+test(f.readAt(1500,100), all.substr(1500,100));
+test(f.readAt(all.length-5,100), all.substr(all.length-5));
+test(f.readAt(all.length,10), undefined);
+// readAt doesn't move the read position
+test(f.readLine(), lines[0]);
+
+test(f.seek(2000), 2000);
+test(f.read(50), all.substr(2000,50));
+test(f.seek(all.length+100), all.length);
+test(f.read(10), undefined);
+test(f.seek(-10), all.length-10);
+test(f.read(100), all.substr(all.length-10));
+
+// read backwards from the end
+f.seek(f.getLength());
+var ok = true;
+for (var i=lines.length-1;i>=0;i--)
+  if (f.readPrevLine()!==lines[i]) ok = false;
+test(ok, true);
+test(f.readPrevLine(), undefined);
+test(f.readLine(), lines[0]);
+
+// backwards then forwards from the middle of a line
+f.seek(all.indexOf("Line 100")+3);
+test(f.readPrevLine(), "Lin");
+test(f.readPrevLine(), lines[99]);
+test(f.readLine(), lines[99]);
+
+// files that end exactly at the end of a chunk
+var chunkSize = s.read("log\1").length;
+for (var n=1;n<=2;n++) {
+  var full = "x".repeat(chunkSize*n-3)+"ab\n";
+  f = s.open("full","w");
+  for (var i=0;i<full.length;i+=100) f.write(full.substr(i,100));
+  f = s.open("full","r");
+  test(f.getLength(), full.length);
+  test(f.seek(f.getLength()), full.length);
+  test(f.readPrevLine(), full);
+  test(f.readAt(full.length-3,10), "ab\n");
+  f.erase();
+}
+
+// file modes are still checked
+f = s.open("log","a");
+try {
+  f.seek(0);
+} catch (e) {
+  tests++;testsPass++;
+}
+
+result = tests==testsPass;
@@ -0,0 +1,27 @@
+// Lots of console output over telnet (coalesced into big packets) must all
+// arrive, in order
+
+var result = 0;
+var net = require("net");
+var N = 300;
+
+require("TelnetServer").setOptions({mode:"on"});
+setTimeout(function() {
+  var got = "", packets = 0;
+  var client = net.connect({port: 2323}, function() {
+    client.on('data', function(d) { got += d; packets++; });
+    client.write("\x10for(var i=0;i<"+N+";i++)print('line '+i+' of the console output test');\n");
+  });
+  setTimeout(function() {
+    var ok = true;
+    for (var i=0;i<N;i++)
+      if (got.indexOf("line "+i+" of the console output test\r\n")<0) ok = false;
+    if (!ok || packets > got.length/200) {
+      console.log("got", got.length, "chars in", packets, "packets", JSON.stringify(got.substr(-100)));
+      ok = false;
+    }
+    client.end();
+    require("TelnetServer").setOptions({mode:"off"});
+    result = ok;
+  }, 1000);
+}, 100);
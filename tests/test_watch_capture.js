@@ -0,0 +1,62 @@
+// setWatch with capture:Uint32Array records edges natively and calls back in
+// batches (when half full, or after captureGap with no edges). On Linux,
+// writing to a pin with no GPIO behind it replays edges into the watch
+
+var result = 0;
+var ok = true;
+var buf = new Uint32Array(64);
+var edges = [], overflow = 0, calls = 0;
+var pin = D20;
+
+setWatch(function(e) {
+  calls++;
+  if (e.buffer!==buf || e.pin!=pin) ok = false;
+  for (var i=0;i<e.count;i++)
+    edges.push(e.buffer[(e.start+i)%e.buffer.length]);
+  overflow += e.overflow;
+}, pin, { capture: buf, captureGap: 20 });
+
+// 3 bursts of 20 edges - each one is under half the buffer
+var n = 0, bursts = 0;
+var interval = setInterval(function() {
+  for (var i=0;i<20;i++) digitalWrite(pin, (++n)&1);
+  if (++bursts==3) clearInterval(interval);
+}, 50);
+
+setTimeout(function() {
+  // one big burst that won't all fit
+  for (var i=0;i<100;i++) digitalWrite(pin, (++n)&1);
+}, 200);
+
+setTimeout(function() {
+  if (edges.length+overflow != n || overflow!=100-64) {
+    console.log("got", edges.length, "edges +", overflow, "overflow, expected", n);
+    ok = false;
+  }
+  if (calls!=4) {
+    console.log("got", calls, "callbacks");
+    ok = false;
+  }
+  var state = 1;
+  for (var i=0;i<edges.length;i++) {
+    if ((edges[i]>>>31) != state) {
+      console.log("edge", i, "has wrong state");
+      ok = false;
+      break;
+    }
+    state ^= 1;
+    if (i && ((edges[i]-edges[i-1])&0x7FFFFFFF) > 300000) {
+      console.log("edge", i, "has a bad time");
+      ok = false;
+      break;
+    }
+  }
+  clearWatch();
+  // capture rejects arrays it can't write into directly
+  try {
+    setWatch(function(){}, pin, { capture: new Uint8Array(8) });
+    ok = false;
+  } catch (e) {
+  }
+  result = ok;
+}, 400);
@@ -0,0 +1,108 @@
+// setWatch dispatches pin events through a native table of watches. On Linux,
+// writing to a pin with no GPIO behind it replays edges into the watch
+
+var result = 0;
+var ok = true;
+var pin = D20;
+
+function check(name, got, expected) {
+  if (got != expected) {
+    console.log(name, "got", got, "expected", expected);
+    ok = false;
+  }
+}
+
+function watchCount() {
+  return Object.keys(global["\xFF"].watches).length;
+}
+
+function pulse(n) {
+  for (var i=0;i<n;i++) {
+    digitalWrite(pin, 1);
+    digitalWrite(pin, 0);
+  }
+}
+
+var steps = [
+  function() { // edge filtering
+    var rising = 0, falling = 0, both = 0;
+    setWatch(function(e) { rising++; if (!e.state) ok=false; }, pin, { edge:"rising", repeat:true });
+    setWatch(function(e) { falling++; if (e.state) ok=false; }, pin, { edge:"falling", repeat:true });
+    setWatch(function() { both++; }, pin, { edge:"both", repeat:true });
+    pulse(5);
+    return function() {
+      check("rising", rising, 5);
+      check("falling", falling, 5);
+      check("both", both, 10);
+    };
+  },
+  function() { // debounce - only the final state after a burst of edges is reported
+    var calls = 0, lastState;
+    digitalWrite(pin, 0);
+    setWatch(function(e) { calls++; lastState = e.state; }, pin, { edge:"both", repeat:true, debounce:20 });
+    pulse(10);
+    digitalWrite(pin, 1);
+    return function() {
+      check("debounce calls", calls, 1);
+      check("debounce state", lastState, true);
+      digitalWrite(pin, 0);
+    };
+  },
+  function() { // repeat:false watches are removed after firing once
+    var once = 0, always = 0;
+    setWatch(function() { once++; }, pin, { edge:"rising", repeat:false });
+    setWatch(function() { always++; }, pin, { edge:"rising", repeat:true });
+    pulse(3);
+    return function() {
+      check("once", once, 1);
+      check("always", always, 3);
+      check("watches left", watchCount(), 1);
+    };
+  },
+  function() { // clearWatch from inside a callback, for this and other watches
+    var a = 0, b = 0, c = 0, wb, wc;
+    setWatch(function() { a++; if (a==2) clearWatch(wb); }, pin, { edge:"rising", repeat:true });
+    wb = setWatch(function() { b++; }, pin, { edge:"rising", repeat:true });
+    wc = setWatch(function() { c++; clearWatch(wc); }, pin, { edge:"rising", repeat:true });
+    pulse(4);
+    return function() {
+      check("a", a, 4);
+      check("b", b, 1);
+      check("c", c, 1);
+      check("watches left", watchCount(), 1);
+    };
+  },
+  function() { // more watches than fit in the table
+    var counts = [], w = [];
+    for (var i=0;i<40;i++) {
+      counts[i] = 0;
+      w.push(setWatch(function(e) { counts[this.n]++; }.bind({n:i}), pin, { edge:"rising", repeat:true }));
+    }
+    pulse(2);
+    // clear a few so we're back under the limit, and check we switch back
+    setTimeout(function() {
+      for (var i=0;i<20;i++) clearWatch(w[i]);
+      pulse(1);
+    }, 10);
+    return function() {
+      for (var i=0;i<40;i++)
+        check("watch "+i, counts[i], i<20 ? 2 : 3);
+      check("watches left", watchCount(), 20);
+    };
+  }
+];
+
+var step = 0;
+function next() {
+  clearWatch();
+  if (step>=steps.length) {
+    result = ok;
+    return;
+  }
+  var verify = steps[step++]();
+  setTimeout(function() {
+    verify();
+    next();
+  }, 100);
+}
+next();
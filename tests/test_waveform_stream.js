@@ -0,0 +1,49 @@
+// Waveform can stream playback from a StorageFile and record into one without
+// any JS code running per buffer
+var result = 0;
+var ok = true;
+function check(a, b, msg) {
+  if (a!=b) {
+    console.log(msg, "got", JSON.stringify(a), "expected", JSON.stringify(b));
+    ok = false;
+  }
+}
+var s = require("Storage");
+s.eraseAll();
+// a running Waveform doesn't keep the Linux test runner going by itself
+var keepAlive = setTimeout(function(){}, 5000);
+
+// 1000 samples, played back 64 at a time
+var f = s.open("wvplay","w");
+for (var i=0;i<10;i++) f.write(E.toString({data:i,count:100}));
+var src = s.open("wvplay","r");
+var w = new Waveform(64);
+var events = 0;
+w.on("buffer", function() { events++; });
+var t = getTime();
+w.startOutput(D1, 4000, {stream:src});
+check(w.buffer2.length, 64, "second buffer");
+w.on("finish", function() {
+  var dt = getTime()-t;
+  if (dt<0.2 || dt>1.5) {
+    console.log("Playback took", dt);
+    ok = false;
+  }
+  check(src.read(1), undefined, "all data read");
+  check(events, 0, "'buffer' events");
+  // now record for a while
+  var rec = s.open("wvrec","w");
+  var w2 = new Waveform(64, {doubleBuffer:true});
+  w2.on("finish", function() {
+    var len = s.open("wvrec","r").getLength();
+    if (len<800 || len>1200) {
+      console.log("Recorded", len);
+      ok = false;
+    }
+    s.eraseAll();
+    clearTimeout(keepAlive);
+    result = ok;
+  });
+  w2.startInput(D1, 4000, {stream:rec});
+  setTimeout(function() { w2.stop(); }, 250);
+});